@@ -0,0 +1,57 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef SG_GRAPHICS_BXDFS_SH_HEADER_GUARD
+#define SG_GRAPHICS_BXDFS_SH_HEADER_GUARD
+
+// Microfacet specular and diffuse BRDF terms. Prototypes/common/bxdfs.h implements the
+// same functions on the CPU, keep both in sync.
+
+#ifndef PI
+#	define PI 3.14159265
+#endif // PI
+
+// Taken from Siggraph 2014: Moving Frostbite to Physically based rendering V3 course notes. Sebastien Lagarde
+// https://media.contentapi.ea.com/content/dam/eacom/frostbite/files/course-notes-moving-frostbite-to-pbr-v32.pdf
+vec3 F_Schlick(in vec3 f0, in float f90, in float u)
+{
+	return f0 + (f90 - f0) * pow(1.0 - u, 5.0);
+}
+
+// Taken from Siggraph 2014: Moving Frostbite to Physically based rendering V3 course notes. Sebastien Lagarde
+// https://media.contentapi.ea.com/content/dam/eacom/frostbite/files/course-notes-moving-frostbite-to-pbr-v32.pdf
+float D_GGX(float _NdotH, float _alpha)
+{
+	float alpha2 = _alpha * _alpha;
+	float f = (_NdotH * alpha2 - _NdotH)*_NdotH + 1.0;
+	return alpha2 / (f*f);
+}
+
+// Taken from Siggraph 2014: Moving Frostbite to Physically based rendering V3 course notes. Sebastien Lagarde
+// https://media.contentapi.ea.com/content/dam/eacom/frostbite/files/course-notes-moving-frostbite-to-pbr-v32.pdf
+float G_SmithGGXCorrelated(float _NdotL, float _NdotV, float _alphaG)
+{
+	float alphaG2 = _alphaG * _alphaG;
+	float Lambda_GGXV = _NdotL * sqrt((-_NdotV * alphaG2 + _NdotV) * _NdotV + alphaG2);
+	float Lambda_GGXL = _NdotV * sqrt((-_NdotL * alphaG2 + _NdotL) * _NdotL + alphaG2);
+
+	return 0.5 / (Lambda_GGXL + Lambda_GGXV);
+}
+
+// Taken from Siggraph 2014: Moving Frostbite to Physically based rendering V3 course notes. Sebastien Lagarde
+// https://media.contentapi.ea.com/content/dam/eacom/frostbite/files/course-notes-moving-frostbite-to-pbr-v32.pdf
+float Fr_DisneyDiffuse(float _NdotV, float _NdotL, float _LdotH, float _roughness)
+{
+	float energyBias    = mix(0.0, 0.5, _roughness);
+	float energyFactor  = mix(1.0, 1.0/1.51, _roughness);
+	float fd90          = energyBias + 2.0 * _LdotH * _LdotH * _roughness;
+	vec3  f0            = vec3(1.0, 1.0, 1.0);
+	float lightScatter  = F_Schlick(f0, fd90, _NdotL).r;
+	float viewScatter   = F_Schlick(f0, fd90, _NdotV).r;
+
+	return lightScatter * viewScatter * energyFactor;
+}
+
+#endif // SG_GRAPHICS_BXDFS_SH_HEADER_GUARD
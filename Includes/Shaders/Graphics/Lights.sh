@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef SG_GRAPHICS_LIGHTS_SH_HEADER_GUARD
+#define SG_GRAPHICS_LIGHTS_SH_HEADER_GUARD
+
+// Light falloff and image based lighting. Prototypes/common/bxdfs.h implements the same
+// functions on the CPU, keep both in sync.
+
+// Point light color at squared distance _radiusSquared. Taken from chapter 5.2 of Real
+// Time Rendering 3rd Edition (Pg 111-113).
+vec3 light_point_attenuated(vec3 _lightColor, float _radiusSquared, float _minRadius, float _maxRadius)
+{
+	// Dampening factor taken from unreal and Frostbyte game engines. RealTime Rendering 3rd Edition Eq: 5.14
+	float ratio2    = _radiusSquared/(_maxRadius*_maxRadius);
+	float dampening = max(0.0, 1.0 - ratio2*ratio2);
+	dampening = dampening * dampening;
+
+	// Assuming at 1 m measured luminance of 50.0 .
+	float intensity = 50.0 * 1.0/max(_minRadius*_minRadius, _radiusSquared);
+	return _lightColor * intensity * dampening;
+}
+
+// Split sum image based lighting. _dfg is the DFG table (Prototypes/common/dfg_lut.h)
+// at (NdotV, roughness), _prefiltered the specular cubemap (Prototypes/common/ibl.h) at
+// mip light_ibl_lod() along the reflection vector, _irradiance the irradiance cubemap
+// along the normal.
+float light_ibl_lod(float _roughness, float _maxLod)
+{
+	return _roughness * _maxLod;
+}
+
+vec3 light_ibl_specular(vec3 _prefiltered, vec3 _dfg, vec3 _f0, float _f90)
+{
+	return _prefiltered * (_f0*_dfg.x + _f90*_dfg.y);
+}
+
+vec3 light_ibl_diffuse(vec3 _irradiance, vec3 _dfg, vec3 _albedo)
+{
+	return _irradiance * _albedo * _dfg.z;
+}
+
+// Irradiance/PI along _normal from L2 spherical harmonics (Prototypes/common/ibl.h),
+// drop in for the irradiance cubemap fetch in light_ibl_diffuse().
+vec3 light_sh_irradiance(vec3 _normal
+	, vec3 _sh0, vec3 _sh1, vec3 _sh2
+	, vec3 _sh3, vec3 _sh4, vec3 _sh5
+	, vec3 _sh6, vec3 _sh7, vec3 _sh8
+	)
+{
+	float x = _normal.x;
+	float y = _normal.y;
+	float z = _normal.z;
+
+	vec3 irradiance = _sh0 * 0.282095
+		+ _sh1 * (0.488603 * y)
+		+ _sh2 * (0.488603 * z)
+		+ _sh3 * (0.488603 * x)
+		+ _sh4 * (1.092548 * x*y)
+		+ _sh5 * (1.092548 * y*z)
+		+ _sh6 * (0.315392 * (3.0*z*z - 1.0) )
+		+ _sh7 * (1.092548 * x*z)
+		+ _sh8 * (0.546274 * (x*x - y*y) )
+		;
+
+	// Ringing can go negative behind bright lights.
+	return max(irradiance, vec3_splat(0.0) );
+}
+
+#endif // SG_GRAPHICS_LIGHTS_SH_HEADER_GUARD
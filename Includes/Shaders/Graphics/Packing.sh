@@ -0,0 +1,26 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef SG_GRAPHICS_PACKING_SH_HEADER_GUARD
+#define SG_GRAPHICS_PACKING_SH_HEADER_GUARD
+
+// Octahedral normal encoding, matches octEncode()/octDecode() in
+// Prototypes/common/mesh_quantize.h.
+vec2 octEncode(vec3 _normal)
+{
+	vec3 n = _normal / (abs(_normal.x) + abs(_normal.y) + abs(_normal.z) );
+	vec2 fold = (vec2_splat(1.0) - abs(n.yx) ) * mix(vec2_splat(-1.0), vec2_splat(1.0), step(vec2_splat(0.0), n.xy) );
+	return mix(fold, n.xy, step(0.0, n.z) );
+}
+
+vec3 octDecode(vec2 _oct)
+{
+	vec3 n = vec3(_oct.xy, 1.0 - abs(_oct.x) - abs(_oct.y) );
+	float t = max(-n.z, 0.0);
+	n.xy += mix(vec2_splat(t), vec2_splat(-t), step(vec2_splat(0.0), n.xy) );
+	return normalize(n);
+}
+
+#endif // SG_GRAPHICS_PACKING_SH_HEADER_GUARD
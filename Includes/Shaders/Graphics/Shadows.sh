@@ -0,0 +1,103 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef SG_GRAPHICS_SHADOWS_SH_HEADER_GUARD
+#define SG_GRAPHICS_SHADOWS_SH_HEADER_GUARD
+
+// Shadow atlas lookups, see Prototypes/common/shadow_atlas.h and shadow_cascades.h.
+// Tiles are passed as their ShadowAtlas::getTileUv(), atlas uv = ndc.xy*tile.xy + tile.zw.
+
+// Cube shadow face _dir points into, 0 to 5 for +x, -x, +y, -y, +z, -z.
+float shadow_point_face(vec3 _dir)
+{
+	vec3 a = abs(_dir);
+	if (a.x >= a.y && a.x >= a.z)
+	{
+		return _dir.x >= 0.0 ? 0.0 : 1.0;
+	}
+
+	if (a.y >= a.z)
+	{
+		return _dir.y >= 0.0 ? 2.0 : 3.0;
+	}
+
+	return _dir.z >= 0.0 ? 4.0 : 5.0;
+}
+
+vec4 shadow_point_tile(float _face
+	, vec4 _tile0, vec4 _tile1, vec4 _tile2
+	, vec4 _tile3, vec4 _tile4, vec4 _tile5
+	)
+{
+	return _face < 0.5 ? _tile0
+		:  _face < 1.5 ? _tile1
+		:  _face < 2.5 ? _tile2
+		:  _face < 3.5 ? _tile3
+		:  _face < 4.5 ? _tile4
+		:                _tile5
+		;
+}
+
+// Atlas uv and depth of _dir, from the light to the shaded point, in face _face. View
+// axes are right = cross(up, forward) with the forward and up vectors of
+// shadowPointFaceMtx(). _depth is shadowPointDepthParams(), _bias moves the point
+// towards the light by a fraction of its distance.
+vec3 shadow_point_coord(vec3 _dir, float _face, vec4 _tile, vec2 _depth, float _bias)
+{
+	vec3 view = _face < 0.5 ? vec3(-_dir.z,  _dir.y,  _dir.x)
+		:       _face < 1.5 ? vec3( _dir.z,  _dir.y, -_dir.x)
+		:       _face < 2.5 ? vec3( _dir.x, -_dir.z,  _dir.y)
+		:       _face < 3.5 ? vec3( _dir.x,  _dir.z, -_dir.y)
+		:       _face < 4.5 ? vec3( _dir.x,  _dir.y,  _dir.z)
+		:                     vec3(-_dir.x,  _dir.y, -_dir.z)
+		;
+
+	vec2  uv    = view.xy/view.z * _tile.xy + _tile.zw;
+	float depth = _depth.x + _depth.y/(view.z*(1.0 - _bias) );
+	return vec3(uv, depth);
+}
+
+// Four bilinear comparisons half a texel apart, kept inside _tile so the filter never
+// reads a neighbouring tile.
+float shadow_sample_pcf(sampler2DShadow _atlas, vec3 _coord, vec4 _tile, float _texelSize)
+{
+	vec2 extent = abs(_tile.xy) - vec2_splat(1.5*_texelSize);
+	vec2 lo     = _tile.zw - extent;
+	vec2 hi     = _tile.zw + extent;
+	float depth = min(_coord.z, 1.0);
+	float offset = 0.5*_texelSize;
+
+	float visibility = 0.0;
+	visibility += shadow2D(_atlas, vec3(clamp(_coord.xy + vec2(-offset, -offset), lo, hi), depth) );
+	visibility += shadow2D(_atlas, vec3(clamp(_coord.xy + vec2( offset, -offset), lo, hi), depth) );
+	visibility += shadow2D(_atlas, vec3(clamp(_coord.xy + vec2(-offset,  offset), lo, hi), depth) );
+	visibility += shadow2D(_atlas, vec3(clamp(_coord.xy + vec2( offset,  offset), lo, hi), depth) );
+	return visibility * 0.25;
+}
+
+// Cascade of a point at view depth _depth, _splits holds the far depth of each cascade
+// with unused ones repeating the last. kShadowMaxCascades past the last cascade.
+float shadow_cascade_index(float _depth, vec4 _splits)
+{
+	return dot(step(_splits, vec4_splat(_depth) ), vec4_splat(1.0) );
+}
+
+vec4 shadow_cascade_select(float _cascade, vec4 _value0, vec4 _value1, vec4 _value2, vec4 _value3)
+{
+	return _cascade < 0.5 ? _value0
+		:  _cascade < 1.5 ? _value1
+		:  _cascade < 2.5 ? _value2
+		:                   _value3
+		;
+}
+
+// Atlas uv and depth of light view position _pos in a cascade, _uv and _depth are
+// shadowCascadeUv(). _bias is in depth texels.
+vec3 shadow_cascade_coord(vec3 _pos, vec4 _uv, vec2 _depth, float _bias)
+{
+	return vec3(_pos.xy*_uv.xy + _uv.zw, _pos.z*_depth.x + _depth.y - _bias);
+}
+
+#endif // SG_GRAPHICS_SHADOWS_SH_HEADER_GUARD
@@ -1,4 +1,4 @@
-$input v_pos, v_normal, v_view
+$input v_pos, v_normal, v_view, v_world
 
 /*
  * Copyright 2025 Soumitra Goswami. All rights reserved.
@@ -7,6 +7,9 @@ $input v_pos, v_normal, v_view
 
 #include "../common/common.sh"
 #include "uniforms.sh"
+#include "Graphics/Shadows.sh"
+
+SAMPLER2DSHADOW(s_shadowAtlas, 0);
 
 vec3 gooch_highlighted(vec3 _colorCool, vec3 _colorWarm, vec3 _colorHighlight, float _kDiff, float _kSpec )
 {
@@ -32,9 +35,26 @@ vec3 gooch_highlighted(vec3 _colorCool, vec3 _colorWarm, vec3 _colorHighlight, f
     float kDiff = (ndotl + 1.0) * 0.5f;
     vec3 rVec = 2.0 * (ndotl)*normal - 1.0;
     float kSpec = clamp(100.0 * dot(rVec, view)- 97.0,0.0,1.0); // saturate not available in GLSL. Use clamp instead.
+
+    // Sun shadow from the cascade covering this view depth. Shadowed points take the
+    // cool tone and lose the highlight.
+    vec3  shadowPos     = vec3(dot(u_shadowAxisX, v_world), dot(u_shadowAxisY, v_world), dot(u_shadowAxisZ, v_world) );
+    float cascade       = shadow_cascade_index(v_view.z, u_cascadeSplits);
+    vec4  cascadeMask   = shadow_cascade_select(cascade, vec4(1.0, 0.0, 0.0, 0.0), vec4(0.0, 1.0, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(0.0, 0.0, 0.0, 1.0) );
+    vec4  cascadeUv     = shadow_cascade_select(cascade, u_cascadeUv0, u_cascadeUv1, u_cascadeUv2, u_cascadeUv3);
+    vec4  cascadeTile   = shadow_cascade_select(cascade, u_cascadeTile0, u_cascadeTile1, u_cascadeTile2, u_cascadeTile3);
+    vec2  cascadeDepth  = vec2(dot(cascadeMask, u_cascadeDepthScale), dot(cascadeMask, u_cascadeDepthBias) );
+    vec3  shadowCoord   = shadow_cascade_coord(shadowPos, cascadeUv, cascadeDepth, u_shadowBias);
+    float visibility    = u_shadowEnabled > 0.5 && cascade < 3.5 ? shadow_sample_pcf(s_shadowAtlas, shadowCoord, cascadeTile, u_shadowTexelSize) : 1.0;
+    kDiff = mix(1.0, kDiff, visibility);
+    kSpec *= visibility;
     
     // Apply Shading
     vec3 color = gooch_highlighted(colorCool, colorWarm, colorHighlight, kDiff, kSpec );
+
+    // Tint each cascade to check the splits.
+    vec3 cascadeTint = shadow_cascade_select(cascade, vec4(1.0, 0.5, 0.5, 0.0), vec4(0.5, 1.0, 0.5, 0.0), vec4(0.5, 0.5, 1.0, 0.0), vec4(1.0, 1.0, 0.5, 0.0) ).xyz;
+    color *= u_cascadeDebug > 0.5 && cascade < 3.5 ? cascadeTint : vec3_splat(1.0);
     
     
     // Apply sRGB lut "pow(color,1/2.2)"
@@ -0,0 +1,11 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "../common/common.sh"
+
+void main()
+{
+	gl_FragColor = vec4_splat(0.0);
+}
@@ -4,15 +4,23 @@
  */
 
 #include "common.h"
+#include "camera.h"
 #include "bgfx_utils.h"
 #include "imgui/imgui.h"
+#include "prototype_app.h"
+#include "shadow_atlas.h"
+#include "shadow_cascades.h"
+#include "uniform_block.h"
+#include "uniforms.h"
 
+#include <bx/hash.h>
+#include <bx/timer.h>
 
-namespace
-{
+#include <vector>
 
-#define RENDER_PASS_MAIN	0
 
+namespace
+{
 
 struct Settings
 {
@@ -21,6 +29,16 @@ struct Settings
 	float m_highlightColor[3];
 	float m_surfaceColor[3];
 
+	// Sun shadows
+	bool m_shadows;
+	bool m_shadowCaching;
+	bool m_cascadeDebug;
+	bool m_rotateBunny;
+	int32_t m_numCascades;
+	float m_shadowDistance;
+	float m_splitLambda;
+	float m_shadowBias;
+
 	Settings()
 	{
 		// Default Gooch shading parameters
@@ -28,233 +46,450 @@ struct Settings
 		m_warmColor[0] = 0.3f; m_warmColor[1] = 0.3f; m_warmColor[2] = 0.0f; // Yellowish
 		m_coolColor[0] = 0.0f; m_coolColor[1] = 0.0f; m_coolColor[2] = 0.55f; // Bluish
 		m_highlightColor[0] = 1.0f; m_highlightColor[1] = 1.0f; m_highlightColor[2] = 1.0f; // White
+
+		m_shadows        = true;
+		m_shadowCaching  = true;
+		m_cascadeDebug   = false;
+		m_rotateBunny    = true;
+		m_numCascades    = kShadowMaxCascades;
+		m_shadowDistance = 40.0f;
+		m_splitLambda    = 0.75f;
+		m_shadowBias     = 0.001f;
 	}
 };
 
-struct Uniforms // Constant Buffers
-{
-	enum { NumVec4 = 4 };
-
-	void init()
-	{
-		u_params = bgfx::createUniform("u_params", bgfx::UniformType::Vec4, NumVec4);
+typedef UniformBlock<GoochUniforms> Uniforms; // Constant Buffers
 
-	}
+constexpr float kFovY = 60.0f;
+constexpr float kNear = 0.1f;
+constexpr float kFar  = 100.0f;
 
-	void submit()
-	{
-		bgfx::setUniform(u_params, m_params, NumVec4);
-	}
-
-	void destroy()
-	{
-		bgfx::destroy(u_params);
-	}
-
-	union
-	{
-		struct
-		{
-			/* 0	*/	struct { float m_time; float m_warmColor[3]; };
-			/* 1    */  struct { float m_coolColor[3]; float m_lightDirX; };
-			/* 2    */  struct { float m_highlightColor[3]; float m_lightDirY;};
-			/* 3    */  struct { float m_surfaceColor[3]; float m_lightDirZ;};
-			///* 4    */  struct { float m_lightDir[3]; float m_unused3; };  // Light Dir could be packed into the other 3 float channels to save a float4 slot.
-		};	
-		float m_params[NumVec4 * 4];
-	};
-	bgfx::UniformHandle u_params;
+struct CascadeStats
+{
+	uint32_t m_numDraws;
+	uint32_t m_numSubmitted;
+	double   m_cpuMs;
+	bool     m_rendered;
 };
 
-class GoochHighlighted : public entry::AppI 
+class GoochHighlighted : public PrototypeApp
 {
 public:
-	entry::MouseState m_mouseState;
-	uint32_t m_width;
-	uint32_t m_height;
-	uint32_t m_debug;
-	uint32_t m_reset;
-
-	int64_t m_timeOffset;
-	Mesh* m_mesh;
+	MeshHandle m_mesh;
+	MeshHandle m_ground;
 	bgfx::ProgramHandle m_program;
+	bgfx::ProgramHandle m_programQuantized;
+	bgfx::ProgramHandle m_shadowProgram;
 
 	Uniforms m_uniforms;
+	RenderPassHandle m_shadowPass;
+	RenderPassHandle m_mainPass;
+	float m_time;
+	float m_view[16];
+	float m_proj[16];
+
+	// Rotating bunny at the origin and a field of still ones for the far cascades.
+	float m_bunnyTransform[16];
+	float m_groundTransform[16];
+	std::vector<float> m_bunnyTransforms;
+
+	// One atlas tile per cascade, each added as its own light so a cascade whose bounds
+	// and casters didn't change keeps its depth.
+	ShadowAtlas m_shadowAtlas;
+	ShadowCascade m_cascades[kShadowMaxCascades];
+	CascadeStats m_cascadeStats[kShadowMaxCascades];
+	uint16_t m_cascadeLights[kShadowMaxCascades];
+	uint8_t m_numCascades;
+	bool m_shadowsSupported;
+	bgfx::UniformHandle s_shadowAtlas;
 
 	// UI
 	Settings m_Settings;
 	float m_lightAngle;
 
-	void updateUniforms(int _pass, float _time)
+	void updateUniforms(bgfx::ViewId _pass)
 	{
-		m_uniforms.m_time = _time;
 		// Gooch shading parameters
-		m_uniforms.m_surfaceColor[0] = m_Settings.m_surfaceColor[0];		m_uniforms.m_surfaceColor[1] = m_Settings.m_surfaceColor[1];		m_uniforms.m_surfaceColor[2] = m_Settings.m_surfaceColor[2];
-		m_uniforms.m_warmColor[0] = m_Settings.m_warmColor[0];				m_uniforms.m_warmColor[1] = m_Settings.m_warmColor[1];				m_uniforms.m_warmColor[2] = m_Settings.m_warmColor[2];
-		m_uniforms.m_coolColor[0] = m_Settings.m_coolColor[0];				m_uniforms.m_coolColor[1] = m_Settings.m_coolColor[1];				m_uniforms.m_coolColor[2] = m_Settings.m_coolColor[2];
-		m_uniforms.m_highlightColor[0] = m_Settings.m_highlightColor[0];	m_uniforms.m_highlightColor[1] = m_Settings.m_highlightColor[1];	m_uniforms.m_highlightColor[2] = m_Settings.m_highlightColor[2];
+		m_uniforms.set<GoochUniforms::SurfaceColor>(m_Settings.m_surfaceColor);
+		m_uniforms.set<GoochUniforms::WarmColor>(m_Settings.m_warmColor);
+		m_uniforms.set<GoochUniforms::CoolColor>(m_Settings.m_coolColor);
+		m_uniforms.set<GoochUniforms::HighlightColor>(m_Settings.m_highlightColor);
 		
-		const bx::Vec3 at = { 0.0f, 1.0f,  0.0f };
-		const bx::Vec3 eye = { 0.0f, 1.0f, -2.5f };
+		// Set view and projection matrix for the main pass.
+		bgfx::setViewTransform(_pass, m_view, m_proj);
+
+		// Normals are shaded in view space.
+		m_uniforms.set<GoochUniforms::LightDir>(bx::mulXyz0(getSunDir(), m_view) );
+
+		updateShadowUniforms();
+	}
+
+	// Direction the sunlight travels, 60 degrees above the horizon with m_lightAngle
+	// as its azimuth.
+	bx::Vec3 getSunDir() const
+	{
+		const float altitude = bx::toRad(60.0f);
+		const bx::Vec3 pos =
+		{
+			 bx::cos(altitude) * bx::sin(m_lightAngle),
+			 bx::sin(altitude),
+			-bx::cos(altitude) * bx::cos(m_lightAngle),
+		};
+
+		return bx::neg(pos);
+	}
 
-		// Set view and projection matrix for view 0.
+	void updateShadowUniforms()
+	{
+		// Without a tile for every cascade the sun is unshadowed.
+		bool shadowed = 0 != m_numCascades;
+		for (uint8_t ii = 0; ii < m_numCascades; ++ii)
 		{
-			float view[16];
-			bx::mtxLookAt(view, eye, at);
+			shadowed = shadowed && m_shadowAtlas.hasTiles(m_cascadeLights[ii]);
+		}
 
-			float proj[16];
-			bx::mtxProj(proj, 60.0f, float(m_width) / float(m_height), 0.1f, 100.0f, bgfx::getCaps()->homogeneousDepth);
-			bgfx::setViewTransform(_pass, view, proj);
+		if (shadowed)
+		{
+			// The light view is a rotation shared by every cascade, pass its rows.
+			const float* view = m_cascades[0].m_view;
+			m_uniforms.set<GoochUniforms::ShadowAxisX>(bx::Vec3{ view[0], view[4], view[ 8] });
+			m_uniforms.set<GoochUniforms::ShadowAxisY>(bx::Vec3{ view[1], view[5], view[ 9] });
+			m_uniforms.set<GoochUniforms::ShadowAxisZ>(bx::Vec3{ view[2], view[6], view[10] });
+
+			const bool homogeneousDepth = bgfx::getCaps()->homogeneousDepth;
+
+			float uv[kShadowMaxCascades][4];
+			float tile[kShadowMaxCascades][4];
+			float splits[kShadowMaxCascades];
+			float depthScale[kShadowMaxCascades];
+			float depthBias[kShadowMaxCascades];
+			for (uint8_t ii = 0; ii < kShadowMaxCascades; ++ii)
+			{
+				// Unused cascades repeat the last, see shadow_cascade_index().
+				const uint8_t cascade = bx::min<uint8_t>(ii, m_numCascades - 1);
+				m_shadowAtlas.getTileUv(tile[ii], m_cascadeLights[cascade], 0);
+
+				float depth[2];
+				shadowCascadeUv(uv[ii], depth, m_cascades[cascade], tile[ii], homogeneousDepth);
+				splits[ii]     = m_cascades[cascade].m_far;
+				depthScale[ii] = depth[0];
+				depthBias[ii]  = depth[1];
+			}
+
+			m_uniforms.set<GoochUniforms::CascadeUv0>(uv[0]);
+			m_uniforms.set<GoochUniforms::CascadeUv1>(uv[1]);
+			m_uniforms.set<GoochUniforms::CascadeUv2>(uv[2]);
+			m_uniforms.set<GoochUniforms::CascadeUv3>(uv[3]);
+			m_uniforms.set<GoochUniforms::CascadeTile0>(tile[0]);
+			m_uniforms.set<GoochUniforms::CascadeTile1>(tile[1]);
+			m_uniforms.set<GoochUniforms::CascadeTile2>(tile[2]);
+			m_uniforms.set<GoochUniforms::CascadeTile3>(tile[3]);
+			m_uniforms.set<GoochUniforms::CascadeSplits>(splits);
+			m_uniforms.set<GoochUniforms::CascadeDepthScale>(depthScale);
+			m_uniforms.set<GoochUniforms::CascadeDepthBias>(depthBias);
+			m_uniforms.set<GoochUniforms::ShadowBias>(m_Settings.m_shadowBias);
+			m_uniforms.set<GoochUniforms::ShadowTexelSize>(1.0f / float(m_shadowAtlas.getDesc().m_size) );
 		}
 
-		// 60 degree altitude for light
-		bx::Vec3 pos = bx::normalize(bx::fromLatLong(m_lightAngle, bx::toRad(30)));
-		pos = bx::normalize(pos);
-		// Light direction
-		m_uniforms.m_lightDirX = -pos.x;
-		m_uniforms.m_lightDirY = -pos.y;
-		m_uniforms.m_lightDirZ = -pos.z;
+		m_uniforms.set<GoochUniforms::ShadowEnabled>(shadowed ? 1.0f : 0.0f);
+		m_uniforms.set<GoochUniforms::CascadeDebug>(m_Settings.m_cascadeDebug ? 1.0f : 0.0f);
 	}
 
+	void addMeshes(bool _shadow)
+	{
+		const Mesh* bunny  = m_meshes.get(m_mesh);
+		const Mesh* ground = m_meshes.get(m_ground);
+
+		if (_shadow)
+		{
+			const uint64_t state = 0
+				| BGFX_STATE_WRITE_Z
+				| BGFX_STATE_DEPTH_TEST_LESS
+				| BGFX_STATE_CULL_CCW
+				;
+
+			m_drawList.add(bunny, m_shadowProgram, m_bunnyTransform, state);
+			for (uint32_t ii = 0, num = uint32_t(m_bunnyTransforms.size() )/16; ii < num; ++ii)
+			{
+				m_drawList.add(bunny, m_shadowProgram, &m_bunnyTransforms[ii*16], state);
+			}
+		}
+		else
+		{
+			const bgfx::ProgramHandle bunnyProgram = meshIsQuantized(bunny) ? m_programQuantized : m_program;
+			m_drawList.add(bunny, bunnyProgram, m_bunnyTransform);
+			for (uint32_t ii = 0, num = uint32_t(m_bunnyTransforms.size() )/16; ii < num; ++ii)
+			{
+				m_drawList.add(bunny, bunnyProgram, &m_bunnyTransforms[ii*16]);
+			}
+
+			m_drawList.add(ground, meshIsQuantized(ground) ? m_programQuantized : m_program, m_groundTransform);
+		}
+	}
+
+	void submitShadowPass()
+	{
+		if (!m_shadowsSupported)
+		{
+			return;
+		}
+
+		m_numCascades = m_Settings.m_shadows ? uint8_t(m_Settings.m_numCascades) : 0;
+
+		ShadowCascadeDesc desc;
+		desc.m_numCascades = m_numCascades;
+		desc.m_distance    = m_Settings.m_shadowDistance;
+		desc.m_splitLambda = m_Settings.m_splitLambda;
+		desc.m_resolution  = m_shadowAtlas.getDesc().m_maxTileSize;
+
+		const bool homogeneousDepth = bgfx::getCaps()->homogeneousDepth;
+		if (0 != m_numCascades)
+		{
+			shadowCascadesFit(m_cascades, desc, m_view, kFovY, float(m_width) / float(m_height), kNear, getSunDir(), homogeneousDepth);
+		}
+
+		// Casters, placeholder meshes included. The ground only receives.
+		bx::HashMurmur2A casters;
+		casters.begin();
+		casters.add(m_bunnyTransform, sizeof(m_bunnyTransform) );
+		casters.add(m_bunnyTransforms.data(), uint32_t(m_bunnyTransforms.size() * sizeof(float) ) );
+		casters.add(m_meshes.get(m_mesh) );
+		const uint32_t castersHash = casters.end();
+
+		m_shadowAtlas.setCaching(m_Settings.m_shadowCaching);
+		m_shadowAtlas.begin();
+
+		for (uint8_t ii = 0; ii < m_numCascades; ++ii)
+		{
+			// Texel snapping keeps the bounds of a still camera's cascades bit exact.
+			bx::HashMurmur2A hash;
+			hash.begin();
+			hash.add(castersHash);
+			hash.add(m_cascades[ii].m_view, sizeof(m_cascades[ii].m_view) );
+			hash.add(m_cascades[ii].m_proj, sizeof(m_cascades[ii].m_proj) );
+
+			ShadowLightDesc light;
+			light.m_id       = ii;
+			light.m_hash     = hash.end();
+			light.m_tileSize = desc.m_resolution;
+			light.m_numTiles = 1;
+			m_cascadeLights[ii] = m_shadowAtlas.add(light);
+
+			m_cascadeStats[ii].m_rendered = false;
+		}
+
+		m_shadowAtlas.end();
+
+		m_shadowAtlas.submit([&](bgfx::ViewId _view, uint16_t _light, uint8_t _tile)
+		{
+			BX_UNUSED(_tile);
+
+			// Cascades are added in order, the light index is the cascade.
+			const ShadowCascade& cascade = m_cascades[_light];
+			CascadeStats& stats = m_cascadeStats[_light];
+
+			const int64_t start = bx::getHPCounter();
+
+			bgfx::setViewTransform(_view, cascade.m_view, cascade.m_proj);
+
+			m_drawList.begin();
+			addMeshes(true);
+			m_drawList.cull(cascade.m_view, cascade.m_proj);
+			m_drawList.submit(_view);
+
+			stats.m_numDraws     = m_drawList.getStats().m_numDraws;
+			stats.m_numSubmitted = m_drawList.getStats().m_numSubmitted;
+			stats.m_cpuMs        = double(bx::getHPCounter() - start) * 1000.0 / double(bx::getHPFrequency() );
+			stats.m_rendered     = true;
+		});
+	}
+
+	void submitMainPass(bgfx::ViewId _view)
+	{
+		updateUniforms(_view);
+
+		m_uniforms.submit();
+		m_drawList.begin();
+		addMeshes(false);
+		m_drawList.cull(m_view, m_proj);
+
+		bgfx::setTexture(0, s_shadowAtlas, m_shadowAtlas.getTexture() );
+		m_drawList.submit(_view, BGFX_DISCARD_ALL & ~BGFX_DISCARD_BINDINGS);
+		bgfx::discard();
+	}
 
 	GoochHighlighted(const char* _name, const char* _description, const char* _url)
-		: entry::AppI(_name, _description, _url), m_lightAngle(bx::toRad(0.0f))
+		: PrototypeApp(_name, _description, _url), m_time(0.0f), m_numCascades(0), m_shadowsSupported(false), m_lightAngle(bx::toRad(0.0f))
 	{
+		m_settingsHeight = 1.0f / 1.3f;
 	}
 
-	void init(int32_t _argc, const char* const* _argv, uint32_t _width, uint32_t _height) override
+	void onInit(int32_t _argc, const char* const* _argv) override
 	{
-		Args args(_argc, _argv);
-
-		m_width = _width;
-		m_height = _height;
-		m_debug = BGFX_DEBUG_NONE;
-		m_reset = BGFX_RESET_VSYNC;
-
-		bgfx::Init init;
-		init.type = args.m_type;
-		init.vendorId = args.m_pciId;
-		init.platformData.nwh = entry::getNativeWindowHandle(entry::kDefaultWindowHandle);
-		init.platformData.ndt = entry::getNativeDisplayHandle();
-		init.platformData.type = entry::getNativeWindowHandleType();
-		init.resolution.width = m_width;
-		init.resolution.height = m_height;
-		init.resolution.reset = m_reset;
-		bgfx::init(init);
-
-		// Enable debug Text
-		bgfx::setDebug(m_debug);
+		BX_UNUSED(_argc, _argv);
+
+		// Cascade tiles take the views below the graph's.
+		ShadowAtlasDesc shadowDesc;
+		shadowDesc.m_maxTileSize = 1024;
+		shadowDesc.m_maxViews    = kShadowMaxCascades;
+		m_graph.setFirstView(bgfx::ViewId(shadowDesc.m_maxViews) );
+		const RenderResourceHandle shadowAtlas = m_graph.createResource("Shadow atlas");
+
+		// Setup Shadow pass
+		{
+			m_shadowPass = m_graph.addPass(RenderPassDesc("Shadows"), [this](bgfx::ViewId _view) { BX_UNUSED(_view); submitShadowPass(); });
+			m_graph.write(m_shadowPass, shadowAtlas);
+
+			m_shadowsSupported = m_shadowAtlas.init(0, shadowDesc);
+			if (!m_shadowsSupported)
+			{
+				printf("[shadows] Depth comparison not supported, shadows disabled.\n");
+			}
+
+			m_shaderReload.loadProgram(&m_shadowProgram, "vs_goochhighlighted_shadow", "fs_goochhighlighted_shadow");
+			s_shadowAtlas   = bgfx::createUniform("s_shadowAtlas", bgfx::UniformType::Sampler);
+		}
 
 		// Setup Main pass
 		{
-			// Set view 0 clear sate.
-			bgfx::setViewClear(RENDER_PASS_MAIN
-				, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH
-				, 0x303030ff
-				, 1.0f
-				, 0
-			);
-
-			//u_time = bgfx::createUniform("u_time", bgfx::UniformFreq::Frame, bgfx::UniformType::Vec4);
+			RenderPassDesc desc("Main");
+			desc.m_clearFlags = BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH;
+			desc.m_clearRgba  = 0x303030ff;
+			m_mainPass = m_graph.addPass(desc, [this](bgfx::ViewId _view) { submitMainPass(_view); });
+			m_graph.read(m_mainPass, shadowAtlas);
+			m_graph.write(m_mainPass, m_graph.getBackbuffer());
+
 			m_uniforms.init();
 			// Create program from shaders
-			m_program = loadProgram("vs_goochhighlighted", "fs_goochhighlighted");
-			m_mesh = meshLoad("meshes/bunny.bin");
-			m_timeOffset = bx::getHPCounter();
-
+			m_shaderReload.loadProgram(&m_program, "vs_goochhighlighted", "fs_goochhighlighted");
+			m_shaderReload.loadProgram(&m_programQuantized, "vs_goochhighlighted_quantized", "fs_goochhighlighted");
+			m_mesh = m_meshes.request("meshes/bunny.bin");
+			m_ground = m_meshes.request("meshes/cube.bin");
 		}
-		imguiCreate();
 
+		// Same view as before the camera could move.
+		cameraCreate();
+		cameraSetPosition({ 0.0f, 1.0f, -2.5f });
+		cameraSetVerticalAngle(0.0f);
+
+		// Ground is the top of an 80x80 cube at y = 0.
+		float mtxScale[16];
+		const float scale = 40.0f;
+		bx::mtxScale(mtxScale, scale, scale, scale);
+
+		float mtxTranslate[16];
+		bx::mtxTranslate(mtxTranslate, 0.0f, -40.0f, 0.0f);
+		bx::mtxMul(m_groundTransform, mtxScale, mtxTranslate);
+
+		// 7x7 bunnies behind the first, reaching into every cascade.
+		const uint32_t side = 7;
+		const float spacing = 5.0f;
+		const float offset  = -0.5f * spacing * float(side - 1);
+		m_bunnyTransforms.resize(side*side*16);
+		for (uint32_t ii = 0; ii < side*side; ++ii)
+		{
+			bx::mtxSRT(&m_bunnyTransforms[ii*16]
+				, 1.0f, 1.0f, 1.0f
+				, 0.0f, float(ii) * 0.9f, 0.0f
+				, offset + spacing * float(ii % side), 0.0f, 5.0f + spacing * float(ii / side)
+				);
+		}
 
+		bx::mtxRotateXY(m_bunnyTransform, 0.0f, m_time * 0.37f);
 	}
 
-	int shutdown() override
+	void onShutdown() override
 	{
-		imguiDestroy();
+		cameraDestroy();
 
-		meshUnload(m_mesh);
+		m_meshes.release(m_mesh);
+		m_meshes.release(m_ground);
+		m_shadowAtlas.shutdown();
 
 		// Cleanup
 		bgfx::destroy(m_program);
-		// bgfx::destroy(u_time);
+		bgfx::destroy(m_programQuantized);
+		bgfx::destroy(m_shadowProgram);
+		bgfx::destroy(s_shadowAtlas);
 		m_uniforms.destroy();
+	}
+
+	// Scripted parameters for headless benchmark runs. Sweeps the sun and nudges the
+	// colors so every frame goes through the same uniform updates as a UI session.
+	void onBenchmark(float _progress) override
+	{
+		m_lightAngle = bx::toRad(bx::lerp(-45.0f, 45.0f, _progress) );
+		m_Settings.m_warmColor[0] = bx::lerp(0.3f, 0.6f, _progress);
+		m_Settings.m_coolColor[2] = bx::lerp(0.55f, 0.25f, _progress);
+	}
+
+	void onGui() override
+	{
+		ImGui::PushItemWidth(ImGui::GetWindowWidth() * 0.5f);
+		ImGui::Text("Light Parms");
+		ImGui::SliderAngle("Sun Angle (Azimuth)", &m_lightAngle, -45.0f, 45.0f);
+		ImGui::ColorEdit3("Gooch Warm Color", &m_Settings.m_warmColor[0], ImGuiColorEditFlags_NoSidePreview);
+		ImGui::ColorEdit3("Gooch Cool Color", &m_Settings.m_coolColor[0],  ImGuiColorEditFlags_NoSidePreview);
+		ImGui::ColorEdit3("Highlight Color", &m_Settings.m_highlightColor[0], ImGuiColorEditFlags_NoSidePreview);
+		
+
+		ImGui::Separator();
+		ImGui::Text("Surface Params");
+		ImGui::ColorEdit3("Surface Color", &m_Settings.m_surfaceColor[0], ImGuiColorEditFlags_NoAlpha | ImGuiColorEditFlags_NoSidePreview);
 
-		// Shutdown bgfx
-		bgfx::shutdown();
+		ImGui::Separator();
+		ImGui::Text("Sun Shadows");
+		if (!m_shadowsSupported)
+		{
+			ImGui::Text("Depth comparison not supported.");
+			return;
+		}
 
-		return 0;
+		ImGui::Checkbox("Cascaded shadows", &m_Settings.m_shadows);
+		ImGui::Checkbox("Cache still cascades", &m_Settings.m_shadowCaching);
+		ImGui::Checkbox("Show cascades", &m_Settings.m_cascadeDebug);
+		ImGui::Checkbox("Rotate bunny", &m_Settings.m_rotateBunny);
+		ImGui::SliderInt("Cascades", &m_Settings.m_numCascades, 1, kShadowMaxCascades);
+		ImGui::SliderFloat("Shadow Distance", &m_Settings.m_shadowDistance, 5.0f, kFar);
+		ImGui::SliderFloat("Split Lambda", &m_Settings.m_splitLambda, 0.0f, 1.0f);
+		ImGui::SliderFloat("Shadow Bias", &m_Settings.m_shadowBias, 0.0f, 0.01f, "%.4f");
 
+		for (uint8_t ii = 0; ii < m_numCascades; ++ii)
+		{
+			const CascadeStats& stats = m_cascadeStats[ii];
+			if (stats.m_rendered)
+			{
+				ImGui::Text("%u: %5.1f-%5.1f, %u/%u draws, %.3f ms"
+					, ii
+					, m_cascades[ii].m_near
+					, m_cascades[ii].m_far
+					, stats.m_numSubmitted
+					, stats.m_numDraws
+					, stats.m_cpuMs
+					);
+			}
+			else
+			{
+				ImGui::Text("%u: %5.1f-%5.1f, cached", ii, m_cascades[ii].m_near, m_cascades[ii].m_far);
+			}
+		}
 	}
 
-	bool update() override
+	void onUpdate(float _time, float _deltaTime) override
 	{
-		if (!entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState))
-		{
-		
-			// Set main render pass 
-			bgfx::setViewRect(RENDER_PASS_MAIN, 0, 0, uint16_t(m_width), uint16_t(m_height));
-
-			bgfx::touch(RENDER_PASS_MAIN);
-
-			float time = (float)((bx::getHPCounter() - m_timeOffset) / double(bx::getHPFrequency()));
-			//bgfx::setFrameUniform(u_time, &time);
-
-			updateUniforms(RENDER_PASS_MAIN, time);
-
-			// Set view 0 default viewport.
-			bgfx::setViewRect(RENDER_PASS_MAIN, 0, 0, uint16_t(m_width), uint16_t(m_height));
-			
-
-			// Update model matrix. Rotate over time.
-			float mtx[16];
-			bx::mtxRotateXY(mtx, 0.0f, time * 0.37f);
-
-			m_uniforms.submit();
-			meshSubmit(m_mesh, RENDER_PASS_MAIN, m_program, mtx);
-
-			//draw UI
-			imguiBeginFrame(m_mouseState.m_mx
-				, m_mouseState.m_my
-				, (m_mouseState.m_buttons[entry::MouseButton::Left] ? IMGUI_MBUT_LEFT : 0)
-				| (m_mouseState.m_buttons[entry::MouseButton::Right] ? IMGUI_MBUT_RIGHT : 0)
-				| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
-				, m_mouseState.m_mz
-				, uint16_t(m_width)
-				, uint16_t(m_height)
-			);
-
-			showExampleDialog(this);
-			ImGui::SetNextWindowPos(
-				ImVec2(m_width - m_width / 4.0f - 10.0f, 10.0f)
-				, ImGuiCond_FirstUseEver
-			);
-			ImGui::SetNextWindowSize(
-				ImVec2(m_width / 4.0f, m_height / 1.3f)
-				, ImGuiCond_FirstUseEver
-			);
-			ImGui::Begin("Settings", NULL, 0);
-
-			ImGui::PushItemWidth(ImGui::GetWindowWidth() * 0.5f);
-			ImGui::Text("Light Parms");
-			ImGui::SliderAngle("Sun Angle (Azimuth)", &m_lightAngle, -45.0f, 45.0f);
-			ImGui::ColorEdit3("Gooch Warm Color", &m_Settings.m_warmColor[0], ImGuiColorEditFlags_NoSidePreview);
-			ImGui::ColorEdit3("Gooch Cool Color", &m_Settings.m_coolColor[0],  ImGuiColorEditFlags_NoSidePreview);
-			ImGui::ColorEdit3("Highlight Color", &m_Settings.m_highlightColor[0], ImGuiColorEditFlags_NoSidePreview);
-			
-
-			ImGui::Separator();
-			ImGui::Text("Surface Params");
-			ImGui::ColorEdit3("Surface Color", &m_Settings.m_surfaceColor[0], ImGuiColorEditFlags_NoAlpha | ImGuiColorEditFlags_NoSidePreview);
-
-			ImGui::End();
-
-			imguiEndFrame();
-
-			bgfx::frame();
-			return true;
+		BX_UNUSED(_time);
 
+		// Update camera
+		cameraUpdate(_deltaTime * 0.15f, m_mouseState, ImGui::MouseOverArea());
+		cameraGetViewMtx(m_view);
+		bx::mtxProj(m_proj, kFovY, float(m_width) / float(m_height), kNear, kFar, bgfx::getCaps()->homogeneousDepth);
+
+		// Update model matrix. Rotate over time.
+		if (m_Settings.m_rotateBunny)
+		{
+			m_time += _deltaTime;
+			bx::mtxRotateXY(m_bunnyTransform, 0.0f, m_time * 0.37f);
 		}
-		return false;
 	}
 };
 
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef GOOCHHIGHLIGHTED_UNIFORMS_H_HEADER_GUARD
+#define GOOCHHIGHLIGHTED_UNIFORMS_H_HEADER_GUARD
+
+#include "frame_uniforms.h"
+#include "uniform_layout.h"
+
+// Single source for the u_params layout. uniforms.sh is generated from this file.
+// Per-material block, time lives in FrameUniforms so this only re-uploads when the
+// settings change.
+struct GoochUniforms
+{
+	enum Enum
+	{
+		WarmColor,
+		CoolColor,
+		HighlightColor,
+		SurfaceColor,
+		LightDir,
+
+		// Sun cascaded shadows, see shadow_cascades.h and Shadows.sh
+		ShadowAxisX,
+		ShadowAxisY,
+		ShadowAxisZ,
+		CascadeUv0,
+		CascadeUv1,
+		CascadeUv2,
+		CascadeUv3,
+		CascadeTile0,
+		CascadeTile1,
+		CascadeTile2,
+		CascadeTile3,
+		CascadeSplits,
+		CascadeDepthScale,
+		CascadeDepthBias,
+		ShadowBias,
+		ShadowTexelSize,
+		ShadowEnabled,
+		CascadeDebug,
+
+		Count
+	};
+
+	enum { NumVec4 = 18 };
+
+	static constexpr const char* s_name = "u_params";
+	static constexpr UniformField s_fields[Count] =
+	{
+		{ "u_warmColor",         3, false },
+		{ "u_coolColor",         3, false },
+		{ "u_highlightColor",    3, false },
+		{ "u_surfaceColor",      3, false },
+		{ "u_lightDir",          3, true  }, // Spread over the free .w lanes instead of taking a 5th vec4.
+		{ "u_shadowAxisX",       3, false },
+		{ "u_shadowAxisY",       3, false },
+		{ "u_shadowAxisZ",       3, false },
+		{ "u_cascadeUv0",        4, false },
+		{ "u_cascadeUv1",        4, false },
+		{ "u_cascadeUv2",        4, false },
+		{ "u_cascadeUv3",        4, false },
+		{ "u_cascadeTile0",      4, false },
+		{ "u_cascadeTile1",      4, false },
+		{ "u_cascadeTile2",      4, false },
+		{ "u_cascadeTile3",      4, false },
+		{ "u_cascadeSplits",     4, false },
+		{ "u_cascadeDepthScale", 4, false },
+		{ "u_cascadeDepthBias",  4, false },
+		{ "u_shadowBias",        1, false },
+		{ "u_shadowTexelSize",   1, false },
+		{ "u_shadowEnabled",     1, false },
+		{ "u_cascadeDebug",      1, false },
+	};
+};
+
+#define UNIFORM_BLOCKS(_x) \
+	_x(FrameUniforms) \
+	_x(GoochUniforms)
+
+#endif // GOOCHHIGHLIGHTED_UNIFORMS_H_HEADER_GUARD
@@ -1,9 +1,32 @@
-uniform vec4 u_params[4];
+// Generated by uniformgen from uniforms.h. Do not edit.
 
+uniform vec4 u_frame[1];
 
-#define u_time				u_params[0].x
-#define u_warmColor			u_params[0].yzw
-#define u_coolColor			u_params[1].xyz
-#define u_highlightColor	u_params[2].xyz
-#define u_surfaceColor		u_params[3].xyz
-#define u_lightDir			vec3(u_params[1].w, u_params[2].w, u_params[3].w)	
\ No newline at end of file
+#define u_time              u_frame[0].x
+#define u_deltaTime         u_frame[0].y
+
+uniform vec4 u_params[18];
+
+#define u_warmColor         u_params[11].xyz
+#define u_coolColor         u_params[12].xyz
+#define u_highlightColor    u_params[13].xyz
+#define u_surfaceColor      u_params[14].xyz
+#define u_lightDir          vec3(u_params[15].w, u_params[16].w, u_params[17].w)
+#define u_shadowAxisX       u_params[15].xyz
+#define u_shadowAxisY       u_params[16].xyz
+#define u_shadowAxisZ       u_params[17].xyz
+#define u_cascadeUv0        u_params[0].xyzw
+#define u_cascadeUv1        u_params[1].xyzw
+#define u_cascadeUv2        u_params[2].xyzw
+#define u_cascadeUv3        u_params[3].xyzw
+#define u_cascadeTile0      u_params[4].xyzw
+#define u_cascadeTile1      u_params[5].xyzw
+#define u_cascadeTile2      u_params[6].xyzw
+#define u_cascadeTile3      u_params[7].xyzw
+#define u_cascadeSplits     u_params[8].xyzw
+#define u_cascadeDepthScale u_params[9].xyzw
+#define u_cascadeDepthBias  u_params[10].xyzw
+#define u_shadowBias        u_params[11].w
+#define u_shadowTexelSize   u_params[12].w
+#define u_shadowEnabled     u_params[13].w
+#define u_cascadeDebug      u_params[14].w
@@ -1,5 +1,5 @@
 $input a_position, a_normal
-$output v_pos, v_normal, v_view
+$output v_pos, v_normal, v_view, v_world
 
 /*
  * Copyright 2025 Soumitra Goswami. All rights reserved.
@@ -15,4 +15,5 @@ $output v_pos, v_normal, v_view
     vec3 normal = a_normal.xyz*2.0 - 1.0;
     v_normal = mul(u_modelView, vec4(normal, 0.0)).xyz;
     v_view = mul(u_modelView, vec4(a_position,1.0)).xyz;
+    v_world = mul(u_model[0], vec4(a_position,1.0)).xyz;
  }
\ No newline at end of file
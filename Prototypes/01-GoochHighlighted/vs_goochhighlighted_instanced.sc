@@ -0,0 +1,22 @@
+$input a_position, a_normal, i_data0, i_data1, i_data2, i_data3
+$output v_pos, v_normal, v_view, v_world
+
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+ #include "../common/common.sh"
+
+ // Instanced draws, see mesh_instancing.h. The model matrix comes from i_data0..3.
+ void main()
+ {
+    mat4 model = mtxFromCols(i_data0, i_data1, i_data2, i_data3);
+    vec4 world = mul(model, vec4(a_position,1.0));
+    gl_Position = mul(u_viewProj, world);
+    v_pos = gl_Position.xyz;
+    vec3 normal = a_normal.xyz*2.0 - 1.0;
+    v_normal = mul(u_view, vec4(mul(model, vec4(normal, 0.0)).xyz, 0.0)).xyz;
+    v_view = mul(u_view, world).xyz;
+    v_world = world.xyz;
+ }
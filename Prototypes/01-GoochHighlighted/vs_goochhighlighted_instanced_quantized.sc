@@ -0,0 +1,24 @@
+$input a_position, a_normal, i_data0, i_data1, i_data2, i_data3
+$output v_pos, v_normal, v_view, v_world
+
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+ #include "../common/common.sh"
+ #include "Graphics/Packing.sh"
+
+ // Instanced draws of quantized meshes. The instance matrices already include the
+ // dequantization, the normal is octahedral encoded.
+ void main()
+ {
+    mat4 model = mtxFromCols(i_data0, i_data1, i_data2, i_data3);
+    vec4 world = mul(model, vec4(a_position,1.0));
+    gl_Position = mul(u_viewProj, world);
+    v_pos = gl_Position.xyz;
+    vec3 normal = octDecode(a_normal.xy);
+    v_normal = mul(u_view, vec4(mul(model, vec4(normal, 0.0)).xyz, 0.0)).xyz;
+    v_view = mul(u_view, world).xyz;
+    v_world = world.xyz;
+ }
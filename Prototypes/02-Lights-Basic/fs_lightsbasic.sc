@@ -4,66 +4,17 @@ $input v_world, v_normal, v_view
  * Copyright 2025 Soumitra Goswami. All rights reserved.
  * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
  */
+// permutations: SHADOWS IBL IBL_SH:IBL
 #include "../common/common.sh"
 #include "uniforms.sh"
+#include "Graphics/BXDFs.sh"
+#include "Graphics/Lights.sh"
+#include "Graphics/Shadows.sh"
 
-#define PI 3.14159265
-
-
-// Taken from Siggraph 2014: Moving Frostbite to Physically based rendering V3 course notes. Sebastien Lagarde
-// https://media.contentapi.ea.com/content/dam/eacom/frostbite/files/course-notes-moving-frostbite-to-pbr-v32.pdf
-vec3 F_Schlick(in vec3 f0, in float f90, in float u)
-{
-    return f0 + (f90 - f0) * pow(1.f - u, 5.f);
-}
-
-// Taken from Siggraph 2014: Moving Frostbite to Physically based rendering V3 course notes. Sebastien Lagarde
-// https://media.contentapi.ea.com/content/dam/eacom/frostbite/files/course-notes-moving-frostbite-to-pbr-v32.pdf
-float D_GGX(float _NdotH, float _alpha)
-{
-    float alpha2 = _alpha * _alpha;
-    float f = (_NdotH * alpha2 - _NdotH)*_NdotH + 1.0;
-    return alpha2 / (f*f);
-}
-
-// Taken from Siggraph 2014: Moving Frostbite to Physically based rendering V3 course notes. Sebastien Lagarde
-// https://media.contentapi.ea.com/content/dam/eacom/frostbite/files/course-notes-moving-frostbite-to-pbr-v32.pdf
-float G_SmithGGXCorrelated(float _NdotL, float _NdotV, float _alphaG)
-{
-    float alphaG2 = _alphaG * _alphaG;
-    float Lambda_GGXV = _NdotL * sqrt((-_NdotV * alphaG2 + _NdotV)) * _NdotV + alphaG2;
-    float Lambda_GGXL = _NdotV * sqrt((-_NdotL * alphaG2 + _NdotL)) * _NdotL + alphaG2;
-
-    return 0.5f/ (Lambda_GGXL + Lambda_GGXV);
-}
-
-
-vec3 light_point_attenuated(vec3 _lightColor, float _radiusSquared, float _minRadius, float _maxRadius)
-{
-    //Taken from chapter 5.2 of Real Time Rendering 3rd Edition (Pg 111-113)
-    
-    // Dampening factor taken from unreal and Frostbyte game engines. RealTime Rendering 3rd Edition Eq: 5.14
-    float dampening = max(0.0, 1.0 - ((_radiusSquared/(_maxRadius*_maxRadius))*(_radiusSquared/(_maxRadius*_maxRadius))));
-    dampening = dampening * dampening;
-    
-    // Assuming at 1 m measured luminance of 50.0 .
-    float intensity = 50.0 * 1.0/max(_minRadius*_minRadius, _radiusSquared);
-    return _lightColor * intensity * dampening;
-}
-
-// Taken from Siggraph 2014: Moving Frostbite to Physically based rendering V3 course notes. Sebastien Lagarde
-// https://media.contentapi.ea.com/content/dam/eacom/frostbite/files/course-notes-moving-frostbite-to-pbr-v32.pdf
-float Fr_DisneyDiffuse (float _NdotV, float _NdotL, float _LdotH, float _roughness )
-{
-    float energyBias    = mix(0, 0.5f, _roughness);
-    float energyFactor  = mix(1.0, 1.0/1.51, _roughness);
-    float fd90          = energyBias + 2.0 * _LdotH * _LdotH * _roughness;
-    vec3  f0            = vec3(1.0f, 1.0f, 1.0f);
-    float lightScatter  = F_Schlick(f0, fd90, _NdotL).r;
-    float viewScatter   = F_Schlick(f0, fd90, _NdotV).r;
-
-    return lightScatter * viewScatter * energyFactor;
-}
+SAMPLER2D(s_dfgLut, 0);
+SAMPLERCUBE(s_envSpecular, 1);
+SAMPLERCUBE(s_envIrradiance, 2);
+SAMPLER2DSHADOW(s_shadowAtlas, 3);
 
 void main()
 {
@@ -76,11 +27,11 @@ vec3 lightDir = normalize(lightMinusPos);
 
 vec3 lightColor = light_point_attenuated(u_lightColor, dot(lightMinusPos, lightMinusPos), u_lightRadiusMin, u_lightRadiusMax);
 
-float NdotV = abs(dot(normal, view)) + 1e-5f;
+float NdotV = abs(dot(normal, view)) + 1e-5;
 vec3  H     = normalize(view + lightDir);
-float LdotH = clamp(dot(lightDir, H), 0.f, 1.f);
-float NdotH = clamp(dot(normal, H), 0.f, 1.f);
-float NdotL = clamp(dot(normal, lightDir), 0.f, 1.f);
+float LdotH = clamp(dot(lightDir, H), 0.0, 1.0);
+float NdotH = clamp(dot(normal, H), 0.0, 1.0);
+float NdotL = clamp(dot(normal, lightDir), 0.0, 1.0);
 
 // Specular BRDF 
 vec3 f0    = mix(vec3(1.0,1.0,1.0), u_f0, u_metallic);
@@ -95,7 +46,35 @@ vec3  Fr    = (D * G / PI) * F;
 // Diffuse BRDF
 float Fd    = Fr_DisneyDiffuse(NdotV, NdotL, LdotH, u_roughness);
 
-vec3 color =  lightColor * Fr * Fd;
+// Point light shadow from the atlas.
+#ifdef SHADOWS
+vec3  lightToPoint = v_world.xyz - lightPos;
+float shadowFace   = shadow_point_face(lightToPoint);
+vec4  shadowTile   = shadow_point_tile(shadowFace, u_shadowTile0, u_shadowTile1, u_shadowTile2, u_shadowTile3, u_shadowTile4, u_shadowTile5);
+vec3  shadowCoord  = shadow_point_coord(lightToPoint, shadowFace, shadowTile, u_shadowDepth, u_shadowBias);
+float visibility   = shadow_sample_pcf(s_shadowAtlas, shadowCoord, shadowTile, u_shadowTexelSize);
+#else
+float visibility   = 1.0;
+#endif
+
+vec3 color =  lightColor * Fr * Fd * visibility;
+
+// Image based ambient, in world space. Irradiance from spherical harmonics with IBL_SH,
+// from the irradiance cubemap otherwise.
+#ifdef IBL
+vec3  eye         = mul(u_invView, vec4(0.0, 0.0, 0.0, 1.0)).xyz;
+vec3  worldView   = normalize(eye - v_world.xyz);
+vec3  reflected   = reflect(-worldView, normal);
+float worldNdotV  = clamp(dot(normal, worldView), 0.0, 1.0);
+vec3  dfg         = texture2D(s_dfgLut, vec2(worldNdotV, u_roughness)).xyz;
+vec3  prefiltered = textureCubeLod(s_envSpecular, reflected, light_ibl_lod(u_roughness, u_iblMaxLod)).xyz;
+#ifdef IBL_SH
+vec3  irradiance  = light_sh_irradiance(normal, u_sh0, u_sh1, u_sh2, u_sh3, u_sh4, u_sh5, u_sh6, u_sh7, u_sh8);
+#else
+vec3  irradiance  = textureCube(s_envIrradiance, normal).xyz;
+#endif
+color += (light_ibl_specular(prefiltered, dfg, u_f0, f90) + light_ibl_diffuse(irradiance, dfg, u_albedo*(1.0 - u_metallic))) * u_iblIntensity;
+#endif
 
 gl_FragColor.xyz = pow(color, vec3(1.0,1.0,1.0)*0.44) ;
 gl_FragColor.w = 1.0;
@@ -8,11 +8,20 @@
 #include "bgfx_utils.h"
 #include "imgui/imgui.h"
 #include <debugdraw/debugdraw.h>
+#include "prototype_app.h"
+#include "dfg_lut_load.h"
+#include "ibl_load.h"
+#include "shadow_atlas.h"
+#include "occlusion_buffer.h"
+#include "program_permutations.h"
+
+#include <bx/commandline.h>
+#include <bx/hash.h>
+#include "uniform_block.h"
+#include "uniforms.h"
 
 namespace
 {
-#define RENDER_PASS_MAIN	0
-		
 
 	struct Material
 	{
@@ -22,39 +31,29 @@ namespace
 		float metallic;
 	};
 
-	
-	struct Uniforms // Constant Buffer
+	typedef UniformBlock<LightsUniforms> Uniforms; // Constant Buffer
+
+	// Shader features, in the order of the `// permutations:` lines of vs_lightsbasic.sc
+	// and fs_lightsbasic.sc.
+	struct Features
 	{
-		enum {NumVec4 = 4};
-		bgfx::UniformHandle u_params;
-		
-		union
+		enum Enum
 		{
-			struct 
-			{
-				/*0-1*/	struct { Material gold; };
-				/*2*/	struct { float lightPos[3];  float influenceRadiusMin; };
-				/*3*/	struct { float lightColor[3]; float influenceRadiusMax; };
-			};
-		
-			float m_params[NumVec4 * 4];
+			QuantizedVertex = 1 << 0,
+			Shadows         = 1 << 1,
+			Ibl             = 1 << 2,
+			IblSh           = 1 << 3,
 		};
+	};
 
-		void init()
-		{
-			u_params = bgfx::createUniform("u_params", bgfx::UniformType::Vec4, NumVec4);
-		}
+	const char* s_vsFeatures[] = { "QUANTIZED_VERTEX" };
+	const char* s_fsFeatures[] = { "SHADOWS", "IBL", "IBL_SH:IBL" };
 
-		void submit()
-		{
-			bgfx::setUniform(u_params, m_params, NumVec4);
-		}
+	// Near plane of the point light shadow faces, the far plane is the light's max radius.
+	constexpr float kShadowNear = 0.1f;
 
-		void destroy()
-		{
-			bgfx::destroy(u_params);
-		}
-	};
+	// View depth drawn black in the occlusion buffer overlay, nearer is brighter.
+	constexpr float kOcclusionDebugDistance = 30.0f;
 
 	struct Settings
 	{
@@ -72,6 +71,21 @@ namespace
 		float m_influenceRadiusMin;
 		float m_influenceRadiusMax;
 
+		// Image Based Lighting
+		float m_iblIntensity;
+		bool m_iblUseSh;
+		bool m_shEveryFrame;
+
+		// Shadows
+		bool m_shadows;
+		bool m_shadowCaching;
+		bool m_rotateBunny;
+		float m_shadowBias;
+
+		// Occlusion Culling
+		bool m_occlusion;
+		bool m_showOcclusion;
+
 		Settings()
 		{
 			//Default material parameters for gold
@@ -85,102 +99,425 @@ namespace
 			m_lightLatAngle = 0.0f; m_lightLongAngle = bx::toRad(30.0f); m_lightDistance = 20.0f;
 			m_influenceRadiusMin = 1.0; m_influenceRadiusMax = 50.0f;
 
+			m_iblIntensity = 1.0f;
+			m_iblUseSh = true;
+			m_shEveryFrame = false;
+
+			m_shadows = true;
+			m_shadowCaching = true;
+			m_rotateBunny = false;
+			m_shadowBias = 0.01f;
+
+			m_occlusion = true;
+			m_showOcclusion = false;
 		}
 	};
 
 
-	class LightsBasic : public entry::AppI
+	class LightsBasic : public PrototypeApp
 	{
 	public:
-		entry::MouseState m_mouseState;
-		uint32_t m_width;
-		uint32_t m_height;
-		uint32_t m_debug;
-		uint32_t m_reset;
-
-		int64_t m_timeOffset;
-		Mesh* m_ground;
+		MeshHandle m_ground;
+		MeshHandle m_bunny;
 		
 		Uniforms m_uniforms;
+		RenderPassHandle m_shadowPass;
+		RenderPassHandle m_mainPass;
 
 		float m_groundTransform[16];
+		float m_bunnyTransform[16];
+		float m_time;
 		float m_fovY;
 		float m_lightPos[3];
 		float m_lightLatAngle, m_lightLongAngle;
 
-		bgfx::ProgramHandle m_program;
-		bgfx::UniformHandle u_time;
+		ProgramPermutations m_programs;
+		bgfx::ProgramHandle m_shadowProgram;
+
+		// Point light shadow, six cube face tiles in the atlas. Rendered again only when
+		// the light or the casters change.
+		ShadowAtlas m_shadowAtlas;
+		uint16_t m_shadowLight;
+		bool m_shadowsSupported;
+
+		// The ground cube hides what is below it, from the main camera only.
+		OcclusionBuffer m_occlusion;
+		bgfx::TextureHandle m_occlusionTexture;
+
+		// Pre-integrated DFG table and prefiltered environment for image based lighting.
+		bgfx::TextureHandle m_dfgLut;
+		DfgLutLoadStats m_dfgLutStats;
+		IblTextures m_ibl;
+		IblLoadStats m_iblStats;
+
+		// Irradiance as spherical harmonics of the unfiltered environment, cheap enough
+		// to reproject every frame.
+		IblCubemap m_envSource;
+		IblSh m_sh;
+		double m_shTimeMs;
+
+		bgfx::UniformHandle s_dfgLut;
+		bgfx::UniformHandle s_envSpecular;
+		bgfx::UniformHandle s_envIrradiance;
+		bgfx::UniformHandle s_shadowAtlas;
 
 		//UI 
 		Settings m_settings;
 
 		LightsBasic(const char* _name, const char* _description, const char* _url)
-			: entry::AppI(_name, _description, _url)
+			: PrototypeApp(_name, _description, _url)
+			, m_time(0.0f)
+			, m_shadowLight(0)
+			, m_shadowsSupported(false)
+			, m_shTimeMs(0.0)
 		{
+			m_settingsHeight = 0.25f;
 		}
 
-		void updateUniforms(uint32_t _pass, float _time)
+		void updateUniforms()
 		{  
 			//Material Attributes
-			m_uniforms.m_params[0] = m_settings.m_albedo[0]; m_uniforms.m_params[1] = m_settings.m_albedo[1]; m_uniforms.m_params[2] = m_settings.m_albedo[2]; 
-			m_uniforms.m_params[3] = m_settings.m_roughness;
-			m_uniforms.m_params[4] = m_settings.m_f0[0]; m_uniforms.m_params[5] = m_settings.m_f0[1]; m_uniforms.m_params[6] = m_settings.m_f0[2];
-			m_uniforms.m_params[7] = m_settings.m_metallic;
-
-			m_uniforms.lightColor[0] = m_settings.m_lightColor[0]; m_uniforms.lightColor[1] = m_settings.m_lightColor[1]; m_uniforms.lightColor [2] = m_settings.m_lightColor[2];
-			m_uniforms.influenceRadiusMax = m_settings.m_influenceRadiusMax;
-			m_uniforms.influenceRadiusMin = m_settings.m_influenceRadiusMin;
-			
+			m_uniforms.set<LightsUniforms::Albedo>(m_settings.m_albedo);
+			m_uniforms.set<LightsUniforms::Roughness>(m_settings.m_roughness);
+			m_uniforms.set<LightsUniforms::F0>(m_settings.m_f0);
+			m_uniforms.set<LightsUniforms::Metallic>(m_settings.m_metallic);
+
+			m_uniforms.set<LightsUniforms::LightColor>(m_settings.m_lightColor);
+			m_uniforms.set<LightsUniforms::LightRadiusMax>(m_settings.m_influenceRadiusMax);
+			m_uniforms.set<LightsUniforms::LightRadiusMin>(m_settings.m_influenceRadiusMin);
+			m_uniforms.set<LightsUniforms::LightPos>(m_lightPos);
+
+			m_uniforms.set<LightsUniforms::IblIntensity>(m_settings.m_iblIntensity);
+			m_uniforms.set<LightsUniforms::IblMaxLod>(m_ibl.m_maxLod);
+
+			m_uniforms.set<LightsUniforms::Sh0>(m_sh.m_coeffs[0]);
+			m_uniforms.set<LightsUniforms::Sh1>(m_sh.m_coeffs[1]);
+			m_uniforms.set<LightsUniforms::Sh2>(m_sh.m_coeffs[2]);
+			m_uniforms.set<LightsUniforms::Sh3>(m_sh.m_coeffs[3]);
+			m_uniforms.set<LightsUniforms::Sh4>(m_sh.m_coeffs[4]);
+			m_uniforms.set<LightsUniforms::Sh5>(m_sh.m_coeffs[5]);
+			m_uniforms.set<LightsUniforms::Sh6>(m_sh.m_coeffs[6]);
+			m_uniforms.set<LightsUniforms::Sh7>(m_sh.m_coeffs[7]);
+			m_uniforms.set<LightsUniforms::Sh8>(m_sh.m_coeffs[8]);
+
+			if (isShadowed() )
+			{
+				float tiles[6][4];
+				for (uint8_t ii = 0; ii < 6; ++ii)
+				{
+					m_shadowAtlas.getTileUv(tiles[ii], m_shadowLight, ii);
+				}
+
+				m_uniforms.set<LightsUniforms::ShadowTile0>(tiles[0]);
+				m_uniforms.set<LightsUniforms::ShadowTile1>(tiles[1]);
+				m_uniforms.set<LightsUniforms::ShadowTile2>(tiles[2]);
+				m_uniforms.set<LightsUniforms::ShadowTile3>(tiles[3]);
+				m_uniforms.set<LightsUniforms::ShadowTile4>(tiles[4]);
+				m_uniforms.set<LightsUniforms::ShadowTile5>(tiles[5]);
+
+				float depth[2];
+				shadowPointDepthParams(depth, kShadowNear, m_settings.m_influenceRadiusMax, bgfx::getCaps()->homogeneousDepth);
+				m_uniforms.set<LightsUniforms::ShadowDepth>(depth);
+				m_uniforms.set<LightsUniforms::ShadowBias>(m_settings.m_shadowBias);
+				m_uniforms.set<LightsUniforms::ShadowTexelSize>(1.0f / float(m_shadowAtlas.getDesc().m_size) );
+			}
+		}
+
+		// Without all six tiles the light is unshadowed.
+		bool isShadowed() const
+		{
+			return m_shadowsSupported
+				&& m_settings.m_shadows
+				&& m_shadowAtlas.hasTiles(m_shadowLight)
+				;
+		}
+
+		// Program variant for the main pass, quantized meshes add QuantizedVertex.
+		uint32_t getFeatures() const
+		{
+			uint32_t features = 0;
+			features |= isShadowed() ? Features::Shadows : 0;
+			if (m_settings.m_iblIntensity > 0.0f)
+			{
+				features |= Features::Ibl;
+				features |= m_settings.m_iblUseSh ? Features::IblSh : 0;
+			}
+			return features;
+		}
+
+		void updateLight()
+		{
 			m_lightLatAngle = m_settings.m_lightLatAngle;
 			m_lightLongAngle = m_settings.m_lightLongAngle;
 			bx::Vec3 lightPos = bx::normalize(bx::fromLatLong(m_lightLatAngle, -m_lightLongAngle)) ;
 			lightPos = bx::mul(lightPos, m_settings.m_lightDistance);
 
-
-			m_uniforms.lightPos[0] = lightPos.x; m_uniforms.lightPos[1] = lightPos.y; m_uniforms.lightPos[2] = lightPos.z;
 			m_lightPos[0] = lightPos.x; m_lightPos[1] = lightPos.y; m_lightPos[2] = lightPos.z;
+		}
 
+		void getCameraMtx(float* _outView, float* _outProj)
+		{
+			cameraGetViewMtx(_outView);
+			bx::mtxProj(_outProj, m_fovY, float(m_width) / float(m_height), 0.1f, 100.0f, bgfx::getCaps()->homogeneousDepth);
+		}
+
+		void addMeshes(bool _shadow)
+		{
+			const Mesh* ground = m_meshes.get(m_ground);
+			const Mesh* bunny  = m_meshes.get(m_bunny);
 
+			if (_shadow)
+			{
+				const uint64_t state = 0
+					| BGFX_STATE_WRITE_Z
+					| BGFX_STATE_DEPTH_TEST_LESS
+					| BGFX_STATE_CULL_CCW
+					;
+
+				m_drawList.add(ground, m_shadowProgram, m_groundTransform, state);
+				m_drawList.add(bunny,  m_shadowProgram, m_bunnyTransform,  state);
+			}
+			else
+			{
+				const uint32_t features = getFeatures();
+				m_drawList.add(ground, m_programs.get(features | (meshIsQuantized(ground) ? Features::QuantizedVertex : 0) ), m_groundTransform);
+				m_drawList.add(bunny,  m_programs.get(features | (meshIsQuantized(bunny)  ? Features::QuantizedVertex : 0) ), m_bunnyTransform);
+			}
 		}
 
-		void init(int32_t _argc, const char* const* _argv, uint32_t _width, uint32_t _height) override
+		void submitShadowPass()
 		{
-			Args args(_argc, _argv);
-			m_width = _width;
-			m_height = _height;
-			m_debug = BGFX_DEBUG_NONE;
-			m_reset = BGFX_RESET_VSYNC;
-
-			bgfx::Init init;
-			init.type = args.m_type;
-			init.vendorId = args.m_pciId;
-			init.platformData.nwh = entry::getNativeWindowHandle(entry::kDefaultWindowHandle);
-			init.platformData.ndt = entry::getNativeDisplayHandle();
-			init.platformData.type = entry::getNativeWindowHandleType();
-			init.resolution.width = m_width;
-			init.resolution.height = m_height;
-			init.resolution.reset = m_reset;
-			bgfx::init(init);
-
-			// Enable debug Text
-			bgfx::setDebug(m_debug);
-			
+			if (!m_shadowsSupported)
+			{
+				return;
+			}
+
+			m_shadowAtlas.setCaching(m_settings.m_shadowCaching);
+			m_shadowAtlas.begin();
+
+			if (m_settings.m_shadows)
+			{
+				float view[16];
+				float proj[16];
+				getCameraMtx(view, proj);
+
+				const float radius = m_settings.m_influenceRadiusMax;
+				const bx::Vec3 lightPos = { m_lightPos[0], m_lightPos[1], m_lightPos[2] };
+
+				// Anything that moves the light or a caster, placeholder meshes included.
+				bx::HashMurmur2A hash;
+				hash.begin();
+				hash.add(m_lightPos, sizeof(m_lightPos) );
+				hash.add(radius);
+				hash.add(m_groundTransform, sizeof(m_groundTransform) );
+				hash.add(m_bunnyTransform, sizeof(m_bunnyTransform) );
+				hash.add(m_meshes.get(m_ground) );
+				hash.add(m_meshes.get(m_bunny) );
+
+				ShadowLightDesc desc;
+				desc.m_id       = 0;
+				desc.m_hash     = hash.end();
+				desc.m_tileSize = shadowAtlasTileSize({ lightPos, radius }, view, proj, m_shadowAtlas.getDesc() );
+				desc.m_numTiles = 6;
+				m_shadowLight = m_shadowAtlas.add(desc);
+			}
+
+			m_shadowAtlas.end();
+
+			const bool homogeneousDepth = bgfx::getCaps()->homogeneousDepth;
+			m_shadowAtlas.submit([&](bgfx::ViewId _view, uint16_t _light, uint8_t _tile)
+			{
+				BX_UNUSED(_light);
+
+				float view[16];
+				float proj[16];
+				shadowPointFaceMtx(view, proj, { m_lightPos[0], m_lightPos[1], m_lightPos[2] }, _tile, kShadowNear, m_settings.m_influenceRadiusMax, homogeneousDepth);
+				bgfx::setViewTransform(_view, view, proj);
+
+				m_drawList.begin();
+				addMeshes(true);
+				m_drawList.cull(view, proj);
+				m_drawList.submit(_view);
+			});
+		}
+
+		void buildOcclusion(const float* _view, const float* _proj)
+		{
+			m_occlusion.begin(_view, _proj, bgfx::getCaps()->homogeneousDepth);
+
+			for (const Group& group : m_meshes.get(m_ground)->m_groups)
+			{
+				m_occlusion.addOccluderBox(group.m_aabb, m_groundTransform);
+			}
+
+			m_occlusion.end(&m_jobs);
+
+			if (m_settings.m_showOcclusion)
+			{
+				updateOcclusionTexture(_proj);
+			}
+		}
+
+		void updateOcclusionTexture(const float* _proj)
+		{
+			const uint16_t width  = m_occlusion.getWidth();
+			const uint16_t height = m_occlusion.getHeight();
+			const bool homogeneousDepth = bgfx::getCaps()->homogeneousDepth;
+
+			const bgfx::Memory* mem = bgfx::alloc(uint32_t(width)*height*4);
+			const float* depth = m_occlusion.getDepth();
+			for (uint32_t ii = 0, num = uint32_t(width)*height; ii < num; ++ii)
+			{
+				// Back to view depth, ndc z = proj[10] + proj[14] / view z.
+				const float ndc   = homogeneousDepth ? depth[ii]*2.0f - 1.0f : depth[ii];
+				const float viewZ = _proj[14] / bx::max(ndc - _proj[10], 1e-6f);
+				const uint8_t gray = uint8_t(255.0f * bx::clamp(1.0f - viewZ / kOcclusionDebugDistance, 0.0f, 1.0f) );
+
+				mem->data[ii*4 + 0] = gray;
+				mem->data[ii*4 + 1] = gray;
+				mem->data[ii*4 + 2] = gray;
+				mem->data[ii*4 + 3] = 0xff;
+			}
+
+			bgfx::updateTexture2D(m_occlusionTexture, 0, 0, 0, 0, width, height, mem);
+		}
+
+		void projectSh()
+		{
+			const int64_t start = bx::getHPCounter();
+			iblProjectSh(m_sh, m_envSource, &m_jobs);
+			m_shTimeMs = double(bx::getHPCounter() - start) * 1000.0 / double(bx::getHPFrequency() );
+		}
+
+		void submitMainPass(bgfx::ViewId _view)
+		{
+			updateUniforms();
+			// Set up matrices for view
+			float view[16];
+			float proj[16];
+			getCameraMtx(view, proj);
+			bgfx::setViewTransform(_view, view, proj);
+
+			DebugDrawEncoder dde;
+
+			dde.begin(_view);
+			dde.push();
+				bx::Sphere sphere = bx::Sphere{ {m_lightPos[0], m_lightPos[1], m_lightPos[2]} , 0.5f};
+				dde.setColor(0xff0000ff);
+				dde.setWireframe(true);
+				dde.draw(sphere);
+				dde.setWireframe(false);
+			dde.pop();
+			dde.end();
+
+			m_uniforms.submit();
+
+			// Draw ground and bunny
+			m_drawList.begin();
+			addMeshes(false);
+
+			if (m_settings.m_occlusion)
+			{
+				buildOcclusion(view, proj);
+			}
+
+			m_drawList.cull(view, proj, m_settings.m_occlusion ? &m_occlusion : NULL);
+
+			// Every draw reads the same lighting textures.
+			bgfx::setTexture(0, s_dfgLut,        m_dfgLut);
+			bgfx::setTexture(1, s_envSpecular,   m_ibl.m_specular);
+			bgfx::setTexture(2, s_envIrradiance, m_ibl.m_irradiance);
+			bgfx::setTexture(3, s_shadowAtlas,   m_shadowAtlas.getTexture() );
+			m_drawList.submit(_view, BGFX_DISCARD_ALL & ~BGFX_DISCARD_BINDINGS);
+			bgfx::discard();
+		}
+
+		void onInit(int32_t _argc, const char* const* _argv) override
+		{
+			bx::CommandLine cmdLine(_argc, _argv);
+
+			// Shadow tiles take the views below the graph's.
+			const ShadowAtlasDesc shadowDesc;
+			m_graph.setFirstView(bgfx::ViewId(shadowDesc.m_maxViews) );
+			const RenderResourceHandle shadowAtlas = m_graph.createResource("Shadow atlas");
+
+			// Setup Shadow pass
+			{
+				m_shadowPass = m_graph.addPass(RenderPassDesc("Shadows"), [this](bgfx::ViewId _view) { BX_UNUSED(_view); submitShadowPass(); });
+				m_graph.write(m_shadowPass, shadowAtlas);
+
+				m_shadowsSupported = m_shadowAtlas.init(0, shadowDesc);
+				if (!m_shadowsSupported)
+				{
+					printf("[shadows] Depth comparison not supported, shadows disabled.\n");
+				}
+
+				m_shaderReload.loadProgram(&m_shadowProgram, "vs_lightsbasic_shadow", "fs_lightsbasic_shadow");
+				s_shadowAtlas   = bgfx::createUniform("s_shadowAtlas", bgfx::UniformType::Sampler);
+			}
+
 			// Setup Main pass
 			{
-				// Set view 0 clear state.
-				bgfx::setViewClear(RENDER_PASS_MAIN
-					, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH
-					, 0x303030ff
-					, 1.0f
-					, 0
-				);
+				RenderPassDesc desc("Main");
+				desc.m_clearFlags = BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH;
+				desc.m_clearRgba  = 0x303030ff;
+				m_mainPass = m_graph.addPass(desc, [this](bgfx::ViewId _view) { submitMainPass(_view); });
+				m_graph.read(m_mainPass, shadowAtlas);
+				m_graph.write(m_mainPass, m_graph.getBackbuffer());
 
 				m_uniforms.init();
-				// Create program from shaders
-				u_time = bgfx::createUniform("u_time", bgfx::UniformFreq::Frame, bgfx::UniformType::Vec4);
-				m_program = loadProgram("vs_lightsbasic", "fs_lightsbasic");
-				m_ground = meshLoad("meshes/cube.bin");
-				m_timeOffset = bx::getHPCounter();
+				s_dfgLut        = bgfx::createUniform("s_dfgLut",        bgfx::UniformType::Sampler);
+				s_envSpecular   = bgfx::createUniform("s_envSpecular",   bgfx::UniformType::Sampler);
+				s_envIrradiance = bgfx::createUniform("s_envIrradiance", bgfx::UniformType::Sampler);
+
+				// Every variant of the lighting shaders, picked per draw by getFeatures().
+				m_programs.load(
+					  { "vs_lightsbasic", s_vsFeatures, BX_COUNTOF(s_vsFeatures) }
+					, { "fs_lightsbasic", s_fsFeatures, BX_COUNTOF(s_fsFeatures) }
+					, m_shaderArchive
+					);
+				m_shaderReload.addPermutations(&m_programs);
+				m_ground = m_meshes.request("meshes/cube.bin");
+				m_bunny  = m_meshes.request("meshes/bunny.bin");
+			}
+
+			// Setup occlusion culling
+			{
+				m_occlusion.init();
+				m_occlusionTexture = bgfx::createTexture2D(
+					  m_occlusion.getWidth()
+					, m_occlusion.getHeight()
+					, false
+					, 1
+					, bgfx::TextureFormat::BGRA8
+					, BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT | BGFX_SAMPLER_UVW_CLAMP
+					);
+			}
+
+			// Mapped from the cache after the first run.
+			{
+				const char* filePath = "cache/dfg_lut.bin";
+				m_dfgLut = dfgLutLoad(filePath, DfgLutDesc(), &m_jobs, &m_dfgLutStats);
+				dfgLutLoadStatsPrint(filePath, m_dfgLutStats);
+			}
+
+			// `--env <file>` lights the scene with an HDR environment, equirectangular or
+			// a cubemap, the procedural sky otherwise. Prefiltered once per environment.
+			{
+				const char* envFilePath = cmdLine.findOption("env");
+				if (NULL == envFilePath
+				||  !iblLoadSource(m_envSource, envFilePath, 256, &m_jobs) )
+				{
+					std::vector<float> sky;
+					iblCreateSky(sky, 1024, 512);
+					iblEquirectToCubemap(m_envSource, sky.data(), 1024, 512, 256, &m_jobs);
+				}
+
+				m_ibl = iblLoad("cache", m_envSource, IblPrefilterDesc(), &m_jobs, &m_iblStats);
+				iblLoadStatsPrint(m_iblStats);
+
+				projectSh();
+				printf("[sh] %ux%u faces projected in %.3f ms\n", m_envSource.m_size, m_envSource.m_size, m_shTimeMs);
 			}
 
 			// Initialize camera
@@ -201,135 +538,162 @@ namespace
 			bx::mtxTranslate(mtxTranslate, 0.0f, -10.0f, 0.0f);
 			bx::mtxMul(m_groundTransform, mtxScale, mtxTranslate);
 
-			imguiCreate();
+			updateBunny();
 		}
 
 
-		int shutdown() override
+		void onShutdown() override
 		{
 			cameraDestroy();
-			imguiDestroy();
 
 			// Direct Draw Cleanup
 			ddShutdown();
 
-			meshUnload(m_ground);
+			m_meshes.release(m_ground);
+			m_meshes.release(m_bunny);
+			m_shadowAtlas.shutdown();
 			
 			// Cleanup
-			bgfx::destroy(m_program);
-			bgfx::destroy(u_time);
+			m_programs.destroy();
+			bgfx::destroy(m_shadowProgram);
+			bgfx::destroy(m_dfgLut);
+			iblDestroy(m_ibl);
+			bgfx::destroy(s_dfgLut);
+			bgfx::destroy(s_envSpecular);
+			bgfx::destroy(s_envIrradiance);
+			bgfx::destroy(s_shadowAtlas);
+			bgfx::destroy(m_occlusionTexture);
 			m_uniforms.destroy();
+		}
 
-			// Shutdown bgfx
-			bgfx::shutdown();
-
-			return 0;
+		// Scripted parameters for headless benchmark runs. Orbits the camera around the
+		// ground and sweeps the light and material so the uniforms change every frame.
+		void onBenchmark(float _progress) override
+		{
+			m_settings.m_lightLatAngle  = bx::toRad(bx::lerp(-45.0f, 45.0f, _progress) );
+			m_settings.m_lightLongAngle = bx::toRad(bx::lerp(0.0f, 90.0f, _progress) );
+			m_settings.m_roughness      = bx::lerp(0.05f, 1.0f, _progress);
+
+			const float angle  = _progress * bx::kPi2;
+			const float radius = 6.7f;
+			cameraSetPosition({ -radius * bx::sin(angle), 3.0f, -radius * bx::cos(angle) });
+			cameraSetHorizontalAngle(angle);
+			cameraSetVerticalAngle(-0.3f);
 		}
 
-		bool update() override
+		void onGui() override
 		{
-			if (!entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState))
+			ImGui::Text("This example shows basic lighting with a single point light source.");
+			ImGui::Separator();
+
+			ImGui::Text("Material Parms");
+			ImGui::SliderFloat("Roughness", &m_settings.m_roughness, 0.0f, 1.0f);
+			ImGui::SliderFloat("Metallic", &m_settings.m_metallic, 0.0f, 1.0f);
+			ImGui::ColorEdit3("Albedo", &m_settings.m_albedo[0], ImGuiColorEditFlags_NoSidePreview);
+			ImGui::SliderFloat3("f0", &m_settings.m_f0[0], 0.0, 2.0);
+			ImGui::Separator();
+
+			ImGui::Text("Light Parms");
+			ImGui::ColorEdit3("Color", &m_settings.m_lightColor[0], ImGuiColorEditFlags_NoSidePreview);
+			ImGui::SliderAngle("Light Lat Angle", &m_settings.m_lightLatAngle, -45.0f, 45.0f);
+			ImGui::SliderAngle("Light Long Angle", &m_settings.m_lightLongAngle, 0.0f, 90.0f);
+			ImGui::SliderFloat("Light Distance", &m_settings.m_lightDistance, 1.0f, 60.0f);
+			ImGui::SliderFloat("Light Min Radius", &m_settings.m_influenceRadiusMin, 0.5f, 10.0f);
+			ImGui::SliderFloat("Light Max Radius", &m_settings.m_influenceRadiusMax, 1.0f, 100.0f);
+			ImGui::Separator();
+
+			ImGui::Text("Image Based Lighting");
+			ImGui::SliderFloat("IBL Intensity", &m_settings.m_iblIntensity, 0.0f, 4.0f);
+			ImGui::Checkbox("SH irradiance", &m_settings.m_iblUseSh);
+			ImGui::Checkbox("Reproject SH every frame", &m_settings.m_shEveryFrame);
+			ImGui::Text("SH projection: %.3f ms", m_shTimeMs);
+			ImGui::Text("DFG LUT: %s, %.3f ms"
+				, m_dfgLutStats.m_cached ? "cached" : "computed"
+				, m_dfgLutStats.m_loadTimeMs
+				);
+			ImGui::Text("Environment %08x: %s, %.3f ms"
+				, m_iblStats.m_hash
+				, m_iblStats.m_cached ? "cached" : "prefiltered"
+				, m_iblStats.m_loadTimeMs
+				);
+			ImGui::Separator();
+
+			ImGui::Text("Occlusion Culling");
+			ImGui::Checkbox("Ground occludes", &m_settings.m_occlusion);
+			if (m_settings.m_occlusion)
+			{
+				const OcclusionStats& stats = m_occlusion.getStats();
+				ImGui::Text("Occluders: %u, %u triangles, %.3f ms"
+					, stats.m_numOccluders
+					, stats.m_numTriangles
+					, stats.m_rasterTimeMs
+					);
+				ImGui::Text("Draws occluded: %u", m_drawList.getStats().m_numCulledOcclusion);
+
+				ImGui::Checkbox("Show occlusion buffer", &m_settings.m_showOcclusion);
+				if (m_settings.m_showOcclusion)
+				{
+					const float width = ImGui::GetWindowWidth() * 0.9f;
+					ImGui::Image(m_occlusionTexture, ImVec2(width, width * float(m_occlusion.getHeight() ) / float(m_occlusion.getWidth() ) ) );
+				}
+			}
+			ImGui::Separator();
+
+			ImGui::Text("Shadows");
+			if (!m_shadowsSupported)
 			{
-				// Update frame timer
-				const double freq = double(bx::getHPFrequency());
-				int64_t now = bx::getHPCounter();
-				static int64_t last = now;
-				const float deltaTime = float(now - last) / freq;
-				last = now;
-
-
-				//draw UI
-				imguiBeginFrame(m_mouseState.m_mx
-					, m_mouseState.m_my
-					, (m_mouseState.m_buttons[entry::MouseButton::Left] ? IMGUI_MBUT_LEFT : 0)
-					| (m_mouseState.m_buttons[entry::MouseButton::Right] ? IMGUI_MBUT_RIGHT : 0)
-					| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
-					, m_mouseState.m_mz
-					, uint16_t(m_width)
-					, uint16_t(m_height)
-					
+				ImGui::Text("Depth comparison not supported.");
+				return;
+			}
+
+			ImGui::Checkbox("Point light shadows", &m_settings.m_shadows);
+			ImGui::Checkbox("Cache static shadows", &m_settings.m_shadowCaching);
+			ImGui::Checkbox("Rotate bunny", &m_settings.m_rotateBunny);
+			ImGui::SliderFloat("Shadow Bias", &m_settings.m_shadowBias, 0.0f, 0.05f);
+
+			const ShadowAtlasStats& stats = m_shadowAtlas.getStats();
+			ImGui::Text("Tiles: %u rendered, %u cached, %u deferred"
+				, stats.m_numRendered
+				, stats.m_numCached
+				, stats.m_numDeferred
 				);
-				showExampleDialog(this);
-				ImGui::SetNextWindowPos(
-					ImVec2(m_width - m_width / 4.0 - 10.f, 10.f)
-					, ImGuiCond_FirstUseEver
+			ImGui::Text("Atlas: %.1f%% used%s"
+				, 100.0f * float(stats.m_usedArea) / float(uint32_t(m_shadowAtlas.getDesc().m_size) * m_shadowAtlas.getDesc().m_size)
+				, stats.m_repacked ? ", repacked" : ""
 				);
-				ImGui::SetNextWindowSize(
-					ImVec2(m_width / 4.0f, m_height / 4.0f)
-					, ImGuiCond_FirstUseEver
+		}
+
+		void updateBunny()
+		{
+			bx::mtxSRT(m_bunnyTransform
+				, 2.0f, 2.0f, 2.0f
+				, 0.0f, m_time * 0.5f, 0.0f
+				, 0.0f, 0.0f, 0.0f
 				);
+		}
 
-				ImGui::Begin("Settings", NULL, 0);
-				ImGui::Text("This example shows basic lighting with a single point light source.");
-				ImGui::Separator();
-
-				ImGui::Text("Material Parms");
-				ImGui::SliderFloat("Roughness", &m_settings.m_roughness, 0.0f, 1.0f);
-				ImGui::SliderFloat("Metallic", &m_settings.m_metallic, 0.0f, 1.0f);
-				ImGui::ColorEdit3("Albedo", &m_settings.m_albedo[0], ImGuiColorEditFlags_NoSidePreview);
-				ImGui::SliderFloat3("f0", &m_settings.m_f0[0], 0.0, 2.0);
-				ImGui::Separator();
-
-				ImGui::Text("Light Parms");
-				ImGui::ColorEdit3("Color", &m_settings.m_lightColor[0], ImGuiColorEditFlags_NoSidePreview);
-				ImGui::SliderAngle("Light Lat Angle", &m_settings.m_lightLatAngle, -45.0f, 45.0f);
-				ImGui::SliderAngle("Light Long Angle", &m_settings.m_lightLongAngle, 0.0f, 90.0f);
-				ImGui::SliderFloat("Light Distance", &m_settings.m_lightDistance, 1.0f, 60.0f);
-				ImGui::SliderFloat("Light Min Radius", &m_settings.m_influenceRadiusMin, 0.5f, 10.0f);
-				ImGui::SliderFloat("Light Max Radius", &m_settings.m_influenceRadiusMax, 1.0f, 100.0f);
-				ImGui::End();
-
-				imguiEndFrame();
-
-				// Update camera
-				cameraUpdate(deltaTime * 0.15f, m_mouseState, ImGui::MouseOverArea());
-
-				
-				// Render Scene
-				bgfx::setViewRect(RENDER_PASS_MAIN, 0, 0, uint16_t(m_width), uint16_t(m_height));
-				bgfx::touch(RENDER_PASS_MAIN);
-				bgfx::setFrameUniform(u_time, &deltaTime);
-
-				updateUniforms(RENDER_PASS_MAIN, deltaTime);
-				// Set up matrices for view
-				float view[16];
-				cameraGetViewMtx(view);
-				float proj[16];
-				bx::mtxProj(proj, m_fovY, float(m_width) / float(m_height), 0.1f, 100.0f, bgfx::getCaps()->homogeneousDepth);
-				bgfx::setViewTransform(RENDER_PASS_MAIN, view, proj);
-				
-				float mtxScale[16];
-				const float scale = 10.0f;
-				bx::mtxScale(mtxScale, scale, scale, scale);
-				float mtx[16];
-				float mtxTranslate[16];
-				bx::mtxTranslate(mtxTranslate, 0.0f, -10.0f, 0.0f);
-				bx::mtxMul(mtx, mtxScale, mtxTranslate);
-
-				DebugDrawEncoder dde;
-
-				dde.begin(0);
-				dde.push();
-					bx::Sphere sphere = bx::Sphere{ {m_lightPos[0], m_lightPos[1], m_lightPos[2]} , 0.5f};
-					dde.setColor(0xff0000ff);
-					dde.setWireframe(true);
-					dde.draw(sphere);
-					dde.setWireframe(false);
-				dde.pop();
-				dde.end();
-
-
-
-				m_uniforms.submit();
-
-				// Draw ground
- 				meshSubmit(m_ground, RENDER_PASS_MAIN, m_program, mtx);
-
-				// Submit frame
-				bgfx::frame();
-				return true;
+		void onUpdate(float _time, float _deltaTime) override
+		{
+			BX_UNUSED(_time);
+
+			// Update camera
+			cameraUpdate(_deltaTime * 0.15f, m_mouseState, ImGui::MouseOverArea());
+
+			// Both passes read these, the shadow pass runs first.
+			updateLight();
+
+			// A moving caster re-renders the shadow every frame, a still one is cached.
+			if (m_settings.m_rotateBunny)
+			{
+				m_time += _deltaTime;
+				updateBunny();
+			}
+
+			// What a dynamic environment, e.g. a time of day sky, would pay per frame.
+			if (m_settings.m_shEveryFrame)
+			{
+				projectSh();
 			}
-			return false;
 		}
 	};
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef LIGHTSBASIC_UNIFORMS_H_HEADER_GUARD
+#define LIGHTSBASIC_UNIFORMS_H_HEADER_GUARD
+
+#include "frame_uniforms.h"
+#include "uniform_layout.h"
+
+// Single source for the u_params layout. uniforms.sh is generated from this file.
+struct LightsUniforms
+{
+	enum Enum
+	{
+		// Material
+		Albedo,
+		Roughness,
+		F0,
+		Metallic,
+
+		// Point light
+		LightPos,
+		LightRadiusMin,
+		LightColor,
+		LightRadiusMax,
+
+		// Image based lighting
+		IblIntensity,
+		IblMaxLod,
+
+		// Irradiance spherical harmonics, see IblSh
+		Sh0,
+		Sh1,
+		Sh2,
+		Sh3,
+		Sh4,
+		Sh5,
+		Sh6,
+		Sh7,
+		Sh8,
+
+		// Point light shadow, see Shadows.sh
+		ShadowTile0,
+		ShadowTile1,
+		ShadowTile2,
+		ShadowTile3,
+		ShadowTile4,
+		ShadowTile5,
+		ShadowDepth,
+		ShadowBias,
+		ShadowTexelSize,
+
+		Count
+	};
+
+	enum { NumVec4 = 20 };
+
+	static constexpr const char* s_name = "u_params";
+	static constexpr UniformField s_fields[Count] =
+	{
+		{ "u_albedo",          3, false },
+		{ "u_roughness",       1, false },
+		{ "u_f0",              3, false },
+		{ "u_metallic",        1, false },
+		{ "u_lightPos",        3, false },
+		{ "u_lightRadiusMin",  1, false },
+		{ "u_lightColor",      3, false },
+		{ "u_lightRadiusMax",  1, false },
+		{ "u_iblIntensity",    1, false },
+		{ "u_iblMaxLod",       1, false },
+		{ "u_sh0",             3, false },
+		{ "u_sh1",             3, false },
+		{ "u_sh2",             3, false },
+		{ "u_sh3",             3, false },
+		{ "u_sh4",             3, false },
+		{ "u_sh5",             3, false },
+		{ "u_sh6",             3, false },
+		{ "u_sh7",             3, false },
+		{ "u_sh8",             3, false },
+		{ "u_shadowTile0",     4, false },
+		{ "u_shadowTile1",     4, false },
+		{ "u_shadowTile2",     4, false },
+		{ "u_shadowTile3",     4, false },
+		{ "u_shadowTile4",     4, false },
+		{ "u_shadowTile5",     4, false },
+		{ "u_shadowDepth",     2, false },
+		{ "u_shadowBias",      1, false },
+		{ "u_shadowTexelSize", 1, false },
+	};
+};
+
+#define UNIFORM_BLOCKS(_x) \
+	_x(FrameUniforms) \
+	_x(LightsUniforms)
+
+#endif // LIGHTSBASIC_UNIFORMS_H_HEADER_GUARD
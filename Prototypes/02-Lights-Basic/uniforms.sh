@@ -1,10 +1,37 @@
-uniform vec4 u_params[4];
-
-#define u_albedo			u_params[0].xyz
-#define u_roughness			u_params[0].w
-#define u_f0				u_params[1].xyz
-#define u_metallic			u_params[1].w
-#define u_lightPos			u_params[2].xyz
-#define u_lightRadiusMin	u_params[2].w
-#define u_lightColor		u_params[3].xyz
-#define u_lightRadiusMax	u_params[3].w
\ No newline at end of file
+// Generated by uniformgen from uniforms.h. Do not edit.
+
+uniform vec4 u_frame[1];
+
+#define u_time              u_frame[0].x
+#define u_deltaTime         u_frame[0].y
+
+uniform vec4 u_params[20];
+
+#define u_albedo            u_params[6].xyz
+#define u_roughness         u_params[6].w
+#define u_f0                u_params[7].xyz
+#define u_metallic          u_params[7].w
+#define u_lightPos          u_params[8].xyz
+#define u_lightRadiusMin    u_params[8].w
+#define u_lightColor        u_params[9].xyz
+#define u_lightRadiusMax    u_params[9].w
+#define u_iblIntensity      u_params[10].w
+#define u_iblMaxLod         u_params[11].w
+#define u_sh0               u_params[10].xyz
+#define u_sh1               u_params[11].xyz
+#define u_sh2               u_params[12].xyz
+#define u_sh3               u_params[13].xyz
+#define u_sh4               u_params[14].xyz
+#define u_sh5               u_params[15].xyz
+#define u_sh6               u_params[16].xyz
+#define u_sh7               u_params[17].xyz
+#define u_sh8               u_params[18].xyz
+#define u_shadowTile0       u_params[0].xyzw
+#define u_shadowTile1       u_params[1].xyzw
+#define u_shadowTile2       u_params[2].xyzw
+#define u_shadowTile3       u_params[3].xyzw
+#define u_shadowTile4       u_params[4].xyzw
+#define u_shadowTile5       u_params[5].xyzw
+#define u_shadowDepth       u_params[19].xy
+#define u_shadowBias        u_params[12].w
+#define u_shadowTexelSize   u_params[13].w
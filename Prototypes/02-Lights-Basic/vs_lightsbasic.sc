@@ -6,14 +6,25 @@ $output v_world, v_normal, v_view
  * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
  */
 
+// permutations: QUANTIZED_VERTEX
 #include "../common/common.sh"
 
+// Quantized meshes, see mesh_quantize.h. The dequantization is part of the model
+// matrix, the normal is octahedral encoded.
+#ifdef QUANTIZED_VERTEX
+#include "Graphics/Packing.sh"
+#endif
+
 void main()
 {
    vec4 world = mul(u_model[0], vec4(a_position, 1.0));
    gl_Position = mul(u_viewProj, world);
    v_world = world.xyz;
+#ifdef QUANTIZED_VERTEX
+   vec3 normal = octDecode(a_normal.xy);
+#else
    vec3 normal = a_normal.xyz*2.0 - 1.0;
+#endif
    v_normal = mul(u_model[0], vec4(normal, 0.0)).xyz;
    v_view = mul(u_view, world).xyz;
 }
\ No newline at end of file
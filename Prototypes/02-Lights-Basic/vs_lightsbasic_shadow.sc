@@ -0,0 +1,15 @@
+$input a_position
+
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "../common/common.sh"
+
+// Depth only, for shadow atlas tiles. Quantized meshes fold their dequantization into
+// the model matrix, so both vertex formats share this shader.
+void main()
+{
+   gl_Position = mul(u_modelViewProj, vec4(a_position, 1.0));
+}
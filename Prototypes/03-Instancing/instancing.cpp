@@ -0,0 +1,265 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "imgui/imgui.h"
+#include "mesh_instancing.h"
+#include "prototype_app.h"
+#include "uniform_block.h"
+
+#include <bx/commandline.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+#include <vector>
+
+// Shades with 01-GoochHighlighted's programs, so it shares its uniform block.
+#include "../01-GoochHighlighted/uniforms.h"
+
+namespace
+{
+
+typedef UniformBlock<GoochUniforms> Uniforms;
+
+// Stress test for the instanced submit path. Draws a grid of bunnies, by default 100k,
+// either with meshSubmitInstanced() or with one meshSubmit() per bunny, and reports the
+// time the submit thread spends issuing them. The grid doesn't move, so its matrices
+// live in a static instance buffer; 100k of them don't fit transient memory.
+//
+// Command line:
+//   --instances <n>    Number of bunnies (default 100000).
+//   --no-instancing    One meshSubmit() per bunny. bgfx caps the number of draws per
+//                      frame, so this draws at most limits.maxDrawCalls bunnies.
+class Instancing : public PrototypeApp
+{
+public:
+	MeshHandle m_mesh;
+	bgfx::ProgramHandle m_program;
+	bgfx::ProgramHandle m_programQuantized;
+	bgfx::ProgramHandle m_programInstanced;
+	bgfx::ProgramHandle m_programInstancedQuantized;
+
+	Uniforms m_uniforms;
+	RenderPassHandle m_mainPass;
+
+	std::vector<float> m_instances;
+	bgfx::VertexBufferHandle m_instanceBuffer;
+	const Mesh* m_instanceBufferMesh;
+	uint32_t m_numInstances;
+	uint32_t m_numDrawn;
+	bool m_instancing;
+	float m_time;
+
+	// Submit thread time, last frame and totals for the shutdown report.
+	double m_submitTimeMs;
+	double m_totalSubmitTimeMs;
+	uint32_t m_numFrames;
+
+	Instancing(const char* _name, const char* _description, const char* _url)
+		: PrototypeApp(_name, _description, _url)
+		, m_instanceBuffer(BGFX_INVALID_HANDLE)
+		, m_instanceBufferMesh(NULL)
+		, m_numInstances(100000)
+		, m_numDrawn(0)
+		, m_instancing(true)
+		, m_time(0.0f)
+		, m_submitTimeMs(0.0)
+		, m_totalSubmitTimeMs(0.0)
+		, m_numFrames(0)
+	{
+		m_settingsHeight = 0.25f;
+	}
+
+	void createInstances()
+	{
+		// Square grid on the xz plane, each bunny turned a little further than the last.
+		const uint32_t side = uint32_t(bx::ceil(bx::sqrt(float(m_numInstances) ) ) );
+		const float spacing = 2.0f;
+		const float offset  = -0.5f * spacing * float(side - 1);
+
+		m_instances.resize(m_numInstances*16);
+		for (uint32_t ii = 0; ii < m_numInstances; ++ii)
+		{
+			const float xx = offset + spacing * float(ii % side);
+			const float zz = offset + spacing * float(ii / side);
+			bx::mtxSRT(&m_instances[ii*16]
+				, 1.0f, 1.0f, 1.0f
+				, 0.0f, float(ii) * 0.37f, 0.0f
+				, xx, 0.0f, zz
+				);
+		}
+	}
+
+	void submitMainPass(bgfx::ViewId _view)
+	{
+		m_uniforms.set<GoochUniforms::SurfaceColor>(bx::Vec3{ 0.6f, 0.6f, 0.6f });
+		m_uniforms.set<GoochUniforms::WarmColor>(bx::Vec3{ 0.3f, 0.3f, 0.0f });
+		m_uniforms.set<GoochUniforms::CoolColor>(bx::Vec3{ 0.0f, 0.0f, 0.55f });
+		m_uniforms.set<GoochUniforms::HighlightColor>(bx::Vec3{ 1.0f, 1.0f, 1.0f });
+
+		// Slow orbit above the grid.
+		const float radius = float(bx::sqrt(float(m_numInstances) ) ) * 1.2f;
+		const float angle  = m_time * 0.1f;
+		const bx::Vec3 at  = { 0.0f, 0.0f, 0.0f };
+		const bx::Vec3 eye = { radius * bx::sin(angle), radius * 0.5f, -radius * bx::cos(angle) };
+
+		float view[16];
+		bx::mtxLookAt(view, eye, at);
+		float proj[16];
+		bx::mtxProj(proj, 60.0f, float(m_width) / float(m_height), 0.1f, radius * 4.0f, bgfx::getCaps()->homogeneousDepth);
+		bgfx::setViewTransform(_view, view, proj);
+
+		// Normals are shaded in view space, the light stays put while the camera orbits.
+		m_uniforms.set<GoochUniforms::LightDir>(bx::mulXyz0(bx::normalize(bx::Vec3{ -0.3f, -1.0f, 0.5f }), view) );
+
+		m_uniforms.submit();
+
+		const Mesh* mesh = m_meshes.get(m_mesh);
+
+		const int64_t start = bx::getHPCounter();
+		if (m_instancing)
+		{
+			const bgfx::ProgramHandle program = meshIsQuantized(mesh)
+				? m_programInstancedQuantized
+				: m_programInstanced
+				;
+
+			// Baked with the mesh's dequantization, so rebuilt when the bunny replaces the
+			// streaming placeholder.
+			if (mesh != m_instanceBufferMesh)
+			{
+				if (bgfx::isValid(m_instanceBuffer) )
+				{
+					bgfx::destroy(m_instanceBuffer);
+				}
+
+				m_instanceBuffer     = meshCreateInstanceBuffer(mesh, m_instances.data(), m_numInstances);
+				m_instanceBufferMesh = mesh;
+			}
+
+			meshSubmitInstanced(mesh, _view, program, m_instanceBuffer, 0, m_numInstances);
+			m_numDrawn = m_numInstances;
+		}
+		else
+		{
+			// Leave room for the GUI's draws.
+			const uint32_t maxDrawCalls = bgfx::getCaps()->limits.maxDrawCalls;
+			const uint32_t maxDraws = maxDrawCalls > 1024 ? maxDrawCalls - 1024 : maxDrawCalls / 2;
+			const uint32_t numGroups = bx::max<uint32_t>(uint32_t(mesh->m_groups.size() ), 1);
+			m_numDrawn = bx::min(m_numInstances, maxDraws / numGroups);
+
+			const bgfx::ProgramHandle program = meshIsQuantized(mesh)
+				? m_programQuantized
+				: m_program
+				;
+
+			float model[16];
+			for (uint32_t ii = 0; ii < m_numDrawn; ++ii)
+			{
+				meshGetModelMtx(model, mesh, &m_instances[ii*16]);
+				meshSubmit(mesh, _view, program, model);
+			}
+
+			benchmarkCountDraw(m_numDrawn * uint32_t(mesh->m_groups.size() ) );
+		}
+
+		m_submitTimeMs = double(bx::getHPCounter() - start) * 1000.0 / double(bx::getHPFrequency() );
+		m_totalSubmitTimeMs += m_submitTimeMs;
+		++m_numFrames;
+	}
+
+	void onInit(int32_t _argc, const char* const* _argv) override
+	{
+		bx::CommandLine cmdLine(_argc, _argv);
+		if (const char* instances = cmdLine.findOption("instances") )
+		{
+			bx::fromString(&m_numInstances, instances);
+			m_numInstances = bx::max<uint32_t>(m_numInstances, 1);
+		}
+
+		m_instancing = !cmdLine.hasArg("no-instancing");
+		if (m_instancing
+		&&  !meshInstancingSupported() )
+		{
+			printf("[instancing] Renderer doesn't support instancing, falling back to one submit per mesh.\n");
+			m_instancing = false;
+		}
+
+		// Setup Main pass
+		{
+			RenderPassDesc desc("Main");
+			desc.m_clearFlags = BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH;
+			desc.m_clearRgba  = 0x303030ff;
+			m_mainPass = m_graph.addPass(desc, [this](bgfx::ViewId _view) { submitMainPass(_view); });
+			m_graph.write(m_mainPass, m_graph.getBackbuffer());
+
+			m_uniforms.init();
+			m_shaderReload.loadProgram(&m_program,                   "vs_goochhighlighted",                     "fs_goochhighlighted");
+			m_shaderReload.loadProgram(&m_programQuantized,          "vs_goochhighlighted_quantized",           "fs_goochhighlighted");
+			m_shaderReload.loadProgram(&m_programInstanced,          "vs_goochhighlighted_instanced",           "fs_goochhighlighted");
+			m_shaderReload.loadProgram(&m_programInstancedQuantized, "vs_goochhighlighted_instanced_quantized", "fs_goochhighlighted");
+			m_mesh = m_meshes.request("meshes/bunny.bin");
+		}
+
+		createInstances();
+	}
+
+	void onShutdown() override
+	{
+		if (0 != m_numFrames)
+		{
+			printf("[instancing] %u instances, %s: submit %.4f ms/frame over %u frames\n"
+				, m_numInstances
+				, m_instancing ? "instanced" : "one submit per mesh"
+				, m_totalSubmitTimeMs / double(m_numFrames)
+				, m_numFrames
+				);
+		}
+
+		m_meshes.release(m_mesh);
+
+		if (bgfx::isValid(m_instanceBuffer) )
+		{
+			bgfx::destroy(m_instanceBuffer);
+		}
+
+		// Cleanup
+		bgfx::destroy(m_program);
+		bgfx::destroy(m_programQuantized);
+		bgfx::destroy(m_programInstanced);
+		bgfx::destroy(m_programInstancedQuantized);
+		m_uniforms.destroy();
+	}
+
+	void onGui() override
+	{
+		ImGui::Text("%u bunnies, %u drawn", m_numInstances, m_numDrawn);
+		if (meshInstancingSupported()
+		&&  ImGui::Checkbox("Instancing", &m_instancing) )
+		{
+			// The shutdown report averages one mode only.
+			m_totalSubmitTimeMs = 0.0;
+			m_numFrames         = 0;
+		}
+		ImGui::Text("Submit: %.3f ms", m_submitTimeMs);
+	}
+
+	void onUpdate(float _time, float _deltaTime) override
+	{
+		BX_UNUSED(_deltaTime);
+		m_time = _time;
+	}
+};
+
+} // namespace
+
+ENTRY_IMPLEMENT_MAIN(
+	  Instancing
+	, "SGTestBed 03-Instancing"
+	, "Stress test for instanced mesh submission."
+	, ""
+);
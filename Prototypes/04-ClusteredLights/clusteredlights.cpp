@@ -0,0 +1,424 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "common.h"
+#include "camera.h"
+#include "bgfx_utils.h"
+#include "imgui/imgui.h"
+#include "light_clusters.h"
+#include "prototype_app.h"
+#include "uniform_block.h"
+#include "uniforms.h"
+
+#include <bx/commandline.h>
+#include <bx/rng.h>
+#include <bx/string.h>
+
+#include <stdio.h>
+#include <vector>
+
+namespace
+{
+
+	typedef UniformBlock<ClusteredUniforms> Uniforms; // Constant Buffer
+
+	struct Settings
+	{
+		// Material Properties
+		float m_albedo[3];
+		float m_roughness;
+		float m_f0[3];
+		float m_metallic;
+
+		// Point Light Properties, shared by all lights.
+		float m_lightIntensity;
+		float m_influenceRadiusMin;
+		float m_influenceRadiusMax;
+
+		Settings()
+		{
+			m_albedo[0] = 0.8f; m_albedo[1] = 0.8f; m_albedo[2] = 0.8f;
+			m_roughness = 0.4f;
+			m_f0[0] = 0.04f; m_f0[1] = 0.04f; m_f0[2] = 0.04f;
+			m_metallic = 0.0f;
+
+			m_lightIntensity = 0.05f;
+			m_influenceRadiusMin = 0.25f; m_influenceRadiusMax = 3.0f;
+		}
+	};
+
+	// Lights circle around a fixed point each, at their own speed.
+	struct LightOrbit
+	{
+		bx::Vec3 m_center;
+		bx::Vec3 m_color;
+		float m_radius;
+		float m_speed;
+		float m_phase;
+	};
+
+	// Many point lights over a field of bunnies. Lights are binned into view space
+	// froxels by LightClusters and the fragment shader only loops over the lights of its
+	// cluster. The brute force shader loops over every light for comparison.
+	//
+	// Command line:
+	//   --lights <n>     Number of point lights (default 1024, at most 4096).
+	//   --brute-force    Start with the brute force shader.
+	//   --serial-binning Bin lights on the main thread instead of the job system.
+	class ClusteredLights : public PrototypeApp
+	{
+	public:
+		MeshHandle m_ground;
+		MeshHandle m_bunny;
+
+		Uniforms m_uniforms;
+		RenderPassHandle m_mainPass;
+
+		bgfx::ProgramHandle m_program;
+		bgfx::ProgramHandle m_programQuantized;
+		bgfx::ProgramHandle m_programBruteForce;
+		bgfx::ProgramHandle m_programBruteForceQuantized;
+
+		bgfx::UniformHandle s_lights;
+		bgfx::UniformHandle s_indices;
+		bgfx::UniformHandle s_clusters;
+
+		LightClusters m_clusters;
+		std::vector<LightOrbit> m_orbits;
+		std::vector<PointLight> m_lights;
+		uint32_t m_numLights;
+		bool m_bruteForce;
+		bool m_parallelBinning;
+
+		std::vector<float> m_bunnyTransforms;
+		float m_groundTransform[16];
+		float m_fovY;
+		float m_time;
+
+		// GPU time of the last frame bgfx reported, and totals for the shutdown report.
+		double m_gpuTimeMs;
+		double m_totalGpuTimeMs;
+		double m_totalBinTimeMs;
+		uint32_t m_numFrames;
+
+		//UI
+		Settings m_settings;
+
+		ClusteredLights(const char* _name, const char* _description, const char* _url)
+			: PrototypeApp(_name, _description, _url)
+			, m_numLights(1024)
+			, m_bruteForce(false)
+			, m_parallelBinning(true)
+			, m_fovY(60.0f)
+			, m_time(0.0f)
+			, m_gpuTimeMs(0.0)
+			, m_totalGpuTimeMs(0.0)
+			, m_totalBinTimeMs(0.0)
+			, m_numFrames(0)
+		{
+			m_settingsHeight = 0.4f;
+		}
+
+		void createLights()
+		{
+			bx::RngMwc rng;
+
+			m_orbits.resize(m_numLights);
+			m_lights.resize(m_numLights);
+			for (LightOrbit& orbit : m_orbits)
+			{
+				orbit.m_center =
+				{
+					bx::lerp(-10.0f, 10.0f, bx::frnd(&rng) ),
+					bx::lerp(  0.2f,  2.0f, bx::frnd(&rng) ),
+					bx::lerp(-10.0f, 10.0f, bx::frnd(&rng) ),
+				};
+
+				const bx::Vec3 color = { bx::frnd(&rng), bx::frnd(&rng), bx::frnd(&rng) };
+				orbit.m_color  = bx::div(color, bx::max(color.x, bx::max(color.y, color.z) ) + 0.001f);
+				orbit.m_radius = bx::lerp(0.5f, 2.0f, bx::frnd(&rng) );
+				orbit.m_speed  = bx::lerp(-1.0f, 1.0f, bx::frnd(&rng) );
+				orbit.m_phase  = bx::frnd(&rng) * bx::kPi2;
+			}
+		}
+
+		void updateLights()
+		{
+			for (uint32_t ii = 0; ii < m_numLights; ++ii)
+			{
+				const LightOrbit& orbit = m_orbits[ii];
+				const float angle = orbit.m_phase + m_time*orbit.m_speed;
+
+				PointLight& light = m_lights[ii];
+				light.m_pos = bx::add(orbit.m_center, bx::Vec3{ orbit.m_radius*bx::cos(angle), 0.0f, orbit.m_radius*bx::sin(angle) });
+				light.m_color     = bx::mul(orbit.m_color, m_settings.m_lightIntensity);
+				light.m_radiusMin = m_settings.m_influenceRadiusMin;
+				light.m_radiusMax = bx::max(m_settings.m_influenceRadiusMax, m_settings.m_influenceRadiusMin);
+			}
+		}
+
+		void updateUniforms()
+		{
+			//Material Attributes
+			m_uniforms.set<ClusteredUniforms::Albedo>(m_settings.m_albedo);
+			m_uniforms.set<ClusteredUniforms::Roughness>(m_settings.m_roughness);
+			m_uniforms.set<ClusteredUniforms::F0>(m_settings.m_f0);
+			m_uniforms.set<ClusteredUniforms::Metallic>(m_settings.m_metallic);
+
+			const LightClustersDesc& desc = m_clusters.getDesc();
+			m_uniforms.set<ClusteredUniforms::ClusterDims>(bx::Vec3{ float(desc.m_dimX), float(desc.m_dimY), float(desc.m_dimZ) });
+			m_uniforms.set<ClusteredUniforms::NumLights>(float(m_clusters.getStats().m_numLights) );
+
+			float scaleBias[2];
+			m_clusters.getSliceScaleBias(scaleBias);
+			m_uniforms.set<ClusteredUniforms::ClusterScaleBias>(scaleBias);
+
+			const float lightsTexSize[2] = { float(m_clusters.getLightsWidth() ), float(m_clusters.getLightsHeight() ) };
+			m_uniforms.set<ClusteredUniforms::LightsTexSize>(lightsTexSize);
+
+			const float indicesTexSize[2] = { float(m_clusters.getIndicesWidth() ), float(m_clusters.getIndicesHeight() ) };
+			m_uniforms.set<ClusteredUniforms::IndicesTexSize>(indicesTexSize);
+		}
+
+		void submitMainPass(bgfx::ViewId _view)
+		{
+			const LightClustersDesc& desc = m_clusters.getDesc();
+
+			// Set up matrices for view, the clusters span the projection's depth range.
+			float view[16];
+			cameraGetViewMtx(view);
+			float proj[16];
+			bx::mtxProj(proj, m_fovY, float(m_width) / float(m_height), desc.m_near, desc.m_far, bgfx::getCaps()->homogeneousDepth);
+			bgfx::setViewTransform(_view, view, proj);
+
+			updateLights();
+			m_clusters.build(m_lights.data(), m_numLights, view, proj, m_parallelBinning ? &m_jobs : NULL);
+			m_clusters.upload();
+
+			updateUniforms();
+			m_uniforms.submit();
+
+			const Mesh* ground = m_meshes.get(m_ground);
+			const Mesh* bunny  = m_meshes.get(m_bunny);
+
+			m_drawList.begin();
+			m_drawList.add(ground, selectProgram(ground), m_groundTransform);
+			for (uint32_t ii = 0, num = uint32_t(m_bunnyTransforms.size() )/16; ii < num; ++ii)
+			{
+				m_drawList.add(bunny, selectProgram(bunny), &m_bunnyTransforms[ii*16]);
+			}
+			m_drawList.cull(view, proj);
+
+			// Every draw reads the same light textures.
+			m_clusters.setTextures(0, s_lights, s_indices, s_clusters);
+			m_drawList.submit(_view, BGFX_DISCARD_ALL & ~BGFX_DISCARD_BINDINGS);
+			bgfx::discard();
+
+			const bgfx::Stats* stats = bgfx::getStats();
+			m_gpuTimeMs = 0 != stats->gpuTimerFreq
+				? double(stats->gpuTimeEnd - stats->gpuTimeBegin) * 1000.0 / double(stats->gpuTimerFreq)
+				: 0.0
+				;
+
+			m_totalGpuTimeMs += m_gpuTimeMs;
+			m_totalBinTimeMs += m_clusters.getStats().m_binTimeMs;
+			++m_numFrames;
+		}
+
+		bgfx::ProgramHandle selectProgram(const Mesh* _mesh) const
+		{
+			if (m_bruteForce)
+			{
+				return meshIsQuantized(_mesh) ? m_programBruteForceQuantized : m_programBruteForce;
+			}
+
+			return meshIsQuantized(_mesh) ? m_programQuantized : m_program;
+		}
+
+		void onInit(int32_t _argc, const char* const* _argv) override
+		{
+			LightClustersDesc desc;
+
+			bx::CommandLine cmdLine(_argc, _argv);
+			if (const char* lights = cmdLine.findOption("lights") )
+			{
+				bx::fromString(&m_numLights, lights);
+			}
+			m_numLights  = bx::clamp<uint32_t>(m_numLights, 1, desc.m_maxLights);
+			m_bruteForce = cmdLine.hasArg("brute-force");
+			m_parallelBinning = !cmdLine.hasArg("serial-binning");
+
+			// Setup Main pass
+			{
+				RenderPassDesc passDesc("Main");
+				passDesc.m_clearFlags = BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH;
+				passDesc.m_clearRgba  = 0x303030ff;
+				m_mainPass = m_graph.addPass(passDesc, [this](bgfx::ViewId _view) { submitMainPass(_view); });
+				m_graph.write(m_mainPass, m_graph.getBackbuffer());
+
+				m_uniforms.init();
+				s_lights   = bgfx::createUniform("s_lights",   bgfx::UniformType::Sampler);
+				s_indices  = bgfx::createUniform("s_indices",  bgfx::UniformType::Sampler);
+				s_clusters = bgfx::createUniform("s_clusters", bgfx::UniformType::Sampler);
+
+				// Create program from shaders
+				m_shaderReload.loadProgram(&m_program,                    "vs_clusteredlights",           "fs_clusteredlights");
+				m_shaderReload.loadProgram(&m_programQuantized,           "vs_clusteredlights_quantized", "fs_clusteredlights");
+				m_shaderReload.loadProgram(&m_programBruteForce,          "vs_clusteredlights",           "fs_clusteredlights_bruteforce");
+				m_shaderReload.loadProgram(&m_programBruteForceQuantized, "vs_clusteredlights_quantized", "fs_clusteredlights_bruteforce");
+				m_ground = m_meshes.request("meshes/cube.bin");
+				m_bunny  = m_meshes.request("meshes/bunny.bin");
+			}
+
+			m_clusters.init(desc);
+			createLights();
+
+			// Initialize camera
+			cameraCreate();
+			cameraSetPosition({ 0.0f, 6.0f, -16.0f });
+			cameraSetVerticalAngle(-0.4f);
+
+			// Ground is the top of a 20x20 cube at y = 0.
+			float mtxScale[16];
+			const float scale = 10.0f;
+			bx::mtxScale(mtxScale, scale, scale, scale);
+
+			float mtxTranslate[16];
+			bx::mtxTranslate(mtxTranslate, 0.0f, -10.0f, 0.0f);
+			bx::mtxMul(m_groundTransform, mtxScale, mtxTranslate);
+
+			// 7x7 bunnies standing on it.
+			const uint32_t side = 7;
+			const float spacing = 2.5f;
+			const float offset  = -0.5f * spacing * float(side - 1);
+			m_bunnyTransforms.resize(side*side*16);
+			for (uint32_t ii = 0; ii < side*side; ++ii)
+			{
+				bx::mtxSRT(&m_bunnyTransforms[ii*16]
+					, 1.0f, 1.0f, 1.0f
+					, 0.0f, float(ii) * 0.9f, 0.0f
+					, offset + spacing * float(ii % side), 0.0f, offset + spacing * float(ii / side)
+					);
+			}
+		}
+
+		void onShutdown() override
+		{
+			if (0 != m_numFrames)
+			{
+				const LightClustersStats& stats = m_clusters.getStats();
+				printf("[clusters] %u lights, %s, %u bin threads: bin %.4f ms, gpu %.4f ms/frame over %u frames\n"
+					, m_numLights
+					, m_bruteForce ? "brute force" : "clustered"
+					, m_parallelBinning ? m_jobs.getNumThreads() + 1 : 1
+					, m_totalBinTimeMs / double(m_numFrames)
+					, m_totalGpuTimeMs / double(m_numFrames)
+					, m_numFrames
+					);
+				printf("[clusters] last frame: %u/%u clusters occupied, max %u, avg %.2f lights per occupied cluster, %u overflowed, %u indices, %u dropped\n"
+					, stats.m_numOccupied
+					, stats.m_numClusters
+					, stats.m_maxPerCluster
+					, 0 != stats.m_numOccupied ? double(stats.m_numIndices) / double(stats.m_numOccupied) : 0.0
+					, stats.m_numOverflowed
+					, stats.m_numIndices
+					, stats.m_numDropped
+					);
+			}
+
+			cameraDestroy();
+
+			m_meshes.release(m_ground);
+			m_meshes.release(m_bunny);
+
+			// Cleanup
+			m_clusters.shutdown();
+			bgfx::destroy(s_lights);
+			bgfx::destroy(s_indices);
+			bgfx::destroy(s_clusters);
+			bgfx::destroy(m_program);
+			bgfx::destroy(m_programQuantized);
+			bgfx::destroy(m_programBruteForce);
+			bgfx::destroy(m_programBruteForceQuantized);
+			m_uniforms.destroy();
+		}
+
+		// Scripted parameters for headless benchmark runs. Orbits the camera around the
+		// bunnies and grows the light radius so cluster occupancy changes over the run.
+		void onBenchmark(float _progress) override
+		{
+			m_settings.m_influenceRadiusMax = bx::lerp(1.0f, 6.0f, _progress);
+
+			const float angle  = _progress * bx::kPi2;
+			const float radius = 17.0f;
+			cameraSetPosition({ -radius * bx::sin(angle), 6.0f, -radius * bx::cos(angle) });
+			cameraSetHorizontalAngle(angle);
+			cameraSetVerticalAngle(-0.4f);
+		}
+
+		void onGui() override
+		{
+			ImGui::Text("This example shades many point lights with clustered forward culling.");
+			ImGui::Separator();
+
+			if (ImGui::Checkbox("Brute force", &m_bruteForce) )
+			{
+				// The shutdown report averages one mode only.
+				m_totalGpuTimeMs = 0.0;
+				m_totalBinTimeMs = 0.0;
+				m_numFrames      = 0;
+			}
+
+			if (ImGui::Checkbox("Multithreaded binning", &m_parallelBinning) )
+			{
+				m_totalGpuTimeMs = 0.0;
+				m_totalBinTimeMs = 0.0;
+				m_numFrames      = 0;
+			}
+
+			const LightClustersStats& stats = m_clusters.getStats();
+			const LightClustersDesc& desc = m_clusters.getDesc();
+			ImGui::Text("Lights: %u, clusters: %ux%ux%u", stats.m_numLights, desc.m_dimX, desc.m_dimY, desc.m_dimZ);
+			ImGui::Text("Bin: %.3f ms, GPU: %.3f ms", stats.m_binTimeMs, m_gpuTimeMs);
+			ImGui::Text("Occupied: %u/%u, max: %u, avg: %.2f"
+				, stats.m_numOccupied
+				, stats.m_numClusters
+				, stats.m_maxPerCluster
+				, 0 != stats.m_numOccupied ? double(stats.m_numIndices) / double(stats.m_numOccupied) : 0.0
+				);
+			ImGui::Text("Overflowed: %u (max %u per cluster)", stats.m_numOverflowed, desc.m_maxLightsPerCluster);
+			ImGui::Text("Indices: %u, dropped: %u", stats.m_numIndices, stats.m_numDropped);
+			ImGui::Separator();
+
+			ImGui::Text("Material Parms");
+			ImGui::SliderFloat("Roughness", &m_settings.m_roughness, 0.0f, 1.0f);
+			ImGui::SliderFloat("Metallic", &m_settings.m_metallic, 0.0f, 1.0f);
+			ImGui::ColorEdit3("Albedo", &m_settings.m_albedo[0], ImGuiColorEditFlags_NoSidePreview);
+			ImGui::SliderFloat3("f0", &m_settings.m_f0[0], 0.0, 2.0);
+			ImGui::Separator();
+
+			ImGui::Text("Light Parms");
+			ImGui::SliderFloat("Light Intensity", &m_settings.m_lightIntensity, 0.0f, 0.5f);
+			ImGui::SliderFloat("Light Min Radius", &m_settings.m_influenceRadiusMin, 0.1f, 2.0f);
+			ImGui::SliderFloat("Light Max Radius", &m_settings.m_influenceRadiusMax, 0.5f, 10.0f);
+		}
+
+		void onUpdate(float _time, float _deltaTime) override
+		{
+			m_time = _time;
+
+			// Update camera
+			cameraUpdate(_deltaTime * 0.15f, m_mouseState, ImGui::MouseOverArea());
+		}
+	};
+
+}
+
+ENTRY_IMPLEMENT_MAIN(
+	  ClusteredLights
+	, "clusteredlights"
+	, "Clustered forward shading of many point lights."
+	, ""
+);
@@ -0,0 +1,37 @@
+$input v_world, v_normal, v_view
+
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+#include "../common/common.sh"
+#include "uniforms.sh"
+#include "lighting.sh"
+
+// Upper bound for the loop, ESSL needs constant loop bounds. The cluster's count ends
+// it early.
+#define MAX_LIGHTS_PER_CLUSTER 256
+
+void main()
+{
+	vec3 normal = normalize(v_normal);
+	vec3 camera = mul(u_invView, vec4(0.0, 0.0, 0.0, 1.0)).xyz;
+	vec3 view   = normalize(camera - v_world);
+
+	vec2 cluster = fetchCluster(v_view);
+
+	vec3 color = vec3(0.0, 0.0, 0.0);
+	for (int ii = 0; ii < MAX_LIGHTS_PER_CLUSTER; ++ii)
+	{
+		if (float(ii) >= cluster.y)
+		{
+			break;
+		}
+
+		float index = fetchLightIndex(cluster.x + float(ii));
+		color += shadePointLight(index, v_world, normal, view);
+	}
+
+	gl_FragColor.xyz = pow(color, vec3(1.0, 1.0, 1.0)*0.44);
+	gl_FragColor.w = 1.0;
+}
@@ -0,0 +1,34 @@
+$input v_world, v_normal, v_view
+
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+#include "../common/common.sh"
+#include "uniforms.sh"
+#include "lighting.sh"
+
+// Baseline for fs_clusteredlights, every fragment loops over every light. Matches
+// LightClustersDesc::m_maxLights.
+#define MAX_LIGHTS 4096
+
+void main()
+{
+	vec3 normal = normalize(v_normal);
+	vec3 camera = mul(u_invView, vec4(0.0, 0.0, 0.0, 1.0)).xyz;
+	vec3 view   = normalize(camera - v_world);
+
+	vec3 color = vec3(0.0, 0.0, 0.0);
+	for (int ii = 0; ii < MAX_LIGHTS; ++ii)
+	{
+		if (float(ii) >= u_numLights)
+		{
+			break;
+		}
+
+		color += shadePointLight(float(ii), v_world, normal, view);
+	}
+
+	gl_FragColor.xyz = pow(color, vec3(1.0, 1.0, 1.0)*0.44);
+	gl_FragColor.w = 1.0;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef CLUSTEREDLIGHTS_LIGHTING_SH_HEADER_GUARD
+#define CLUSTEREDLIGHTS_LIGHTING_SH_HEADER_GUARD
+
+// Point light shading shared by the clustered and the brute force fragment shaders.
+
+#include "Graphics/BXDFs.sh"
+#include "Graphics/Lights.sh"
+
+SAMPLER2D(s_lights,   0);
+SAMPLER2D(s_indices,  1);
+SAMPLER2D(s_clusters, 2);
+
+// Light _index of the light texture, see LightClusters.
+void fetchLight(float _index, out vec4 _posRadiusMax, out vec4 _colorRadiusMin)
+{
+    float perRow = u_lightsTexSize.x * 0.5;
+    float row    = floor(_index / perRow);
+    float column = _index - row*perRow;
+    vec2  uv     = (vec2(column*2.0, row) + 0.5) / u_lightsTexSize;
+
+    _posRadiusMax   = texture2DLod(s_lights, uv, 0.0);
+    _colorRadiusMin = texture2DLod(s_lights, uv + vec2(1.0/u_lightsTexSize.x, 0.0), 0.0);
+}
+
+float fetchLightIndex(float _offset)
+{
+    float row    = floor(_offset / u_indicesTexSize.x);
+    float column = _offset - row*u_indicesTexSize.x;
+    vec2  uv     = (vec2(column, row) + 0.5) / u_indicesTexSize;
+
+    return texture2DLod(s_indices, uv, 0.0).x;
+}
+
+// (first index, count) of the cluster containing view space position _view.
+vec2 fetchCluster(vec3 _view)
+{
+    vec4 clip = mul(u_proj, vec4(_view, 1.0));
+    vec2 ndc  = clip.xy / clip.w;
+
+    vec2  cell  = clamp(floor((ndc*0.5 + 0.5) * u_clusterDims.xy), vec2(0.0, 0.0), u_clusterDims.xy - 1.0);
+    float slice = clamp(floor(log(max(_view.z, 1e-4)) * u_clusterScaleBias.x + u_clusterScaleBias.y), 0.0, u_clusterDims.z - 1.0);
+
+    vec2 size = vec2(u_clusterDims.x * u_clusterDims.y, u_clusterDims.z);
+    vec2 uv   = (vec2(cell.x + cell.y*u_clusterDims.x, slice) + 0.5) / size;
+    return texture2DLod(s_clusters, uv, 0.0).xy;
+}
+
+vec3 shadePointLight(float _index, vec3 _world, vec3 _normal, vec3 _view)
+{
+    vec4 posRadiusMax;
+    vec4 colorRadiusMin;
+    fetchLight(_index, posRadiusMax, colorRadiusMin);
+
+    vec3 lightMinusPos = posRadiusMax.xyz - _world;
+    float distance2    = dot(lightMinusPos, lightMinusPos);
+    if (distance2 >= posRadiusMax.w*posRadiusMax.w)
+    {
+        return vec3(0.0, 0.0, 0.0);
+    }
+
+    vec3 lightDir   = lightMinusPos * inversesqrt(distance2);
+    vec3 lightColor = light_point_attenuated(colorRadiusMin.xyz, distance2, colorRadiusMin.w, posRadiusMax.w);
+
+    float NdotV = abs(dot(_normal, _view)) + 1e-5;
+    vec3  H     = normalize(_view + lightDir);
+    float LdotH = clamp(dot(lightDir, H), 0.0, 1.0);
+    float NdotH = clamp(dot(_normal, H), 0.0, 1.0);
+    float NdotL = clamp(dot(_normal, lightDir), 0.0, 1.0);
+
+    // Specular BRDF, f90 from the Frostbite course notes (pg78).
+    vec3  f0    = mix(vec3(0.04, 0.04, 0.04), u_f0, u_metallic);
+    float f90   = clamp(50.0 * dot(f0, vec3(0.33, 0.33, 0.33)), 0.0, 1.0);
+    vec3  F     = F_Schlick(f0, f90, LdotH);
+    float alpha = u_roughness*u_roughness;
+    float G     = G_SmithGGXCorrelated(NdotL, NdotV, alpha);
+    float D     = D_GGX(NdotH, alpha);
+    vec3  Fr    = (D * G / PI) * F;
+
+    // Diffuse BRDF
+    vec3 Fd = u_albedo * (1.0 - u_metallic) * Fr_DisneyDiffuse(NdotV, NdotL, LdotH, u_roughness) / PI;
+
+    return lightColor * (Fr + Fd) * NdotL;
+}
+
+#endif // CLUSTEREDLIGHTS_LIGHTING_SH_HEADER_GUARD
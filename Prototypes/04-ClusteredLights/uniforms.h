@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef CLUSTEREDLIGHTS_UNIFORMS_H_HEADER_GUARD
+#define CLUSTEREDLIGHTS_UNIFORMS_H_HEADER_GUARD
+
+#include "frame_uniforms.h"
+#include "uniform_layout.h"
+
+// Single source for the u_params layout. uniforms.sh is generated from this file.
+struct ClusteredUniforms
+{
+	enum Enum
+	{
+		// Material
+		Albedo,
+		Roughness,
+		F0,
+		Metallic,
+
+		// Light clusters, see light_clusters.h
+		ClusterDims,
+		NumLights,
+		ClusterScaleBias,
+		LightsTexSize,
+		IndicesTexSize,
+
+		Count
+	};
+
+	enum { NumVec4 = 5 };
+
+	static constexpr const char* s_name = "u_params";
+	static constexpr UniformField s_fields[Count] =
+	{
+		{ "u_albedo",           3, false },
+		{ "u_roughness",        1, false },
+		{ "u_f0",               3, false },
+		{ "u_metallic",         1, false },
+		{ "u_clusterDims",      3, false },
+		{ "u_numLights",        1, false },
+		{ "u_clusterScaleBias", 2, false },
+		{ "u_lightsTexSize",    2, false },
+		{ "u_indicesTexSize",   2, false },
+	};
+};
+
+#define UNIFORM_BLOCKS(_x) \
+	_x(FrameUniforms) \
+	_x(ClusteredUniforms)
+
+#endif // CLUSTEREDLIGHTS_UNIFORMS_H_HEADER_GUARD
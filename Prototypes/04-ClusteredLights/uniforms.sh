@@ -0,0 +1,18 @@
+// Generated by uniformgen from uniforms.h. Do not edit.
+
+uniform vec4 u_frame[1];
+
+#define u_time              u_frame[0].x
+#define u_deltaTime         u_frame[0].y
+
+uniform vec4 u_params[5];
+
+#define u_albedo            u_params[0].xyz
+#define u_roughness         u_params[0].w
+#define u_f0                u_params[1].xyz
+#define u_metallic          u_params[1].w
+#define u_clusterDims       u_params[2].xyz
+#define u_numLights         u_params[2].w
+#define u_clusterScaleBias  u_params[3].xy
+#define u_lightsTexSize     u_params[3].zw
+#define u_indicesTexSize    u_params[4].xy
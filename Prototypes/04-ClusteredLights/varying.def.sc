@@ -0,0 +1,13 @@
+vec3 v_normal: normal    = vec3(0.0,0.0,1.0);
+vec2 v_texcoord: TEXCOORD0 = vec2(0.0,0.0);
+vec3 v_world     : TEXCOORD1 = vec3(0.0,0.0,0.0); 
+vec3 v_view    : TEXCOORD2 = vec3(0.0,0.0,0.0);
+
+vec3 a_position  : POSITION;
+vec2 a_texcoord0 : TEXCOORD0;
+vec3 a_normal    : NORMAL;
+
+vec4 i_data0     : TEXCOORD7;
+vec4 i_data1     : TEXCOORD6;
+vec4 i_data2     : TEXCOORD5;
+vec4 i_data3     : TEXCOORD4;
@@ -0,0 +1,158 @@
+# Content addressed cache for bgfx::shaderc, see add_bgfx_shader() in prototypes.cmake.
+#
+# Each shader backend gets an arguments file written at configure time:
+#
+#	set(SHADERC <path to shaderc>)
+#	set(SHADER_ARGS <shaderc command line>)
+#	set(SHADER_CACHE_DIR <store, empty to always compile>)
+#	set(SHADER_DEPFILE <depfile to write, may be empty>)
+#
+# and the build runs `cmake -DSHADER_ARGS_FILE=<file> -P shaderCache.cmake`. The shader is
+# preprocessed first, and the compiled binary is looked up by a hash of the preprocessed
+# source, the command line without its output path (profile, platform, defines, flags),
+# varying.def.sc and the shaderc executable. Hits copy from the store, misses compile and
+# add to it. A touched include, a switched branch or a new build tree sharing the store
+# then costs a preprocess per shader instead of a compile.
+#
+# shaderbatch keys on unpreprocessed sources instead and keeps its entries under
+# <store>/batch/, apart from these.
+#
+# Included from CMake it only defines shader_cache_scan_includes().
+
+if(CMAKE_SCRIPT_MODE_FILE)
+	cmake_minimum_required(VERSION 3.20)
+endif()
+
+# Files #included by FILE, recursively, searched next to the including file and then in
+# the include directories. Every #include counts, taken or not, so the list is a superset
+# of what shaderc reads.
+function(shader_cache_scan_includes OUT FILE)
+	set(PENDING ${FILE})
+	set(FOUND "")
+	while(PENDING)
+		list(POP_FRONT PENDING CURRENT)
+		get_filename_component(CURRENT_DIR ${CURRENT} DIRECTORY)
+		file(STRINGS ${CURRENT} LINES REGEX "^[ \t]*#[ \t]*include[ \t]*[<\"][^>\"]+[>\"]")
+		foreach(LINE ${LINES})
+			string(REGEX REPLACE "^[ \t]*#[ \t]*include[ \t]*[<\"]([^>\"]+)[>\"].*$" "\\1" NAME "${LINE}")
+			foreach(DIR ${CURRENT_DIR} ${ARGN})
+				if(EXISTS ${DIR}/${NAME} AND NOT IS_DIRECTORY ${DIR}/${NAME})
+					get_filename_component(INCLUDE ${DIR}/${NAME} ABSOLUTE)
+					if(NOT INCLUDE IN_LIST FOUND)
+						list(APPEND FOUND ${INCLUDE})
+						list(APPEND PENDING ${INCLUDE})
+					endif()
+					break()
+				endif()
+			endforeach()
+		endforeach()
+	endwhile()
+	set(${OUT} ${FOUND} PARENT_SCOPE)
+endfunction()
+
+if(NOT CMAKE_SCRIPT_MODE_FILE OR NOT SHADER_ARGS_FILE)
+	return()
+endif()
+
+include(${SHADER_ARGS_FILE})
+
+# Input, output, include directories and varying definitions from the command line.
+set(INPUT "")
+set(OUTPUT "")
+set(INCLUDE_DIRS "")
+set(VARYING_DEF "")
+set(NEXT "")
+foreach(ARG ${SHADER_ARGS})
+	if(NEXT STREQUAL "-f")
+		set(INPUT ${ARG})
+	elseif(NEXT STREQUAL "-o")
+		set(OUTPUT ${ARG})
+	elseif(NEXT STREQUAL "-i")
+		list(APPEND INCLUDE_DIRS ${ARG})
+	elseif(NEXT STREQUAL "--varyingdef")
+		set(VARYING_DEF ${ARG})
+	endif()
+	set(NEXT ${ARG})
+endforeach()
+
+if(NOT VARYING_DEF)
+	# shaderc's default.
+	get_filename_component(INPUT_DIR ${INPUT} DIRECTORY)
+	set(VARYING_DEF ${INPUT_DIR}/varying.def.sc)
+endif()
+
+if(SHADER_DEPFILE)
+	shader_cache_scan_includes(INCLUDES ${INPUT} ${INCLUDE_DIRS})
+	set(DEPENDS ${INPUT} ${INCLUDES})
+	if(EXISTS ${VARYING_DEF})
+		list(APPEND DEPENDS ${VARYING_DEF})
+	endif()
+
+	string(REPLACE " " "\\ " DEPFILE_CONTENT "${OUTPUT}:")
+	foreach(DEPEND ${DEPENDS})
+		string(REPLACE " " "\\ " DEPEND "${DEPEND}")
+		string(APPEND DEPFILE_CONTENT " \\\n  ${DEPEND}")
+	endforeach()
+	file(WRITE ${SHADER_DEPFILE} "${DEPFILE_CONTENT}\n")
+endif()
+
+set(KEY "")
+if(SHADER_CACHE_DIR)
+	# Same command line, preprocessed output next to the depfile instead of the binary.
+	get_filename_component(ARGS_NAME ${SHADER_ARGS_FILE} NAME_WE)
+	get_filename_component(ARGS_DIR ${SHADER_ARGS_FILE} DIRECTORY)
+	set(PREPROCESSED ${ARGS_DIR}/${ARGS_NAME}.i)
+	string(REPLACE "${OUTPUT}" "${PREPROCESSED}" PREPROCESS_ARGS "${SHADER_ARGS}")
+
+	execute_process(
+		COMMAND ${SHADERC} ${PREPROCESS_ARGS} --preprocess
+		RESULT_VARIABLE RESULT
+		OUTPUT_QUIET
+		ERROR_QUIET
+	)
+
+	# A shader that doesn't preprocess isn't cached, compiling it below reports why.
+	if(RESULT EQUAL 0 AND EXISTS ${PREPROCESSED})
+		file(SHA256 ${PREPROCESSED} SOURCE_HASH)
+		file(SHA256 ${SHADERC} SHADERC_HASH)
+		set(VARYING_HASH "")
+		if(EXISTS ${VARYING_DEF})
+			file(SHA256 ${VARYING_DEF} VARYING_HASH)
+		endif()
+		file(REMOVE ${PREPROCESSED})
+
+		string(REPLACE "${OUTPUT}" "" KEY_ARGS "${SHADER_ARGS}")
+		string(SHA256 KEY "${SHADERC_HASH}\n${KEY_ARGS}\n${VARYING_HASH}\n${SOURCE_HASH}")
+	endif()
+endif()
+
+if(KEY)
+	string(SUBSTRING ${KEY} 0 2 PREFIX)
+	set(ENTRY ${SHADER_CACHE_DIR}/${PREFIX}/${KEY}.bin)
+
+	if(EXISTS ${ENTRY})
+		# Copies may keep the store's time stamp, the output mustn't look older than its inputs.
+		execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${ENTRY} ${OUTPUT} RESULT_VARIABLE RESULT)
+		if(RESULT EQUAL 0)
+			file(TOUCH ${OUTPUT})
+			return()
+		endif()
+	endif()
+endif()
+
+execute_process(COMMAND ${SHADERC} ${SHADER_ARGS} RESULT_VARIABLE RESULT)
+if(NOT RESULT EQUAL 0)
+	file(REMOVE ${OUTPUT})
+	message(FATAL_ERROR "shaderc failed to compile ${INPUT}.")
+endif()
+
+if(KEY)
+	# Parallel builds may add the same entry, each renames its own copy into place.
+	string(RANDOM LENGTH 8 SUFFIX)
+	get_filename_component(ENTRY_DIR ${ENTRY} DIRECTORY)
+	file(MAKE_DIRECTORY ${ENTRY_DIR})
+	execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${OUTPUT} ${ENTRY}.${SUFFIX} RESULT_VARIABLE RESULT)
+	if(RESULT EQUAL 0)
+		file(RENAME ${ENTRY}.${SUFFIX} ${ENTRY})
+	endif()
+endif()
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "benchmark.h"
+
+#include <bgfx/bgfx.h>
+#include <bx/commandline.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <algorithm>
+#include <stdio.h>
+
+namespace
+{
+	constexpr float kFrameDelta = 1.0f / 60.0f;
+
+	FrameCounters s_counters;
+
+	uint32_t parseCount(const bx::CommandLine& _cmdLine, const char* _option, uint32_t _default)
+	{
+		const char* str = _cmdLine.findOption(_option);
+		uint32_t value = 0;
+		if (NULL != str
+		&&  bx::fromString(&value, str)
+		&&  0 != value)
+		{
+			return value;
+		}
+
+		return _default;
+	}
+
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+	int64_t percentile(const std::vector<int64_t>& _sorted, double _p)
+	{
+		const size_t idx = size_t(_p * double(_sorted.size() - 1) + 0.5);
+		return _sorted[idx];
+	}
+
+} // namespace
+
+void benchmarkCountDraw(uint32_t _num)
+{
+	s_counters.m_numDraws += _num;
+}
+
+void benchmarkCountCulled(uint32_t _num)
+{
+	s_counters.m_numCulled += _num;
+}
+
+void benchmarkCountUniform(uint16_t _numVec4)
+{
+	s_counters.m_numUniformUploads += 1;
+	s_counters.m_uniformBytes      += _numVec4 * 4 * sizeof(float);
+}
+
+void benchmarkCountUniformSkip()
+{
+	s_counters.m_numUniformSkips += 1;
+}
+
+Benchmark::Benchmark()
+	: m_lastCounters()
+	, m_name("")
+	, m_frameBegin(0)
+	, m_frame(0)
+	, m_numFrames(0)
+	, m_numWarmupFrames(0)
+	, m_enabled(false)
+{
+}
+
+void Benchmark::init(const char* _name, int32_t _argc, const char* const* _argv)
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	m_name    = _name;
+	m_enabled = cmdLine.hasArg("bench");
+	m_frame   = 0;
+
+	if (m_enabled)
+	{
+		m_numFrames       = parseCount(cmdLine, "bench-frames", 600);
+		m_numWarmupFrames = parseCount(cmdLine, "bench-warmup", 60);
+
+		m_frameTime.clear();
+		m_frameTime.reserve(m_numFrames);
+		m_counters.clear();
+		m_counters.reserve(m_numFrames);
+	}
+}
+
+float Benchmark::getTime() const
+{
+	return float(m_frame) * kFrameDelta;
+}
+
+float Benchmark::getDeltaTime() const
+{
+	return kFrameDelta;
+}
+
+float Benchmark::getProgress() const
+{
+	const uint32_t total = m_numWarmupFrames + m_numFrames;
+	return total > 1 ? float(m_frame) / float(total - 1) : 0.0f;
+}
+
+void Benchmark::beginFrame()
+{
+	s_counters = {};
+	m_frameBegin = bx::getHPCounter();
+}
+
+bool Benchmark::endFrame()
+{
+	m_lastCounters = s_counters;
+
+	if (!m_enabled)
+	{
+		return true;
+	}
+
+	const int64_t elapsed = bx::getHPCounter() - m_frameBegin;
+
+	if (m_frame >= m_numWarmupFrames)
+	{
+		m_frameTime.push_back(elapsed);
+		m_counters.push_back(s_counters);
+	}
+
+	++m_frame;
+
+	if (m_frame < m_numWarmupFrames + m_numFrames)
+	{
+		return true;
+	}
+
+	report();
+	return false;
+}
+
+void Benchmark::report() const
+{
+	if (m_frameTime.empty() )
+	{
+		return;
+	}
+
+	std::vector<int64_t> sorted = m_frameTime;
+	std::sort(sorted.begin(), sorted.end() );
+
+	int64_t total = 0;
+	for (int64_t ticks : sorted)
+	{
+		total += ticks;
+	}
+
+	double draws = 0.0;
+	double culled = 0.0;
+	double uploads = 0.0;
+	double skips = 0.0;
+	double bytes = 0.0;
+	for (const FrameCounters& counters : m_counters)
+	{
+		draws   += counters.m_numDraws;
+		culled  += counters.m_numCulled;
+		uploads += counters.m_numUniformUploads;
+		skips   += counters.m_numUniformSkips;
+		bytes   += counters.m_uniformBytes;
+	}
+
+	const double num = double(m_counters.size() );
+
+	printf("[bench] %s: %u frames (%u warmup), renderer %s\n"
+		, m_name
+		, uint32_t(sorted.size() )
+		, m_numWarmupFrames
+		, bgfx::getRendererName(bgfx::getRendererType() )
+		);
+	printf("[bench] cpu ms  min %.4f  p50 %.4f  p90 %.4f  p95 %.4f  p99 %.4f  max %.4f  mean %.4f\n"
+		, toMs(sorted.front() )
+		, toMs(percentile(sorted, 0.50) )
+		, toMs(percentile(sorted, 0.90) )
+		, toMs(percentile(sorted, 0.95) )
+		, toMs(percentile(sorted, 0.99) )
+		, toMs(sorted.back() )
+		, toMs(total) / double(sorted.size() )
+		);
+	printf("[bench] per frame  draws %.1f  culled %.1f  uniform uploads %.1f  skipped %.1f  uniform bytes %.1f\n"
+		, draws   / num
+		, culled  / num
+		, uploads / num
+		, skips   / num
+		, bytes   / num
+		);
+	fflush(stdout);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_BENCHMARK_H_HEADER_GUARD
+#define PROTOTYPE_BENCHMARK_H_HEADER_GUARD
+
+#include <bx/bx.h>
+#include <vector>
+
+// Headless benchmark mode shared by the prototypes.
+//
+// Command line:
+//   --bench               Run a fixed number of scripted frames, print a report and exit.
+//   --bench-frames <n>    Number of measured frames (default 600).
+//   --bench-warmup <n>    Number of frames run before measuring starts (default 60).
+//
+// Combine with `--noop` to bring bgfx up on the Noop renderer. For machines without a
+// display build with SGTESTBED_HEADLESS=ON so the entry layer doesn't open a window.
+
+// Submit counters. Prototypes call these from their submit path so the benchmark can
+// report per-frame draw-call and uniform-upload counts.
+void benchmarkCountDraw(uint32_t _num = 1);
+void benchmarkCountCulled(uint32_t _num);
+void benchmarkCountUniform(uint16_t _numVec4);
+void benchmarkCountUniformSkip();
+
+struct FrameCounters
+{
+	uint32_t m_numDraws;
+	uint32_t m_numCulled;
+	uint32_t m_numUniformUploads;
+	uint32_t m_numUniformSkips;
+	uint32_t m_uniformBytes;
+};
+
+class Benchmark
+{
+public:
+	Benchmark();
+
+	// Parses the command line. Does nothing unless `--bench` is present.
+	void init(const char* _name, int32_t _argc, const char* const* _argv);
+
+	bool isEnabled() const { return m_enabled; }
+
+	// Scripted time in seconds, advancing a fixed 1/60s per frame so every run
+	// feeds the same camera and light parameters into the frame.
+	float getTime() const;
+
+	// Fixed frame delta matching getTime().
+	float getDeltaTime() const;
+
+	// Normalized progress over the whole run [0, 1], for sweeping UI parameters.
+	float getProgress() const;
+
+	void beginFrame();
+
+	// Returns false once the last frame has been measured and the report printed.
+	bool endFrame();
+
+	// Counters of the last finished frame. Collected in interactive runs too.
+	const FrameCounters& getLastCounters() const { return m_lastCounters; }
+
+private:
+	void report() const;
+
+	std::vector<int64_t>       m_frameTime;
+	std::vector<FrameCounters> m_counters;
+	FrameCounters m_lastCounters;
+	const char* m_name;
+	int64_t  m_frameBegin;
+	uint32_t m_frame;
+	uint32_t m_numFrames;
+	uint32_t m_numWarmupFrames;
+	bool     m_enabled;
+};
+
+#endif // PROTOTYPE_BENCHMARK_H_HEADER_GUARD
@@ -0,0 +1,208 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "dfg_lut.h"
+#include "bxdfs.h"
+#include "job_system.h"
+
+#include <vector>
+
+namespace
+{
+	constexpr uint32_t kMagic = BX_MAKEFOURCC('D', 'F', 'G', 1);
+
+	// Bump whenever the integrand, the sample set or the texel layout changes, caches
+	// from before are rebuilt instead of silently reused.
+	constexpr uint32_t kVersion = 1;
+
+	struct DfgLutHeader
+	{
+		uint32_t m_magic;
+		uint32_t m_version;
+		uint32_t m_size;
+		uint32_t m_numSamples;
+	};
+
+	// Hammersley point set, shared by every texel. Stored structure of arrays so the
+	// integration loads eight samples at a time.
+	struct DfgSamples
+	{
+		// GGX half vectors: xi drives cos(theta), phi is shared with the diffuse lobe.
+		std::vector<float> m_xi;
+		std::vector<float> m_cosPhi;
+
+		// Cosine distributed light directions for the diffuse term.
+		std::vector<float> m_cosTheta;
+		std::vector<float> m_sinThetaCosPhi;
+	};
+
+	uint32_t getNumSamples(const DfgLutDesc& _desc)
+	{
+		return bx::max<uint32_t>( (_desc.m_numSamples + 7) & ~7u, 8);
+	}
+
+	void createSamples(DfgSamples& _outSamples, uint32_t _num)
+	{
+		_outSamples.m_xi.resize(_num);
+		_outSamples.m_cosPhi.resize(_num);
+		_outSamples.m_cosTheta.resize(_num);
+		_outSamples.m_sinThetaCosPhi.resize(_num);
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const float phi = bx::kPi2 * (float(ii) + 0.5f) / float(_num);
+			const float xi  = bxdfRadicalInverse(ii);
+
+			_outSamples.m_xi[ii]             = xi;
+			_outSamples.m_cosPhi[ii]         = bx::cos(phi);
+			_outSamples.m_cosTheta[ii]       = bx::sqrt(1.0f - xi);
+			_outSamples.m_sinThetaCosPhi[ii] = bx::sqrt(xi) * bx::cos(phi);
+		}
+	}
+
+	// Integrates one texel. V lies in the xz plane, N is +z.
+	void integrate(float* _outTexel, float _NdotV, float _roughness, const DfgSamples& _samples)
+	{
+		const uint32_t num = uint32_t(_samples.m_xi.size() );
+
+		const SimdFloat8 NdotV(_NdotV);
+		const SimdFloat8 sinV(bx::sqrt(1.0f - _NdotV*_NdotV) );
+		const SimdFloat8 roughness(_roughness);
+
+		// Same remapping as fs_lightsbasic.sc.
+		const float alpha = _roughness*_roughness;
+		const SimdFloat8 alphaG(alpha);
+		const SimdFloat8 alpha2Minus1(alpha*alpha - 1.0f);
+
+		const SimdFloat8 zero(0.0f);
+		const SimdFloat8 one(1.0f);
+
+		SimdFloat8 scale(0.0f);
+		SimdFloat8 bias(0.0f);
+		SimdFloat8 diffuse(0.0f);
+
+		for (uint32_t ii = 0; ii < num; ii += 8)
+		{
+			// Half vectors distributed by D_GGX()*NdotH.
+			const SimdFloat8 xi     = bxdfLoad<SimdFloat8>(&_samples.m_xi[ii]);
+			const SimdFloat8 cosPhi = bxdfLoad<SimdFloat8>(&_samples.m_cosPhi[ii]);
+
+			const SimdFloat8 NdotH2 = (one - xi) / (alpha2Minus1*xi + one);
+			const SimdFloat8 NdotH  = bxdfSqrt(NdotH2);
+			const SimdFloat8 sinH   = bxdfSqrt(bxdfMax(one - NdotH2, zero) );
+
+			// L = reflect(-V, H), samples below the horizon get no weight.
+			const SimdFloat8 VdotH = bxdfMax(sinV*sinH*cosPhi + NdotV*NdotH, zero);
+			const SimdFloat8 NdotL = bxdfMax(SimdFloat8(2.0f)*VdotH*NdotH - NdotV, zero);
+
+			// The pdf of L is D*NdotH/(4*VdotH), D cancels against the BRDF.
+			const SimdFloat8 weight = G_SmithGGXCorrelated(NdotL, NdotV, alphaG) * NdotL * SimdFloat8(4.0f) * VdotH / NdotH;
+			const SimdFloat8 Fc     = bxdfPow5(one - VdotH);
+
+			scale = scale + (one - Fc)*weight;
+			bias  = bias  + Fc*weight;
+
+			// Cosine distributed L, the pdf cancels the Lambert term.
+			const SimdFloat8 cosTheta       = bxdfLoad<SimdFloat8>(&_samples.m_cosTheta[ii]);
+			const SimdFloat8 sinThetaCosPhi = bxdfLoad<SimdFloat8>(&_samples.m_sinThetaCosPhi[ii]);
+
+			const SimdFloat8 VdotL = sinV*sinThetaCosPhi + NdotV*cosTheta;
+			const SimdFloat8 LdotH = bxdfSqrt(bxdfMax( (one + VdotL)*SimdFloat8(0.5f), zero) );
+
+			diffuse = diffuse + Fr_DisneyDiffuse(NdotV, cosTheta, LdotH, roughness);
+		}
+
+		const float invNum = 1.0f / float(num);
+		_outTexel[0] = bxdfSumLanes(scale)   * invNum;
+		_outTexel[1] = bxdfSumLanes(bias)    * invNum;
+		_outTexel[2] = bxdfSumLanes(diffuse) * invNum;
+		_outTexel[3] = 0.0f;
+	}
+
+} // namespace
+
+DfgLutDesc::DfgLutDesc()
+	: m_size(128)
+	, m_numSamples(512)
+{
+}
+
+void dfgLutCompute(float* _outLut, const DfgLutDesc& _desc, JobSystem* _jobs)
+{
+	const uint32_t size = _desc.m_size;
+
+	DfgSamples samples;
+	createSamples(samples, getNumSamples(_desc) );
+
+	const JobSystem::RangeFn integrateRows = [&](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t yy = _begin; yy < _end; ++yy)
+		{
+			const float roughness = (float(yy) + 0.5f) / float(size);
+
+			for (uint32_t xx = 0; xx < size; ++xx)
+			{
+				const float NdotV = (float(xx) + 0.5f) / float(size);
+				integrate(&_outLut[(yy*size + xx)*4], NdotV, roughness, samples);
+			}
+		}
+	};
+
+	jobSystemParallelFor(_jobs, size, integrateRows);
+}
+
+void dfgLutToHalf(uint16_t* _outTexels, const DfgLutDesc& _desc, const float* _lut)
+{
+	const uint32_t num = uint32_t(_desc.m_size)*_desc.m_size*4;
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		_outTexels[ii] = bx::halfFromFloat(_lut[ii]);
+	}
+}
+
+bool dfgLutWrite(bx::WriterI* _writer, const DfgLutDesc& _desc, const float* _lut, bx::Error* _err)
+{
+	DfgLutHeader header;
+	header.m_magic      = kMagic;
+	header.m_version    = kVersion;
+	header.m_size       = _desc.m_size;
+	header.m_numSamples = getNumSamples(_desc);
+
+	std::vector<uint16_t> texels(uint32_t(_desc.m_size)*_desc.m_size*4);
+	dfgLutToHalf(texels.data(), _desc, _lut);
+
+	bx::write(_writer, header, _err);
+	bx::write(_writer, texels.data(), int32_t(dfgLutGetTexelsSize(_desc) ), _err);
+
+	return _err->isOk();
+}
+
+const uint16_t* dfgLutGetTexels(const MappedFile* _file, const DfgLutDesc& _desc)
+{
+	if (mappedFileGetSize(_file) != sizeof(DfgLutHeader) + dfgLutGetTexelsSize(_desc) )
+	{
+		return NULL;
+	}
+
+	const uint8_t* data = mappedFileGetData(_file);
+
+	DfgLutHeader header;
+	bx::memCopy(&header, data, sizeof(header) );
+
+	if (kMagic                != header.m_magic
+	||  kVersion              != header.m_version
+	||  _desc.m_size          != header.m_size
+	||  getNumSamples(_desc)  != header.m_numSamples)
+	{
+		return NULL;
+	}
+
+	return reinterpret_cast<const uint16_t*>(data + sizeof(header) );
+}
+
+uint32_t dfgLutGetTexelsSize(const DfgLutDesc& _desc)
+{
+	return uint32_t(_desc.m_size)*_desc.m_size*4*sizeof(uint16_t);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_DFG_LUT_H_HEADER_GUARD
+#define PROTOTYPE_DFG_LUT_H_HEADER_GUARD
+
+#include <bx/readerwriter.h>
+
+#include "mapped_file.h"
+
+class JobSystem;
+
+// Pre-integrated DFG table for image based lighting, split sum style. Texel (x, y) holds
+// NdotV = (x + 0.5)/size and roughness = (y + 0.5)/size:
+//
+//   r  scale, specular = prefiltered * (f0*r + f90*g)
+//   g  bias
+//   b  mean Fr_DisneyDiffuse() over the cosine lobe, diffuse = irradiance * albedo * b
+//   a  0
+//
+// Integrated on the CPU with the BXDFs.sh terms from bxdfs.h. Only depends on bx so host
+// tools can use it, creating the texture lives in dfg_lut_load.h.
+struct DfgLutDesc
+{
+	DfgLutDesc();
+
+	uint16_t m_size;
+
+	// Importance samples per texel, rounded up to a multiple of 8.
+	uint32_t m_numSamples;
+};
+
+// Fills _outLut with m_size*m_size RGBA floats. Rows run in parallel on _jobs if given,
+// samples in SimdFloat8 lanes. The result doesn't depend on the thread count.
+void dfgLutCompute(float* _outLut, const DfgLutDesc& _desc, JobSystem* _jobs = NULL);
+
+// Converts a computed table to the RGBA16F texels the cache and the texture hold.
+void dfgLutToHalf(uint16_t* _outTexels, const DfgLutDesc& _desc, const float* _lut);
+
+// Cache file: a small header with the desc and the integrand version followed by the
+// RGBA16F texels, ready to be handed to the GPU without conversion.
+bool dfgLutWrite(bx::WriterI* _writer, const DfgLutDesc& _desc, const float* _lut, bx::Error* _err);
+
+// Returns the RGBA16F texels in the mapping, NULL if the file isn't a cache for _desc.
+const uint16_t* dfgLutGetTexels(const MappedFile* _file, const DfgLutDesc& _desc);
+
+// Bytes of RGBA16F texel data for _desc.
+uint32_t dfgLutGetTexelsSize(const DfgLutDesc& _desc);
+
+#endif // PROTOTYPE_DFG_LUT_H_HEADER_GUARD
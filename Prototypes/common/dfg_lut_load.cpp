@@ -0,0 +1,127 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "dfg_lut_load.h"
+
+#include <bx/file.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+#include <vector>
+
+namespace
+{
+	constexpr uint64_t kTextureFlags = 0
+		| BGFX_SAMPLER_UVW_CLAMP
+		;
+
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+	bool writeCache(const char* _filePath, const DfgLutDesc& _desc, const float* _lut)
+	{
+		const bx::FilePath filePath(_filePath);
+
+		bx::Error err;
+		bx::makeAll(bx::FilePath(filePath.getPath() ), &err);
+
+		bx::FileWriter writer;
+		if (!bx::open(&writer, filePath, false, &err) )
+		{
+			return false;
+		}
+
+		const bool result = dfgLutWrite(&writer, _desc, _lut, &err);
+		bx::close(&writer);
+
+		return result;
+	}
+
+} // namespace
+
+bgfx::TextureHandle dfgLutLoad(const char* _filePath, const DfgLutDesc& _desc, JobSystem* _jobs, DfgLutLoadStats* _stats)
+{
+	const int64_t start = bx::getHPCounter();
+
+	MappedFile* file = mappedFileOpen(_filePath);
+	const uint16_t* texels = NULL != file ? dfgLutGetTexels(file, _desc) : NULL;
+
+	const bgfx::Memory* mem = NULL;
+	double computeTimeMs = 0.0;
+
+	if (NULL != texels)
+	{
+		mappedFileAddRef(file);
+		mem = bgfx::makeRef(texels, dfgLutGetTexelsSize(_desc), mappedFileReleaseFn, file);
+	}
+	else
+	{
+		std::vector<float> lut(uint32_t(_desc.m_size)*_desc.m_size*4);
+
+		const int64_t computeStart = bx::getHPCounter();
+		dfgLutCompute(lut.data(), _desc, _jobs);
+		computeTimeMs = toMs(bx::getHPCounter() - computeStart);
+
+		mem = bgfx::alloc(dfgLutGetTexelsSize(_desc) );
+		dfgLutToHalf(reinterpret_cast<uint16_t*>(mem->data), _desc, lut.data() );
+
+		// The mapping must be gone before the file is rewritten.
+		if (NULL != file)
+		{
+			mappedFileRelease(file);
+			file = NULL;
+		}
+
+		if (!writeCache(_filePath, _desc, lut.data() ) )
+		{
+			printf("[dfg] %s: failed to write the cache\n", _filePath);
+		}
+	}
+
+	const bgfx::TextureHandle texture = bgfx::createTexture2D(
+		  _desc.m_size
+		, _desc.m_size
+		, false
+		, 1
+		, bgfx::TextureFormat::RGBA16F
+		, kTextureFlags
+		, mem
+		);
+
+	if (NULL != file)
+	{
+		mappedFileRelease(file);
+	}
+
+	if (NULL != _stats)
+	{
+		_stats->m_loadTimeMs    = toMs(bx::getHPCounter() - start);
+		_stats->m_computeTimeMs = computeTimeMs;
+		_stats->m_cached        = NULL != texels;
+	}
+
+	return texture;
+}
+
+void dfgLutLoadStatsPrint(const char* _filePath, const DfgLutLoadStats& _stats)
+{
+	if (_stats.m_cached)
+	{
+		printf("[dfg] %s: cached, %.3f ms\n"
+			, _filePath
+			, _stats.m_loadTimeMs
+			);
+	}
+	else
+	{
+		printf("[dfg] %s: computed in %.3f ms, %.3f ms total\n"
+			, _filePath
+			, _stats.m_computeTimeMs
+			, _stats.m_loadTimeMs
+			);
+	}
+}
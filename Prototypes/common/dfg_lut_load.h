@@ -0,0 +1,31 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_DFG_LUT_LOAD_H_HEADER_GUARD
+#define PROTOTYPE_DFG_LUT_LOAD_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+
+#include "dfg_lut.h"
+
+struct DfgLutLoadStats
+{
+	double m_loadTimeMs;
+
+	// 0 when the cache was used.
+	double m_computeTimeMs;
+
+	bool m_cached;
+};
+
+// Creates the RGBA16F DFG texture. A cache file matching _desc is mapped and handed to
+// bgfx::makeRef as is, otherwise the table is computed on _jobs and the cache written
+// for the next run, creating missing directories. Runs on the thread that owns bgfx.
+bgfx::TextureHandle dfgLutLoad(const char* _filePath, const DfgLutDesc& _desc, JobSystem* _jobs = NULL, DfgLutLoadStats* _stats = NULL);
+
+// Prints one `[dfg]` line with the load stats.
+void dfgLutLoadStatsPrint(const char* _filePath, const DfgLutLoadStats& _stats);
+
+#endif // PROTOTYPE_DFG_LUT_LOAD_H_HEADER_GUARD
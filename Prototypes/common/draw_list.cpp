@@ -0,0 +1,185 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "draw_list.h"
+#include "benchmark.h"
+#include "mesh_load.h"
+#include "occlusion_buffer.h"
+
+DrawList::DrawList()
+	: m_culling(true)
+{
+	bx::memSet(&m_stats, 0, sizeof(m_stats) );
+}
+
+void DrawList::begin()
+{
+	m_draws.clear();
+	m_matrices.clear();
+	m_aabbs.clear();
+	m_sphereBlocks.clear();
+	m_visible.clear();
+}
+
+void DrawList::add(const Mesh* _mesh, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state)
+{
+	const uint32_t mtx = uint32_t(m_matrices.size() );
+	m_matrices.resize(mtx + 16);
+	meshGetModelMtx(&m_matrices[mtx], _mesh, _mtx);
+
+	for (const Group& group : _mesh->m_groups)
+	{
+		const uint32_t idx = uint32_t(m_draws.size() );
+		m_draws.push_back({ &group, _program, _state, mtx });
+		m_aabbs.push_back(cullTransformAabb(group.m_aabb, _mtx) );
+
+		if (0 == idx%4)
+		{
+			m_sphereBlocks.emplace_back();
+		}
+
+		const bx::Sphere sphere = cullTransformSphere(group.m_sphere, _mtx);
+		CullSpheres4& block = m_sphereBlocks.back();
+		block.m_x[idx%4]      = sphere.center.x;
+		block.m_y[idx%4]      = sphere.center.y;
+		block.m_z[idx%4]      = sphere.center.z;
+		block.m_radius[idx%4] = sphere.radius;
+	}
+}
+
+void DrawList::cull(const float* _view, const float* _proj, const OcclusionBuffer* _occlusion)
+{
+	const uint32_t numDraws = uint32_t(m_draws.size() );
+
+	m_stats = {};
+	m_stats.m_numDraws = numDraws;
+	m_visible.assign(numDraws, m_culling ? 0 : 1);
+
+	if (!m_culling)
+	{
+		return;
+	}
+
+	float viewProj[16];
+	bx::mtxMul(viewProj, _view, _proj);
+
+	Frustum frustum;
+	frustumFromViewProj(frustum, viewProj, bgfx::getCaps()->homogeneousDepth);
+
+	// Spheres are the cheap rejection, every draw is tested.
+	const uint32_t numSphereBlocks = uint32_t(m_sphereBlocks.size() );
+	m_masks.resize(numSphereBlocks);
+	frustumCullSpheres(m_masks.data(), frustum, m_sphereBlocks.data(), numSphereBlocks);
+
+	m_candidates.clear();
+	for (uint32_t ii = 0; ii < numDraws; ++ii)
+	{
+		if (0 != (m_masks[ii/4] & (1 << (ii%4) ) ) )
+		{
+			m_candidates.push_back(ii);
+		}
+	}
+
+	// Boxes fit tighter, only the spheres that survived are refined.
+	const uint32_t numCandidates = uint32_t(m_candidates.size() );
+	const uint32_t numAabbBlocks = (numCandidates + 3)/4;
+	m_aabbBlocks.resize(numAabbBlocks);
+	for (uint32_t ii = 0; ii < numCandidates; ++ii)
+	{
+		const bx::Aabb& aabb = m_aabbs[m_candidates[ii] ];
+		CullAabbs4& block = m_aabbBlocks[ii/4];
+		block.m_centerX[ii%4] = (aabb.min.x + aabb.max.x) * 0.5f;
+		block.m_centerY[ii%4] = (aabb.min.y + aabb.max.y) * 0.5f;
+		block.m_centerZ[ii%4] = (aabb.min.z + aabb.max.z) * 0.5f;
+		block.m_extentX[ii%4] = (aabb.max.x - aabb.min.x) * 0.5f;
+		block.m_extentY[ii%4] = (aabb.max.y - aabb.min.y) * 0.5f;
+		block.m_extentZ[ii%4] = (aabb.max.z - aabb.min.z) * 0.5f;
+	}
+
+	m_masks.resize(numAabbBlocks);
+	frustumCullAabbs(m_masks.data(), frustum, m_aabbBlocks.data(), numAabbBlocks);
+
+	uint32_t numVisible  = 0;
+	uint32_t numOccluded = 0;
+	for (uint32_t ii = 0; ii < numCandidates; ++ii)
+	{
+		if (0 == (m_masks[ii/4] & (1 << (ii%4) ) ) )
+		{
+			continue;
+		}
+
+		// Only the draws inside the frustum pay for the occlusion test.
+		const uint32_t idx = m_candidates[ii];
+		if (NULL != _occlusion
+		&&  !_occlusion->isVisible(m_aabbs[idx]) )
+		{
+			++numOccluded;
+			continue;
+		}
+
+		m_visible[idx] = 1;
+		++numVisible;
+	}
+
+	m_stats.m_numCulledSphere    = numDraws - numCandidates;
+	m_stats.m_numCulledAabb      = numCandidates - numVisible - numOccluded;
+	m_stats.m_numCulledOcclusion = numOccluded;
+}
+
+void DrawList::submit(bgfx::ViewId _view, uint8_t _discard)
+{
+	// Draws without a cull() this frame are all visible.
+	m_visible.resize(m_draws.size(), 1);
+
+	uint32_t lastMtx = UINT32_MAX;
+	uint32_t cachedMtx = 0;
+	uint32_t numSubmitted = 0;
+
+	for (uint32_t ii = 0, num = uint32_t(m_draws.size() ); ii < num; ++ii)
+	{
+		if (0 == m_visible[ii])
+		{
+			continue;
+		}
+
+		const Draw& draw = m_draws[ii];
+
+		// Groups of the same mesh share one transform cache entry.
+		if (lastMtx != draw.m_mtx)
+		{
+			lastMtx   = draw.m_mtx;
+			cachedMtx = bgfx::setTransform(&m_matrices[draw.m_mtx]);
+		}
+		else
+		{
+			bgfx::setTransform(cachedMtx);
+		}
+
+		uint64_t state = draw.m_state;
+		if (BGFX_STATE_MASK == state)
+		{
+			// bgfx_utils' Mesh::submit() default.
+			state = 0
+				| BGFX_STATE_WRITE_RGB
+				| BGFX_STATE_WRITE_A
+				| BGFX_STATE_WRITE_Z
+				| BGFX_STATE_DEPTH_TEST_LESS
+				| BGFX_STATE_CULL_CCW
+				| BGFX_STATE_MSAA
+				;
+		}
+
+		bgfx::setState(state);
+		bgfx::setIndexBuffer(draw.m_group->m_ibh);
+		bgfx::setVertexBuffer(0, draw.m_group->m_vbh);
+		bgfx::submit(_view, draw.m_program, 0, _discard);
+		++numSubmitted;
+	}
+
+	m_stats.m_numSubmitted = numSubmitted;
+
+	benchmarkCountDraw(numSubmitted);
+	benchmarkCountCulled(uint32_t(m_draws.size() ) - numSubmitted);
+}
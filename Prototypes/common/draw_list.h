@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_DRAW_LIST_H_HEADER_GUARD
+#define PROTOTYPE_DRAW_LIST_H_HEADER_GUARD
+
+#include "bgfx_utils.h"
+#include "frustum_cull.h"
+
+#include <vector>
+
+class OcclusionBuffer;
+
+struct CullStats
+{
+	uint32_t m_numDraws;
+	uint32_t m_numCulledSphere;
+	uint32_t m_numCulledAabb;
+	uint32_t m_numCulledOcclusion;
+	uint32_t m_numSubmitted;
+};
+
+// Per mesh group draws, culled against the view frustum before submission. Replaces
+// meshSubmit() in the submit path:
+//
+//   m_drawList.begin();
+//   m_drawList.add(mesh, program, mtx);
+//   m_drawList.cull(view, proj);
+//   m_drawList.submit(viewId);
+//
+// cull() tests the group bounding spheres first and the AABBs of the survivors second,
+// four groups per SIMD instruction. With an OcclusionBuffer the AABBs inside the frustum
+// are also tested against the occluders rasterized this frame. submit() reports
+// submitted and culled counts to the benchmark counters.
+class DrawList
+{
+public:
+	DrawList();
+
+	// With culling disabled cull() keeps every draw, for comparing against.
+	void setCulling(bool _enabled) { m_culling = _enabled; }
+	bool isCulling() const { return m_culling; }
+
+	void begin();
+
+	// Adds one draw per group of _mesh. _mtx is the object to world matrix the group
+	// bounds are in, quantized meshes get their dequantization from meshGetModelMtx().
+	void add(const Mesh* _mesh, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state = BGFX_STATE_MASK);
+
+	// _occlusion, if given, must have been built with the same _view and _proj.
+	void cull(const float* _view, const float* _proj, const OcclusionBuffer* _occlusion = NULL);
+
+	// _discard is passed to bgfx::submit(). Keep BGFX_DISCARD_BINDINGS out of it to share
+	// textures set before submit() between all draws, and bgfx::discard() afterwards.
+	void submit(bgfx::ViewId _view, uint8_t _discard = BGFX_DISCARD_ALL);
+
+	// Counts of the last cull().
+	const CullStats& getStats() const { return m_stats; }
+
+private:
+	struct Draw
+	{
+		const Group* m_group;
+		bgfx::ProgramHandle m_program;
+		uint64_t m_state;
+		uint32_t m_mtx;
+	};
+
+	std::vector<Draw> m_draws;
+	std::vector<float> m_matrices;
+	std::vector<bx::Aabb> m_aabbs;
+	std::vector<uint8_t> m_visible;
+
+	// Scratch for cull().
+	std::vector<CullSpheres4> m_sphereBlocks;
+	std::vector<CullAabbs4> m_aabbBlocks;
+	std::vector<uint8_t> m_masks;
+	std::vector<uint32_t> m_candidates;
+
+	CullStats m_stats;
+	bool m_culling;
+};
+
+#endif // PROTOTYPE_DRAW_LIST_H_HEADER_GUARD
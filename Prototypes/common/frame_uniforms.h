@@ -0,0 +1,33 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_FRAME_UNIFORMS_H_HEADER_GUARD
+#define PROTOTYPE_FRAME_UNIFORMS_H_HEADER_GUARD
+
+#include "uniform_layout.h"
+
+// Per-frame uniforms, owned and uploaded once per frame by PrototypeApp. Prototypes
+// list FrameUniforms in their UNIFORM_BLOCKS so the shader side gets the defines.
+struct FrameUniforms
+{
+	enum Enum
+	{
+		Time,
+		DeltaTime,
+
+		Count
+	};
+
+	enum { NumVec4 = 1 };
+
+	static constexpr const char* s_name = "u_frame";
+	static constexpr UniformField s_fields[Count] =
+	{
+		{ "u_time",      1, false },
+		{ "u_deltaTime", 1, false },
+	};
+};
+
+#endif // PROTOTYPE_FRAME_UNIFORMS_H_HEADER_GUARD
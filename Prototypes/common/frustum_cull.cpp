@@ -0,0 +1,175 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "frustum_cull.h"
+
+#include <bx/math.h>
+#include <bx/simd_t.h>
+
+namespace
+{
+	// Plane _a*clip[_compA] + _b*clip[_compB] >= 0. bx matrices transform row vectors,
+	// clip[j] = dot(p, column j).
+	void setPlane(float* _plane, const float* _mtx, uint32_t _compA, float _a, uint32_t _compB, float _b)
+	{
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			_plane[ii] = _a*_mtx[ii*4 + _compA] + _b*_mtx[ii*4 + _compB];
+		}
+
+		const float len = bx::length(bx::Vec3{ _plane[0], _plane[1], _plane[2] });
+		const float invLen = len > 0.0f ? 1.0f / len : 0.0f;
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			_plane[ii] *= invLen;
+		}
+	}
+
+	// Plane coefficients splatted across lanes, loaded once per batch.
+	struct SplatPlanes
+	{
+		bx::simd128_t m_x[6];
+		bx::simd128_t m_y[6];
+		bx::simd128_t m_z[6];
+		bx::simd128_t m_w[6];
+		bx::simd128_t m_absX[6];
+		bx::simd128_t m_absY[6];
+		bx::simd128_t m_absZ[6];
+	};
+
+	void splatPlanes(SplatPlanes& _out, const Frustum& _frustum)
+	{
+		for (uint32_t ii = 0; ii < 6; ++ii)
+		{
+			const float* plane = _frustum.m_planes[ii];
+			_out.m_x[ii]    = bx::simd_splat(plane[0]);
+			_out.m_y[ii]    = bx::simd_splat(plane[1]);
+			_out.m_z[ii]    = bx::simd_splat(plane[2]);
+			_out.m_w[ii]    = bx::simd_splat(plane[3]);
+			_out.m_absX[ii] = bx::simd_splat(bx::abs(plane[0]) );
+			_out.m_absY[ii] = bx::simd_splat(bx::abs(plane[1]) );
+			_out.m_absZ[ii] = bx::simd_splat(bx::abs(plane[2]) );
+		}
+	}
+
+	// All ones lanes are outside.
+	uint8_t toVisibleMask(bx::simd128_t _outside)
+	{
+		BX_ALIGN_DECL_16(uint32_t lanes[4]);
+		bx::simd_st(lanes, _outside);
+
+		return uint8_t(0
+			| (0 == lanes[0] ? 1 : 0)
+			| (0 == lanes[1] ? 2 : 0)
+			| (0 == lanes[2] ? 4 : 0)
+			| (0 == lanes[3] ? 8 : 0)
+			);
+	}
+
+} // namespace
+
+void frustumFromViewProj(Frustum& _frustum, const float* _viewProj, bool _homogeneousDepth)
+{
+	setPlane(_frustum.m_planes[0], _viewProj, 3, 1.0f, 0,  1.0f); // left
+	setPlane(_frustum.m_planes[1], _viewProj, 3, 1.0f, 0, -1.0f); // right
+	setPlane(_frustum.m_planes[2], _viewProj, 3, 1.0f, 1,  1.0f); // bottom
+	setPlane(_frustum.m_planes[3], _viewProj, 3, 1.0f, 1, -1.0f); // top
+	setPlane(_frustum.m_planes[4], _viewProj, 3, _homogeneousDepth ? 1.0f : 0.0f, 2, 1.0f); // near
+	setPlane(_frustum.m_planes[5], _viewProj, 3, 1.0f, 2, -1.0f); // far
+}
+
+void frustumCullSpheres(uint8_t* _outMask, const Frustum& _frustum, const CullSpheres4* _spheres, uint32_t _numBlocks)
+{
+	SplatPlanes planes;
+	splatPlanes(planes, _frustum);
+
+	const bx::simd128_t zero = bx::simd_zero();
+
+	for (uint32_t ii = 0; ii < _numBlocks; ++ii)
+	{
+		const CullSpheres4& spheres = _spheres[ii];
+		const bx::simd128_t xx     = bx::simd_ld(spheres.m_x);
+		const bx::simd128_t yy     = bx::simd_ld(spheres.m_y);
+		const bx::simd128_t zz     = bx::simd_ld(spheres.m_z);
+		const bx::simd128_t radius = bx::simd_ld(spheres.m_radius);
+
+		bx::simd128_t outside = zero;
+		for (uint32_t jj = 0; jj < 6; ++jj)
+		{
+			// dot(n, c) + d + r < 0
+			bx::simd128_t dist = bx::simd_madd(xx, planes.m_x[jj], planes.m_w[jj]);
+			dist = bx::simd_madd(yy, planes.m_y[jj], dist);
+			dist = bx::simd_madd(zz, planes.m_z[jj], dist);
+			outside = bx::simd_or(outside, bx::simd_cmplt(bx::simd_add(dist, radius), zero) );
+		}
+
+		_outMask[ii] = toVisibleMask(outside);
+	}
+}
+
+void frustumCullAabbs(uint8_t* _outMask, const Frustum& _frustum, const CullAabbs4* _aabbs, uint32_t _numBlocks)
+{
+	SplatPlanes planes;
+	splatPlanes(planes, _frustum);
+
+	const bx::simd128_t zero = bx::simd_zero();
+
+	for (uint32_t ii = 0; ii < _numBlocks; ++ii)
+	{
+		const CullAabbs4& aabbs = _aabbs[ii];
+		const bx::simd128_t cx = bx::simd_ld(aabbs.m_centerX);
+		const bx::simd128_t cy = bx::simd_ld(aabbs.m_centerY);
+		const bx::simd128_t cz = bx::simd_ld(aabbs.m_centerZ);
+		const bx::simd128_t ex = bx::simd_ld(aabbs.m_extentX);
+		const bx::simd128_t ey = bx::simd_ld(aabbs.m_extentY);
+		const bx::simd128_t ez = bx::simd_ld(aabbs.m_extentZ);
+
+		bx::simd128_t outside = zero;
+		for (uint32_t jj = 0; jj < 6; ++jj)
+		{
+			// dot(n, c) + d + dot(|n|, e) < 0, the corner furthest along n is outside.
+			bx::simd128_t dist = bx::simd_madd(cx, planes.m_x[jj], planes.m_w[jj]);
+			dist = bx::simd_madd(cy, planes.m_y[jj], dist);
+			dist = bx::simd_madd(cz, planes.m_z[jj], dist);
+
+			bx::simd128_t radius = bx::simd_mul(ex, planes.m_absX[jj]);
+			radius = bx::simd_madd(ey, planes.m_absY[jj], radius);
+			radius = bx::simd_madd(ez, planes.m_absZ[jj], radius);
+
+			outside = bx::simd_or(outside, bx::simd_cmplt(bx::simd_add(dist, radius), zero) );
+		}
+
+		_outMask[ii] = toVisibleMask(outside);
+	}
+}
+
+bx::Sphere cullTransformSphere(const bx::Sphere& _sphere, const float* _mtx)
+{
+	const float scaleX = bx::length(bx::Vec3{ _mtx[0], _mtx[1], _mtx[ 2] });
+	const float scaleY = bx::length(bx::Vec3{ _mtx[4], _mtx[5], _mtx[ 6] });
+	const float scaleZ = bx::length(bx::Vec3{ _mtx[8], _mtx[9], _mtx[10] });
+
+	bx::Sphere result;
+	result.center = bx::mul(_sphere.center, _mtx);
+	result.radius = _sphere.radius * bx::max(scaleX, bx::max(scaleY, scaleZ) );
+	return result;
+}
+
+bx::Aabb cullTransformAabb(const bx::Aabb& _aabb, const float* _mtx)
+{
+	const bx::Vec3 center = bx::mul(bx::add(_aabb.min, _aabb.max), 0.5f);
+	const bx::Vec3 extent = bx::mul(bx::sub(_aabb.max, _aabb.min), 0.5f);
+
+	// Each world axis extent sums the absolute contributions of the local axes.
+	const bx::Vec3 worldCenter = bx::mul(center, _mtx);
+	const bx::Vec3 worldExtent =
+	{
+		bx::abs(_mtx[0])*extent.x + bx::abs(_mtx[4])*extent.y + bx::abs(_mtx[ 8])*extent.z,
+		bx::abs(_mtx[1])*extent.x + bx::abs(_mtx[5])*extent.y + bx::abs(_mtx[ 9])*extent.z,
+		bx::abs(_mtx[2])*extent.x + bx::abs(_mtx[6])*extent.y + bx::abs(_mtx[10])*extent.z,
+	};
+
+	return { bx::sub(worldCenter, worldExtent), bx::add(worldCenter, worldExtent) };
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_FRUSTUM_CULL_H_HEADER_GUARD
+#define PROTOTYPE_FRUSTUM_CULL_H_HEADER_GUARD
+
+#include <bx/bx.h>
+#include <bx/bounds.h>
+
+// View frustum as six planes, xyz normal pointing inside and w distance. A point p is
+// inside a plane if dot(xyz, p) + w >= 0.
+struct Frustum
+{
+	float m_planes[6][4];
+};
+
+// Extracts the planes from a bx view projection matrix. _homogeneousDepth is
+// bgfx::Caps::homogeneousDepth, the near plane is at z = -w instead of z = 0.
+void frustumFromViewProj(Frustum& _frustum, const float* _viewProj, bool _homogeneousDepth);
+
+// Four bounding volumes in structure-of-arrays layout, the unit the tests below process
+// per SIMD instruction. Unused lanes may hold anything, their result is ignored.
+struct CullSpheres4
+{
+	BX_ALIGN_DECL_16(float m_x[4]);
+	BX_ALIGN_DECL_16(float m_y[4]);
+	BX_ALIGN_DECL_16(float m_z[4]);
+	BX_ALIGN_DECL_16(float m_radius[4]);
+};
+
+struct CullAabbs4
+{
+	BX_ALIGN_DECL_16(float m_centerX[4]);
+	BX_ALIGN_DECL_16(float m_centerY[4]);
+	BX_ALIGN_DECL_16(float m_centerZ[4]);
+	BX_ALIGN_DECL_16(float m_extentX[4]);
+	BX_ALIGN_DECL_16(float m_extentY[4]);
+	BX_ALIGN_DECL_16(float m_extentZ[4]);
+};
+
+// Writes one mask per block of four to _outMask, bit ii set if volume ii intersects the
+// frustum. Conservative, volumes crossing two planes outside a corner are kept.
+void frustumCullSpheres(uint8_t* _outMask, const Frustum& _frustum, const CullSpheres4* _spheres, uint32_t _numBlocks);
+void frustumCullAabbs(uint8_t* _outMask, const Frustum& _frustum, const CullAabbs4* _aabbs, uint32_t _numBlocks);
+
+// World space bounds of _sphere and _aabb transformed by the bx matrix _mtx. The sphere
+// radius grows with the largest axis scale, the box is refit around the rotated box.
+bx::Sphere cullTransformSphere(const bx::Sphere& _sphere, const float* _mtx);
+bx::Aabb cullTransformAabb(const bx::Aabb& _aabb, const float* _mtx);
+
+#endif // PROTOTYPE_FRUSTUM_CULL_H_HEADER_GUARD
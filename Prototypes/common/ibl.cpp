@@ -0,0 +1,825 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "ibl.h"
+#include "bxdfs.h"
+#include "job_system.h"
+
+#include <bx/hash.h>
+
+namespace
+{
+	constexpr uint32_t kMagic = BX_MAKEFOURCC('I', 'B', 'L', 1);
+
+	// Bump whenever the prefilter integrand, the sample sets or the texel layout change,
+	// caches from before are rebuilt instead of silently reused.
+	constexpr uint32_t kVersion = 1;
+
+	// Rows of one side and mip are grouped into jobs of at least this many texels.
+	constexpr uint32_t kTexelsPerJob = 1024;
+
+	struct IblHeader
+	{
+		uint32_t m_magic;
+		uint32_t m_version;
+		uint32_t m_hash;
+		uint32_t m_specularSize;
+		uint32_t m_irradianceSize;
+		uint32_t m_numSamples;
+		uint32_t m_numIrradianceSamples;
+	};
+
+	// Sample directions around +z for one output mip, structure of arrays and padded
+	// to a multiple of 8 with zero weights.
+	struct IblSamples
+	{
+		std::vector<float> m_x;
+		std::vector<float> m_y;
+		std::vector<float> m_z;
+		std::vector<float> m_weight;
+
+		// Source mip each sample reads.
+		std::vector<uint8_t> m_mip;
+
+		float m_invTotalWeight;
+	};
+
+	// Rows of one side per spherical harmonics job.
+	constexpr uint32_t kShRowsPerJob = 8;
+
+	// L2 harmonics can't tell a box filtered mip of this size from mip 0.
+	constexpr uint16_t kShMaxSize = 128;
+
+	struct PrefilterJob
+	{
+		IblCubemap* m_cube;
+		const IblSamples* m_samples;
+		uint8_t  m_mip;
+		uint8_t  m_side;
+		uint16_t m_begin;
+		uint16_t m_end;
+	};
+
+	uint32_t getNumSamples(uint32_t _num)
+	{
+		return bx::max<uint32_t>( (_num + 7) & ~7u, 8);
+	}
+
+	// Direction through (_u, _v) in [0, 1] of _side, bgfx cubemap convention.
+	bx::Vec3 texelToDir(uint8_t _side, float _u, float _v)
+	{
+		const float ss = _u*2.0f - 1.0f;
+		const float tt = _v*2.0f - 1.0f;
+
+		switch (_side)
+		{
+		case 0:  return bx::normalize(bx::Vec3{  1.0f,   -tt,   -ss });
+		case 1:  return bx::normalize(bx::Vec3{ -1.0f,   -tt,    ss });
+		case 2:  return bx::normalize(bx::Vec3{    ss,  1.0f,    tt });
+		case 3:  return bx::normalize(bx::Vec3{    ss, -1.0f,   -tt });
+		case 4:  return bx::normalize(bx::Vec3{    ss,   -tt,  1.0f });
+		default: return bx::normalize(bx::Vec3{   -ss,   -tt, -1.0f });
+		}
+	}
+
+	// Inverse of texelToDir(), _x, _y, _z don't need to be normalized.
+	void dirToTexel(uint8_t& _outSide, float& _outU, float& _outV, float _x, float _y, float _z)
+	{
+		const float ax = bx::abs(_x);
+		const float ay = bx::abs(_y);
+		const float az = bx::abs(_z);
+
+		float major;
+		float ss;
+		float tt;
+
+		if (ax >= ay
+		&&  ax >= az)
+		{
+			major    = ax;
+			_outSide = 0.0f <= _x ? 0 : 1;
+			ss       = 0.0f <= _x ? -_z : _z;
+			tt       = -_y;
+		}
+		else if (ay >= az)
+		{
+			major    = ay;
+			_outSide = 0.0f <= _y ? 2 : 3;
+			ss       = _x;
+			tt       = 0.0f <= _y ? _z : -_z;
+		}
+		else
+		{
+			major    = az;
+			_outSide = 0.0f <= _z ? 4 : 5;
+			ss       = 0.0f <= _z ? _x : -_x;
+			tt       = -_y;
+		}
+
+		_outU = (ss/major + 1.0f)*0.5f;
+		_outV = (tt/major + 1.0f)*0.5f;
+	}
+
+	// Bilinear fetch of an RGBA float image. Columns wrap if _wrapX, rows always clamp.
+	void sampleBilinear(float* _outRgba, const float* _texels, uint32_t _width, uint32_t _height, float _u, float _v, bool _wrapX)
+	{
+		const float xx = _u*float(_width)  - 0.5f;
+		const float yy = _v*float(_height) - 0.5f;
+		const float x0 = bx::floor(xx);
+		const float y0 = bx::floor(yy);
+		const float fx = xx - x0;
+		const float fy = yy - y0;
+
+		const int32_t maxX = int32_t(_width)  - 1;
+		const int32_t maxY = int32_t(_height) - 1;
+
+		int32_t ix0 = int32_t(x0);
+		int32_t ix1 = ix0 + 1;
+		if (_wrapX)
+		{
+			ix0 = (ix0 + int32_t(_width) ) % int32_t(_width);
+			ix1 = ix1 % int32_t(_width);
+		}
+		else
+		{
+			ix0 = bx::clamp(ix0, 0, maxX);
+			ix1 = bx::clamp(ix1, 0, maxX);
+		}
+
+		const int32_t iy0 = bx::clamp(int32_t(y0),     0, maxY);
+		const int32_t iy1 = bx::clamp(int32_t(y0) + 1, 0, maxY);
+
+		const float* t00 = &_texels[(iy0*_width + ix0)*4];
+		const float* t10 = &_texels[(iy0*_width + ix1)*4];
+		const float* t01 = &_texels[(iy1*_width + ix0)*4];
+		const float* t11 = &_texels[(iy1*_width + ix1)*4];
+
+		for (uint32_t cc = 0; cc < 4; ++cc)
+		{
+			const float top    = bx::lerp(t00[cc], t10[cc], fx);
+			const float bottom = bx::lerp(t01[cc], t11[cc], fx);
+			_outRgba[cc] = bx::lerp(top, bottom, fy);
+		}
+	}
+
+	// Bilinear within one face, clamped at the face edges.
+	void sampleCube(float* _outRgba, const IblCubemap& _cube, uint8_t _mip, float _x, float _y, float _z)
+	{
+		uint8_t side;
+		float uu;
+		float vv;
+		dirToTexel(side, uu, vv, _x, _y, _z);
+
+		const uint16_t size = _cube.getMipSize(_mip);
+		sampleBilinear(_outRgba, _cube.getFace(side, _mip), size, size, uu, vv, false);
+	}
+
+	// Source mip whose texels match the solid angle a sample stands for, GPU Gems 3
+	// chapter 20.4 with its +1 bias. Never finer than the output's own texels.
+	uint8_t selectMip(float _sampleSolidAngle, const IblCubemap& _source, uint16_t _size)
+	{
+		const float sourceSize      = float(_source.m_size);
+		const float texelSolidAngle = 4.0f*bx::kPi / (6.0f*sourceSize*sourceSize);
+
+		const float lod    = 0.5f*bx::log2(_sampleSolidAngle / texelSolidAngle) + 1.0f;
+		const float minLod = bx::max(bx::log2(sourceSize / float(_size) ), 0.0f);
+
+		return uint8_t(bx::clamp(bx::round(bx::max(lod, minLod) ), 0.0f, float(_source.m_numMips - 1) ) );
+	}
+
+	void addSample(IblSamples& _samples, const bx::Vec3& _dir, float _weight, uint8_t _mip)
+	{
+		_samples.m_x.push_back(_dir.x);
+		_samples.m_y.push_back(_dir.y);
+		_samples.m_z.push_back(_dir.z);
+		_samples.m_weight.push_back(_weight);
+		_samples.m_mip.push_back(_mip);
+	}
+
+	void finishSamples(IblSamples& _samples)
+	{
+		float totalWeight = 0.0f;
+		for (const float weight : _samples.m_weight)
+		{
+			totalWeight += weight;
+		}
+
+		while (0 != (_samples.m_x.size() & 7) )
+		{
+			addSample(_samples, { 0.0f, 0.0f, 1.0f }, 0.0f, 0);
+		}
+
+		_samples.m_invTotalWeight = 1.0f / totalWeight;
+	}
+
+	// GGX lobe around N = V = R, weighted by NdotL. Split sum assumption, the view
+	// dependent part lives in the DFG table.
+	void createSpecularSamples(IblSamples& _outSamples, float _roughness, uint32_t _num, const IblCubemap& _source, uint16_t _size)
+	{
+		if (0.0f == _roughness)
+		{
+			addSample(_outSamples, { 0.0f, 0.0f, 1.0f }, 1.0f, selectMip(0.0f, _source, _size) );
+			finishSamples(_outSamples);
+			return;
+		}
+
+		const float alpha  = _roughness*_roughness;
+		const float alpha2 = alpha*alpha;
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const float phi    = bx::kPi2 * (float(ii) + 0.5f) / float(_num);
+			const float xi     = bxdfRadicalInverse(ii);
+			const float NdotH2 = (1.0f - xi) / ( (alpha2 - 1.0f)*xi + 1.0f);
+			const float NdotH  = bx::sqrt(NdotH2);
+			const float sinH   = bx::sqrt(bx::max(1.0f - NdotH2, 0.0f) );
+
+			// L = reflect(-N, H).
+			const bx::Vec3 dir =
+			{
+				2.0f*NdotH*sinH*bx::cos(phi),
+				2.0f*NdotH*sinH*bx::sin(phi),
+				2.0f*NdotH2 - 1.0f,
+			};
+
+			if (0.0f < dir.z)
+			{
+				// With N = V the pdf of L is D/4, D_GGX() leaves out the 1/PI.
+				const float pdf = D_GGX(NdotH, alpha) / (4.0f*bx::kPi);
+				addSample(_outSamples, dir, dir.z, selectMip(1.0f / (float(_num)*pdf), _source, _size) );
+			}
+		}
+
+		finishSamples(_outSamples);
+	}
+
+	// Cosine distributed, the pdf cancels the cosine.
+	void createIrradianceSamples(IblSamples& _outSamples, uint32_t _num, const IblCubemap& _source, uint16_t _size)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const float phi      = bx::kPi2 * (float(ii) + 0.5f) / float(_num);
+			const float xi       = bxdfRadicalInverse(ii);
+			const float sinTheta = bx::sqrt(xi);
+			const float cosTheta = bx::sqrt(1.0f - xi);
+
+			const bx::Vec3 dir =
+			{
+				sinTheta*bx::cos(phi),
+				sinTheta*bx::sin(phi),
+				cosTheta,
+			};
+
+			const float pdf = cosTheta / bx::kPi;
+			addSample(_outSamples, dir, 1.0f, selectMip(1.0f / (float(_num)*pdf), _source, _size) );
+		}
+
+		finishSamples(_outSamples);
+	}
+
+	// Rotates the samples into N's tangent frame eight at a time, then fetches them.
+	void prefilterTexel(float* _outRgba, const bx::Vec3& _normal, const IblSamples& _samples, const IblCubemap& _source)
+	{
+		const bx::Vec3 up = bx::abs(_normal.z) < 0.999f
+			? bx::Vec3{ 0.0f, 0.0f, 1.0f }
+			: bx::Vec3{ 1.0f, 0.0f, 0.0f }
+			;
+		const bx::Vec3 tangent   = bx::normalize(bx::cross(up, _normal) );
+		const bx::Vec3 bitangent = bx::cross(_normal, tangent);
+
+		const SimdFloat8 tx(tangent.x);
+		const SimdFloat8 ty(tangent.y);
+		const SimdFloat8 tz(tangent.z);
+		const SimdFloat8 btx(bitangent.x);
+		const SimdFloat8 bty(bitangent.y);
+		const SimdFloat8 btz(bitangent.z);
+		const SimdFloat8 nx(_normal.x);
+		const SimdFloat8 ny(_normal.y);
+		const SimdFloat8 nz(_normal.z);
+
+		float rgba[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		const uint32_t num = uint32_t(_samples.m_x.size() );
+		for (uint32_t ii = 0; ii < num; ii += 8)
+		{
+			const SimdFloat8 sx = bxdfLoad<SimdFloat8>(&_samples.m_x[ii]);
+			const SimdFloat8 sy = bxdfLoad<SimdFloat8>(&_samples.m_y[ii]);
+			const SimdFloat8 sz = bxdfLoad<SimdFloat8>(&_samples.m_z[ii]);
+
+			float dirX[8];
+			float dirY[8];
+			float dirZ[8];
+			bxdfStore(dirX, tx*sx + btx*sy + nx*sz);
+			bxdfStore(dirY, ty*sx + bty*sy + ny*sz);
+			bxdfStore(dirZ, tz*sx + btz*sy + nz*sz);
+
+			for (uint32_t lane = 0; lane < 8; ++lane)
+			{
+				const float weight = _samples.m_weight[ii + lane];
+				if (0.0f == weight)
+				{
+					continue;
+				}
+
+				float texel[4];
+				sampleCube(texel, _source, _samples.m_mip[ii + lane], dirX[lane], dirY[lane], dirZ[lane]);
+
+				for (uint32_t cc = 0; cc < 3; ++cc)
+				{
+					rgba[cc] += texel[cc]*weight;
+				}
+			}
+		}
+
+		_outRgba[0] = rgba[0]*_samples.m_invTotalWeight;
+		_outRgba[1] = rgba[1]*_samples.m_invTotalWeight;
+		_outRgba[2] = rgba[2]*_samples.m_invTotalWeight;
+		_outRgba[3] = 1.0f;
+	}
+
+	void addJobs(std::vector<PrefilterJob>& _outJobs, IblCubemap& _cube, uint8_t _mip, const IblSamples& _samples)
+	{
+		const uint16_t size    = _cube.getMipSize(_mip);
+		const uint16_t numRows = uint16_t(bx::max<uint32_t>(kTexelsPerJob / size, 1) );
+
+		for (uint8_t side = 0; side < 6; ++side)
+		{
+			for (uint32_t begin = 0; begin < size; begin += numRows)
+			{
+				PrefilterJob job;
+				job.m_cube    = &_cube;
+				job.m_samples = &_samples;
+				job.m_mip     = _mip;
+				job.m_side    = side;
+				job.m_begin   = uint16_t(begin);
+				job.m_end     = uint16_t(bx::min<uint32_t>(begin + numRows, size) );
+				_outJobs.push_back(job);
+			}
+		}
+	}
+
+	void runJob(const PrefilterJob& _job, const IblCubemap& _source)
+	{
+		const uint16_t size = _job.m_cube->getMipSize(_job.m_mip);
+		float* face = _job.m_cube->getFace(_job.m_side, _job.m_mip);
+
+		for (uint32_t yy = _job.m_begin; yy < _job.m_end; ++yy)
+		{
+			for (uint32_t xx = 0; xx < size; ++xx)
+			{
+				const bx::Vec3 normal = texelToDir(_job.m_side
+					, (float(xx) + 0.5f) / float(size)
+					, (float(yy) + 0.5f) / float(size)
+					);
+				prefilterTexel(&face[(yy*size + xx)*4], normal, *_job.m_samples, _source);
+			}
+		}
+	}
+
+	// Unnormalized direction through (_s, _t) in [-1, 1] of _side, see texelToDir().
+	template<typename T>
+	void faceToDir(T& _outX, T& _outY, T& _outZ, uint8_t _side, T _s, T _t)
+	{
+		const T one(1.0f);
+
+		switch (_side)
+		{
+		case 0:  _outX =  one; _outY = -_t;  _outZ = -_s;  break;
+		case 1:  _outX = -one; _outY = -_t;  _outZ =  _s;  break;
+		case 2:  _outX =  _s;  _outY =  one; _outZ =  _t;  break;
+		case 3:  _outX =  _s;  _outY = -one; _outZ = -_t;  break;
+		case 4:  _outX =  _s;  _outY = -_t;  _outZ =  one; break;
+		default: _outX = -_s;  _outY = -_t;  _outZ = -one; break;
+		}
+	}
+
+	// Radiance times basis times solid angle, summed over rows [_begin, _end) of _side.
+	void projectRows(IblSh& _outSh, const IblCubemap& _source, uint8_t _side, uint8_t _mip, uint32_t _begin, uint32_t _end)
+	{
+		const uint32_t size = _source.getMipSize(_mip);
+		const float* face = _source.getFace(_side, _mip);
+		const float texelSize = 2.0f / float(size);
+
+		SimdFloat8 sums[9][3];
+		for (uint32_t ii = 0; ii < 9; ++ii)
+		{
+			sums[ii][0] = sums[ii][1] = sums[ii][2] = SimdFloat8(0.0f);
+		}
+
+		for (uint32_t yy = _begin; yy < _end; ++yy)
+		{
+			const SimdFloat8 tt( (float(yy) + 0.5f)*texelSize - 1.0f);
+
+			for (uint32_t xx = 0; xx < size; xx += 8)
+			{
+				// Lanes past the row edge have no radiance.
+				float ss[8];
+				float red[8];
+				float green[8];
+				float blue[8];
+				for (uint32_t lane = 0; lane < 8; ++lane)
+				{
+					const bool inside = xx + lane < size;
+					const float* texel = &face[(yy*size + bx::min(xx + lane, size - 1) )*4];
+
+					ss[lane]    = (float(xx + lane) + 0.5f)*texelSize - 1.0f;
+					red[lane]   = inside ? texel[0] : 0.0f;
+					green[lane] = inside ? texel[1] : 0.0f;
+					blue[lane]  = inside ? texel[2] : 0.0f;
+				}
+
+				const SimdFloat8 sv = bxdfLoad<SimdFloat8>(ss);
+
+				SimdFloat8 dx;
+				SimdFloat8 dy;
+				SimdFloat8 dz;
+				faceToDir(dx, dy, dz, _side, sv, tt);
+
+				// Texel solid angle is texelSize^2 / (1 + s^2 + t^2)^(3/2).
+				const SimdFloat8 invLength  = SimdFloat8(1.0f) / bxdfSqrt(SimdFloat8(1.0f) + sv*sv + tt*tt);
+				const SimdFloat8 solidAngle = SimdFloat8(texelSize*texelSize) * invLength*invLength*invLength;
+
+				const SimdFloat8 nx = dx*invLength;
+				const SimdFloat8 ny = dy*invLength;
+				const SimdFloat8 nz = dz*invLength;
+
+				const SimdFloat8 basis[9] =
+				{
+					SimdFloat8(0.282095f),
+					SimdFloat8(0.488603f)*ny,
+					SimdFloat8(0.488603f)*nz,
+					SimdFloat8(0.488603f)*nx,
+					SimdFloat8(1.092548f)*nx*ny,
+					SimdFloat8(1.092548f)*ny*nz,
+					SimdFloat8(0.315392f)*(SimdFloat8(3.0f)*nz*nz - SimdFloat8(1.0f) ),
+					SimdFloat8(1.092548f)*nx*nz,
+					SimdFloat8(0.546274f)*(nx*nx - ny*ny),
+				};
+
+				const SimdFloat8 rr = bxdfLoad<SimdFloat8>(red)   * solidAngle;
+				const SimdFloat8 gg = bxdfLoad<SimdFloat8>(green) * solidAngle;
+				const SimdFloat8 bb = bxdfLoad<SimdFloat8>(blue)  * solidAngle;
+
+				for (uint32_t ii = 0; ii < 9; ++ii)
+				{
+					sums[ii][0] = sums[ii][0] + basis[ii]*rr;
+					sums[ii][1] = sums[ii][1] + basis[ii]*gg;
+					sums[ii][2] = sums[ii][2] + basis[ii]*bb;
+				}
+			}
+		}
+
+		for (uint32_t ii = 0; ii < 9; ++ii)
+		{
+			for (uint32_t cc = 0; cc < 3; ++cc)
+			{
+				_outSh.m_coeffs[ii][cc] = bxdfSumLanes(sums[ii][cc]);
+			}
+		}
+	}
+
+} // namespace
+
+IblCubemap::IblCubemap()
+	: m_size(0)
+	, m_numMips(0)
+	, m_sideStride(0)
+{
+}
+
+void IblCubemap::init(uint16_t _size, bool _hasMips)
+{
+	m_size    = _size;
+	m_numMips = 1;
+
+	if (_hasMips)
+	{
+		for (uint32_t size = _size; 1 < size; size /= 2)
+		{
+			++m_numMips;
+		}
+	}
+
+	m_mipOffsets.resize(m_numMips);
+	m_sideStride = 0;
+	for (uint8_t mip = 0; mip < m_numMips; ++mip)
+	{
+		const uint32_t size = getMipSize(mip);
+		m_mipOffsets[mip] = m_sideStride;
+		m_sideStride += size*size*4;
+	}
+
+	m_texels.resize(m_sideStride*6);
+}
+
+uint16_t IblCubemap::getMipSize(uint8_t _mip) const
+{
+	return uint16_t(bx::max<uint32_t>(m_size >> _mip, 1) );
+}
+
+float* IblCubemap::getFace(uint8_t _side, uint8_t _mip)
+{
+	return &m_texels[_side*m_sideStride + m_mipOffsets[_mip] ];
+}
+
+const float* IblCubemap::getFace(uint8_t _side, uint8_t _mip) const
+{
+	return &m_texels[_side*m_sideStride + m_mipOffsets[_mip] ];
+}
+
+IblPrefilterDesc::IblPrefilterDesc()
+	: m_specularSize(128)
+	, m_irradianceSize(32)
+	, m_numSamples(64)
+	, m_numIrradianceSamples(256)
+{
+}
+
+void iblEquirectToCubemap(IblCubemap& _outCube, const float* _rgba, uint32_t _width, uint32_t _height, uint16_t _size, JobSystem* _jobs)
+{
+	_outCube.init(_size, true);
+
+	jobSystemParallelFor(_jobs, 6*_size, [&](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t row = _begin; row < _end; ++row)
+		{
+			const uint8_t side = uint8_t(row / _size);
+			const uint32_t yy  = row % _size;
+			float* face = _outCube.getFace(side, 0);
+
+			for (uint32_t xx = 0; xx < _size; ++xx)
+			{
+				const bx::Vec3 dir = texelToDir(side
+					, (float(xx) + 0.5f) / float(_size)
+					, (float(yy) + 0.5f) / float(_size)
+					);
+
+				const float uu = 0.5f + bx::atan2(dir.z, dir.x) / bx::kPi2;
+				const float vv = bx::acos(bx::clamp(dir.y, -1.0f, 1.0f) ) / bx::kPi;
+				sampleBilinear(&face[(yy*_size + xx)*4], _rgba, _width, _height, uu, vv, true);
+			}
+		}
+	});
+
+	iblGenerateMips(_outCube, _jobs);
+}
+
+void iblGenerateMips(IblCubemap& _cube, JobSystem* _jobs)
+{
+	jobSystemParallelFor(_jobs, 6, [&](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t side = _begin; side < _end; ++side)
+		{
+			for (uint8_t mip = 1; mip < _cube.m_numMips; ++mip)
+			{
+				const uint32_t srcSize = _cube.getMipSize(mip - 1);
+				const uint32_t dstSize = _cube.getMipSize(mip);
+				const float* src = _cube.getFace(uint8_t(side), mip - 1);
+				float* dst = _cube.getFace(uint8_t(side), mip);
+
+				for (uint32_t yy = 0; yy < dstSize; ++yy)
+				{
+					for (uint32_t xx = 0; xx < dstSize; ++xx)
+					{
+						const float* t00 = &src[( (yy*2    )*srcSize + xx*2    )*4];
+						const float* t10 = &src[( (yy*2    )*srcSize + xx*2 + 1)*4];
+						const float* t01 = &src[( (yy*2 + 1)*srcSize + xx*2    )*4];
+						const float* t11 = &src[( (yy*2 + 1)*srcSize + xx*2 + 1)*4];
+
+						for (uint32_t cc = 0; cc < 4; ++cc)
+						{
+							dst[(yy*dstSize + xx)*4 + cc] = (t00[cc] + t10[cc] + t01[cc] + t11[cc])*0.25f;
+						}
+					}
+				}
+			}
+		}
+	});
+}
+
+void iblCreateSky(std::vector<float>& _outRgba, uint32_t _width, uint32_t _height)
+{
+	const bx::Vec3 zenith  = { 0.20f, 0.40f, 0.95f };
+	const bx::Vec3 horizon = { 1.00f, 0.90f, 0.75f };
+	const bx::Vec3 ground  = { 0.25f, 0.22f, 0.20f };
+	const bx::Vec3 sunDir  = bx::normalize(bx::Vec3{ 0.6f, 0.5f, 0.4f });
+
+	_outRgba.resize(_width*_height*4);
+
+	for (uint32_t yy = 0; yy < _height; ++yy)
+	{
+		const float theta = (float(yy) + 0.5f) / float(_height) * bx::kPi;
+
+		for (uint32_t xx = 0; xx < _width; ++xx)
+		{
+			const float phi = ( (float(xx) + 0.5f) / float(_width) - 0.5f) * bx::kPi2;
+			const bx::Vec3 dir =
+			{
+				bx::sin(theta)*bx::cos(phi),
+				bx::cos(theta),
+				bx::sin(theta)*bx::sin(phi),
+			};
+
+			bx::Vec3 color = 0.0f <= dir.y
+				? bx::lerp(horizon, zenith, bx::sqrt(dir.y) )
+				: bx::lerp(horizon, ground, bx::min(-dir.y*4.0f, 1.0f) )
+				;
+
+			// Soft sun, a hard disc would need far more samples to converge.
+			const float sun = bx::max(bx::dot(dir, sunDir), 0.0f);
+			color = bx::add(color, 50.0f*bx::pow(sun, 512.0f) + 0.5f*bx::pow(sun, 16.0f) );
+
+			float* texel = &_outRgba[(yy*_width + xx)*4];
+			texel[0] = color.x;
+			texel[1] = color.y;
+			texel[2] = color.z;
+			texel[3] = 1.0f;
+		}
+	}
+}
+
+void iblPrefilter(IblCubemap& _outSpecular, IblCubemap& _outIrradiance, const IblCubemap& _source, const IblPrefilterDesc& _desc, JobSystem* _jobs)
+{
+	_outSpecular.init(_desc.m_specularSize, true);
+	_outIrradiance.init(_desc.m_irradianceSize, false);
+
+	// One sample set per specular mip and one for irradiance.
+	std::vector<IblSamples> samples(_outSpecular.m_numMips + 1);
+
+	const uint8_t lastMip = uint8_t(_outSpecular.m_numMips - 1);
+	for (uint8_t mip = 0; mip <= lastMip; ++mip)
+	{
+		const float roughness = 0 != lastMip ? float(mip) / float(lastMip) : 0.0f;
+		createSpecularSamples(samples[mip], roughness, getNumSamples(_desc.m_numSamples), _source, _outSpecular.getMipSize(mip) );
+	}
+
+	createIrradianceSamples(samples[_outSpecular.m_numMips], getNumSamples(_desc.m_numIrradianceSamples), _source, _desc.m_irradianceSize);
+
+	std::vector<PrefilterJob> jobs;
+	for (uint8_t mip = 0; mip <= lastMip; ++mip)
+	{
+		addJobs(jobs, _outSpecular, mip, samples[mip]);
+	}
+	addJobs(jobs, _outIrradiance, 0, samples[_outSpecular.m_numMips]);
+
+	jobSystemParallelFor(_jobs, uint32_t(jobs.size() ), [&](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			runJob(jobs[ii], _source);
+		}
+	});
+}
+
+void iblProjectSh(IblSh& _outSh, const IblCubemap& _source, JobSystem* _jobs)
+{
+	uint8_t mip = 0;
+	while (mip + 1 < _source.m_numMips
+	&&     _source.getMipSize(mip) > kShMaxSize)
+	{
+		++mip;
+	}
+
+	const uint16_t size = _source.getMipSize(mip);
+	const uint32_t jobsPerSide = (size + kShRowsPerJob - 1) / kShRowsPerJob;
+
+	std::vector<IblSh> partials(6*jobsPerSide);
+	jobSystemParallelFor(_jobs, uint32_t(partials.size() ), [&](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			const uint32_t begin = (ii % jobsPerSide)*kShRowsPerJob;
+			const uint32_t end   = bx::min<uint32_t>(begin + kShRowsPerJob, size);
+			projectRows(partials[ii], _source, uint8_t(ii / jobsPerSide), mip, begin, end);
+		}
+	});
+
+	// Cosine lobe convolution per band (PI, 2PI/3, PI/4), divided by PI.
+	const float bandScale[9] =
+	{
+		1.0f,
+		2.0f/3.0f, 2.0f/3.0f, 2.0f/3.0f,
+		0.25f, 0.25f, 0.25f, 0.25f, 0.25f,
+	};
+
+	for (uint32_t ii = 0; ii < 9; ++ii)
+	{
+		for (uint32_t cc = 0; cc < 3; ++cc)
+		{
+			float sum = 0.0f;
+			for (const IblSh& partial : partials)
+			{
+				sum += partial.m_coeffs[ii][cc];
+			}
+
+			_outSh.m_coeffs[ii][cc] = sum*bandScale[ii];
+		}
+	}
+}
+
+uint32_t iblHash(const IblCubemap& _source, const IblPrefilterDesc& _desc)
+{
+	bx::HashMurmur2A hash;
+	hash.begin(kMagic);
+	hash.add(kVersion);
+	hash.add(_desc.m_specularSize);
+	hash.add(_desc.m_irradianceSize);
+	hash.add(getNumSamples(_desc.m_numSamples) );
+	hash.add(getNumSamples(_desc.m_numIrradianceSamples) );
+	hash.add(_source.m_size);
+
+	// The rest of the chain is derived from mip 0.
+	for (uint8_t side = 0; side < 6; ++side)
+	{
+		hash.add(_source.getFace(side, 0), int32_t(_source.m_size*_source.m_size*4*sizeof(float) ) );
+	}
+
+	return hash.end();
+}
+
+bool iblWrite(bx::WriterI* _writer, uint32_t _hash, const IblPrefilterDesc& _desc, const IblCubemap& _specular, const IblCubemap& _irradiance, bx::Error* _err)
+{
+	IblHeader header;
+	header.m_magic                = kMagic;
+	header.m_version              = kVersion;
+	header.m_hash                 = _hash;
+	header.m_specularSize         = _desc.m_specularSize;
+	header.m_irradianceSize       = _desc.m_irradianceSize;
+	header.m_numSamples           = getNumSamples(_desc.m_numSamples);
+	header.m_numIrradianceSamples = getNumSamples(_desc.m_numIrradianceSamples);
+	bx::write(_writer, header, _err);
+
+	std::vector<uint16_t> texels;
+
+	texels.resize(_specular.m_texels.size() );
+	iblToHalf(texels.data(), _specular);
+	bx::write(_writer, texels.data(), int32_t(texels.size()*sizeof(uint16_t) ), _err);
+
+	texels.resize(_irradiance.m_texels.size() );
+	iblToHalf(texels.data(), _irradiance);
+	bx::write(_writer, texels.data(), int32_t(texels.size()*sizeof(uint16_t) ), _err);
+
+	return _err->isOk();
+}
+
+bool iblGetTexels(IblCacheTexels& _outTexels, const MappedFile* _file, uint32_t _hash, const IblPrefilterDesc& _desc)
+{
+	const uint32_t specularSize   = iblGetTexelsSize(_desc.m_specularSize, true);
+	const uint32_t irradianceSize = iblGetTexelsSize(_desc.m_irradianceSize, false);
+
+	if (mappedFileGetSize(_file) != sizeof(IblHeader) + specularSize + irradianceSize)
+	{
+		return false;
+	}
+
+	const uint8_t* data = mappedFileGetData(_file);
+
+	IblHeader header;
+	bx::memCopy(&header, data, sizeof(header) );
+
+	if (kMagic                                       != header.m_magic
+	||  kVersion                                     != header.m_version
+	||  _hash                                        != header.m_hash
+	||  _desc.m_specularSize                         != header.m_specularSize
+	||  _desc.m_irradianceSize                       != header.m_irradianceSize
+	||  getNumSamples(_desc.m_numSamples)            != header.m_numSamples
+	||  getNumSamples(_desc.m_numIrradianceSamples)  != header.m_numIrradianceSamples)
+	{
+		return false;
+	}
+
+	_outTexels.m_specular       = reinterpret_cast<const uint16_t*>(data + sizeof(header) );
+	_outTexels.m_specularSize   = specularSize;
+	_outTexels.m_irradiance     = reinterpret_cast<const uint16_t*>(data + sizeof(header) + specularSize);
+	_outTexels.m_irradianceSize = irradianceSize;
+
+	return true;
+}
+
+void iblToHalf(uint16_t* _outTexels, const IblCubemap& _cube)
+{
+	const uint32_t num = uint32_t(_cube.m_texels.size() );
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		_outTexels[ii] = bx::halfFromFloat(_cube.m_texels[ii]);
+	}
+}
+
+uint32_t iblGetTexelsSize(uint16_t _size, bool _hasMips)
+{
+	uint32_t size = 0;
+	for (uint32_t mipSize = _size; ; mipSize /= 2)
+	{
+		size += mipSize*mipSize*4*sizeof(uint16_t)*6;
+
+		if (!_hasMips
+		||  1 >= mipSize)
+		{
+			break;
+		}
+	}
+
+	return size;
+}
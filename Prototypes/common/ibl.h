@@ -0,0 +1,118 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_IBL_H_HEADER_GUARD
+#define PROTOTYPE_IBL_H_HEADER_GUARD
+
+#include <bx/readerwriter.h>
+
+#include "mapped_file.h"
+
+#include <vector>
+
+class JobSystem;
+
+// Environment prefiltering for image based lighting, on the CPU. Only depends on bx so
+// host tools can use it, creating textures lives in ibl_load.h.
+//
+// The specular cubemap holds GGX prefiltered radiance with roughness = mip/(numMips - 1),
+// alpha = roughness^2 as in fs_lightsbasic.sc, the irradiance cubemap the cosine
+// convolution divided by PI, so diffuse = irradiance * albedo.
+
+// RGBA float cubemap. Sides in bgfx order (+x, -x, +y, -y, +z, -z), each side's mips
+// consecutive, which is the layout bgfx::createTextureCube() takes.
+struct IblCubemap
+{
+	IblCubemap();
+
+	// _hasMips allocates the full chain down to 1x1.
+	void init(uint16_t _size, bool _hasMips);
+
+	uint16_t getMipSize(uint8_t _mip) const;
+
+	float* getFace(uint8_t _side, uint8_t _mip);
+	const float* getFace(uint8_t _side, uint8_t _mip) const;
+
+	uint16_t m_size;
+	uint8_t  m_numMips;
+
+	std::vector<float> m_texels;
+
+	// Float offset of every mip within a side.
+	std::vector<uint32_t> m_mipOffsets;
+	uint32_t m_sideStride;
+};
+
+struct IblPrefilterDesc
+{
+	IblPrefilterDesc();
+
+	uint16_t m_specularSize;
+	uint16_t m_irradianceSize;
+
+	// Importance samples per texel, rounded up to a multiple of 8. Samples read the
+	// source mip matching their solid angle, so few are needed.
+	uint32_t m_numSamples;
+	uint32_t m_numIrradianceSamples;
+};
+
+// Resamples a latitude/longitude RGBA float image into _outCube, mip 0 and the chain.
+// +y is up, u = 0.5 looks down +x.
+void iblEquirectToCubemap(IblCubemap& _outCube, const float* _rgba, uint32_t _width, uint32_t _height, uint16_t _size, JobSystem* _jobs = NULL);
+
+// Box filters mip 0 down the chain, sides in parallel.
+void iblGenerateMips(IblCubemap& _cube, JobSystem* _jobs = NULL);
+
+// Procedural latitude/longitude HDR sky with a sun, for prototypes without an
+// environment file and for benchmarks.
+void iblCreateSky(std::vector<float>& _outRgba, uint32_t _width, uint32_t _height);
+
+// Prefilters _source, which needs its mip chain. Every mip, side and block of rows is
+// one job, samples run in SimdFloat8 lanes. The result doesn't depend on the thread
+// count.
+void iblPrefilter(IblCubemap& _outSpecular, IblCubemap& _outIrradiance, const IblCubemap& _source, const IblPrefilterDesc& _desc, JobSystem* _jobs = NULL);
+
+// L2 spherical harmonics of irradiance/PI, the same scale as the irradiance cubemap.
+// Coefficient order matches light_sh_irradiance() in Lights.sh: (0,0), (1,-1), (1,0),
+// (1,1), (2,-2), (2,-1), (2,0), (2,1), (2,2).
+struct IblSh
+{
+	float m_coeffs[9][3];
+};
+
+// Projects _source onto L2 spherical harmonics and convolves them with the cosine lobe.
+// Reads the first mip no larger than 128^2, so the cost doesn't grow with the source
+// once it has its mip chain. Blocks of rows are jobs with SimdFloat8 lanes over texels,
+// their partial sums are added in a fixed order so the result doesn't depend on the
+// thread count.
+void iblProjectSh(IblSh& _outSh, const IblCubemap& _source, JobSystem* _jobs = NULL);
+
+// Cache key for prefiltering _source with _desc, includes the integrand version.
+uint32_t iblHash(const IblCubemap& _source, const IblPrefilterDesc& _desc);
+
+// Cache file: a small header with the version, key and desc followed by the RGBA16F
+// texels of both cubemaps in bgfx::createTextureCube() layout.
+bool iblWrite(bx::WriterI* _writer, uint32_t _hash, const IblPrefilterDesc& _desc, const IblCubemap& _specular, const IblCubemap& _irradiance, bx::Error* _err);
+
+struct IblCacheTexels
+{
+	const uint16_t* m_specular;
+	uint32_t m_specularSize;
+
+	const uint16_t* m_irradiance;
+	uint32_t m_irradianceSize;
+};
+
+// Points _outTexels into the mapping, false if the file isn't the cache for _hash and
+// _desc.
+bool iblGetTexels(IblCacheTexels& _outTexels, const MappedFile* _file, uint32_t _hash, const IblPrefilterDesc& _desc);
+
+// Converts _cube to RGBA16F, _outTexels holds one half per float of _cube.m_texels.
+void iblToHalf(uint16_t* _outTexels, const IblCubemap& _cube);
+
+// Bytes of RGBA16F texel data for a cubemap of _size.
+uint32_t iblGetTexelsSize(uint16_t _size, bool _hasMips);
+
+#endif // PROTOTYPE_IBL_H_HEADER_GUARD
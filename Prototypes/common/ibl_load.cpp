@@ -0,0 +1,198 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "ibl_load.h"
+
+#include <bx/file.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+#include <vector>
+
+namespace
+{
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+	bool writeCache(const char* _filePath, uint32_t _hash, const IblPrefilterDesc& _desc, const IblCubemap& _specular, const IblCubemap& _irradiance)
+	{
+		const bx::FilePath filePath(_filePath);
+
+		bx::Error err;
+		bx::makeAll(bx::FilePath(filePath.getPath() ), &err);
+
+		bx::FileWriter writer;
+		if (!bx::open(&writer, filePath, false, &err) )
+		{
+			return false;
+		}
+
+		const bool result = iblWrite(&writer, _hash, _desc, _specular, _irradiance, &err);
+		bx::close(&writer);
+
+		return result;
+	}
+
+	const bgfx::Memory* toHalfMemory(const IblCubemap& _cube)
+	{
+		const bgfx::Memory* mem = bgfx::alloc(uint32_t(_cube.m_texels.size()*sizeof(uint16_t) ) );
+		iblToHalf(reinterpret_cast<uint16_t*>(mem->data), _cube);
+		return mem;
+	}
+
+} // namespace
+
+bool iblLoadSource(IblCubemap& _outSource, const char* _filePath, uint16_t _size, JobSystem* _jobs)
+{
+	bimg::ImageContainer* image = imageLoad(_filePath, bgfx::TextureFormat::RGBA32F);
+	if (NULL == image)
+	{
+		return false;
+	}
+
+	if (image->m_cubeMap)
+	{
+		const uint16_t size = uint16_t(image->m_width);
+		_outSource.init(size, true);
+
+		for (uint8_t side = 0; side < 6; ++side)
+		{
+			bimg::ImageMip mip;
+			bimg::imageGetRawData(*image, side, 0, image->m_data, image->m_size, mip);
+			bx::memCopy(_outSource.getFace(side, 0), mip.m_data, size*size*4*sizeof(float) );
+		}
+
+		iblGenerateMips(_outSource, _jobs);
+	}
+	else
+	{
+		bimg::ImageMip mip;
+		bimg::imageGetRawData(*image, 0, 0, image->m_data, image->m_size, mip);
+		iblEquirectToCubemap(_outSource, reinterpret_cast<const float*>(mip.m_data), mip.m_width, mip.m_height, _size, _jobs);
+	}
+
+	bimg::imageFree(image);
+
+	return true;
+}
+
+IblTextures iblLoad(const char* _cacheDir, const IblCubemap& _source, const IblPrefilterDesc& _desc, JobSystem* _jobs, IblLoadStats* _stats)
+{
+	const int64_t start = bx::getHPCounter();
+
+	const uint32_t hash = iblHash(_source, _desc);
+	const double hashTimeMs = toMs(bx::getHPCounter() - start);
+
+	char filePath[512];
+	bx::snprintf(filePath, sizeof(filePath), "%s/ibl_%08x.bin", _cacheDir, hash);
+
+	MappedFile* file = mappedFileOpen(filePath);
+
+	IblCacheTexels texels;
+	const bool cached = NULL != file
+		&& iblGetTexels(texels, file, hash, _desc)
+		;
+
+	const bgfx::Memory* specularMem   = NULL;
+	const bgfx::Memory* irradianceMem = NULL;
+	double prefilterTimeMs = 0.0;
+
+	if (cached)
+	{
+		mappedFileAddRef(file);
+		specularMem = bgfx::makeRef(texels.m_specular, texels.m_specularSize, mappedFileReleaseFn, file);
+
+		mappedFileAddRef(file);
+		irradianceMem = bgfx::makeRef(texels.m_irradiance, texels.m_irradianceSize, mappedFileReleaseFn, file);
+	}
+	else
+	{
+		const int64_t prefilterStart = bx::getHPCounter();
+		IblCubemap specular;
+		IblCubemap irradiance;
+		iblPrefilter(specular, irradiance, _source, _desc, _jobs);
+		prefilterTimeMs = toMs(bx::getHPCounter() - prefilterStart);
+
+		specularMem   = toHalfMemory(specular);
+		irradianceMem = toHalfMemory(irradiance);
+
+		// The mapping must be gone before the file is rewritten.
+		if (NULL != file)
+		{
+			mappedFileRelease(file);
+			file = NULL;
+		}
+
+		if (!writeCache(filePath, hash, _desc, specular, irradiance) )
+		{
+			printf("[ibl] %s: failed to write the cache\n", filePath);
+		}
+	}
+
+	if (NULL != file)
+	{
+		mappedFileRelease(file);
+	}
+
+	IblTextures textures;
+	textures.m_specular = bgfx::createTextureCube(
+		  _desc.m_specularSize
+		, true
+		, 1
+		, bgfx::TextureFormat::RGBA16F
+		, BGFX_SAMPLER_NONE
+		, specularMem
+		);
+	textures.m_irradiance = bgfx::createTextureCube(
+		  _desc.m_irradianceSize
+		, false
+		, 1
+		, bgfx::TextureFormat::RGBA16F
+		, BGFX_SAMPLER_NONE
+		, irradianceMem
+		);
+	textures.m_maxLod = bx::log2(float(_desc.m_specularSize) );
+
+	if (NULL != _stats)
+	{
+		_stats->m_hashTimeMs      = hashTimeMs;
+		_stats->m_prefilterTimeMs = prefilterTimeMs;
+		_stats->m_loadTimeMs      = toMs(bx::getHPCounter() - start);
+		_stats->m_hash            = hash;
+		_stats->m_cached          = cached;
+	}
+
+	return textures;
+}
+
+void iblDestroy(const IblTextures& _textures)
+{
+	bgfx::destroy(_textures.m_specular);
+	bgfx::destroy(_textures.m_irradiance);
+}
+
+void iblLoadStatsPrint(const IblLoadStats& _stats)
+{
+	if (_stats.m_cached)
+	{
+		printf("[ibl] %08x: cached, hash %.3f ms, %.3f ms total\n"
+			, _stats.m_hash
+			, _stats.m_hashTimeMs
+			, _stats.m_loadTimeMs
+			);
+	}
+	else
+	{
+		printf("[ibl] %08x: prefiltered in %.3f ms, hash %.3f ms, %.3f ms total\n"
+			, _stats.m_hash
+			, _stats.m_prefilterTimeMs
+			, _stats.m_hashTimeMs
+			, _stats.m_loadTimeMs
+			);
+	}
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_IBL_LOAD_H_HEADER_GUARD
+#define PROTOTYPE_IBL_LOAD_H_HEADER_GUARD
+
+#include "bgfx_utils.h"
+#include "ibl.h"
+
+struct IblTextures
+{
+	bgfx::TextureHandle m_specular;
+	bgfx::TextureHandle m_irradiance;
+
+	// Specular mip for roughness 1.
+	float m_maxLod;
+};
+
+struct IblLoadStats
+{
+	double m_hashTimeMs;
+
+	// 0 when the cache was used.
+	double m_prefilterTimeMs;
+
+	double m_loadTimeMs;
+	uint32_t m_hash;
+	bool m_cached;
+};
+
+// Loads an HDR environment through bimg as RGBA32F with its mip chain. Cubemaps are
+// taken as is, other images are latitude/longitude and resampled to _size. Sizes must
+// be powers of two. Returns false if the file can't be loaded.
+bool iblLoadSource(IblCubemap& _outSource, const char* _filePath, uint16_t _size, JobSystem* _jobs = NULL);
+
+// Creates the RGBA16F prefiltered cubemaps for _source, cached in _cacheDir under
+// iblHash(). A cache hit is mapped and handed to bgfx::makeRef as is, a miss prefilters
+// on _jobs and writes the cache, creating missing directories. Runs on the thread that
+// owns bgfx.
+IblTextures iblLoad(const char* _cacheDir, const IblCubemap& _source, const IblPrefilterDesc& _desc, JobSystem* _jobs = NULL, IblLoadStats* _stats = NULL);
+
+void iblDestroy(const IblTextures& _textures);
+
+// Prints one `[ibl]` line with the load stats.
+void iblLoadStatsPrint(const IblLoadStats& _stats);
+
+#endif // PROTOTYPE_IBL_LOAD_H_HEADER_GUARD
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "job_system.h"
+
+namespace
+{
+	// Worker the current thread is, for pushing split jobs onto its own deque.
+	thread_local const JobSystem* s_system = NULL;
+	thread_local uint32_t s_worker = UINT32_MAX;
+
+} // namespace
+
+JobSystem::JobSystem()
+	: m_numQueued(0)
+	, m_nextWorker(0)
+	, m_quit(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+	shutdown();
+}
+
+void JobSystem::init(uint32_t _numThreads)
+{
+	BX_ASSERT(m_threads.empty(), "JobSystem is already initialized.");
+
+	if (0 == _numThreads)
+	{
+		const uint32_t numHardwareThreads = std::thread::hardware_concurrency();
+		_numThreads = numHardwareThreads > 1 ? numHardwareThreads - 1 : 1;
+	}
+
+	m_quit = false;
+	m_workers.reserve(_numThreads);
+	for (uint32_t ii = 0; ii < _numThreads; ++ii)
+	{
+		m_workers.emplace_back(new Worker);
+	}
+
+	m_threads.reserve(_numThreads);
+	for (uint32_t ii = 0; ii < _numThreads; ++ii)
+	{
+		m_threads.emplace_back(&JobSystem::workerMain, this, ii);
+	}
+}
+
+void JobSystem::shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_cv.notify_all();
+
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+
+	m_threads.clear();
+	m_workers.clear();
+}
+
+void JobSystem::submit(JobFn&& _job, JobCounter* _counter)
+{
+	if (NULL != _counter)
+	{
+		_counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	push({ std::move(_job), _counter });
+}
+
+void JobSystem::wait(JobCounter& _counter)
+{
+	const uint32_t worker = this == s_system ? s_worker : UINT32_MAX;
+
+	while (0 != _counter.m_pending.load(std::memory_order_acquire) )
+	{
+		Job job;
+		if ( (UINT32_MAX != worker && pop(worker, job, &_counter) )
+		||  steal(worker, job, &_counter) )
+		{
+			execute(job);
+		}
+		else
+		{
+			// The rest of the group is running on other threads.
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::parallelFor(uint32_t _num, uint32_t _grain, const RangeFn& _fn)
+{
+	_grain = bx::max<uint32_t>(_grain, 1);
+
+	if (0 == _num)
+	{
+		return;
+	}
+
+	if (m_workers.empty()
+	||  _num <= _grain)
+	{
+		_fn(0, _num);
+		return;
+	}
+
+	JobCounter counter;
+	splitRange(0, _num, _grain, _fn, &counter);
+	wait(counter);
+}
+
+void jobSystemParallelFor(JobSystem* _jobs, uint32_t _num, const JobSystem::RangeFn& _fn, uint32_t _grain)
+{
+	if (NULL == _jobs)
+	{
+		_fn(0, _num);
+		return;
+	}
+
+	_jobs->parallelFor(_num, _grain, _fn);
+}
+
+void JobSystem::push(Job&& _job)
+{
+	BX_ASSERT(!m_workers.empty(), "JobSystem is not initialized.");
+
+	// Split jobs stay with the worker that split them, others are dealt round robin.
+	const uint32_t worker = this == s_system
+		? s_worker
+		: m_nextWorker.fetch_add(1, std::memory_order_relaxed) % uint32_t(m_workers.size() )
+		;
+
+	// Counted before it's published, a thief could otherwise take the job and decrement
+	// first. Sleeping workers that see the count early spin until the job shows up.
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_numQueued;
+	}
+
+	{
+		Worker& queue = *m_workers[worker];
+		std::lock_guard<std::mutex> lock(queue.m_mutex);
+		queue.m_queue.push_back(std::move(_job) );
+	}
+	m_cv.notify_one();
+}
+
+bool JobSystem::pop(uint32_t _worker, Job& _outJob, const JobCounter* _group)
+{
+	Worker& worker = *m_workers[_worker];
+	std::lock_guard<std::mutex> lock(worker.m_mutex);
+
+	for (auto it = worker.m_queue.rbegin(), itEnd = worker.m_queue.rend(); it != itEnd; ++it)
+	{
+		if (NULL == _group
+		||  _group == it->m_counter)
+		{
+			_outJob = std::move(*it);
+			worker.m_queue.erase(std::next(it).base() );
+			--m_numQueued;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool JobSystem::steal(uint32_t _thief, Job& _outJob, const JobCounter* _group)
+{
+	const uint32_t numWorkers = uint32_t(m_workers.size() );
+	const uint32_t first      = UINT32_MAX == _thief ? 0 : _thief + 1;
+
+	for (uint32_t ii = 0; ii < numWorkers; ++ii)
+	{
+		const uint32_t victim = (first + ii) % numWorkers;
+		if (victim == _thief)
+		{
+			continue;
+		}
+
+		Worker& worker = *m_workers[victim];
+		std::lock_guard<std::mutex> lock(worker.m_mutex);
+
+		for (auto it = worker.m_queue.begin(), itEnd = worker.m_queue.end(); it != itEnd; ++it)
+		{
+			if (NULL == _group
+			||  _group == it->m_counter)
+			{
+				_outJob = std::move(*it);
+				worker.m_queue.erase(it);
+				--m_numQueued;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void JobSystem::execute(Job& _job)
+{
+	_job.m_fn();
+
+	if (NULL != _job.m_counter)
+	{
+		_job.m_counter->m_pending.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+void JobSystem::splitRange(uint32_t _begin, uint32_t _end, uint32_t _grain, const RangeFn& _fn, JobCounter* _counter)
+{
+	// Hand the upper half to the deque until the rest is one grain, an idle worker
+	// steals the oldest and therefore largest half.
+	while (_end - _begin > _grain)
+	{
+		const uint32_t mid = _begin + (_end - _begin)/2;
+		const RangeFn* fn  = &_fn;
+		submit([this, mid, _end, _grain, fn, _counter] { splitRange(mid, _end, _grain, *fn, _counter); }, _counter);
+		_end = mid;
+	}
+
+	_fn(_begin, _end);
+}
+
+void JobSystem::workerMain(uint32_t _worker)
+{
+	s_system = this;
+	s_worker = _worker;
+
+	for (;;)
+	{
+		Job job;
+		if (pop(_worker, job, NULL)
+		||  steal(_worker, job, NULL) )
+		{
+			execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(lock, [this] { return m_quit || 0 != m_numQueued; });
+
+		if (m_quit
+		&&  0 == m_numQueued)
+		{
+			return;
+		}
+	}
+}
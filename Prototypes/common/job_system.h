@@ -0,0 +1,103 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_JOB_SYSTEM_H_HEADER_GUARD
+#define PROTOTYPE_JOB_SYSTEM_H_HEADER_GUARD
+
+#include <bx/bx.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Jobs still pending in a group of jobs, see JobSystem::wait().
+struct JobCounter
+{
+	JobCounter()
+		: m_pending(0)
+	{
+	}
+
+	std::atomic<uint32_t> m_pending;
+};
+
+// Fixed pool of worker threads with one job deque each. Workers run their own jobs
+// newest first and steal the oldest job of another worker when they run dry, so jobs
+// that split themselves keep their halves local until someone is idle. Used for work
+// that must stay off the main thread, e.g. asset I/O and decoding, and for fork/join
+// loops through parallelFor().
+class JobSystem
+{
+public:
+	typedef std::function<void()> JobFn;
+	typedef std::function<void(uint32_t _begin, uint32_t _end)> RangeFn;
+
+	JobSystem();
+	~JobSystem();
+
+	// _numThreads 0 uses one worker per hardware thread minus the main thread.
+	void init(uint32_t _numThreads = 0);
+
+	// Runs the jobs still queued, then joins the workers.
+	void shutdown();
+
+	// Thread safe. _counter, if given, is incremented now and decremented once the job
+	// has run.
+	void submit(JobFn&& _job, JobCounter* _counter = NULL);
+
+	// Returns once every job submitted with _counter has run. The calling thread runs
+	// jobs of the same group meanwhile, never unrelated ones.
+	void wait(JobCounter& _counter);
+
+	// Calls _fn over [0, _num) in ranges of at most _grain items, in parallel with the
+	// calling thread. Ranges split in halves on demand, workers steal the larger halves.
+	void parallelFor(uint32_t _num, uint32_t _grain, const RangeFn& _fn);
+
+	uint32_t getNumThreads() const { return uint32_t(m_threads.size() ); }
+
+private:
+	struct Job
+	{
+		JobFn m_fn;
+		JobCounter* m_counter;
+	};
+
+	struct Worker
+	{
+		std::deque<Job> m_queue;
+		std::mutex m_mutex;
+	};
+
+	void push(Job&& _job);
+
+	// Own jobs come off the back, stolen ones off the front. _group limits both to jobs
+	// of one counter.
+	bool pop(uint32_t _worker, Job& _outJob, const JobCounter* _group);
+	bool steal(uint32_t _thief, Job& _outJob, const JobCounter* _group);
+
+	void execute(Job& _job);
+	void splitRange(uint32_t _begin, uint32_t _end, uint32_t _grain, const RangeFn& _fn, JobCounter* _counter);
+
+	void workerMain(uint32_t _worker);
+
+	std::vector<std::unique_ptr<Worker> > m_workers;
+	std::vector<std::thread> m_threads;
+	std::atomic<uint32_t> m_numQueued;
+	std::atomic<uint32_t> m_nextWorker;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	bool m_quit;
+};
+
+// _jobs->parallelFor(), or _fn(0, _num) on the calling thread when _jobs is NULL. For
+// code that runs threaded or not depending on its caller.
+void jobSystemParallelFor(JobSystem* _jobs, uint32_t _num, const JobSystem::RangeFn& _fn, uint32_t _grain = 1);
+
+#endif // PROTOTYPE_JOB_SYSTEM_H_HEADER_GUARD
@@ -0,0 +1,351 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "light_binning.h"
+#include "job_system.h"
+
+#include <bx/timer.h>
+
+namespace
+{
+	// Lights binned per job of the first pass.
+	constexpr uint32_t kLightsPerBatch = 64;
+
+	float distanceSq(const bx::Aabb& _aabb, const bx::Vec3& _pos)
+	{
+		const bx::Vec3 closest = bx::min(bx::max(_pos, _aabb.min), _aabb.max);
+		const bx::Vec3 delta   = bx::sub(_pos, closest);
+		return bx::dot(delta, delta);
+	}
+
+	int32_t toCell(float _ndc, uint16_t _dim)
+	{
+		const int32_t cell = int32_t(bx::floor( (_ndc*0.5f + 0.5f) * float(_dim) ) );
+		return bx::clamp(cell, 0, int32_t(_dim) - 1);
+	}
+
+} // namespace
+
+LightClustersDesc::LightClustersDesc()
+	: m_dimX(16)
+	, m_dimY(9)
+	, m_dimZ(24)
+	, m_near(0.1f)
+	, m_far(100.0f)
+	, m_maxLights(4096)
+	, m_maxLightsPerCluster(256)
+	, m_maxIndices(256*1024)
+{
+}
+
+LightBinner::LightBinner()
+{
+	bx::memSet(m_proj, 0, sizeof(m_proj) );
+	bx::memSet(m_scaleBias, 0, sizeof(m_scaleBias) );
+	bx::memSet(&m_stats, 0, sizeof(m_stats) );
+}
+
+void LightBinner::init(const LightClustersDesc& _desc)
+{
+	m_desc = _desc;
+	bx::memSet(m_proj, 0, sizeof(m_proj) );
+
+	const float logRange = bx::log(m_desc.m_far / m_desc.m_near);
+	m_scaleBias[0] = float(m_desc.m_dimZ) / logRange;
+	m_scaleBias[1] = -float(m_desc.m_dimZ) * bx::log(m_desc.m_near) / logRange;
+
+	const uint32_t numClusters = uint32_t(m_desc.m_dimX) * m_desc.m_dimY * m_desc.m_dimZ;
+	m_clusterData.assign(numClusters*2, 0.0f);
+	m_counts.resize(numClusters);
+	m_clusterEnds.resize(numClusters);
+	m_sliceOffsets.resize(m_desc.m_dimZ);
+	m_sliceStats.resize(m_desc.m_dimZ);
+}
+
+void LightBinner::bin(const PointLight* _lights, uint32_t _num, const float* _view, const float* _proj, JobSystem* _jobs)
+{
+	const int64_t start = bx::getHPCounter();
+
+	if (0 != bx::memCmp(m_proj, _proj, sizeof(m_proj) ) )
+	{
+		buildGrid(_proj);
+	}
+
+	const uint32_t numLights  = bx::min(_num, m_desc.m_maxLights);
+	const uint32_t numBatches = (numLights + kLightsPerBatch - 1) / kLightsPerBatch;
+	const uint32_t dimZ       = m_desc.m_dimZ;
+
+	if (m_buckets.size() < numBatches*dimZ)
+	{
+		m_buckets.resize(numBatches*dimZ);
+	}
+
+	jobSystemParallelFor(_jobs, numBatches, [&](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			binBatch(ii, _lights, numLights, _view);
+		}
+	});
+
+	jobSystemParallelFor(_jobs, dimZ, [&](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			countSlice(ii, numBatches);
+		}
+	});
+
+	// Slice totals to first indices.
+	uint32_t numPairs = 0;
+	for (uint32_t ii = 0; ii < dimZ; ++ii)
+	{
+		const uint32_t count = m_sliceOffsets[ii];
+		m_sliceOffsets[ii] = numPairs;
+		numPairs += count;
+	}
+
+	const uint32_t numIndices = bx::min(numPairs, m_desc.m_maxIndices);
+	m_indexData.resize(numIndices);
+
+	jobSystemParallelFor(_jobs, dimZ, [&](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			scatterSlice(ii, numBatches);
+		}
+	});
+
+	m_stats = {};
+	m_stats.m_numLights   = numLights;
+	m_stats.m_numClusters = uint32_t(m_clusterAabbs.size() );
+	m_stats.m_numIndices  = numIndices;
+
+	for (const SliceStats& slice : m_sliceStats)
+	{
+		m_stats.m_numOccupied   += slice.m_numOccupied;
+		m_stats.m_maxPerCluster  = bx::max(m_stats.m_maxPerCluster, slice.m_maxPerCluster);
+		m_stats.m_numOverflowed += slice.m_numOverflowed;
+		m_stats.m_numDropped    += slice.m_numDropped;
+	}
+
+	m_stats.m_binTimeMs = double(bx::getHPCounter() - start) * 1000.0 / double(bx::getHPFrequency() );
+}
+
+void LightBinner::getSliceScaleBias(float _outScaleBias[2]) const
+{
+	_outScaleBias[0] = m_scaleBias[0];
+	_outScaleBias[1] = m_scaleBias[1];
+}
+
+void LightBinner::buildGrid(const float* _proj)
+{
+	bx::memCopy(m_proj, _proj, sizeof(m_proj) );
+
+	const uint16_t dimX = m_desc.m_dimX;
+	const uint16_t dimY = m_desc.m_dimY;
+	const uint16_t dimZ = m_desc.m_dimZ;
+	m_clusterAabbs.resize(uint32_t(dimX) * dimY * dimZ);
+
+	// bx projections are left handed with w = z, view space x = (ndc.x - P[8])*z/P[0].
+	const float ratio = m_desc.m_far / m_desc.m_near;
+
+	for (uint16_t zz = 0; zz < dimZ; ++zz)
+	{
+		const float depth[2] =
+		{
+			m_desc.m_near * bx::pow(ratio, float(zz    ) / float(dimZ) ),
+			m_desc.m_near * bx::pow(ratio, float(zz + 1) / float(dimZ) ),
+		};
+
+		for (uint16_t yy = 0; yy < dimY; ++yy)
+		{
+			const float ndcY[2] =
+			{
+				-1.0f + 2.0f * float(yy    ) / float(dimY),
+				-1.0f + 2.0f * float(yy + 1) / float(dimY),
+			};
+
+			for (uint16_t xx = 0; xx < dimX; ++xx)
+			{
+				const float ndcX[2] =
+				{
+					-1.0f + 2.0f * float(xx    ) / float(dimX),
+					-1.0f + 2.0f * float(xx + 1) / float(dimX),
+				};
+
+				bx::Aabb aabb = {};
+				bool first = true;
+				for (uint32_t corner = 0; corner < 8; ++corner)
+				{
+					const float zv = depth[corner>>2 & 1];
+					const bx::Vec3 pos =
+					{
+						(ndcX[corner    & 1] - _proj[8]) * zv / _proj[0],
+						(ndcY[corner>>1 & 1] - _proj[9]) * zv / _proj[5],
+						zv,
+					};
+
+					aabb.min = first ? pos : bx::min(aabb.min, pos);
+					aabb.max = first ? pos : bx::max(aabb.max, pos);
+					first = false;
+				}
+
+				m_clusterAabbs[xx + yy*dimX + zz*dimX*dimY] = aabb;
+			}
+		}
+	}
+}
+
+void LightBinner::binBatch(uint32_t _batch, const PointLight* _lights, uint32_t _num, const float* _view)
+{
+	const uint16_t dimX = m_desc.m_dimX;
+	const uint16_t dimY = m_desc.m_dimY;
+	const uint16_t dimZ = m_desc.m_dimZ;
+
+	std::vector<Pair>* buckets = &m_buckets[_batch*dimZ];
+	for (uint16_t zz = 0; zz < dimZ; ++zz)
+	{
+		buckets[zz].clear();
+	}
+
+	const uint32_t begin = _batch*kLightsPerBatch;
+	const uint32_t end   = bx::min(begin + kLightsPerBatch, _num);
+
+	for (uint32_t ii = begin; ii < end; ++ii)
+	{
+		const bx::Vec3 center = bx::mul(_lights[ii].m_pos, _view);
+		const float radius    = _lights[ii].m_radiusMax;
+		const float zMin      = center.z - radius;
+		const float zMax      = center.z + radius;
+
+		if (zMax < m_desc.m_near
+		||  zMin > m_desc.m_far)
+		{
+			continue;
+		}
+
+		const int32_t z0 = bx::clamp(int32_t(bx::floor(bx::log(bx::max(zMin, m_desc.m_near) )*m_scaleBias[0] + m_scaleBias[1]) ), 0, int32_t(dimZ) - 1);
+		const int32_t z1 = bx::clamp(int32_t(bx::floor(bx::log(bx::min(zMax, m_desc.m_far ) )*m_scaleBias[0] + m_scaleBias[1]) ), 0, int32_t(dimZ) - 1);
+
+		// Screen rectangle of the sphere's view space box, everything if it crosses the
+		// near plane.
+		int32_t x0 = 0, x1 = dimX - 1;
+		int32_t y0 = 0, y1 = dimY - 1;
+		if (zMin > m_desc.m_near)
+		{
+			float ndcX[4];
+			float ndcY[4];
+			for (uint32_t corner = 0; corner < 4; ++corner)
+			{
+				const float zv   = 0 == (corner & 1) ? zMin : zMax;
+				const float sign = 0 == (corner & 2) ? -1.0f : 1.0f;
+				ndcX[corner] = (center.x + sign*radius) * m_proj[0] / zv + m_proj[8];
+				ndcY[corner] = (center.y + sign*radius) * m_proj[5] / zv + m_proj[9];
+			}
+
+			const float ndcMinX = bx::min(bx::min(ndcX[0], ndcX[1]), bx::min(ndcX[2], ndcX[3]) );
+			const float ndcMaxX = bx::max(bx::max(ndcX[0], ndcX[1]), bx::max(ndcX[2], ndcX[3]) );
+			const float ndcMinY = bx::min(bx::min(ndcY[0], ndcY[1]), bx::min(ndcY[2], ndcY[3]) );
+			const float ndcMaxY = bx::max(bx::max(ndcY[0], ndcY[1]), bx::max(ndcY[2], ndcY[3]) );
+
+			if (ndcMaxX < -1.0f || ndcMinX > 1.0f
+			||  ndcMaxY < -1.0f || ndcMinY > 1.0f)
+			{
+				continue;
+			}
+
+			x0 = toCell(ndcMinX, dimX);
+			x1 = toCell(ndcMaxX, dimX);
+			y0 = toCell(ndcMinY, dimY);
+			y1 = toCell(ndcMaxY, dimY);
+		}
+
+		const float radiusSq = radius*radius;
+		for (int32_t zz = z0; zz <= z1; ++zz)
+		{
+			for (int32_t yy = y0; yy <= y1; ++yy)
+			{
+				for (int32_t xx = x0; xx <= x1; ++xx)
+				{
+					const uint32_t cluster = uint32_t(xx + yy*dimX + zz*dimX*dimY);
+					if (distanceSq(m_clusterAabbs[cluster], center) <= radiusSq)
+					{
+						buckets[zz].push_back({ cluster, ii });
+					}
+				}
+			}
+		}
+	}
+}
+
+void LightBinner::countSlice(uint32_t _slice, uint32_t _numBatches)
+{
+	const uint32_t clustersPerSlice = uint32_t(m_desc.m_dimX) * m_desc.m_dimY;
+	const uint32_t dimZ = m_desc.m_dimZ;
+
+	bx::memSet(&m_counts[_slice*clustersPerSlice], 0, clustersPerSlice*sizeof(uint32_t) );
+
+	for (uint32_t ii = 0; ii < _numBatches; ++ii)
+	{
+		for (const Pair& pair : m_buckets[ii*dimZ + _slice])
+		{
+			++m_counts[pair.m_cluster];
+		}
+	}
+
+	// Only what the clusters keep takes space in the index list.
+	uint32_t total = 0;
+	for (uint32_t ii = _slice*clustersPerSlice, end = ii + clustersPerSlice; ii < end; ++ii)
+	{
+		total += bx::min(m_counts[ii], m_desc.m_maxLightsPerCluster);
+	}
+
+	m_sliceOffsets[_slice] = total;
+}
+
+void LightBinner::scatterSlice(uint32_t _slice, uint32_t _numBatches)
+{
+	const uint32_t clustersPerSlice = uint32_t(m_desc.m_dimX) * m_desc.m_dimY;
+	const uint32_t dimZ       = m_desc.m_dimZ;
+	const uint32_t maxIndices = m_desc.m_maxIndices;
+
+	SliceStats& stats = m_sliceStats[_slice];
+	stats = {};
+
+	uint32_t offset = m_sliceOffsets[_slice];
+	for (uint32_t ii = _slice*clustersPerSlice, end = ii + clustersPerSlice; ii < end; ++ii)
+	{
+		const uint32_t count  = m_counts[ii];
+		const uint32_t kept   = bx::min(count, m_desc.m_maxLightsPerCluster);
+		const uint32_t stored = offset < maxIndices ? bx::min(kept, maxIndices - offset) : 0;
+
+		m_clusterData[ii*2 + 0] = float(offset);
+		m_clusterData[ii*2 + 1] = float(stored);
+
+		stats.m_numOccupied   += 0 != count ? 1 : 0;
+		stats.m_maxPerCluster  = bx::max(stats.m_maxPerCluster, count);
+		stats.m_numOverflowed += count > kept ? 1 : 0;
+		stats.m_numDropped    += count - stored;
+
+		// Becomes the write cursor of the cluster.
+		m_counts[ii]      = offset;
+		m_clusterEnds[ii] = offset + stored;
+		offset += kept;
+	}
+
+	// Batches are in light order, so a full cluster keeps its lowest light indices.
+	for (uint32_t ii = 0; ii < _numBatches; ++ii)
+	{
+		for (const Pair& pair : m_buckets[ii*dimZ + _slice])
+		{
+			uint32_t& pos = m_counts[pair.m_cluster];
+			if (pos < m_clusterEnds[pair.m_cluster])
+			{
+				m_indexData[pos++] = float(pair.m_light);
+			}
+		}
+	}
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_LIGHT_BINNING_H_HEADER_GUARD
+#define PROTOTYPE_LIGHT_BINNING_H_HEADER_GUARD
+
+#include <bx/bounds.h>
+#include <bx/math.h>
+
+#include <vector>
+
+class JobSystem;
+
+// Point light in the LightsBasic model. Two RGBA32F texels in the light texture:
+// (position, radius max) and (color, radius min). m_radiusMax is where the light's
+// attenuation reaches zero and is the radius lights are culled with.
+struct PointLight
+{
+	bx::Vec3 m_pos;
+	float    m_radiusMax;
+	bx::Vec3 m_color;
+	float    m_radiusMin;
+};
+
+struct LightClustersDesc
+{
+	LightClustersDesc();
+
+	// Froxel grid. x and y split the screen evenly, z splits view depth
+	// logarithmically between m_near and m_far.
+	uint16_t m_dimX;
+	uint16_t m_dimY;
+	uint16_t m_dimZ;
+	float    m_near;
+	float    m_far;
+
+	uint32_t m_maxLights;
+
+	// Lights kept per cluster, the lowest light indices win. fs_clusteredlights.sc loops
+	// at most MAX_LIGHTS_PER_CLUSTER times, more would be binned and never shaded.
+	uint32_t m_maxLightsPerCluster;
+
+	// Capacity of the light index list shared by all clusters.
+	uint32_t m_maxIndices;
+};
+
+struct LightClustersStats
+{
+	uint32_t m_numLights;
+	uint32_t m_numClusters;
+	uint32_t m_numOccupied;
+	uint32_t m_numIndices;
+
+	// Lights touching the busiest cluster, before the per cluster limit.
+	uint32_t m_maxPerCluster;
+
+	// Clusters touched by more than m_maxLightsPerCluster lights.
+	uint32_t m_numOverflowed;
+
+	// Indices dropped because a cluster or the index list was full.
+	uint32_t m_numDropped;
+
+	double m_binTimeMs;
+};
+
+// CPU side of the clustered lights, no bgfx involved so tools can benchmark it. bin()
+// assigns lights to the froxels their bounding sphere touches and builds the tables
+// LightClusters uploads:
+//
+//   indices   light indices of all clusters back to back, getStats().m_numIndices.
+//   clusters  (first index, count) per cluster, cluster x + y*dimX + z*dimX*dimY.
+//
+// Binning runs in two passes, split by light batch and then by depth slice. Each batch
+// sorts its (cluster, light) pairs into per slice buckets, each slice then counts and
+// scatters the buckets of all batches in batch order. Slices own disjoint ranges of both
+// tables, so neither pass needs locks and the result matches a single threaded run.
+class LightBinner
+{
+public:
+	LightBinner();
+
+	void init(const LightClustersDesc& _desc = LightClustersDesc() );
+
+	// Bins _num world space lights for a camera. _proj is a bx perspective projection,
+	// the grid is rebuilt whenever it changes. Without _jobs it runs on the calling
+	// thread.
+	void bin(const PointLight* _lights, uint32_t _num, const float* _view, const float* _proj, JobSystem* _jobs = NULL);
+
+	const LightClustersDesc& getDesc() const { return m_desc; }
+
+	// Depth slice of view space z is floor(log(z)*scale + bias).
+	void getSliceScaleBias(float _outScaleBias[2]) const;
+
+	// Tables of the last bin(), floats as the shader reads them.
+	const float* getIndices() const { return m_indexData.data(); }
+	const float* getClusters() const { return m_clusterData.data(); }
+
+	// Stats of the last bin().
+	const LightClustersStats& getStats() const { return m_stats; }
+
+private:
+	struct Pair
+	{
+		uint32_t m_cluster;
+		uint32_t m_light;
+	};
+
+	struct SliceStats
+	{
+		uint32_t m_numOccupied;
+		uint32_t m_maxPerCluster;
+		uint32_t m_numOverflowed;
+		uint32_t m_numDropped;
+	};
+
+	void buildGrid(const float* _proj);
+	void binBatch(uint32_t _batch, const PointLight* _lights, uint32_t _num, const float* _view);
+	void countSlice(uint32_t _slice, uint32_t _numBatches);
+	void scatterSlice(uint32_t _slice, uint32_t _numBatches);
+
+	LightClustersDesc m_desc;
+	float m_proj[16];
+	float m_scaleBias[2];
+
+	// View space bounds of every cluster.
+	std::vector<bx::Aabb> m_clusterAabbs;
+
+	std::vector<float> m_indexData;
+	std::vector<float> m_clusterData;
+
+	// Scratch for bin(). Pairs bucketed by batch*dimZ + slice, light counts and then
+	// write cursors per cluster, the end of every cluster's indices, and the first index
+	// of every slice.
+	std::vector<std::vector<Pair> > m_buckets;
+	std::vector<uint32_t> m_counts;
+	std::vector<uint32_t> m_clusterEnds;
+	std::vector<uint32_t> m_sliceOffsets;
+	std::vector<SliceStats> m_sliceStats;
+
+	LightClustersStats m_stats;
+};
+
+#endif // PROTOTYPE_LIGHT_BINNING_H_HEADER_GUARD
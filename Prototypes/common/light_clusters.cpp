@@ -0,0 +1,141 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "light_clusters.h"
+
+namespace
+{
+	// Lights per row of the light texture, two texels each.
+	constexpr uint32_t kLightsPerRow  = 256;
+	constexpr uint32_t kIndicesPerRow = 1024;
+
+	constexpr uint64_t kTextureFlags = 0
+		| BGFX_SAMPLER_POINT
+		| BGFX_SAMPLER_UVW_CLAMP
+		;
+
+	uint32_t numRows(uint32_t _num, uint32_t _perRow)
+	{
+		return (_num + _perRow - 1) / _perRow;
+	}
+
+} // namespace
+
+LightClusters::LightClusters()
+	: m_lightsTexture(BGFX_INVALID_HANDLE)
+	, m_indicesTexture(BGFX_INVALID_HANDLE)
+	, m_clustersTexture(BGFX_INVALID_HANDLE)
+{
+}
+
+void LightClusters::init(const LightClustersDesc& _desc)
+{
+	m_binner.init(_desc);
+
+	m_lightsTexture = bgfx::createTexture2D(
+		  getLightsWidth()
+		, getLightsHeight()
+		, false
+		, 1
+		, bgfx::TextureFormat::RGBA32F
+		, kTextureFlags
+		);
+	m_indicesTexture = bgfx::createTexture2D(
+		  getIndicesWidth()
+		, getIndicesHeight()
+		, false
+		, 1
+		, bgfx::TextureFormat::R32F
+		, kTextureFlags
+		);
+	m_clustersTexture = bgfx::createTexture2D(
+		  uint16_t(_desc.m_dimX * _desc.m_dimY)
+		, _desc.m_dimZ
+		, false
+		, 1
+		, bgfx::TextureFormat::RG32F
+		, kTextureFlags
+		);
+}
+
+void LightClusters::shutdown()
+{
+	bgfx::destroy(m_lightsTexture);
+	bgfx::destroy(m_indicesTexture);
+	bgfx::destroy(m_clustersTexture);
+}
+
+void LightClusters::build(const PointLight* _lights, uint32_t _num, const float* _view, const float* _proj, JobSystem* _jobs)
+{
+	m_binner.bin(_lights, _num, _view, _proj, _jobs);
+
+	const uint32_t numLights = m_binner.getStats().m_numLights;
+	m_lightData.resize(numRows(numLights, kLightsPerRow)*kLightsPerRow*8);
+	bx::memCopy(m_lightData.data(), _lights, numLights*sizeof(PointLight) );
+}
+
+void LightClusters::upload()
+{
+	const LightClustersStats& stats = m_binner.getStats();
+
+	const uint32_t lightRows = numRows(stats.m_numLights, kLightsPerRow);
+	if (0 != lightRows)
+	{
+		bgfx::updateTexture2D(m_lightsTexture, 0, 0, 0, 0
+			, getLightsWidth()
+			, uint16_t(lightRows)
+			, bgfx::copy(m_lightData.data(), lightRows*kLightsPerRow*8*sizeof(float) )
+			);
+	}
+
+	// The index list ends mid row, the rest of the row is padding.
+	const uint32_t indexRows = numRows(stats.m_numIndices, kIndicesPerRow);
+	if (0 != indexRows)
+	{
+		const bgfx::Memory* mem = bgfx::alloc(indexRows*kIndicesPerRow*sizeof(float) );
+		bx::memSet(mem->data, 0, mem->size);
+		bx::memCopy(mem->data, m_binner.getIndices(), stats.m_numIndices*sizeof(float) );
+
+		bgfx::updateTexture2D(m_indicesTexture, 0, 0, 0, 0
+			, getIndicesWidth()
+			, uint16_t(indexRows)
+			, mem
+			);
+	}
+
+	const LightClustersDesc& desc = m_binner.getDesc();
+	bgfx::updateTexture2D(m_clustersTexture, 0, 0, 0, 0
+		, uint16_t(desc.m_dimX * desc.m_dimY)
+		, desc.m_dimZ
+		, bgfx::copy(m_binner.getClusters(), stats.m_numClusters*2*sizeof(float) )
+		);
+}
+
+void LightClusters::setTextures(uint8_t _stage, bgfx::UniformHandle _lights, bgfx::UniformHandle _indices, bgfx::UniformHandle _clusters) const
+{
+	bgfx::setTexture(_stage + 0, _lights,   m_lightsTexture);
+	bgfx::setTexture(_stage + 1, _indices,  m_indicesTexture);
+	bgfx::setTexture(_stage + 2, _clusters, m_clustersTexture);
+}
+
+uint16_t LightClusters::getLightsWidth() const
+{
+	return uint16_t(kLightsPerRow*2);
+}
+
+uint16_t LightClusters::getLightsHeight() const
+{
+	return uint16_t(bx::max<uint32_t>(numRows(getDesc().m_maxLights, kLightsPerRow), 1) );
+}
+
+uint16_t LightClusters::getIndicesWidth() const
+{
+	return uint16_t(kIndicesPerRow);
+}
+
+uint16_t LightClusters::getIndicesHeight() const
+{
+	return uint16_t(bx::max<uint32_t>(numRows(getDesc().m_maxIndices, kIndicesPerRow), 1) );
+}
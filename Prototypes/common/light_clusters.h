@@ -0,0 +1,65 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_LIGHT_CLUSTERS_H_HEADER_GUARD
+#define PROTOTYPE_LIGHT_CLUSTERS_H_HEADER_GUARD
+
+#include "light_binning.h"
+
+#include <bgfx/bgfx.h>
+
+// Clustered forward light culling. build() bins lights into view space froxels on the
+// CPU with LightBinner, upload() writes three textures the fragment shader reads:
+//
+//   lights    RGBA32F, 2 texels per light, see PointLight.
+//   indices   R32F, the light indices of all clusters back to back.
+//   clusters  RG32F, (first index, count) per cluster at
+//             (x + y*dimX, z).
+//
+// Values are floats so the lookups work with texture2DLod() on every renderer, they
+// are exact well beyond the index counts used here.
+class LightClusters
+{
+public:
+	LightClusters();
+
+	void init(const LightClustersDesc& _desc = LightClustersDesc() );
+	void shutdown();
+
+	// Bins _num world space lights for a camera, see LightBinner::bin().
+	void build(const PointLight* _lights, uint32_t _num, const float* _view, const float* _proj, JobSystem* _jobs = NULL);
+
+	// Uploads the lights and the clusters from the last build().
+	void upload();
+
+	// Binds the textures for the next draw.
+	void setTextures(uint8_t _stage, bgfx::UniformHandle _lights, bgfx::UniformHandle _indices, bgfx::UniformHandle _clusters) const;
+
+	const LightClustersDesc& getDesc() const { return m_binner.getDesc(); }
+
+	// Depth slice of view space z is floor(log(z)*scale + bias).
+	void getSliceScaleBias(float _outScaleBias[2]) const { m_binner.getSliceScaleBias(_outScaleBias); }
+
+	// Texture dimensions, for turning indices into texel coordinates in the shader.
+	uint16_t getLightsWidth() const;
+	uint16_t getLightsHeight() const;
+	uint16_t getIndicesWidth() const;
+	uint16_t getIndicesHeight() const;
+
+	// Stats of the last build().
+	const LightClustersStats& getStats() const { return m_binner.getStats(); }
+
+private:
+	LightBinner m_binner;
+
+	// Light texture contents, rows of lights padded to the texture width.
+	std::vector<float> m_lightData;
+
+	bgfx::TextureHandle m_lightsTexture;
+	bgfx::TextureHandle m_indicesTexture;
+	bgfx::TextureHandle m_clustersTexture;
+};
+
+#endif // PROTOTYPE_LIGHT_CLUSTERS_H_HEADER_GUARD
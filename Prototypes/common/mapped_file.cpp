@@ -0,0 +1,186 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "mapped_file.h"
+
+#include <atomic>
+
+#if BX_PLATFORM_WINDOWS
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif // WIN32_LEAN_AND_MEAN
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif // NOMINMAX
+#	include <windows.h>
+#	include <psapi.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/resource.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif // BX_PLATFORM_WINDOWS
+
+struct MappedFile
+{
+	const uint8_t* m_data;
+	uint32_t m_size;
+	std::atomic<int32_t> m_refCount;
+
+#if BX_PLATFORM_WINDOWS
+	HANDLE m_file;
+	HANDLE m_mapping;
+#endif // BX_PLATFORM_WINDOWS
+};
+
+MappedFile* mappedFileOpen(const char* _filePath)
+{
+#if BX_PLATFORM_WINDOWS
+	HANDLE file = CreateFileA(_filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (INVALID_HANDLE_VALUE == file)
+	{
+		return NULL;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)
+	||  0 == size.QuadPart
+	||  size.QuadPart > INT32_MAX)
+	{
+		CloseHandle(file);
+		return NULL;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	const void* data = NULL != mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+	if (NULL == data)
+	{
+		if (NULL != mapping)
+		{
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+		return NULL;
+	}
+
+	MappedFile* mappedFile = new MappedFile;
+	mappedFile->m_file    = file;
+	mappedFile->m_mapping = mapping;
+	mappedFile->m_size    = uint32_t(size.QuadPart);
+#else
+	const int fd = open(_filePath, O_RDONLY);
+	if (0 > fd)
+	{
+		return NULL;
+	}
+
+	struct stat st;
+	if (0 != fstat(fd, &st)
+	||  0 == st.st_size
+	||  st.st_size > INT32_MAX)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	void* data = mmap(NULL, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping keeps the file referenced.
+	close(fd);
+
+	if (MAP_FAILED == data)
+	{
+		return NULL;
+	}
+
+	madvise(data, size_t(st.st_size), MADV_SEQUENTIAL);
+
+	MappedFile* mappedFile = new MappedFile;
+	mappedFile->m_size = uint32_t(st.st_size);
+#endif // BX_PLATFORM_WINDOWS
+
+	mappedFile->m_data = (const uint8_t*)data;
+	mappedFile->m_refCount.store(1);
+	return mappedFile;
+}
+
+void mappedFileAddRef(MappedFile* _file)
+{
+	_file->m_refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void mappedFileRelease(MappedFile* _file)
+{
+	if (1 != _file->m_refCount.fetch_sub(1, std::memory_order_acq_rel) )
+	{
+		return;
+	}
+
+#if BX_PLATFORM_WINDOWS
+	UnmapViewOfFile(_file->m_data);
+	CloseHandle(_file->m_mapping);
+	CloseHandle(_file->m_file);
+#else
+	munmap(const_cast<uint8_t*>(_file->m_data), _file->m_size);
+#endif // BX_PLATFORM_WINDOWS
+
+	delete _file;
+}
+
+const uint8_t* mappedFileGetData(const MappedFile* _file)
+{
+	return _file->m_data;
+}
+
+uint32_t mappedFileGetSize(const MappedFile* _file)
+{
+	return _file->m_size;
+}
+
+void mappedFilePrefault(const MappedFile* _file)
+{
+	const uint32_t kPageSize = 4096;
+
+	uint8_t sum = 0;
+	for (uint32_t offset = 0; offset < _file->m_size; offset += kPageSize)
+	{
+		sum += ( (const volatile uint8_t*)_file->m_data)[offset];
+	}
+
+	BX_UNUSED(sum);
+}
+
+void mappedFileReleaseFn(void* _ptr, void* _userData)
+{
+	BX_UNUSED(_ptr);
+	mappedFileRelease( (MappedFile*)_userData);
+}
+
+uint64_t memoryGetPeakResident()
+{
+#if BX_PLATFORM_WINDOWS
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters) ) )
+	{
+		return uint64_t(counters.PeakWorkingSetSize);
+	}
+
+	return 0;
+#else
+	struct rusage usage;
+	if (0 != getrusage(RUSAGE_SELF, &usage) )
+	{
+		return 0;
+	}
+
+#	if BX_PLATFORM_OSX || BX_PLATFORM_IOS
+	return uint64_t(usage.ru_maxrss);
+#	else
+	// Linux reports kilobytes.
+	return uint64_t(usage.ru_maxrss) * 1024;
+#	endif // BX_PLATFORM_OSX || BX_PLATFORM_IOS
+#endif // BX_PLATFORM_WINDOWS
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_MAPPED_FILE_H_HEADER_GUARD
+#define PROTOTYPE_MAPPED_FILE_H_HEADER_GUARD
+
+#include <bx/bx.h>
+
+// Read-only memory mapping of a whole file. Reference counted so views into the
+// mapping can be handed to bgfx::makeRef and the file is unmapped when bgfx releases
+// the last of them.
+struct MappedFile;
+
+// Returns NULL if the file can't be opened or is empty. The returned mapping holds one
+// reference.
+MappedFile* mappedFileOpen(const char* _filePath);
+
+void mappedFileAddRef(MappedFile* _file);
+void mappedFileRelease(MappedFile* _file);
+
+const uint8_t* mappedFileGetData(const MappedFile* _file);
+uint32_t mappedFileGetSize(const MappedFile* _file);
+
+// Touches every page so later reads don't fault on disk I/O.
+void mappedFilePrefault(const MappedFile* _file);
+
+// bgfx::ReleaseFn releasing the MappedFile passed as user data. Add a reference per
+// bgfx::makeRef before handing it over.
+void mappedFileReleaseFn(void* _ptr, void* _userData);
+
+// Peak resident set size of the process in bytes, 0 if unavailable.
+uint64_t memoryGetPeakResident();
+
+#endif // PROTOTYPE_MAPPED_FILE_H_HEADER_GUARD
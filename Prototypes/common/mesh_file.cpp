@@ -0,0 +1,399 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "mesh_file.h"
+
+#include <bx/allocator.h>
+#include <meshoptimizer/src/meshoptimizer.h>
+
+namespace bgfx
+{
+	int32_t read(bx::ReaderI* _reader, bgfx::VertexLayout& _layout, bx::Error* _err);
+	int32_t write(bx::WriterI* _writer, const bgfx::VertexLayout& _layout, bx::Error* _err);
+}
+
+namespace
+{
+	// Chunk tags written by geometryc, see bgfx_utils.cpp.
+	constexpr uint32_t kChunkVertexBuffer           = BX_MAKEFOURCC('V', 'B', ' ', 0x1);
+	constexpr uint32_t kChunkVertexBufferCompressed = BX_MAKEFOURCC('V', 'B', 'C', 0x0);
+	constexpr uint32_t kChunkIndexBuffer            = BX_MAKEFOURCC('I', 'B', ' ', 0x0);
+	constexpr uint32_t kChunkIndexBufferCompressed  = BX_MAKEFOURCC('I', 'B', 'C', 0x1);
+	constexpr uint32_t kChunkPrimitive              = BX_MAKEFOURCC('P', 'R', 'I', 0x0);
+
+	bx::DefaultAllocator s_allocator;
+
+	// Bounds checked cursor over the file. Reads copy out small headers, payloads are
+	// returned as pointers into the data.
+	struct ChunkReader
+	{
+		ChunkReader(const void* _data, uint32_t _size)
+			: m_data( (const uint8_t*)_data)
+			, m_size(_size)
+			, m_pos(0)
+		{
+		}
+
+		template<typename Ty>
+		bool read(Ty& _out)
+		{
+			const uint8_t* ptr = skip(sizeof(Ty) );
+			if (NULL == ptr)
+			{
+				return false;
+			}
+
+			bx::memCopy(&_out, ptr, sizeof(Ty) );
+			return true;
+		}
+
+		const uint8_t* skip(uint32_t _size)
+		{
+			if (m_size - m_pos < _size)
+			{
+				return NULL;
+			}
+
+			const uint8_t* ptr = m_data + m_pos;
+			m_pos += _size;
+			return ptr;
+		}
+
+		bool readLayout(bgfx::VertexLayout& _layout)
+		{
+			bx::MemoryReader reader(m_data + m_pos, m_size - m_pos);
+			bx::Error err;
+			bgfx::read(&reader, _layout, &err);
+			if (!err.isOk() )
+			{
+				return false;
+			}
+
+			m_pos += uint32_t(reader.seek(0, bx::Whence::Current) );
+			return true;
+		}
+
+		template<typename Ty>
+		bool readBounds(Ty& _out)
+		{
+			return read(_out.m_sphere)
+				&& read(_out.m_aabb)
+				&& read(_out.m_obb)
+				;
+		}
+
+		// uint16_t length followed by the characters, e.g. material and primitive names.
+		bool readString(std::string& _out)
+		{
+			uint16_t len;
+			if (!read(len) )
+			{
+				return false;
+			}
+
+			const uint8_t* str = skip(len);
+			if (NULL == str)
+			{
+				return false;
+			}
+
+			_out.assign( (const char*)str, len);
+			return true;
+		}
+
+		bool isEnd() const
+		{
+			return m_pos == m_size;
+		}
+
+		const uint8_t* m_data;
+		uint32_t m_size;
+		uint32_t m_pos;
+	};
+
+	void resetGroup(MeshFileGroup& _group)
+	{
+		_group.m_vertices           = NULL;
+		_group.m_verticesSize       = 0;
+		_group.m_numVertices        = 0;
+		_group.m_verticesCompressed = false;
+		_group.m_indices            = NULL;
+		_group.m_indicesSize        = 0;
+		_group.m_numIndices         = 0;
+		_group.m_indicesCompressed  = false;
+		_group.m_material.clear();
+		_group.m_prims.clear();
+	}
+
+	template<typename Ty>
+	void writeBounds(bx::WriterI* _writer, const Ty& _in, bx::Error* _err)
+	{
+		bx::write(_writer, _in.m_sphere, _err);
+		bx::write(_writer, _in.m_aabb, _err);
+		bx::write(_writer, _in.m_obb, _err);
+	}
+
+	void writeString(bx::WriterI* _writer, const std::string& _str, bx::Error* _err)
+	{
+		const uint16_t len = uint16_t(_str.size() );
+		bx::write(_writer, len, _err);
+		bx::write(_writer, _str.data(), len, _err);
+	}
+
+} // namespace
+
+bool meshFileParse(MeshFile& _outMesh, const void* _data, uint32_t _size)
+{
+	_outMesh.m_groups.clear();
+
+	ChunkReader reader(_data, _size);
+
+	MeshFileGroup group;
+	resetGroup(group);
+
+	uint32_t chunk;
+	while (reader.read(chunk) )
+	{
+		switch (chunk)
+		{
+		case kChunkVertexBuffer:
+		case kChunkVertexBufferCompressed:
+			{
+				group.m_verticesCompressed = kChunkVertexBufferCompressed == chunk;
+
+				if (!reader.readBounds(group)
+				||  !reader.readLayout(_outMesh.m_layout)
+				||  !reader.read(group.m_numVertices) )
+				{
+					return false;
+				}
+
+				group.m_verticesSize = group.m_numVertices*_outMesh.m_layout.getStride();
+				if (group.m_verticesCompressed
+				&&  !reader.read(group.m_verticesSize) )
+				{
+					return false;
+				}
+
+				group.m_vertices = reader.skip(group.m_verticesSize);
+				if (NULL == group.m_vertices)
+				{
+					return false;
+				}
+			}
+			break;
+
+		case kChunkIndexBuffer:
+		case kChunkIndexBufferCompressed:
+			{
+				group.m_indicesCompressed = kChunkIndexBufferCompressed == chunk;
+
+				if (!reader.read(group.m_numIndices) )
+				{
+					return false;
+				}
+
+				group.m_indicesSize = group.m_numIndices*sizeof(uint16_t);
+				if (group.m_indicesCompressed
+				&&  !reader.read(group.m_indicesSize) )
+				{
+					return false;
+				}
+
+				group.m_indices = reader.skip(group.m_indicesSize);
+				if (NULL == group.m_indices)
+				{
+					return false;
+				}
+			}
+			break;
+
+		case kChunkPrimitive:
+			{
+				uint16_t num;
+				if (!reader.readString(group.m_material)
+				||  !reader.read(num) )
+				{
+					return false;
+				}
+
+				group.m_prims.resize(num);
+				for (MeshFilePrimitive& prim : group.m_prims)
+				{
+					if (!reader.readString(prim.m_name)
+					||  !reader.read(prim.m_startIndex)
+					||  !reader.read(prim.m_numIndices)
+					||  !reader.read(prim.m_startVertex)
+					||  !reader.read(prim.m_numVertices)
+					||  !reader.readBounds(prim) )
+					{
+						return false;
+					}
+				}
+
+				_outMesh.m_groups.push_back(group);
+				resetGroup(group);
+			}
+			break;
+
+		default:
+			return false;
+		}
+	}
+
+	return reader.isEnd();
+}
+
+bool meshFileWrite(bx::WriterI* _writer, const MeshFile& _mesh, bx::Error* _err)
+{
+	for (const MeshFileGroup& group : _mesh.m_groups)
+	{
+		BX_ASSERT(!group.m_verticesCompressed && !group.m_indicesCompressed
+			, "Decode payloads with meshFileOpen() before writing."
+			);
+
+		bx::write(_writer, kChunkVertexBuffer, _err);
+		writeBounds(_writer, group, _err);
+		bgfx::write(_writer, _mesh.m_layout, _err);
+		bx::write(_writer, group.m_numVertices, _err);
+		bx::write(_writer, group.m_vertices, int32_t(group.m_verticesSize), _err);
+
+		bx::write(_writer, kChunkIndexBuffer, _err);
+		bx::write(_writer, group.m_numIndices, _err);
+		bx::write(_writer, group.m_indices, int32_t(group.m_indicesSize), _err);
+
+		bx::write(_writer, kChunkPrimitive, _err);
+		writeString(_writer, group.m_material, _err);
+		bx::write(_writer, uint16_t(group.m_prims.size() ), _err);
+
+		for (const MeshFilePrimitive& prim : group.m_prims)
+		{
+			writeString(_writer, prim.m_name, _err);
+			bx::write(_writer, prim.m_startIndex, _err);
+			bx::write(_writer, prim.m_numIndices, _err);
+			bx::write(_writer, prim.m_startVertex, _err);
+			bx::write(_writer, prim.m_numVertices, _err);
+			writeBounds(_writer, prim, _err);
+		}
+	}
+
+	return _err->isOk();
+}
+
+MeshFileData* meshFileOpen(const char* _filePath, bool _prefault)
+{
+	MappedFile* file = mappedFileOpen(_filePath);
+	if (NULL == file)
+	{
+		return NULL;
+	}
+
+	MeshFileData* data = new MeshFileData;
+	data->m_file       = file;
+	data->m_ownedBytes = 0;
+
+	if (!meshFileParse(data->m_mesh, mappedFileGetData(file), mappedFileGetSize(file) ) )
+	{
+		meshFileClose(data);
+		return NULL;
+	}
+
+	const uint16_t stride    = data->m_mesh.m_layout.getStride();
+	const uint32_t numGroups = uint32_t(data->m_mesh.m_groups.size() );
+	data->m_ownedVertices.resize(numGroups, NULL);
+	data->m_ownedIndices.resize(numGroups, NULL);
+
+	for (uint32_t ii = 0; ii < numGroups; ++ii)
+	{
+		const MeshFileGroup& group = data->m_mesh.m_groups[ii];
+
+		if (group.m_verticesCompressed)
+		{
+			uint8_t* vertices = (uint8_t*)bx::alloc(&s_allocator, group.m_numVertices*stride);
+			if (0 != meshopt_decodeVertexBuffer(vertices, group.m_numVertices, stride, group.m_vertices, group.m_verticesSize) )
+			{
+				// Truncated or corrupt stream.
+				bx::free(&s_allocator, vertices);
+				meshFileClose(data);
+				return NULL;
+			}
+
+			meshFileSetVertices(*data, ii, vertices, group.m_numVertices);
+		}
+
+		if (group.m_indicesCompressed)
+		{
+			uint16_t* indices = (uint16_t*)bx::alloc(&s_allocator, group.m_numIndices*sizeof(uint16_t) );
+			if (0 != meshopt_decodeIndexBuffer(indices, group.m_numIndices, sizeof(uint16_t), group.m_indices, group.m_indicesSize) )
+			{
+				bx::free(&s_allocator, indices);
+				meshFileClose(data);
+				return NULL;
+			}
+
+			meshFileSetIndices(*data, ii, indices, group.m_numIndices);
+		}
+	}
+
+	if (_prefault)
+	{
+		mappedFilePrefault(file);
+	}
+
+	return data;
+}
+
+void meshFileClose(MeshFileData* _data)
+{
+	for (uint8_t* owned : _data->m_ownedVertices)
+	{
+		bx::free(&s_allocator, owned);
+	}
+
+	for (uint8_t* owned : _data->m_ownedIndices)
+	{
+		bx::free(&s_allocator, owned);
+	}
+
+	// Buffers created from the data hold their own references.
+	mappedFileRelease(_data->m_file);
+
+	delete _data;
+}
+
+bx::AllocatorI* meshFileGetAllocator()
+{
+	return &s_allocator;
+}
+
+void meshFileSetVertices(MeshFileData& _data, uint32_t _group, uint8_t* _vertices, uint16_t _numVertices)
+{
+	MeshFileGroup& group = _data.m_mesh.m_groups[_group];
+	const uint32_t size = _numVertices*_data.m_mesh.m_layout.getStride();
+
+	bx::free(&s_allocator, _data.m_ownedVertices[_group]);
+	_data.m_ownedVertices[_group] = _vertices;
+	_data.m_ownedBytes += size;
+
+	group.m_vertices           = _vertices;
+	group.m_verticesSize       = size;
+	group.m_numVertices        = _numVertices;
+	group.m_verticesCompressed = false;
+}
+
+void meshFileSetIndices(MeshFileData& _data, uint32_t _group, uint16_t* _indices, uint32_t _numIndices)
+{
+	MeshFileGroup& group = _data.m_mesh.m_groups[_group];
+	const uint32_t size = _numIndices*sizeof(uint16_t);
+
+	bx::free(&s_allocator, _data.m_ownedIndices[_group]);
+	_data.m_ownedIndices[_group] = (uint8_t*)_indices;
+	_data.m_ownedBytes += size;
+
+	group.m_indices           = (const uint8_t*)_indices;
+	group.m_indicesSize       = size;
+	group.m_numIndices        = _numIndices;
+	group.m_indicesCompressed = false;
+}
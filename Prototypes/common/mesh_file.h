@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_MESH_FILE_H_HEADER_GUARD
+#define PROTOTYPE_MESH_FILE_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+#include <bx/bounds.h>
+#include <bx/readerwriter.h>
+
+#include "mapped_file.h"
+
+#include <string>
+#include <vector>
+
+// geometryc .bin files without a renderer: parsing in place, decoding and writing.
+// Only depends on bx, bgfx' vertex layout and meshoptimizer so host tools can use it.
+// Creating GPU meshes lives in mesh_load.h.
+
+struct MeshFilePrimitive
+{
+	std::string m_name;
+	uint32_t m_startIndex;
+	uint32_t m_numIndices;
+	uint32_t m_startVertex;
+	uint32_t m_numVertices;
+	bx::Sphere m_sphere;
+	bx::Aabb m_aabb;
+	bx::Obb m_obb;
+};
+
+// CPU side view of one group of a .bin file. Payload pointers point into the parsed
+// memory and are not necessarily aligned. Compressed payloads (VBC/IBC chunks) are
+// meshoptimizer encoded and m_verticesSize/m_indicesSize is the encoded size.
+struct MeshFileGroup
+{
+	const uint8_t* m_vertices;
+	uint32_t m_verticesSize;
+	uint16_t m_numVertices;
+	bool m_verticesCompressed;
+
+	const uint8_t* m_indices;
+	uint32_t m_indicesSize;
+	uint32_t m_numIndices;
+	bool m_indicesCompressed;
+
+	bx::Sphere m_sphere;
+	bx::Aabb m_aabb;
+	bx::Obb m_obb;
+
+	std::string m_material;
+	std::vector<MeshFilePrimitive> m_prims;
+};
+
+struct MeshFile
+{
+	bgfx::VertexLayout m_layout;
+	std::vector<MeshFileGroup> m_groups;
+};
+
+// Parses the chunk headers of a .bin file in place. Nothing is copied except headers,
+// names, bounds and primitives. Returns false on a truncated or unknown chunk.
+bool meshFileParse(MeshFile& _outMesh, const void* _data, uint32_t _size);
+
+// Writes uncompressed VB/IB/PRI chunks, readable by meshLoad() and meshFileParse().
+bool meshFileWrite(bx::WriterI* _writer, const MeshFile& _mesh, bx::Error* _err);
+
+// Mapped and parsed .bin file. meshFileOpen() does the I/O and decoding and may run on
+// any thread, meshFileCreate() (mesh_load.h) only hands the payloads to bgfx and runs
+// on the thread that owns bgfx. Payloads that don't live in the mapping (decoded,
+// optimized) are owned by the data until meshFileCreate() passes them on to bgfx.
+struct MeshFileData
+{
+	MappedFile* m_file;
+	MeshFile m_mesh;
+
+	// Per group, NULL where the payload points into the mapping.
+	std::vector<uint8_t*> m_ownedVertices;
+	std::vector<uint8_t*> m_ownedIndices;
+	uint32_t m_ownedBytes;
+};
+
+// Returns NULL if the file can't be mapped or parsed, or if a compressed payload doesn't
+// decode. With _prefault every page of the mapping is touched so buffer creation and
+// upload don't stall on disk reads.
+MeshFileData* meshFileOpen(const char* _filePath, bool _prefault = false);
+
+void meshFileClose(MeshFileData* _data);
+
+// Allocator for payloads owned by MeshFileData.
+bx::AllocatorI* meshFileGetAllocator();
+
+// Replace a group's payload with memory from meshFileGetAllocator(). The data takes
+// ownership and frees the payload it owned before, if any.
+void meshFileSetVertices(MeshFileData& _data, uint32_t _group, uint8_t* _vertices, uint16_t _numVertices);
+void meshFileSetIndices(MeshFileData& _data, uint32_t _group, uint16_t* _indices, uint32_t _numIndices);
+
+#endif // PROTOTYPE_MESH_FILE_H_HEADER_GUARD
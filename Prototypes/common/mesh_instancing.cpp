@@ -0,0 +1,139 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "mesh_instancing.h"
+#include "benchmark.h"
+#include "mesh_load.h"
+
+namespace
+{
+	uint64_t defaultState(uint64_t _state)
+	{
+		if (BGFX_STATE_MASK != _state)
+		{
+			return _state;
+		}
+
+		// bgfx_utils' Mesh::submit() default.
+		return 0
+			| BGFX_STATE_WRITE_RGB
+			| BGFX_STATE_WRITE_A
+			| BGFX_STATE_WRITE_Z
+			| BGFX_STATE_DEPTH_TEST_LESS
+			| BGFX_STATE_CULL_CCW
+			| BGFX_STATE_MSAA
+			;
+	}
+
+	// _num instance matrices with the dequantization of quantized meshes applied in front.
+	void bakeInstances(float* _dst, const Mesh* _mesh, const float* _mtx, uint32_t _num)
+	{
+		if (!meshIsQuantized(_mesh) )
+		{
+			bx::memCopy(_dst, _mtx, _num*MESH_INSTANCE_STRIDE);
+			return;
+		}
+
+		float identity[16];
+		bx::mtxIdentity(identity);
+		float dequant[16];
+		meshGetModelMtx(dequant, _mesh, identity);
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			bx::mtxMul(&_dst[ii*16], dequant, &_mtx[ii*16]);
+		}
+	}
+
+} // namespace
+
+bool meshInstancingSupported()
+{
+	return 0 != (bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING);
+}
+
+uint32_t meshSubmitInstanced(
+	  const Mesh* _mesh
+	, bgfx::ViewId _view
+	, bgfx::ProgramHandle _program
+	, const float* _mtx
+	, uint32_t _numInstances
+	, uint64_t _state
+	)
+{
+	_state = defaultState(_state);
+
+	const uint16_t stride = MESH_INSTANCE_STRIDE;
+
+	uint32_t numDrawn = 0;
+	while (numDrawn < _numInstances)
+	{
+		const uint32_t num = bgfx::getAvailInstanceDataBuffer(_numInstances - numDrawn, stride);
+		if (0 == num)
+		{
+			break;
+		}
+
+		bgfx::InstanceDataBuffer idb;
+		bgfx::allocInstanceDataBuffer(&idb, num, stride);
+
+		bakeInstances( (float*)idb.data, _mesh, &_mtx[numDrawn*16], num);
+
+		for (const Group& group : _mesh->m_groups)
+		{
+			bgfx::setState(_state);
+			bgfx::setIndexBuffer(group.m_ibh);
+			bgfx::setVertexBuffer(0, group.m_vbh);
+			bgfx::setInstanceDataBuffer(&idb);
+			bgfx::submit(_view, _program);
+		}
+
+		benchmarkCountDraw(uint32_t(_mesh->m_groups.size() ) );
+		numDrawn += num;
+	}
+
+	return numDrawn;
+}
+
+bgfx::VertexBufferHandle meshCreateInstanceBuffer(const Mesh* _mesh, const float* _mtx, uint32_t _numInstances)
+{
+	// i_data0..3 are TEXCOORD7..4, the stride is all setInstanceDataBuffer() uses.
+	bgfx::VertexLayout layout;
+	layout.begin()
+		.add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
+		.add(bgfx::Attrib::TexCoord6, 4, bgfx::AttribType::Float)
+		.add(bgfx::Attrib::TexCoord5, 4, bgfx::AttribType::Float)
+		.add(bgfx::Attrib::TexCoord4, 4, bgfx::AttribType::Float)
+		.end();
+
+	const bgfx::Memory* mem = bgfx::alloc(_numInstances*MESH_INSTANCE_STRIDE);
+	bakeInstances( (float*)mem->data, _mesh, _mtx, _numInstances);
+
+	return bgfx::createVertexBuffer(mem, layout);
+}
+
+void meshSubmitInstanced(
+	  const Mesh* _mesh
+	, bgfx::ViewId _view
+	, bgfx::ProgramHandle _program
+	, bgfx::VertexBufferHandle _instances
+	, uint32_t _start
+	, uint32_t _numInstances
+	, uint64_t _state
+	)
+{
+	_state = defaultState(_state);
+
+	for (const Group& group : _mesh->m_groups)
+	{
+		bgfx::setState(_state);
+		bgfx::setIndexBuffer(group.m_ibh);
+		bgfx::setVertexBuffer(0, group.m_vbh);
+		bgfx::setInstanceDataBuffer(_instances, _start, _numInstances);
+		bgfx::submit(_view, _program);
+	}
+
+	benchmarkCountDraw(uint32_t(_mesh->m_groups.size() ) );
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_MESH_INSTANCING_H_HEADER_GUARD
+#define PROTOTYPE_MESH_INSTANCING_H_HEADER_GUARD
+
+#include "bgfx_utils.h"
+
+// Bytes per instance, one bx matrix read as i_data0..3 by the `_instanced` vertex
+// shader variants (mtxFromCols(i_data0, i_data1, i_data2, i_data3)).
+#define MESH_INSTANCE_STRIDE (16*sizeof(float) )
+
+// True if the renderer supports instanced draws.
+bool meshInstancingSupported();
+
+// Draws _numInstances copies of _mesh with one submit per group, _mtx holds one object
+// to world matrix per instance. Quantized meshes get their dequantization folded into
+// every matrix. Instances go through transient instance data buffers, in several
+// batches if one buffer can't hold them all. Returns the number of instances drawn,
+// less than _numInstances if transient memory ran out this frame.
+uint32_t meshSubmitInstanced(
+	  const Mesh* _mesh
+	, bgfx::ViewId _view
+	, bgfx::ProgramHandle _program
+	, const float* _mtx
+	, uint32_t _numInstances
+	, uint64_t _state = BGFX_STATE_MASK
+	);
+
+// Instance data that doesn't change, uploaded once instead of every frame. _mtx is
+// baked with _mesh's dequantization like above, so the buffer only draws meshes that
+// are quantized the same way, recreate it when the mesh changes.
+bgfx::VertexBufferHandle meshCreateInstanceBuffer(const Mesh* _mesh, const float* _mtx, uint32_t _numInstances);
+
+// Draws instances _start to _start + _numInstances of a meshCreateInstanceBuffer()
+// buffer, with one submit per group. Not limited by transient memory.
+void meshSubmitInstanced(
+	  const Mesh* _mesh
+	, bgfx::ViewId _view
+	, bgfx::ProgramHandle _program
+	, bgfx::VertexBufferHandle _instances
+	, uint32_t _start
+	, uint32_t _numInstances
+	, uint64_t _state = BGFX_STATE_MASK
+	);
+
+#endif // PROTOTYPE_MESH_INSTANCING_H_HEADER_GUARD
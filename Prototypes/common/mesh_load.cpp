@@ -0,0 +1,195 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "mesh_load.h"
+#include "mesh_quantize.h"
+#include "entry/entry.h"
+
+#include <bx/timer.h>
+
+#include <stdio.h>
+
+namespace
+{
+	void ownedReleaseFn(void* _ptr, void* _userData)
+	{
+		BX_UNUSED(_userData);
+		bx::free(meshFileGetAllocator(), _ptr);
+	}
+
+	// Hands a payload to bgfx. Owned payloads transfer ownership, payloads in the
+	// mapping take a reference on it.
+	const bgfx::Memory* makePayloadRef(MappedFile* _file, const uint8_t* _payload, uint32_t _size, uint8_t*& _owned)
+	{
+		if (NULL != _owned)
+		{
+			_owned = NULL;
+			return bgfx::makeRef(_payload, _size, ownedReleaseFn);
+		}
+
+		mappedFileAddRef(_file);
+		return bgfx::makeRef(_payload, _size, mappedFileReleaseFn, _file);
+	}
+
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+} // namespace
+
+Mesh* meshFileCreate(MeshFileData* _data)
+{
+	Mesh* mesh = BX_NEW(entry::getAllocator(), Mesh);
+	mesh->m_layout = _data->m_mesh.m_layout;
+
+	const uint32_t numGroups = uint32_t(_data->m_mesh.m_groups.size() );
+	for (uint32_t ii = 0; ii < numGroups; ++ii)
+	{
+		const MeshFileGroup& fileGroup = _data->m_mesh.m_groups[ii];
+
+		// m_vertices/m_indices stay NULL, meshUnload() would free them otherwise.
+		Group group;
+		group.m_sphere      = fileGroup.m_sphere;
+		group.m_aabb        = fileGroup.m_aabb;
+		group.m_obb         = fileGroup.m_obb;
+		group.m_numVertices = fileGroup.m_numVertices;
+		group.m_numIndices  = fileGroup.m_numIndices;
+
+		for (const MeshFilePrimitive& filePrim : fileGroup.m_prims)
+		{
+			Primitive prim;
+			prim.m_startIndex  = filePrim.m_startIndex;
+			prim.m_numIndices  = filePrim.m_numIndices;
+			prim.m_startVertex = filePrim.m_startVertex;
+			prim.m_numVertices = filePrim.m_numVertices;
+			prim.m_sphere      = filePrim.m_sphere;
+			prim.m_aabb        = filePrim.m_aabb;
+			prim.m_obb         = filePrim.m_obb;
+			group.m_prims.push_back(prim);
+		}
+
+		group.m_vbh = bgfx::createVertexBuffer(
+			  makePayloadRef(_data->m_file, fileGroup.m_vertices, fileGroup.m_verticesSize, _data->m_ownedVertices[ii])
+			, mesh->m_layout
+			);
+
+		if (0 != fileGroup.m_numIndices)
+		{
+			group.m_ibh = bgfx::createIndexBuffer(
+				makePayloadRef(_data->m_file, fileGroup.m_indices, fileGroup.m_indicesSize, _data->m_ownedIndices[ii])
+				);
+		}
+
+		mesh->m_groups.push_back(group);
+	}
+
+	return mesh;
+}
+
+Mesh* meshLoadMapped(const char* _filePath, MeshLoadStats* _stats)
+{
+	const uint64_t peakResidentBefore = memoryGetPeakResident();
+	const int64_t  start = bx::getHPCounter();
+
+	MeshFileData* data = meshFileOpen(_filePath);
+	if (NULL == data)
+	{
+		return NULL;
+	}
+
+	Mesh* mesh = meshFileCreate(data);
+	const uint32_t copiedBytes = data->m_ownedBytes;
+	meshFileClose(data);
+
+	if (NULL != _stats)
+	{
+		_stats->m_loadTimeMs         = toMs(bx::getHPCounter() - start);
+		_stats->m_copiedBytes        = copiedBytes;
+		_stats->m_peakResidentBefore = peakResidentBefore;
+		_stats->m_peakResidentAfter  = memoryGetPeakResident();
+		_stats->m_mapped             = true;
+	}
+
+	return mesh;
+}
+
+Mesh* meshLoadCopied(const char* _filePath, MeshLoadStats* _stats)
+{
+	const uint64_t peakResidentBefore = memoryGetPeakResident();
+	const int64_t  start = bx::getHPCounter();
+
+	Mesh* mesh = meshLoad(_filePath);
+	if (NULL == mesh)
+	{
+		return NULL;
+	}
+
+	if (NULL != _stats)
+	{
+		// meshLoad() reads every payload into bgfx::alloc'd memory.
+		uint32_t copiedBytes = 0;
+		for (const Group& group : mesh->m_groups)
+		{
+			copiedBytes += group.m_numVertices*mesh->m_layout.getStride();
+			copiedBytes += group.m_numIndices*sizeof(uint16_t);
+		}
+
+		_stats->m_loadTimeMs         = toMs(bx::getHPCounter() - start);
+		_stats->m_copiedBytes        = copiedBytes;
+		_stats->m_peakResidentBefore = peakResidentBefore;
+		_stats->m_peakResidentAfter  = memoryGetPeakResident();
+		_stats->m_mapped             = false;
+	}
+
+	return mesh;
+}
+
+void meshLoadStatsPrint(const char* _filePath, const MeshLoadStats& _stats)
+{
+	const double mb = 1.0 / (1024.0 * 1024.0);
+	printf("[mesh] %s: %s, %.3f ms, copied %.2f MB, peak RSS %.1f -> %.1f MB\n"
+		, _filePath
+		, _stats.m_mapped ? "mapped" : "copied"
+		, _stats.m_loadTimeMs
+		, _stats.m_copiedBytes * mb
+		, _stats.m_peakResidentBefore * mb
+		, _stats.m_peakResidentAfter * mb
+		);
+}
+
+bool meshIsQuantized(const Mesh* _mesh)
+{
+	return meshIsQuantized(_mesh->m_layout);
+}
+
+void meshGetModelMtx(float* _result, const Mesh* _mesh, const float* _mtx)
+{
+	if (!meshIsQuantized(_mesh)
+	||  _mesh->m_groups.empty() )
+	{
+		bx::memCopy(_result, _mtx, 16*sizeof(float) );
+		return;
+	}
+
+	// Group bounds are object space and kept as is by meshFileQuantize(), so they give
+	// back the dequantization the positions were encoded with.
+	bx::Aabb bounds = _mesh->m_groups[0].m_aabb;
+	for (const Group& group : _mesh->m_groups)
+	{
+		bounds.min = bx::min(bounds.min, group.m_aabb.min);
+		bounds.max = bx::max(bounds.max, group.m_aabb.max);
+	}
+
+	const MeshDequantize dequant = meshDequantizeFromBounds(bounds);
+
+	float mtx[16];
+	bx::mtxSRT(mtx
+		, dequant.m_scale, dequant.m_scale, dequant.m_scale
+		, 0.0f, 0.0f, 0.0f
+		, dequant.m_center.x, dequant.m_center.y, dequant.m_center.z
+		);
+	bx::mtxMul(_result, mtx, _mtx);
+}
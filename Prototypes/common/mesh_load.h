@@ -0,0 +1,48 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_MESH_LOAD_H_HEADER_GUARD
+#define PROTOTYPE_MESH_LOAD_H_HEADER_GUARD
+
+#include "bgfx_utils.h"
+#include "mesh_file.h"
+
+// Creates the GPU buffers for parsed mesh data, handing payloads in the mapping to
+// bgfx::makeRef. Runs on the thread that owns bgfx. Call once per data, close it
+// afterwards. Unload the mesh with meshUnload().
+Mesh* meshFileCreate(MeshFileData* _data);
+
+struct MeshLoadStats
+{
+	double m_loadTimeMs;
+
+	// Bytes held outside the mapping, e.g. decoded compressed chunks.
+	uint32_t m_copiedBytes;
+
+	uint64_t m_peakResidentBefore;
+	uint64_t m_peakResidentAfter;
+
+	bool m_mapped;
+};
+
+// Maps the file and hands vertex/index payloads to bgfx::makeRef. The mapping stays
+// alive until bgfx released every buffer created from it.
+Mesh* meshLoadMapped(const char* _filePath, MeshLoadStats* _stats = NULL);
+
+// bgfx_utils' meshLoad() with the same stats, for comparing against meshLoadMapped().
+Mesh* meshLoadCopied(const char* _filePath, MeshLoadStats* _stats = NULL);
+
+// Prints one `[mesh]` line with the load stats.
+void meshLoadStatsPrint(const char* _filePath, const MeshLoadStats& _stats);
+
+// True if the mesh is in the quantized format from mesh_quantize.h and needs the
+// `_quantized` vertex shader variant.
+bool meshIsQuantized(const Mesh* _mesh);
+
+// Model matrix to submit _mesh with. Quantized meshes get their dequantization folded
+// in front of _mtx, other meshes use _mtx as is.
+void meshGetModelMtx(float* _result, const Mesh* _mesh, const float* _mtx);
+
+#endif // PROTOTYPE_MESH_LOAD_H_HEADER_GUARD
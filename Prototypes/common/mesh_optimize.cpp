@@ -0,0 +1,209 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "mesh_optimize.h"
+
+#include <bx/allocator.h>
+#include <meshoptimizer/src/meshoptimizer.h>
+
+#include <stdio.h>
+
+namespace
+{
+	const char* s_stageName[] =
+	{
+		"input",
+		"vertex cache",
+		"overdraw",
+		"vertex fetch",
+	};
+	static_assert(BX_COUNTOF(s_stageName) == MeshOptimizeStage::Count);
+
+	// Raw counters summed over groups, turned into ratios at the end.
+	struct StageCounters
+	{
+		uint64_t m_numTriangles;
+		uint64_t m_numVertices;
+		uint64_t m_verticesTransformed;
+		uint64_t m_pixelsCovered;
+		uint64_t m_pixelsShaded;
+		uint64_t m_bytesFetched;
+		uint64_t m_vertexBytes;
+	};
+
+	void analyze(StageCounters& _counters, const std::vector<uint32_t>& _indices, const std::vector<float>& _positions, uint32_t _numVertices, uint16_t _stride, uint32_t _cacheSize)
+	{
+		const uint32_t numIndices = uint32_t(_indices.size() );
+
+		const meshopt_VertexCacheStatistics cache = meshopt_analyzeVertexCache(_indices.data(), numIndices, _numVertices, _cacheSize, 0, 0);
+		const meshopt_OverdrawStatistics overdraw = meshopt_analyzeOverdraw(_indices.data(), numIndices, _positions.data(), _numVertices, 3*sizeof(float) );
+		const meshopt_VertexFetchStatistics fetch = meshopt_analyzeVertexFetch(_indices.data(), numIndices, _numVertices, _stride);
+
+		_counters.m_numTriangles        += numIndices/3;
+		_counters.m_numVertices         += _numVertices;
+		_counters.m_verticesTransformed += cache.vertices_transformed;
+		_counters.m_pixelsCovered       += overdraw.pixels_covered;
+		_counters.m_pixelsShaded        += overdraw.pixels_shaded;
+		_counters.m_bytesFetched        += fetch.bytes_fetched;
+		_counters.m_vertexBytes         += uint64_t(_numVertices)*_stride;
+	}
+
+	float ratio(uint64_t _num, uint64_t _den)
+	{
+		return 0 != _den ? float(double(_num) / double(_den) ) : 0.0f;
+	}
+
+	void unpackPositions(std::vector<float>& _outPositions, const bgfx::VertexLayout& _layout, const uint8_t* _vertices, uint32_t _numVertices)
+	{
+		_outPositions.resize(_numVertices*3);
+		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		{
+			float pos[4];
+			bgfx::vertexUnpack(pos, bgfx::Attrib::Position, _layout, _vertices, ii);
+			bx::memCopy(&_outPositions[ii*3], pos, 3*sizeof(float) );
+		}
+	}
+
+} // namespace
+
+MeshOptimizeDesc::MeshOptimizeDesc()
+	: m_cacheSize(16)
+	, m_overdrawThreshold(1.05f)
+	, m_fifo(false)
+{
+}
+
+void meshFileOptimize(MeshFileData& _data, const MeshOptimizeDesc& _desc, MeshOptimizeStats* _stats)
+{
+	const bgfx::VertexLayout& layout = _data.m_mesh.m_layout;
+	const uint16_t stride = layout.getStride();
+
+	StageCounters counters[MeshOptimizeStage::Count];
+	bx::memSet(counters, 0, sizeof(counters) );
+
+	std::vector<uint32_t> indices;
+	std::vector<uint32_t> ranges;
+	std::vector<float> positions;
+
+	const uint32_t numGroups = uint32_t(_data.m_mesh.m_groups.size() );
+	for (uint32_t ii = 0; ii < numGroups; ++ii)
+	{
+		MeshFileGroup& group = _data.m_mesh.m_groups[ii];
+		if (0 == group.m_numIndices)
+		{
+			continue;
+		}
+
+		const uint32_t numIndices  = group.m_numIndices;
+		const uint32_t numVertices = group.m_numVertices;
+
+		// Payloads may be unaligned in the mapping, widen through memcpy.
+		indices.resize(numIndices);
+		for (uint32_t jj = 0; jj < numIndices; ++jj)
+		{
+			uint16_t index;
+			bx::memCopy(&index, group.m_indices + jj*sizeof(uint16_t), sizeof(uint16_t) );
+			indices[jj] = index;
+		}
+
+		unpackPositions(positions, layout, group.m_vertices, numVertices);
+		analyze(counters[MeshOptimizeStage::Input], indices, positions, numVertices, stride, _desc.m_cacheSize);
+
+		// Triangles may only move within their primitive, as [start, count) pairs.
+		ranges.clear();
+		for (const MeshFilePrimitive& prim : group.m_prims)
+		{
+			ranges.push_back(prim.m_startIndex);
+			ranges.push_back(prim.m_numIndices);
+		}
+
+		if (ranges.empty() )
+		{
+			ranges.push_back(0);
+			ranges.push_back(numIndices);
+		}
+
+		for (uint32_t jj = 0, num = uint32_t(ranges.size() ); jj < num; jj += 2)
+		{
+			uint32_t* range = &indices[ranges[jj] ];
+			if (_desc.m_fifo)
+			{
+				meshopt_optimizeVertexCacheFifo(range, range, ranges[jj+1], numVertices, _desc.m_cacheSize);
+			}
+			else
+			{
+				meshopt_optimizeVertexCache(range, range, ranges[jj+1], numVertices);
+			}
+		}
+
+		analyze(counters[MeshOptimizeStage::VertexCache], indices, positions, numVertices, stride, _desc.m_cacheSize);
+
+		for (uint32_t jj = 0, num = uint32_t(ranges.size() ); jj < num; jj += 2)
+		{
+			uint32_t* range = &indices[ranges[jj] ];
+			meshopt_optimizeOverdraw(range, range, ranges[jj+1], positions.data(), numVertices, 3*sizeof(float), _desc.m_overdrawThreshold);
+		}
+
+		analyze(counters[MeshOptimizeStage::Overdraw], indices, positions, numVertices, stride, _desc.m_cacheSize);
+
+		uint8_t* vertices = (uint8_t*)bx::alloc(meshFileGetAllocator(), numVertices*stride);
+		const uint32_t numUnique = uint32_t(meshopt_optimizeVertexFetch(vertices, indices.data(), numIndices, group.m_vertices, numVertices, stride) );
+
+		unpackPositions(positions, layout, vertices, numUnique);
+		analyze(counters[MeshOptimizeStage::VertexFetch], indices, positions, numUnique, stride, _desc.m_cacheSize);
+
+		// Remapping scatters each primitive's vertices, refit the ranges.
+		for (MeshFilePrimitive& prim : group.m_prims)
+		{
+			uint32_t minIndex = UINT32_MAX;
+			uint32_t maxIndex = 0;
+			for (uint32_t jj = 0; jj < prim.m_numIndices; ++jj)
+			{
+				const uint32_t index = indices[prim.m_startIndex + jj];
+				minIndex = bx::min(minIndex, index);
+				maxIndex = bx::max(maxIndex, index);
+			}
+
+			prim.m_startVertex = 0 != prim.m_numIndices ? minIndex : 0;
+			prim.m_numVertices = 0 != prim.m_numIndices ? maxIndex - minIndex + 1 : 0;
+		}
+
+		uint16_t* narrowIndices = (uint16_t*)bx::alloc(meshFileGetAllocator(), numIndices*sizeof(uint16_t) );
+		for (uint32_t jj = 0; jj < numIndices; ++jj)
+		{
+			narrowIndices[jj] = uint16_t(indices[jj]);
+		}
+
+		meshFileSetVertices(_data, ii, vertices, uint16_t(numUnique) );
+		meshFileSetIndices(_data, ii, narrowIndices, numIndices);
+	}
+
+	if (NULL != _stats)
+	{
+		for (uint32_t stage = 0; stage < MeshOptimizeStage::Count; ++stage)
+		{
+			const StageCounters& stageCounters = counters[stage];
+			_stats->m_acmr[stage]      = ratio(stageCounters.m_verticesTransformed, stageCounters.m_numTriangles);
+			_stats->m_atvr[stage]      = ratio(stageCounters.m_verticesTransformed, stageCounters.m_numVertices);
+			_stats->m_overdraw[stage]  = ratio(stageCounters.m_pixelsShaded,        stageCounters.m_pixelsCovered);
+			_stats->m_overfetch[stage] = ratio(stageCounters.m_bytesFetched,        stageCounters.m_vertexBytes);
+		}
+	}
+}
+
+void meshOptimizeStatsPrint(const char* _name, const MeshOptimizeStats& _stats)
+{
+	for (uint32_t stage = 0; stage < MeshOptimizeStage::Count; ++stage)
+	{
+		printf("[meshopt] %s: %-12s ACMR %.3f, ATVR %.3f, overdraw %.3f, overfetch %.3f\n"
+			, _name
+			, s_stageName[stage]
+			, _stats.m_acmr[stage]
+			, _stats.m_atvr[stage]
+			, _stats.m_overdraw[stage]
+			, _stats.m_overfetch[stage]
+			);
+	}
+}
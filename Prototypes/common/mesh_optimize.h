@@ -0,0 +1,57 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_MESH_OPTIMIZE_H_HEADER_GUARD
+#define PROTOTYPE_MESH_OPTIMIZE_H_HEADER_GUARD
+
+#include "mesh_file.h"
+
+// Index and vertex reordering for parsed meshes, run by the meshtool offline and by
+// MeshStreamer at load time (`--mesh-optimize`). Passes run in stage order, each on
+// the output of the previous one.
+struct MeshOptimizeStage
+{
+	enum Enum
+	{
+		Input,
+		VertexCache, // Triangle order for the post-transform cache (Forsyth, or Tipsify with m_fifo).
+		Overdraw,    // Cluster order front to back, bounded by the cache threshold.
+		VertexFetch, // Vertex order following first use in the index buffer.
+
+		Count
+	};
+};
+
+struct MeshOptimizeDesc
+{
+	MeshOptimizeDesc();
+
+	// Simulated post-transform cache size.
+	uint32_t m_cacheSize;
+
+	// How much ACMR the overdraw pass may give up, 1.05 allows 5% worse.
+	float m_overdrawThreshold;
+
+	// Tipsify (FIFO cache) instead of the default LRU cache optimizer.
+	bool m_fifo;
+};
+
+// Metrics after each stage, over all groups.
+struct MeshOptimizeStats
+{
+	float m_acmr[MeshOptimizeStage::Count];      // Transformed vertices per triangle.
+	float m_atvr[MeshOptimizeStage::Count];      // Transformed vertices per vertex.
+	float m_overdraw[MeshOptimizeStage::Count];  // Shaded pixels per covered pixel.
+	float m_overfetch[MeshOptimizeStage::Count]; // Fetched bytes per vertex buffer byte.
+};
+
+// Reorders every group's triangles within each primitive and remaps its vertices.
+// Vertices no index refers to are dropped. Results are owned by _data.
+void meshFileOptimize(MeshFileData& _data, const MeshOptimizeDesc& _desc, MeshOptimizeStats* _stats = NULL);
+
+// Prints one `[meshopt]` line per stage.
+void meshOptimizeStatsPrint(const char* _name, const MeshOptimizeStats& _stats);
+
+#endif // PROTOTYPE_MESH_OPTIMIZE_H_HEADER_GUARD
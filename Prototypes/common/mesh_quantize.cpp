@@ -0,0 +1,392 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "mesh_quantize.h"
+
+#include <bx/allocator.h>
+
+#include <stdio.h>
+
+namespace
+{
+	int16_t toSnorm16(float _value)
+	{
+		return int16_t(bx::round(bx::clamp(_value, -1.0f, 1.0f) * 32767.0f) );
+	}
+
+	// Same as the GPU's normalized Int16 fetch.
+	float fromSnorm16(int16_t _value)
+	{
+		return bx::max(float(_value) / 32767.0f, -1.0f);
+	}
+
+	float signNotZero(float _value)
+	{
+		return _value >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	uint32_t getAttribSize(bgfx::AttribType::Enum _type, uint8_t _num)
+	{
+		switch (_type)
+		{
+		case bgfx::AttribType::Uint8:  return _num;
+		case bgfx::AttribType::Uint10: return 4;
+		case bgfx::AttribType::Int16:  return _num*2;
+		case bgfx::AttribType::Half:   return _num*2;
+		default:                       return _num*4;
+		}
+	}
+
+	bool isTexCoord(bgfx::Attrib::Enum _attrib)
+	{
+		return _attrib >= bgfx::Attrib::TexCoord0
+			&& _attrib <= bgfx::Attrib::TexCoord7
+			;
+	}
+
+	void createQuantizedLayout(bgfx::VertexLayout& _outLayout, const bgfx::VertexLayout& _layout)
+	{
+		_outLayout.begin();
+
+		for (uint32_t ii = 0; ii < bgfx::Attrib::Count; ++ii)
+		{
+			const bgfx::Attrib::Enum attrib = bgfx::Attrib::Enum(ii);
+			if (!_layout.has(attrib) )
+			{
+				continue;
+			}
+
+			uint8_t num;
+			bgfx::AttribType::Enum type;
+			bool normalized;
+			bool asInt;
+			_layout.decode(attrib, num, type, normalized, asInt);
+
+			if (bgfx::Attrib::Position == attrib)
+			{
+				_outLayout.add(attrib, 4, bgfx::AttribType::Int16, true);
+			}
+			else if (bgfx::Attrib::Normal == attrib)
+			{
+				_outLayout.add(attrib, 2, bgfx::AttribType::Int16, true);
+			}
+			else if (isTexCoord(attrib)
+				 &&  bgfx::AttribType::Float == type)
+			{
+				_outLayout.add(attrib, num, bgfx::AttribType::Half);
+			}
+			else
+			{
+				_outLayout.add(attrib, num, type, normalized, asInt);
+			}
+		}
+
+		_outLayout.end();
+	}
+
+	// True if the layout stores normals as unorm [0, 1] the shader expands with *2-1.
+	// With asInt, which geometryc writes, vertexUnpack() already returns [-1, 1].
+	bool isNormalBiased(const bgfx::VertexLayout& _layout)
+	{
+		uint8_t num;
+		bgfx::AttribType::Enum type;
+		bool normalized;
+		bool asInt;
+		_layout.decode(bgfx::Attrib::Normal, num, type, normalized, asInt);
+
+		return normalized
+			&& !asInt
+			&& (bgfx::AttribType::Uint8 == type || bgfx::AttribType::Uint10 == type)
+			;
+	}
+
+	// Unit length normal.
+	void unpackNormal(float _out[3], const bgfx::VertexLayout& _layout, const uint8_t* _vertices, uint32_t _index)
+	{
+		float normal[4];
+		bgfx::vertexUnpack(normal, bgfx::Attrib::Normal, _layout, _vertices, _index);
+
+		bx::Vec3 result = { normal[0], normal[1], normal[2] };
+		if (isNormalBiased(_layout) )
+		{
+			result = bx::sub(bx::mul(result, 2.0f), 1.0f);
+		}
+
+		const float len = bx::length(result);
+		result = len > 0.0f ? bx::mul(result, 1.0f / len) : bx::Vec3{ 0.0f, 0.0f, 1.0f };
+		bx::store(_out, result);
+	}
+
+} // namespace
+
+bx::Aabb meshFileGetBounds(const MeshFile& _mesh)
+{
+	if (_mesh.m_groups.empty() )
+	{
+		return { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+	}
+
+	bx::Aabb bounds = _mesh.m_groups[0].m_aabb;
+	for (const MeshFileGroup& group : _mesh.m_groups)
+	{
+		bounds.min = bx::min(bounds.min, group.m_aabb.min);
+		bounds.max = bx::max(bounds.max, group.m_aabb.max);
+	}
+
+	return bounds;
+}
+
+bool meshIsQuantized(const bgfx::VertexLayout& _layout)
+{
+	if (!_layout.has(bgfx::Attrib::Position) )
+	{
+		return false;
+	}
+
+	uint8_t num;
+	bgfx::AttribType::Enum type;
+	bool normalized;
+	bool asInt;
+	_layout.decode(bgfx::Attrib::Position, num, type, normalized, asInt);
+
+	return bgfx::AttribType::Int16 == type
+		&& normalized
+		;
+}
+
+void meshFileDecodeVertices(std::vector<float>& _outPositions, std::vector<float>& _outNormals, const MeshFile& _mesh, uint32_t _group)
+{
+	const bgfx::VertexLayout& layout = _mesh.m_layout;
+	const MeshFileGroup& group = _mesh.m_groups[_group];
+	const uint32_t numVertices = group.m_numVertices;
+
+	_outPositions.resize(numVertices*3);
+	_outNormals.resize(numVertices*3);
+
+	const bool quantized = meshIsQuantized(layout);
+	const bool hasNormal = layout.has(bgfx::Attrib::Normal);
+	const MeshDequantize dequant = quantized
+		? meshDequantizeFromBounds(meshFileGetBounds(_mesh) )
+		: MeshDequantize{ { 0.0f, 0.0f, 0.0f }, 1.0f }
+		;
+
+	for (uint32_t vv = 0; vv < numVertices; ++vv)
+	{
+		float pos[4];
+		bgfx::vertexUnpack(pos, bgfx::Attrib::Position, layout, group.m_vertices, vv);
+		bx::store(&_outPositions[vv*3], bx::mad(bx::load<bx::Vec3>(pos), dequant.m_scale, dequant.m_center) );
+
+		float* normal = &_outNormals[vv*3];
+		if (!hasNormal)
+		{
+			bx::store(normal, bx::Vec3{ 0.0f, 0.0f, 1.0f });
+		}
+		else if (quantized)
+		{
+			float oct[4];
+			bgfx::vertexUnpack(oct, bgfx::Attrib::Normal, layout, group.m_vertices, vv);
+			octDecode(normal, oct);
+		}
+		else
+		{
+			unpackNormal(normal, layout, group.m_vertices, vv);
+		}
+	}
+}
+
+void meshFileQuantize(MeshFileData& _data, MeshQuantizeStats* _stats)
+{
+	const bgfx::VertexLayout layout = _data.m_mesh.m_layout;
+
+	MeshQuantizeStats stats;
+	bx::memSet(&stats, 0, sizeof(stats) );
+	stats.m_strideBefore = layout.getStride();
+	stats.m_strideAfter  = layout.getStride();
+
+	if (meshIsQuantized(layout)
+	||  !layout.has(bgfx::Attrib::Position) )
+	{
+		if (NULL != _stats)
+		{
+			*_stats = stats;
+		}
+
+		return;
+	}
+
+	bgfx::VertexLayout quantized;
+	createQuantizedLayout(quantized, layout);
+	stats.m_strideAfter = quantized.getStride();
+
+	const MeshDequantize dequant = meshDequantizeFromBounds(meshFileGetBounds(_data.m_mesh) );
+	const float invScale = 1.0f / dequant.m_scale;
+
+	const uint16_t posOffset    = quantized.getOffset(bgfx::Attrib::Position);
+	const uint16_t normalOffset = quantized.getOffset(bgfx::Attrib::Normal);
+	const bool hasNormal        = layout.has(bgfx::Attrib::Normal);
+	const bool normalBiased     = hasNormal && isNormalBiased(layout);
+
+	float maxNormalCos = 1.0f;
+
+	// The layout is shared by all groups. Switch it up front, payload sizes follow it,
+	// and read the original vertices through the copy in layout.
+	_data.m_mesh.m_layout = quantized;
+
+	const uint32_t numGroups = uint32_t(_data.m_mesh.m_groups.size() );
+	for (uint32_t ii = 0; ii < numGroups; ++ii)
+	{
+		const MeshFileGroup& group = _data.m_mesh.m_groups[ii];
+		const uint32_t numVertices = group.m_numVertices;
+
+		uint8_t* vertices = (uint8_t*)bx::alloc(meshFileGetAllocator(), numVertices*quantized.getStride() );
+		bx::memSet(vertices, 0, numVertices*quantized.getStride() );
+
+		for (uint32_t vv = 0; vv < numVertices; ++vv)
+		{
+			const uint8_t* src = group.m_vertices + vv*layout.getStride();
+			uint8_t* dst = vertices + vv*quantized.getStride();
+
+			float pos[4];
+			bgfx::vertexUnpack(pos, bgfx::Attrib::Position, layout, group.m_vertices, vv);
+
+			const bx::Vec3 local = bx::mul(bx::sub(bx::load<bx::Vec3>(pos), dequant.m_center), invScale);
+			const int16_t qpos[4] = { toSnorm16(local.x), toSnorm16(local.y), toSnorm16(local.z), 0 };
+			bx::memCopy(dst + posOffset, qpos, sizeof(qpos) );
+
+			const bx::Vec3 decoded =
+			{
+				fromSnorm16(qpos[0])*dequant.m_scale + dequant.m_center.x,
+				fromSnorm16(qpos[1])*dequant.m_scale + dequant.m_center.y,
+				fromSnorm16(qpos[2])*dequant.m_scale + dequant.m_center.z,
+			};
+			stats.m_maxPositionError = bx::max(stats.m_maxPositionError, bx::length(bx::sub(decoded, bx::load<bx::Vec3>(pos) ) ) );
+
+			if (hasNormal)
+			{
+				float normal[3];
+				unpackNormal(normal, layout, group.m_vertices, vv);
+
+				float oct[2];
+				octEncode(oct, normal);
+
+				const int16_t qoct[2] = { toSnorm16(oct[0]), toSnorm16(oct[1]) };
+				bx::memCopy(dst + normalOffset, qoct, sizeof(qoct) );
+
+				const float decodedOct[2] = { fromSnorm16(qoct[0]), fromSnorm16(qoct[1]) };
+				float decodedNormal[3];
+				octDecode(decodedNormal, decodedOct);
+
+				// Against the stored normal as bgfx decodes it, not unpackNormal()'s.
+				float stored[4];
+				bgfx::vertexUnpack(stored, bgfx::Attrib::Normal, layout, group.m_vertices, vv);
+				bx::Vec3 reference = bx::load<bx::Vec3>(stored);
+				if (normalBiased)
+				{
+					reference = bx::sub(bx::mul(reference, 2.0f), 1.0f);
+				}
+
+				const float len = bx::length(reference);
+				if (len > 0.0f)
+				{
+					maxNormalCos = bx::min(maxNormalCos, bx::dot(reference, bx::load<bx::Vec3>(decodedNormal) ) / len);
+				}
+			}
+
+			for (uint32_t aa = 0; aa < bgfx::Attrib::Count; ++aa)
+			{
+				const bgfx::Attrib::Enum attrib = bgfx::Attrib::Enum(aa);
+				if (bgfx::Attrib::Position == attrib
+				||  bgfx::Attrib::Normal   == attrib
+				||  !layout.has(attrib) )
+				{
+					continue;
+				}
+
+				uint8_t num;
+				bgfx::AttribType::Enum srcType;
+				bgfx::AttribType::Enum dstType;
+				bool normalized;
+				bool asInt;
+				layout.decode(attrib, num, srcType, normalized, asInt);
+				quantized.decode(attrib, num, dstType, normalized, asInt);
+
+				if (srcType == dstType)
+				{
+					// Bit exact, a float round trip could change unorm values.
+					bx::memCopy(dst + quantized.getOffset(attrib), src + layout.getOffset(attrib), getAttribSize(srcType, num) );
+				}
+				else
+				{
+					float value[4];
+					bgfx::vertexUnpack(value, attrib, layout, group.m_vertices, vv);
+					bgfx::vertexPack(value, false, attrib, quantized, vertices, vv);
+				}
+			}
+		}
+
+		stats.m_bytesBefore += numVertices*layout.getStride();
+		stats.m_bytesAfter  += numVertices*quantized.getStride();
+
+		meshFileSetVertices(_data, ii, vertices, uint16_t(numVertices) );
+	}
+
+	stats.m_maxNormalErrorDeg = bx::toDeg(bx::acos(bx::clamp(maxNormalCos, -1.0f, 1.0f) ) );
+
+	if (NULL != _stats)
+	{
+		*_stats = stats;
+	}
+}
+
+void meshQuantizeStatsPrint(const char* _name, const MeshQuantizeStats& _stats)
+{
+	printf("[quantize] %s: stride %u -> %u, %u -> %u bytes (%.2fx), max position error %g, max normal error %.4f deg\n"
+		, _name
+		, _stats.m_strideBefore
+		, _stats.m_strideAfter
+		, _stats.m_bytesBefore
+		, _stats.m_bytesAfter
+		, 0 != _stats.m_bytesAfter ? double(_stats.m_bytesBefore) / double(_stats.m_bytesAfter) : 1.0
+		, _stats.m_maxPositionError
+		, _stats.m_maxNormalErrorDeg
+		);
+}
+
+void octEncode(float _out[2], const float _normal[3])
+{
+	const float l1 = bx::abs(_normal[0]) + bx::abs(_normal[1]) + bx::abs(_normal[2]);
+	if (0.0f == l1)
+	{
+		_out[0] = 0.0f;
+		_out[1] = 0.0f;
+		return;
+	}
+
+	float xx = _normal[0] / l1;
+	float yy = _normal[1] / l1;
+
+	// Fold the lower hemisphere over the diagonals.
+	if (_normal[2] < 0.0f)
+	{
+		const float foldX = (1.0f - bx::abs(yy) ) * signNotZero(xx);
+		const float foldY = (1.0f - bx::abs(xx) ) * signNotZero(yy);
+		xx = foldX;
+		yy = foldY;
+	}
+
+	_out[0] = xx;
+	_out[1] = yy;
+}
+
+void octDecode(float _out[3], const float _oct[2])
+{
+	bx::Vec3 normal = { _oct[0], _oct[1], 1.0f - bx::abs(_oct[0]) - bx::abs(_oct[1]) };
+
+	const float tt = bx::max(-normal.z, 0.0f);
+	normal.x += normal.x >= 0.0f ? -tt : tt;
+	normal.y += normal.y >= 0.0f ? -tt : tt;
+
+	bx::store(_out, bx::normalize(normal) );
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_MESH_QUANTIZE_H_HEADER_GUARD
+#define PROTOTYPE_MESH_QUANTIZE_H_HEADER_GUARD
+
+#include "mesh_file.h"
+
+// Compact vertex format for mesh assets:
+//   Position   Int16 x4, normalized. xyz relative to the mesh bounds, w unused.
+//   Normal     Int16 x2, normalized. Octahedral encoded, see Graphics/Packing.sh.
+//   TexcoordN  Half, same number of components.
+// Other attributes keep their format. Positions are scaled uniformly, by the largest
+// half extent of the mesh bounds, so the dequantization folds into the model matrix
+// without skewing normals. Meshes with this layout need the `_quantized` vertex
+// shader variants, which decode the normal with octDecode().
+
+struct MeshDequantize
+{
+	bx::Vec3 m_center;
+	float m_scale;
+};
+
+// Dequantization for positions quantized against _bounds: p = q*m_scale + m_center.
+inline MeshDequantize meshDequantizeFromBounds(const bx::Aabb& _bounds)
+{
+	const bx::Vec3 extent = bx::mul(bx::sub(_bounds.max, _bounds.min), 0.5f);
+
+	MeshDequantize result;
+	result.m_center = bx::mul(bx::add(_bounds.min, _bounds.max), 0.5f);
+	result.m_scale  = bx::max(bx::max(extent.x, extent.y), bx::max(extent.z, 1e-8f) );
+	return result;
+}
+
+// Union of the group bounds, the bounds positions are quantized against.
+bx::Aabb meshFileGetBounds(const MeshFile& _mesh);
+
+// True if the layout's position is in the quantized format.
+bool meshIsQuantized(const bgfx::VertexLayout& _layout);
+
+// Object space positions and unit normals of group _group, three floats per vertex,
+// from either vertex format. Vertices without a normal get +z.
+void meshFileDecodeVertices(std::vector<float>& _outPositions, std::vector<float>& _outNormals, const MeshFile& _mesh, uint32_t _group);
+
+struct MeshQuantizeStats
+{
+	uint16_t m_strideBefore;
+	uint16_t m_strideAfter;
+	uint32_t m_bytesBefore;
+	uint32_t m_bytesAfter;
+
+	// Largest position error in object space units and normal error in degrees.
+	float m_maxPositionError;
+	float m_maxNormalErrorDeg;
+};
+
+// Converts every group to the quantized layout. Results are owned by _data. Does
+// nothing if the mesh is already quantized.
+void meshFileQuantize(MeshFileData& _data, MeshQuantizeStats* _stats = NULL);
+
+// Prints one `[quantize]` line.
+void meshQuantizeStatsPrint(const char* _name, const MeshQuantizeStats& _stats);
+
+// Octahedral normal encoding, matching octEncode()/octDecode() in Graphics/Packing.sh.
+void octEncode(float _out[2], const float _normal[3]);
+void octDecode(float _out[3], const float _oct[2]);
+
+#endif // PROTOTYPE_MESH_QUANTIZE_H_HEADER_GUARD
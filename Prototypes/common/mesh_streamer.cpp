@@ -0,0 +1,341 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "mesh_streamer.h"
+#include "entry/entry.h"
+
+#include <bx/timer.h>
+
+#include <stdio.h>
+
+namespace
+{
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+} // namespace
+
+MeshStreamer::MeshStreamer()
+	: m_jobs(NULL)
+	, m_async(true)
+	, m_optimize(false)
+	, m_quantize(false)
+	, m_numInFlight(0)
+	, m_placeholder(NULL)
+	, m_numRequested(0)
+	, m_numReady(0)
+{
+	bx::memSet(&m_stats, 0, sizeof(m_stats) );
+}
+
+void MeshStreamer::init(JobSystem* _jobs, bool _async, bool _optimize, bool _quantize)
+{
+	m_jobs     = _jobs;
+	m_async    = _async;
+	m_optimize = _optimize;
+	m_quantize = _quantize;
+	m_stats.m_mapped = _async;
+
+	createPlaceholder();
+}
+
+void MeshStreamer::shutdown()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(lock, [this] { return 0 == m_numInFlight; });
+	}
+
+	// Drops the data of loads nobody picked up.
+	for (Entry& entry : m_entries)
+	{
+		entry.m_released = true;
+	}
+	update();
+
+	for (uint16_t ii = 0, num = uint16_t(m_entries.size() ); ii < num; ++ii)
+	{
+		if (!m_entries[ii].m_filePath.empty() )
+		{
+			freeEntry(ii);
+		}
+	}
+
+	m_entries.clear();
+	m_freeEntries.clear();
+
+	if (NULL != m_placeholder)
+	{
+		meshUnload(m_placeholder);
+		m_placeholder = NULL;
+	}
+}
+
+MeshHandle MeshStreamer::request(const char* _filePath)
+{
+	uint16_t idx;
+	if (m_freeEntries.empty() )
+	{
+		BX_ASSERT(m_entries.size() < UINT16_MAX, "Too many meshes.");
+		idx = uint16_t(m_entries.size() );
+		m_entries.emplace_back();
+	}
+	else
+	{
+		idx = m_freeEntries.back();
+		m_freeEntries.pop_back();
+	}
+
+	Entry& entry = m_entries[idx];
+	entry.m_filePath    = _filePath;
+	entry.m_mesh        = NULL;
+	entry.m_requestTime = bx::getHPCounter();
+	entry.m_pending     = true;
+	entry.m_released    = false;
+	++m_numRequested;
+
+	if (!m_async)
+	{
+		MeshLoadStats stats;
+		entry.m_mesh    = meshLoadCopied(_filePath, &stats);
+		entry.m_pending = false;
+
+		if (NULL != entry.m_mesh)
+		{
+			meshLoadStatsPrint(_filePath, stats);
+			m_stats.m_loadTimeMs  += stats.m_loadTimeMs;
+			m_stats.m_copiedBytes += stats.m_copiedBytes;
+			++m_numReady;
+		}
+
+		return { idx };
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_numInFlight;
+	}
+
+	// The worker only sees its own copy of the path and reports back through
+	// m_completed, m_entries stays main thread only.
+	m_jobs->submit([this, idx, filePath = entry.m_filePath]
+		{
+			Completed done;
+			done.m_idx = idx;
+
+			const int64_t start = bx::getHPCounter();
+			done.m_data = meshFileOpen(filePath.c_str(), true);
+			if (m_optimize
+			&&  NULL != done.m_data)
+			{
+				meshFileOptimize(*done.m_data, MeshOptimizeDesc(), &done.m_optimizeStats);
+			}
+
+			if (m_quantize
+			&&  NULL != done.m_data)
+			{
+				meshFileQuantize(*done.m_data, &done.m_quantizeStats);
+			}
+			done.m_workerTimeMs = toMs(bx::getHPCounter() - start);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_completed.push_back(done);
+			--m_numInFlight;
+			m_cv.notify_all();
+		});
+
+	return { idx };
+}
+
+void MeshStreamer::release(MeshHandle _handle)
+{
+	Entry& entry = m_entries[_handle.idx];
+	if (entry.m_pending)
+	{
+		entry.m_released = true;
+		return;
+	}
+
+	freeEntry(_handle.idx);
+}
+
+void MeshStreamer::update()
+{
+	std::vector<Completed> completed;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		completed.swap(m_completed);
+	}
+
+	for (const Completed& done : completed)
+	{
+		Entry& entry = m_entries[done.m_idx];
+		entry.m_pending = false;
+
+		if (entry.m_released)
+		{
+			if (NULL != done.m_data)
+			{
+				meshFileClose(done.m_data);
+			}
+
+			freeEntry(done.m_idx);
+			continue;
+		}
+
+		if (NULL == done.m_data)
+		{
+			printf("[mesh] %s: failed to load, keeping placeholder.\n", entry.m_filePath.c_str() );
+			continue;
+		}
+
+		const int64_t start = bx::getHPCounter();
+		entry.m_mesh = meshFileCreate(done.m_data);
+		const uint32_t copiedBytes = done.m_data->m_ownedBytes;
+		meshFileClose(done.m_data);
+
+		const int64_t now = bx::getHPCounter();
+		const double createTimeMs = toMs(now - start);
+
+		printf("[mesh] %s: streamed, worker %.3f ms, main thread %.3f ms, ready after %.3f ms\n"
+			, entry.m_filePath.c_str()
+			, done.m_workerTimeMs
+			, createTimeMs
+			, toMs(now - entry.m_requestTime)
+			);
+
+		if (m_optimize)
+		{
+			meshOptimizeStatsPrint(entry.m_filePath.c_str(), done.m_optimizeStats);
+		}
+
+		if (m_quantize)
+		{
+			meshQuantizeStatsPrint(entry.m_filePath.c_str(), done.m_quantizeStats);
+		}
+
+		m_stats.m_loadTimeMs  += createTimeMs;
+		m_stats.m_copiedBytes += copiedBytes;
+		++m_numReady;
+	}
+}
+
+void MeshStreamer::flush()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(lock, [this] { return 0 == m_numInFlight; });
+	}
+
+	update();
+}
+
+bool MeshStreamer::isReady(MeshHandle _handle) const
+{
+	return NULL != m_entries[_handle.idx].m_mesh;
+}
+
+const Mesh* MeshStreamer::get(MeshHandle _handle) const
+{
+	const Mesh* mesh = m_entries[_handle.idx].m_mesh;
+	return NULL != mesh ? mesh : m_placeholder;
+}
+
+void MeshStreamer::freeEntry(uint16_t _idx)
+{
+	Entry& entry = m_entries[_idx];
+	if (NULL != entry.m_mesh)
+	{
+		meshUnload(entry.m_mesh);
+		entry.m_mesh = NULL;
+		--m_numReady;
+	}
+
+	entry.m_filePath.clear();
+	--m_numRequested;
+	m_freeEntries.push_back(_idx);
+}
+
+void MeshStreamer::createPlaceholder()
+{
+	struct PosNormalVertex
+	{
+		float m_x;
+		float m_y;
+		float m_z;
+		uint32_t m_normal;
+	};
+
+	bgfx::VertexLayout layout;
+	layout
+		.begin()
+		.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+		.add(bgfx::Attrib::Normal,   4, bgfx::AttribType::Uint8, true, true)
+		.end();
+
+	// Unit cube, 4 vertices per face so the normals are flat.
+	const bgfx::Memory* vertices = bgfx::alloc(24*sizeof(PosNormalVertex) );
+	const bgfx::Memory* indices  = bgfx::alloc(36*sizeof(uint16_t) );
+	PosNormalVertex* vertex = (PosNormalVertex*)vertices->data;
+	uint16_t* index = (uint16_t*)indices->data;
+
+	for (uint32_t face = 0; face < 6; ++face)
+	{
+		const uint32_t axis = face/2;
+		const float    sign = 0 == face%2 ? 1.0f : -1.0f;
+
+		float normal[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		normal[axis] = sign;
+
+		const uint16_t base = uint16_t(face*4);
+		for (uint32_t corner = 0; corner < 4; ++corner)
+		{
+			const float uu = 0 == (corner   &1) ? -1.0f : 1.0f;
+			const float vv = 0 == (corner>>1&1) ? -1.0f : 1.0f;
+
+			float pos[3];
+			pos[axis]       = sign;
+			pos[(axis+1)%3] = uu * sign;
+			pos[(axis+2)%3] = vv;
+
+			vertex->m_x = pos[0];
+			vertex->m_y = pos[1];
+			vertex->m_z = pos[2];
+			bgfx::vertexPack(normal, true, bgfx::Attrib::Normal, layout, &vertex->m_normal);
+			++vertex;
+		}
+
+		const uint16_t quad[6] = { 0, 1, 2, 1, 3, 2 };
+		for (uint16_t ii : quad)
+		{
+			*index++ = base + ii;
+		}
+	}
+
+	Group group;
+	group.m_vbh         = bgfx::createVertexBuffer(vertices, layout);
+	group.m_ibh         = bgfx::createIndexBuffer(indices);
+	group.m_numVertices = 24;
+	group.m_numIndices  = 36;
+	group.m_sphere      = { { 0.0f, 0.0f, 0.0f }, bx::sqrt(3.0f) };
+	group.m_aabb        = { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } };
+	bx::mtxScale(group.m_obb.mtx, 1.0f);
+
+	Primitive prim;
+	prim.m_startIndex  = 0;
+	prim.m_numIndices  = 36;
+	prim.m_startVertex = 0;
+	prim.m_numVertices = 24;
+	prim.m_sphere      = group.m_sphere;
+	prim.m_aabb        = group.m_aabb;
+	prim.m_obb         = group.m_obb;
+	group.m_prims.push_back(prim);
+
+	m_placeholder = BX_NEW(entry::getAllocator(), Mesh);
+	m_placeholder->m_layout = layout;
+	m_placeholder->m_groups.push_back(group);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_MESH_STREAMER_H_HEADER_GUARD
+#define PROTOTYPE_MESH_STREAMER_H_HEADER_GUARD
+
+#include "job_system.h"
+#include "mesh_load.h"
+#include "mesh_optimize.h"
+#include "mesh_quantize.h"
+
+#include <string>
+
+struct MeshHandle { uint16_t idx; };
+inline bool isValid(MeshHandle _handle) { return UINT16_MAX != _handle.idx; }
+
+// Asynchronous mesh loading. request() returns a handle immediately and queues the
+// file mapping, parsing and decoding on the job system. update() runs on the main
+// thread and creates the GPU buffers for whatever finished since the last frame.
+// Until then get() returns a placeholder cube, so callers draw unconditionally.
+class MeshStreamer
+{
+public:
+	MeshStreamer();
+
+	// With _async false request() loads synchronously through bgfx_utils' meshLoad(),
+	// the baseline to compare startup time against. With _optimize the workers run
+	// meshFileOptimize() on every mesh before it's handed to the main thread, and with
+	// _quantize meshFileQuantize() after that (async only).
+	void init(JobSystem* _jobs, bool _async = true, bool _optimize = false, bool _quantize = false);
+
+	// Waits for loads in flight and unloads every mesh.
+	void shutdown();
+
+	MeshHandle request(const char* _filePath);
+
+	// Safe while the load is still in flight, the mesh is dropped when it arrives.
+	void release(MeshHandle _handle);
+
+	// Creates meshes for loads finished since the last call. Main thread, once per frame.
+	void update();
+
+	// Blocks until every request finished and creates the meshes. Used by benchmark
+	// mode so measured frames never see placeholders.
+	void flush();
+
+	bool isReady(MeshHandle _handle) const;
+
+	// Loaded mesh, or the placeholder while streaming or if the load failed.
+	const Mesh* get(MeshHandle _handle) const;
+
+	uint32_t getNumRequested() const { return m_numRequested; }
+	uint32_t getNumReady() const { return m_numReady; }
+
+	// Main thread cost of all loads so far. With async loading this is only buffer
+	// creation, the I/O and decoding run on the workers.
+	const MeshLoadStats& getStats() const { return m_stats; }
+
+private:
+	struct Entry
+	{
+		std::string m_filePath;
+		Mesh* m_mesh;
+		int64_t m_requestTime;
+		bool m_pending;
+		bool m_released;
+	};
+
+	struct Completed
+	{
+		uint16_t m_idx;
+		MeshFileData* m_data;
+		double m_workerTimeMs;
+		MeshOptimizeStats m_optimizeStats;
+		MeshQuantizeStats m_quantizeStats;
+	};
+
+	void freeEntry(uint16_t _idx);
+	void createPlaceholder();
+
+	JobSystem* m_jobs;
+	bool m_async;
+	bool m_optimize;
+	bool m_quantize;
+
+	std::vector<Entry> m_entries;
+	std::vector<uint16_t> m_freeEntries;
+
+	// Shared with the workers.
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::vector<Completed> m_completed;
+	uint32_t m_numInFlight;
+
+	Mesh* m_placeholder;
+	MeshLoadStats m_stats;
+	uint32_t m_numRequested;
+	uint32_t m_numReady;
+};
+
+#endif // PROTOTYPE_MESH_STREAMER_H_HEADER_GUARD
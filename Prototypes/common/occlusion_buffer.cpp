@@ -0,0 +1,484 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "occlusion_buffer.h"
+#include "job_system.h"
+
+#include <bx/simd_t.h>
+#include <bx/timer.h>
+
+namespace
+{
+	// Box corner ii has min or max on x, y and z by bits 0, 1 and 2.
+	const uint16_t s_boxIndices[36] =
+	{
+		0, 1, 3,  0, 3, 2, // -z
+		4, 6, 7,  4, 7, 5, // +z
+		0, 4, 5,  0, 5, 1, // -y
+		2, 3, 7,  2, 7, 6, // +y
+		0, 2, 6,  0, 6, 4, // -x
+		1, 5, 7,  1, 7, 3, // +x
+	};
+
+	void toClip(float* _outClip, const float* _mtx, float _x, float _y, float _z)
+	{
+		_outClip[0] = _x*_mtx[0] + _y*_mtx[4] + _z*_mtx[ 8] + _mtx[12];
+		_outClip[1] = _x*_mtx[1] + _y*_mtx[5] + _z*_mtx[ 9] + _mtx[13];
+		_outClip[2] = _x*_mtx[2] + _y*_mtx[6] + _z*_mtx[10] + _mtx[14];
+		_outClip[3] = _x*_mtx[3] + _y*_mtx[7] + _z*_mtx[11] + _mtx[15];
+	}
+
+} // namespace
+
+OcclusionDesc::OcclusionDesc()
+	: m_width(256)
+	, m_height(128)
+	, m_tileWidth(32)
+	, m_tileHeight(32)
+{
+}
+
+OcclusionBuffer::OcclusionBuffer()
+	: m_homogeneousDepth(false)
+	, m_numTilesX(0)
+	, m_numTilesY(0)
+	, m_numLevels(0)
+	, m_numTileLevels(0)
+{
+	bx::mtxIdentity(m_viewProj);
+	bx::memSet(&m_stats, 0, sizeof(m_stats) );
+}
+
+void OcclusionBuffer::init(const OcclusionDesc& _desc)
+{
+	BX_ASSERT(bx::isPowerOf2(_desc.m_width) && bx::isPowerOf2(_desc.m_height), "Occlusion buffer size must be a power of two.");
+	BX_ASSERT(4 <= _desc.m_tileWidth && bx::isPowerOf2(_desc.m_tileWidth) && bx::isPowerOf2(_desc.m_tileHeight), "Occlusion tiles must be powers of two, at least 4 wide.");
+
+	m_desc = _desc;
+	m_numTilesX = _desc.m_width  / _desc.m_tileWidth;
+	m_numTilesY = _desc.m_height / _desc.m_tileHeight;
+	m_bins.resize(m_numTilesX*m_numTilesY);
+
+	m_depth.resize(uint32_t(_desc.m_width)*_desc.m_height / 4);
+	for (Lanes& lanes : m_depth)
+	{
+		lanes.m_x[0] = lanes.m_x[1] = lanes.m_x[2] = lanes.m_x[3] = 1.0f;
+	}
+
+	// Down to the level where the shorter side is one texel.
+	m_numLevels = bx::min(bx::uint32_cnttz(_desc.m_width), bx::uint32_cnttz(_desc.m_height) ) + 1;
+	m_numTileLevels = bx::min(bx::uint32_cnttz(_desc.m_tileWidth), bx::uint32_cnttz(_desc.m_tileHeight) ) + 1;
+
+	m_levelOffsets.assign(m_numLevels, 0);
+	uint32_t size = 0;
+	for (uint32_t level = 1; level < m_numLevels; ++level)
+	{
+		m_levelOffsets[level] = size;
+		size += (uint32_t(_desc.m_width) >> level) * (uint32_t(_desc.m_height) >> level);
+	}
+
+	m_hiz.assign(size, 1.0f);
+}
+
+void OcclusionBuffer::begin(const float* _view, const float* _proj, bool _homogeneousDepth)
+{
+	bx::mtxMul(m_viewProj, _view, _proj);
+	m_homogeneousDepth = _homogeneousDepth;
+
+	m_triangles.clear();
+	m_stats.m_numOccluders = 0;
+}
+
+void OcclusionBuffer::addOccluder(const float* _vertices, uint32_t _stride, const uint16_t* _indices, uint32_t _numIndices, const float* _mtx)
+{
+	float mvp[16];
+	bx::mtxMul(mvp, _mtx, m_viewProj);
+
+	const uint8_t* vertices = (const uint8_t*)_vertices;
+	for (uint32_t ii = 0; ii + 2 < _numIndices; ii += 3)
+	{
+		float clip[3][4];
+		for (uint32_t jj = 0; jj < 3; ++jj)
+		{
+			const float* pos = (const float*)(vertices + _indices[ii + jj]*_stride);
+			toClip(clip[jj], mvp, pos[0], pos[1], pos[2]);
+		}
+
+		addTriangle(clip[0], clip[1], clip[2]);
+	}
+
+	++m_stats.m_numOccluders;
+}
+
+void OcclusionBuffer::addOccluderBox(const bx::Aabb& _aabb, const float* _mtx)
+{
+	float corners[8][3];
+	for (uint32_t ii = 0; ii < 8; ++ii)
+	{
+		corners[ii][0] = 0 != (ii & 1) ? _aabb.max.x : _aabb.min.x;
+		corners[ii][1] = 0 != (ii & 2) ? _aabb.max.y : _aabb.min.y;
+		corners[ii][2] = 0 != (ii & 4) ? _aabb.max.z : _aabb.min.z;
+	}
+
+	addOccluder(&corners[0][0], sizeof(corners[0]), s_boxIndices, BX_COUNTOF(s_boxIndices), _mtx);
+}
+
+void OcclusionBuffer::addTriangle(const float* _clip0, const float* _clip1, const float* _clip2)
+{
+	// Signed distance to the near plane, z = -w with OpenGL style depth.
+	const float* in[3] = { _clip0, _clip1, _clip2 };
+	float dist[3];
+	uint32_t numInside = 0;
+	for (uint32_t ii = 0; ii < 3; ++ii)
+	{
+		dist[ii] = m_homogeneousDepth ? in[ii][2] + in[ii][3] : in[ii][2];
+		numInside += 0.0f <= dist[ii];
+	}
+
+	if (0 == numInside)
+	{
+		return;
+	}
+
+	// Clip against the near plane, the result is a triangle or a quad.
+	float clipped[4][4];
+	uint32_t numClipped = 0;
+	for (uint32_t ii = 0; ii < 3; ++ii)
+	{
+		const uint32_t jj = (ii + 1) % 3;
+
+		if (0.0f <= dist[ii])
+		{
+			bx::memCopy(clipped[numClipped++], in[ii], sizeof(clipped[0]) );
+		}
+
+		if ( (0.0f <= dist[ii]) != (0.0f <= dist[jj]) )
+		{
+			const float t = dist[ii] / (dist[ii] - dist[jj]);
+			for (uint32_t cc = 0; cc < 4; ++cc)
+			{
+				clipped[numClipped][cc] = bx::lerp(in[ii][cc], in[jj][cc], t);
+			}
+
+			++numClipped;
+		}
+	}
+
+	// Screen space, y down, depth 0 near to 1 far.
+	float screen[4][3];
+	const float width  = float(m_desc.m_width);
+	const float height = float(m_desc.m_height);
+	for (uint32_t ii = 0; ii < numClipped; ++ii)
+	{
+		const float invW = 1.0f / bx::max(clipped[ii][3], 1e-6f);
+		const float z    = clipped[ii][2] * invW;
+		screen[ii][0] = (clipped[ii][0]*invW*0.5f + 0.5f) * width;
+		screen[ii][1] = (0.5f - clipped[ii][1]*invW*0.5f) * height;
+		screen[ii][2] = m_homogeneousDepth ? z*0.5f + 0.5f : z;
+	}
+
+	addScreenTriangle(screen[0], screen[1], screen[2]);
+	if (4 == numClipped)
+	{
+		addScreenTriangle(screen[0], screen[2], screen[3]);
+	}
+}
+
+void OcclusionBuffer::addScreenTriangle(const float* _v0, const float* _v1, const float* _v2)
+{
+	const float area = (_v1[0] - _v0[0])*(_v2[1] - _v0[1]) - (_v2[0] - _v0[0])*(_v1[1] - _v0[1]);
+	if (bx::abs(area) < 1e-6f)
+	{
+		return;
+	}
+
+	Triangle tri;
+	// Clamped as floats, vertices near the near plane can be far off screen.
+	tri.m_minX = int32_t(bx::clamp(bx::floor(bx::min(_v0[0], _v1[0], _v2[0]) ), -1.0f, float(m_desc.m_width) ) );
+	tri.m_minY = int32_t(bx::clamp(bx::floor(bx::min(_v0[1], _v1[1], _v2[1]) ), -1.0f, float(m_desc.m_height) ) );
+	tri.m_maxX = int32_t(bx::clamp(bx::ceil(bx::max(_v0[0], _v1[0], _v2[0]) ),  -1.0f, float(m_desc.m_width  - 1) ) );
+	tri.m_maxY = int32_t(bx::clamp(bx::ceil(bx::max(_v0[1], _v1[1], _v2[1]) ),  -1.0f, float(m_desc.m_height - 1) ) );
+	tri.m_minX = bx::max(tri.m_minX, 0);
+	tri.m_minY = bx::max(tri.m_minY, 0);
+
+	if (tri.m_minX > tri.m_maxX
+	||  tri.m_minY > tri.m_maxY
+	||  1.0f < bx::min(_v0[2], _v1[2], _v2[2]) )
+	{
+		return;
+	}
+
+	// Edge ii runs from vertex ii to ii + 1, oriented so the inside is positive.
+	const float* vertices[3] = { _v0, _v1, _v2 };
+	const float sign = 0.0f < area ? 1.0f : -1.0f;
+	for (uint32_t ii = 0; ii < 3; ++ii)
+	{
+		const float* from = vertices[ii];
+		const float* to   = vertices[(ii + 1) % 3];
+		const float a = sign * (from[1] - to[1]);
+		const float b = sign * (to[0] - from[0]);
+		tri.m_edgeA[ii] = a;
+		tri.m_edgeB[ii] = b;
+		tri.m_edgeC[ii] = -(a*from[0] + b*from[1]);
+	}
+
+	const float invArea = 1.0f / area;
+	const float dzdx = ( (_v1[2] - _v0[2])*(_v2[1] - _v0[1]) - (_v2[2] - _v0[2])*(_v1[1] - _v0[1]) ) * invArea;
+	const float dzdy = ( (_v2[2] - _v0[2])*(_v1[0] - _v0[0]) - (_v1[2] - _v0[2])*(_v2[0] - _v0[0]) ) * invArea;
+	tri.m_depth[0] = dzdx;
+	tri.m_depth[1] = dzdy;
+	tri.m_depth[2] = _v0[2] - dzdx*_v0[0] - dzdy*_v0[1];
+
+	m_triangles.push_back(tri);
+}
+
+void OcclusionBuffer::end(JobSystem* _jobs)
+{
+	const int64_t start = bx::getHPCounter();
+
+	for (std::vector<uint32_t>& bin : m_bins)
+	{
+		bin.clear();
+	}
+
+	const uint32_t tileWidth  = m_desc.m_tileWidth;
+	const uint32_t tileHeight = m_desc.m_tileHeight;
+	for (uint32_t ii = 0, num = uint32_t(m_triangles.size() ); ii < num; ++ii)
+	{
+		const Triangle& tri = m_triangles[ii];
+		for (uint32_t yy = uint32_t(tri.m_minY) / tileHeight, yend = uint32_t(tri.m_maxY) / tileHeight; yy <= yend; ++yy)
+		{
+			for (uint32_t xx = uint32_t(tri.m_minX) / tileWidth, xend = uint32_t(tri.m_maxX) / tileWidth; xx <= xend; ++xx)
+			{
+				m_bins[yy*m_numTilesX + xx].push_back(ii);
+			}
+		}
+	}
+
+	// Tiles own disjoint pixels and HiZ texels down to one texel per tile.
+	jobSystemParallelFor(_jobs, m_numTilesX*m_numTilesY, [this](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t tile = _begin; tile < _end; ++tile)
+		{
+			rasterizeTile(tile);
+		}
+	});
+
+	for (uint32_t level = m_numTileLevels; level < m_numLevels; ++level)
+	{
+		buildLevel(level, 0, 0, uint32_t(m_desc.m_width) >> level, uint32_t(m_desc.m_height) >> level);
+	}
+
+	m_stats.m_numTriangles = uint32_t(m_triangles.size() );
+	m_stats.m_rasterTimeMs = double(bx::getHPCounter() - start) * 1000.0 / double(bx::getHPFrequency() );
+}
+
+void OcclusionBuffer::rasterizeTile(uint32_t _tile)
+{
+	const int32_t tileX0 = int32_t( (_tile % m_numTilesX) * m_desc.m_tileWidth);
+	const int32_t tileY0 = int32_t( (_tile / m_numTilesX) * m_desc.m_tileHeight);
+	const int32_t tileX1 = tileX0 + m_desc.m_tileWidth;
+	const int32_t tileY1 = tileY0 + m_desc.m_tileHeight;
+	const uint32_t width = m_desc.m_width;
+
+	float* depth = &m_depth[0].m_x[0];
+
+	const bx::simd128_t far = bx::simd_splat(1.0f);
+	for (int32_t yy = tileY0; yy < tileY1; ++yy)
+	{
+		for (int32_t xx = tileX0; xx < tileX1; xx += 4)
+		{
+			bx::simd_st(&depth[yy*width + xx], far);
+		}
+	}
+
+	const bx::simd128_t zero    = bx::simd_zero();
+	const bx::simd128_t offsets = bx::simd_ld(0.5f, 1.5f, 2.5f, 3.5f);
+
+	for (const uint32_t idx : m_bins[_tile])
+	{
+		const Triangle& tri = m_triangles[idx];
+
+		const int32_t minX = bx::max(tri.m_minX, tileX0) & ~3;
+		const int32_t maxX = bx::min(tri.m_maxX, tileX1 - 1);
+		const int32_t minY = bx::max(tri.m_minY, tileY0);
+		const int32_t maxY = bx::min(tri.m_maxY, tileY1 - 1);
+
+		const bx::simd128_t a0 = bx::simd_splat(tri.m_edgeA[0]);
+		const bx::simd128_t a1 = bx::simd_splat(tri.m_edgeA[1]);
+		const bx::simd128_t a2 = bx::simd_splat(tri.m_edgeA[2]);
+		const bx::simd128_t dzdx = bx::simd_splat(tri.m_depth[0]);
+
+		for (int32_t yy = minY; yy <= maxY; ++yy)
+		{
+			// Row constant parts at the pixel centers.
+			const float py = float(yy) + 0.5f;
+			const bx::simd128_t row0 = bx::simd_splat(tri.m_edgeB[0]*py + tri.m_edgeC[0]);
+			const bx::simd128_t row1 = bx::simd_splat(tri.m_edgeB[1]*py + tri.m_edgeC[1]);
+			const bx::simd128_t row2 = bx::simd_splat(tri.m_edgeB[2]*py + tri.m_edgeC[2]);
+			const bx::simd128_t rowZ = bx::simd_splat(tri.m_depth[1]*py + tri.m_depth[2]);
+
+			// Narrow the bounding box to the span of pixel centers inside every edge on
+			// this row, long thin triangles would mostly test empty pixels otherwise.
+			float spanMin = float(minX);
+			float spanMax = float(maxX) + 1.0f;
+			for (uint32_t ii = 0; ii < 3; ++ii)
+			{
+				const float a = tri.m_edgeA[ii];
+				const float c = tri.m_edgeB[ii]*py + tri.m_edgeC[ii];
+				if (0.0f < a)
+				{
+					spanMin = bx::max(spanMin, -c/a - 0.5f);
+				}
+				else if (0.0f > a)
+				{
+					spanMax = bx::min(spanMax, -c/a - 0.5f);
+				}
+				else if (0.0f > c)
+				{
+					spanMax = spanMin - 1.0f;
+				}
+			}
+
+			if (spanMin > spanMax)
+			{
+				continue;
+			}
+
+			// Whole pixels, a block of 4 around each end, the edge tests do the rest.
+			const int32_t x0 = bx::max(int32_t(bx::floor(spanMin) ) - 1, minX) & ~3;
+			const int32_t x1 = bx::min(int32_t(bx::ceil(spanMax) ) + 1, maxX);
+
+			float* dst = &depth[yy*width];
+			for (int32_t xx = x0; xx <= x1; xx += 4)
+			{
+				const bx::simd128_t px = bx::simd_add(bx::simd_splat(float(xx) ), offsets);
+
+				const bx::simd128_t e0 = bx::simd_madd(a0, px, row0);
+				const bx::simd128_t e1 = bx::simd_madd(a1, px, row1);
+				const bx::simd128_t e2 = bx::simd_madd(a2, px, row2);
+				const bx::simd128_t inside = bx::simd_and(
+					  bx::simd_and(bx::simd_cmpge(e0, zero), bx::simd_cmpge(e1, zero) )
+					, bx::simd_cmpge(e2, zero)
+					);
+
+				const bx::simd128_t zz  = bx::simd_max(bx::simd_madd(dzdx, px, rowZ), zero);
+				const bx::simd128_t old = bx::simd_ld(&dst[xx]);
+				bx::simd_st(&dst[xx], bx::simd_selb(inside, bx::simd_min(old, zz), old) );
+			}
+		}
+	}
+
+	for (uint32_t level = 1; level < m_numTileLevels; ++level)
+	{
+		buildLevel(level
+			, uint32_t(tileX0) >> level
+			, uint32_t(tileY0) >> level
+			, uint32_t(tileX1) >> level
+			, uint32_t(tileY1) >> level
+			);
+	}
+}
+
+void OcclusionBuffer::buildLevel(uint32_t _level, uint32_t _x0, uint32_t _y0, uint32_t _x1, uint32_t _y1)
+{
+	const uint32_t srcWidth = uint32_t(m_desc.m_width) >> (_level - 1);
+	const uint32_t dstWidth = srcWidth / 2;
+	const float* src = getLevel(_level - 1);
+	float* dst = getLevel(_level);
+
+	for (uint32_t yy = _y0; yy < _y1; ++yy)
+	{
+		const float* row0 = &src[(yy*2    )*srcWidth];
+		const float* row1 = &src[(yy*2 + 1)*srcWidth];
+		for (uint32_t xx = _x0; xx < _x1; ++xx)
+		{
+			dst[yy*dstWidth + xx] = bx::max(row0[xx*2], row0[xx*2 + 1], row1[xx*2], row1[xx*2 + 1]);
+		}
+	}
+}
+
+float* OcclusionBuffer::getLevel(uint32_t _level)
+{
+	return 0 == _level ? &m_depth[0].m_x[0] : &m_hiz[m_levelOffsets[_level] ];
+}
+
+const float* OcclusionBuffer::getLevel(uint32_t _level) const
+{
+	return 0 == _level ? &m_depth[0].m_x[0] : &m_hiz[m_levelOffsets[_level] ];
+}
+
+bool OcclusionBuffer::isVisible(const bx::Aabb& _aabb) const
+{
+	float minX =  bx::kFloatInfinity, minY =  bx::kFloatInfinity, minZ = bx::kFloatInfinity;
+	float maxX = -bx::kFloatInfinity, maxY = -bx::kFloatInfinity;
+
+	for (uint32_t ii = 0; ii < 8; ++ii)
+	{
+		float clip[4];
+		toClip(clip, m_viewProj
+			, 0 != (ii & 1) ? _aabb.max.x : _aabb.min.x
+			, 0 != (ii & 2) ? _aabb.max.y : _aabb.min.y
+			, 0 != (ii & 4) ? _aabb.max.z : _aabb.min.z
+			);
+
+		const float dist = m_homogeneousDepth ? clip[2] + clip[3] : clip[2];
+		if (0.0f > dist)
+		{
+			return true;
+		}
+
+		const float invW = 1.0f / bx::max(clip[3], 1e-6f);
+		const float z    = clip[2] * invW;
+		minX = bx::min(minX, clip[0]*invW);
+		maxX = bx::max(maxX, clip[0]*invW);
+		minY = bx::min(minY, clip[1]*invW);
+		maxY = bx::max(maxY, clip[1]*invW);
+		minZ = bx::min(minZ, m_homogeneousDepth ? z*0.5f + 0.5f : z);
+	}
+
+	const int32_t width  = m_desc.m_width;
+	const int32_t height = m_desc.m_height;
+	const int32_t x0 = int32_t(bx::floor( (minX*0.5f + 0.5f) * float(width) ) );
+	const int32_t x1 = int32_t(bx::floor( (maxX*0.5f + 0.5f) * float(width) ) );
+	const int32_t y0 = int32_t(bx::floor( (0.5f - maxY*0.5f) * float(height) ) );
+	const int32_t y1 = int32_t(bx::floor( (0.5f - minY*0.5f) * float(height) ) );
+
+	if (x1 < 0 || x0 >= width
+	||  y1 < 0 || y0 >= height)
+	{
+		return true;
+	}
+
+	const uint32_t rectX0 = uint32_t(bx::max(x0, 0) );
+	const uint32_t rectY0 = uint32_t(bx::max(y0, 0) );
+	const uint32_t rectX1 = uint32_t(bx::min(x1, width  - 1) );
+	const uint32_t rectY1 = uint32_t(bx::min(y1, height - 1) );
+
+	// Finest level where the rectangle is at most two texels across, it touches at most
+	// four per side there.
+	const uint32_t size = bx::max(rectX1 - rectX0, rectY1 - rectY0);
+	uint32_t level = 0;
+	while (level + 1 < m_numLevels
+	&&     2 < (size >> level) )
+	{
+		++level;
+	}
+
+	const float* hiz = getLevel(level);
+	const uint32_t levelWidth = uint32_t(width) >> level;
+	for (uint32_t yy = rectY0 >> level, yend = rectY1 >> level; yy <= yend; ++yy)
+	{
+		for (uint32_t xx = rectX0 >> level, xend = rectX1 >> level; xx <= xend; ++xx)
+		{
+			if (minZ <= hiz[yy*levelWidth + xx])
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
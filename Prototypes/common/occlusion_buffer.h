@@ -0,0 +1,140 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_OCCLUSION_BUFFER_H_HEADER_GUARD
+#define PROTOTYPE_OCCLUSION_BUFFER_H_HEADER_GUARD
+
+#include <bx/bounds.h>
+#include <bx/math.h>
+
+#include <vector>
+
+class JobSystem;
+
+struct OcclusionDesc
+{
+	OcclusionDesc();
+
+	// Depth buffer size, powers of two and multiples of the tile size.
+	uint16_t m_width;
+	uint16_t m_height;
+
+	// Tiles are rasterized in parallel, four pixels per SIMD instruction. Powers of two,
+	// at least four pixels wide.
+	uint16_t m_tileWidth;
+	uint16_t m_tileHeight;
+};
+
+struct OcclusionStats
+{
+	uint32_t m_numOccluders;
+
+	// Triangles left after near plane clipping and off screen rejection.
+	uint32_t m_numTriangles;
+
+	// end(): binning, rasterization and the HiZ.
+	double m_rasterTimeMs;
+};
+
+// Low resolution software depth buffer for CPU occlusion culling, no bgfx involved so
+// tools can benchmark it. A handful of large occluders are rasterized each frame, then
+// the screen rectangle of each mesh is tested against a max depth pyramid (HiZ) before
+// submission:
+//
+//   m_occlusion.begin(view, proj, homogeneousDepth);
+//   m_occlusion.addOccluderBox(aabb, mtx);
+//   m_occlusion.end(&m_jobs);
+//   m_drawList.cull(view, proj, &m_occlusion);
+//
+// Pixels are covered when their center is inside a triangle, so an occluder may cover
+// up to half a pixel more than it does on screen. Keep occluders inside what they stand
+// for, e.g. the ground cube's own box.
+class OcclusionBuffer
+{
+public:
+	OcclusionBuffer();
+
+	void init(const OcclusionDesc& _desc = OcclusionDesc() );
+
+	// Starts a frame for a camera. _proj is a bx perspective projection, _homogeneousDepth
+	// bgfx::Caps::homogeneousDepth.
+	void begin(const float* _view, const float* _proj, bool _homogeneousDepth);
+
+	// Indexed triangle list. _vertices are model space positions _stride bytes apart,
+	// winding doesn't matter.
+	void addOccluder(const float* _vertices, uint32_t _stride, const uint16_t* _indices, uint32_t _numIndices, const float* _mtx);
+	void addOccluderBox(const bx::Aabb& _aabb, const float* _mtx);
+
+	// Rasterizes the occluders and builds the HiZ, in parallel over tiles. Without _jobs
+	// it runs on the calling thread.
+	void end(JobSystem* _jobs = NULL);
+
+	// False if the world space _aabb is behind the occluders everywhere on screen. Boxes
+	// crossing the near plane or off screen are visible, frustum culling handles those.
+	bool isVisible(const bx::Aabb& _aabb) const;
+
+	// Depth of the last end(), 0 near to 1 far, rows top down.
+	const float* getDepth() const { return &m_depth[0].m_x[0]; }
+	uint16_t getWidth() const { return m_desc.m_width; }
+	uint16_t getHeight() const { return m_desc.m_height; }
+
+	const OcclusionDesc& getDesc() const { return m_desc; }
+	const OcclusionStats& getStats() const { return m_stats; }
+
+private:
+	// Screen space triangle. Edge functions are A*x + B*y + C, positive inside, depth
+	// is the plane a*x + b*y + c.
+	struct Triangle
+	{
+		float m_edgeA[3];
+		float m_edgeB[3];
+		float m_edgeC[3];
+		float m_depth[3];
+		int32_t m_minX;
+		int32_t m_minY;
+		int32_t m_maxX;
+		int32_t m_maxY;
+	};
+
+	struct Lanes
+	{
+		BX_ALIGN_DECL_16(float m_x[4]);
+	};
+
+	void addTriangle(const float* _clip0, const float* _clip1, const float* _clip2);
+	void addScreenTriangle(const float* _v0, const float* _v1, const float* _v2);
+	void rasterizeTile(uint32_t _tile);
+
+	// Farthest depth of each 2x2 block of _level - 1, over [_x0, _x1) x [_y0, _y1) of
+	// _level.
+	void buildLevel(uint32_t _level, uint32_t _x0, uint32_t _y0, uint32_t _x1, uint32_t _y1);
+
+	float* getLevel(uint32_t _level);
+	const float* getLevel(uint32_t _level) const;
+
+	OcclusionDesc m_desc;
+	float m_viewProj[16];
+	bool m_homogeneousDepth;
+
+	std::vector<Triangle> m_triangles;
+
+	// Triangle indices per tile, rows of tiles top down.
+	std::vector<std::vector<uint32_t> > m_bins;
+	uint32_t m_numTilesX;
+	uint32_t m_numTilesY;
+
+	// HiZ level 0 is the depth buffer, levels 1 and up follow in m_hiz.
+	std::vector<Lanes> m_depth;
+	std::vector<float> m_hiz;
+	std::vector<uint32_t> m_levelOffsets;
+	uint32_t m_numLevels;
+
+	// Levels built by the tile jobs, the rest cover several tiles per texel.
+	uint32_t m_numTileLevels;
+
+	OcclusionStats m_stats;
+};
+
+#endif // PROTOTYPE_OCCLUSION_BUFFER_H_HEADER_GUARD
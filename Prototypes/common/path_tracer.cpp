@@ -0,0 +1,865 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "path_tracer.h"
+#include "bxdfs.h"
+#include "job_system.h"
+
+#include <bx/simd_t.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <atomic>
+
+namespace
+{
+	// Pixels per side of a tile, one job each.
+	constexpr uint32_t kTileSize = 16;
+
+	// Triangles per leaf are at most this many blocks of four.
+	constexpr uint32_t kMaxLeafBlocks = 2;
+
+	constexpr uint32_t kNumBins = 12;
+
+	// Levels of the BVH, the size of intersect()'s traversal stack. Nodes this deep are
+	// leaves whatever their size.
+	constexpr uint32_t kMaxDepth = 64;
+
+	// Rays leave surfaces this far along the geometric normal.
+	constexpr float kRayEpsilon = 1e-4f;
+
+	// GGX needs a lobe, a perfect mirror would be a delta distribution.
+	constexpr float kMinAlpha = 1e-3f;
+
+	// PCG hash, one stream per pixel sample.
+	struct Random
+	{
+		Random(uint32_t _seed)
+			: m_state(_seed)
+		{
+			next();
+		}
+
+		uint32_t next()
+		{
+			m_state = m_state*747796405u + 2891336453u;
+			const uint32_t word = ( (m_state >> ( (m_state >> 28u) + 4u) ) ^ m_state) * 277803737u;
+			return (word >> 22u) ^ word;
+		}
+
+		float nextFloat()
+		{
+			return float(next() >> 8) * (1.0f / 16777216.0f);
+		}
+
+		uint32_t m_state;
+	};
+
+	uint32_t hashSeed(uint32_t _a, uint32_t _b)
+	{
+		uint32_t hash = _a*0x9e3779b9u ^ (_b + 0x7f4a7c15u + (_a << 6) + (_a >> 2) );
+		hash ^= hash >> 16;
+		hash *= 0x85ebca6bu;
+		hash ^= hash >> 13;
+		return hash;
+	}
+
+	BxdfVec3<float> toBxdf(const bx::Vec3& _a)
+	{
+		return { _a.x, _a.y, _a.z };
+	}
+
+	bx::Vec3 fromBxdf(const BxdfVec3<float>& _a)
+	{
+		return { _a.x, _a.y, _a.z };
+	}
+
+	// Orthonormal basis around unit _n, Duff et al. 2017.
+	void tangentFrame(bx::Vec3& _outT, bx::Vec3& _outB, const bx::Vec3& _n)
+	{
+		const float sign = 0.0f <= _n.z ? 1.0f : -1.0f;
+		const float a = -1.0f / (sign + _n.z);
+		const float b = _n.x * _n.y * a;
+		_outT = { 1.0f + sign*_n.x*_n.x*a, sign*b, -sign*_n.x };
+		_outB = { b, sign + _n.y*_n.y*a, -_n.y };
+	}
+
+	bx::Vec3 fromTangent(const bx::Vec3& _t, const bx::Vec3& _b, const bx::Vec3& _n, float _x, float _y, float _z)
+	{
+		return bx::add(bx::add(bx::mul(_t, _x), bx::mul(_b, _y) ), bx::mul(_n, _z) );
+	}
+
+	// Surface response of a LightsBasic material, the terms of fs_lightsbasic.sc.
+	struct Brdf
+	{
+		Brdf(const PathTracerMaterial& _material)
+		{
+			m_f0       = { _material.m_f0[0], _material.m_f0[1], _material.m_f0[2] };
+			m_diffuse  = bx::mul(bx::Vec3{ _material.m_albedo[0], _material.m_albedo[1], _material.m_albedo[2] }, 1.0f - _material.m_metallic);
+			m_f90      = bx::clamp(50.0f * bx::dot(m_f0, { 0.33f, 0.33f, 0.33f }), 0.0f, 1.0f);
+			m_roughness = _material.m_roughness;
+			m_alpha    = bx::max(_material.m_roughness*_material.m_roughness, kMinAlpha);
+
+			// Lobe picked by its share of the reflectance at normal incidence.
+			const float specular = (m_f0.x + m_f0.y + m_f0.z) / 3.0f;
+			const float diffuse  = (m_diffuse.x + m_diffuse.y + m_diffuse.z) / 3.0f;
+			m_specularProb = 0.0f >= diffuse  ? 1.0f
+				: 0.0f >= specular ? 0.0f
+				: bx::clamp(specular / (specular + diffuse), 0.1f, 0.9f)
+				;
+		}
+
+		// f(V, L), not including N.L.
+		bx::Vec3 eval(const bx::Vec3& _n, const bx::Vec3& _v, const bx::Vec3& _l) const
+		{
+			const float NdotV = bx::abs(bx::dot(_n, _v) ) + 1e-5f;
+			const bx::Vec3 h  = bx::normalize(bx::add(_v, _l) );
+			const float LdotH = bx::clamp(bx::dot(_l, h), 0.0f, 1.0f);
+			const float NdotH = bx::clamp(bx::dot(_n, h), 0.0f, 1.0f);
+			const float NdotL = bx::clamp(bx::dot(_n, _l), 0.0f, 1.0f);
+
+			const bx::Vec3 F = fromBxdf(F_Schlick(toBxdf(m_f0), m_f90, LdotH) );
+			const float G  = G_SmithGGXCorrelated(NdotV, NdotL, m_alpha);
+			const float D  = D_GGX(NdotH, m_alpha);
+			const bx::Vec3 Fr = bx::mul(F, D * G / bx::kPi);
+
+			const float Fd = Fr_DisneyDiffuse(NdotV, NdotL, LdotH, m_roughness) / bx::kPi;
+
+			return bx::add(Fr, bx::mul(m_diffuse, Fd) );
+		}
+
+		// Picks the specular lobe with m_specularProb, GGX distributed half vectors, and
+		// the cosine weighted diffuse lobe otherwise.
+		bx::Vec3 sample(const bx::Vec3& _n, const bx::Vec3& _v, float _u0, float _u1, float _u2) const
+		{
+			bx::Vec3 t;
+			bx::Vec3 b;
+			tangentFrame(t, b, _n);
+
+			const float phi = bx::kPi2 * _u1;
+
+			if (_u0 < m_specularProb)
+			{
+				const float alpha2   = m_alpha*m_alpha;
+				const float cosTheta = bx::sqrt( (1.0f - _u2) / (1.0f + (alpha2 - 1.0f)*_u2) );
+				const float sinTheta = bx::sqrt(bx::max(1.0f - cosTheta*cosTheta, 0.0f) );
+				const bx::Vec3 h = fromTangent(t, b, _n, sinTheta*bx::cos(phi), sinTheta*bx::sin(phi), cosTheta);
+				return bx::sub(bx::mul(h, 2.0f*bx::dot(_v, h) ), _v);
+			}
+
+			const float radius = bx::sqrt(_u2);
+			return fromTangent(t, b, _n, radius*bx::cos(phi), radius*bx::sin(phi), bx::sqrt(bx::max(1.0f - _u2, 0.0f) ) );
+		}
+
+		// Density of sample() over solid angle.
+		float pdf(const bx::Vec3& _n, const bx::Vec3& _v, const bx::Vec3& _l) const
+		{
+			const float NdotL = bx::dot(_n, _l);
+			if (0.0f >= NdotL)
+			{
+				return 0.0f;
+			}
+
+			const bx::Vec3 h  = bx::normalize(bx::add(_v, _l) );
+			const float NdotH = bx::clamp(bx::dot(_n, h), 0.0f, 1.0f);
+			const float VdotH = bx::max(bx::dot(_v, h), 1e-6f);
+
+			// D_GGX() leaves the 1/PI to the caller.
+			const float specular = D_GGX(NdotH, m_alpha) / bx::kPi * NdotH / (4.0f*VdotH);
+			const float diffuse  = NdotL / bx::kPi;
+			return bx::lerp(diffuse, specular, m_specularProb);
+		}
+
+		bx::Vec3 m_f0;
+		bx::Vec3 m_diffuse;
+		float m_f90;
+		float m_roughness;
+		float m_alpha;
+		float m_specularProb;
+	};
+
+	// Distance along the ray to _min/_max, kFloatInfinity if it misses before _tMax.
+	float intersectBox(const float* _min, const float* _max, const bx::Vec3& _origin, const bx::Vec3& _invDir, float _tMax)
+	{
+		const float tx0 = (_min[0] - _origin.x) * _invDir.x;
+		const float tx1 = (_max[0] - _origin.x) * _invDir.x;
+		const float ty0 = (_min[1] - _origin.y) * _invDir.y;
+		const float ty1 = (_max[1] - _origin.y) * _invDir.y;
+		const float tz0 = (_min[2] - _origin.z) * _invDir.z;
+		const float tz1 = (_max[2] - _origin.z) * _invDir.z;
+
+		const float tNear = bx::max(bx::min(tx0, tx1), bx::min(ty0, ty1), bx::min(tz0, tz1), 0.0f);
+		const float tFar  = bx::min(bx::max(tx0, tx1), bx::max(ty0, ty1), bx::max(tz0, tz1), _tMax);
+		return tNear <= tFar ? tNear : bx::kFloatInfinity;
+	}
+
+	float surfaceArea(const bx::Aabb& _aabb)
+	{
+		const bx::Vec3 size = bx::sub(_aabb.max, _aabb.min);
+		return 2.0f * (size.x*size.y + size.y*size.z + size.z*size.x);
+	}
+
+	bx::Aabb merge(const bx::Aabb& _a, const bx::Aabb& _b)
+	{
+		return { bx::min(_a.min, _b.min), bx::max(_a.max, _b.max) };
+	}
+
+	const bx::Aabb kEmptyAabb =
+	{
+		{  bx::kFloatInfinity,  bx::kFloatInfinity,  bx::kFloatInfinity },
+		{ -bx::kFloatInfinity, -bx::kFloatInfinity, -bx::kFloatInfinity },
+	};
+
+} // namespace
+
+struct PathTracer::Ray
+{
+	bx::Vec3 m_origin;
+	bx::Vec3 m_dir;
+	bx::Vec3 m_invDir;
+	float m_tMax;
+};
+
+struct PathTracer::Hit
+{
+	float m_t;
+	float m_u;
+	float m_v;
+	uint32_t m_triangle;
+};
+
+PathTracerDesc::PathTracerDesc()
+	: m_width(640)
+	, m_height(360)
+	, m_numSamples(64)
+	, m_maxBounces(8)
+	, m_fovY(60.0f)
+	, m_envIntensity(1.0f)
+	, m_seed(0)
+{
+}
+
+PathTracer::PathTracer()
+	: m_env(NULL)
+	, m_envWidth(0)
+	, m_envHeight(0)
+{
+	bx::memSet(&m_stats, 0, sizeof(m_stats) );
+}
+
+void PathTracer::addMesh(const float* _positions
+	, const float* _normals
+	, uint32_t _numVertices
+	, const uint16_t* _indices
+	, uint32_t _numIndices
+	, const float* _mtx
+	, const PathTracerMaterial& _material
+	)
+{
+	const uint32_t material = uint32_t(m_materials.size() );
+	m_materials.push_back(_material);
+
+	for (uint32_t ii = 0; ii + 2 < _numIndices; ii += 3)
+	{
+		Triangle tri;
+		tri.m_material = material;
+
+		for (uint32_t jj = 0; jj < 3; ++jj)
+		{
+			const uint32_t index = _indices[ii + jj];
+			BX_ASSERT(index < _numVertices, "Index %u out of range.", index);
+			BX_UNUSED(_numVertices);
+
+			bx::store(tri.m_pos[jj],    bx::mul(bx::load<bx::Vec3>(&_positions[index*3]), _mtx) );
+			bx::store(tri.m_normal[jj], bx::normalize(bx::mulXyz0(bx::load<bx::Vec3>(&_normals[index*3]), _mtx) ) );
+		}
+
+		m_triangles.push_back(tri);
+	}
+}
+
+void PathTracer::addLight(const PathTracerPointLight& _light)
+{
+	m_lights.push_back(_light);
+}
+
+void PathTracer::setEnvironment(const float* _rgba, uint32_t _width, uint32_t _height)
+{
+	m_env       = _rgba;
+	m_envWidth  = _width;
+	m_envHeight = _height;
+}
+
+void PathTracer::build()
+{
+	const int64_t start = bx::getHPCounter();
+
+	const uint32_t numTriangles = uint32_t(m_triangles.size() );
+
+	std::vector<bx::Aabb> bounds(numTriangles);
+	std::vector<uint32_t> order(numTriangles);
+	for (uint32_t ii = 0; ii < numTriangles; ++ii)
+	{
+		const Triangle& tri = m_triangles[ii];
+		const bx::Vec3 p0 = bx::load<bx::Vec3>(tri.m_pos[0]);
+		const bx::Vec3 p1 = bx::load<bx::Vec3>(tri.m_pos[1]);
+		const bx::Vec3 p2 = bx::load<bx::Vec3>(tri.m_pos[2]);
+		bounds[ii] = { bx::min(p0, p1, p2), bx::max(p0, p1, p2) };
+		order[ii]  = ii;
+	}
+
+	m_nodes.clear();
+	m_blocks.clear();
+	if (0 != numTriangles)
+	{
+		m_nodes.reserve(2*(numTriangles/4 + 1) );
+		m_nodes.emplace_back();
+		buildNode(0, 0, 0, numTriangles, order, bounds);
+	}
+
+	m_stats.m_numTriangles = numTriangles;
+	m_stats.m_numNodes     = uint32_t(m_nodes.size() );
+	m_stats.m_buildTimeMs  = double(bx::getHPCounter() - start) * 1000.0 / double(bx::getHPFrequency() );
+}
+
+void PathTracer::buildNode(uint32_t _node, uint32_t _depth, uint32_t _begin, uint32_t _end, std::vector<uint32_t>& _order, const std::vector<bx::Aabb>& _bounds)
+{
+	bx::Aabb box = kEmptyAabb;
+	bx::Aabb centroids = kEmptyAabb;
+	for (uint32_t ii = _begin; ii < _end; ++ii)
+	{
+		const bx::Aabb& bounds = _bounds[_order[ii] ];
+		const bx::Vec3 center = bx::mul(bx::add(bounds.min, bounds.max), 0.5f);
+		box = merge(box, bounds);
+		centroids = merge(centroids, { center, center });
+	}
+
+	bx::store(m_nodes[_node].m_min, box.min);
+	bx::store(m_nodes[_node].m_max, box.max);
+
+	const uint32_t num = _end - _begin;
+	const bx::Vec3 extent = bx::sub(centroids.max, centroids.min);
+	const uint32_t axis = extent.x > extent.y
+		? (extent.x > extent.z ? 0 : 2)
+		: (extent.y > extent.z ? 1 : 2)
+		;
+	const float axisMin    = (&centroids.min.x)[axis];
+	const float axisExtent = (&extent.x)[axis];
+
+	// Binned SAH over the longest centroid axis. Costs count blocks of four, that is
+	// what a leaf tests.
+	uint32_t bestSplit = 0;
+	float bestCost = bx::kFloatInfinity;
+
+	// Internal nodes push at most one entry each, the deepest ones stay below kMaxDepth.
+	if (num > 4
+	&&  axisExtent > 0.0f
+	&&  _depth + 1 < kMaxDepth)
+	{
+		bx::Aabb binBounds[kNumBins];
+		uint32_t binCounts[kNumBins] = {};
+		for (uint32_t ii = 0; ii < kNumBins; ++ii)
+		{
+			binBounds[ii] = kEmptyAabb;
+		}
+
+		const float scale = float(kNumBins) / axisExtent;
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			const bx::Aabb& bounds = _bounds[_order[ii] ];
+			const float center = ( (&bounds.min.x)[axis] + (&bounds.max.x)[axis]) * 0.5f;
+			const uint32_t bin = bx::min(uint32_t( (center - axisMin) * scale), kNumBins - 1);
+			binBounds[bin] = merge(binBounds[bin], bounds);
+			++binCounts[bin];
+		}
+
+		float rightArea[kNumBins];
+		uint32_t rightCount[kNumBins];
+		bx::Aabb right = kEmptyAabb;
+		uint32_t count = 0;
+		for (uint32_t ii = kNumBins - 1; ii > 0; --ii)
+		{
+			right = merge(right, binBounds[ii]);
+			count += binCounts[ii];
+			rightArea[ii]  = surfaceArea(right);
+			rightCount[ii] = count;
+		}
+
+		bx::Aabb left = kEmptyAabb;
+		count = 0;
+		for (uint32_t ii = 0; ii < kNumBins - 1; ++ii)
+		{
+			left = merge(left, binBounds[ii]);
+			count += binCounts[ii];
+			if (0 == count
+			||  0 == rightCount[ii + 1])
+			{
+				continue;
+			}
+
+			const float cost = surfaceArea(left)*float( (count + 3)/4) + rightArea[ii + 1]*float( (rightCount[ii + 1] + 3)/4);
+			if (cost < bestCost)
+			{
+				bestCost  = cost;
+				bestSplit = ii + 1;
+			}
+		}
+	}
+
+	const uint32_t numBlocks = (num + 3)/4;
+	const float leafCost = surfaceArea(box)*float(numBlocks);
+	const bool leaf = bestCost == bx::kFloatInfinity
+		|| (numBlocks <= kMaxLeafBlocks && leafCost <= bestCost)
+		;
+
+	if (leaf)
+	{
+		m_nodes[_node].m_first     = uint32_t(m_blocks.size() );
+		m_nodes[_node].m_numBlocks = numBlocks;
+
+		for (uint32_t ii = _begin; ii < _end; ii += 4)
+		{
+			TriangleBlock block;
+			bx::memSet(&block, 0, sizeof(block) );
+
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				block.m_triangle[lane] = UINT32_MAX;
+				if (ii + lane >= _end)
+				{
+					continue;
+				}
+
+				const uint32_t index = _order[ii + lane];
+				const Triangle& tri = m_triangles[index];
+				block.m_triangle[lane] = index;
+
+				for (uint32_t cc = 0; cc < 3; ++cc)
+				{
+					block.m_v0[cc][lane]    = tri.m_pos[0][cc];
+					block.m_edge1[cc][lane] = tri.m_pos[1][cc] - tri.m_pos[0][cc];
+					block.m_edge2[cc][lane] = tri.m_pos[2][cc] - tri.m_pos[0][cc];
+				}
+			}
+
+			m_blocks.push_back(block);
+		}
+
+		return;
+	}
+
+	// Partition by bin, same binning as above.
+	const float scale = float(kNumBins) / axisExtent;
+	uint32_t* first = &_order[_begin];
+	uint32_t* last  = &_order[0] + _end;
+	while (first < last)
+	{
+		const bx::Aabb& bounds = _bounds[*first];
+		const float center = ( (&bounds.min.x)[axis] + (&bounds.max.x)[axis]) * 0.5f;
+		const uint32_t bin = bx::min(uint32_t( (center - axisMin) * scale), kNumBins - 1);
+		if (bin < bestSplit)
+		{
+			++first;
+		}
+		else
+		{
+			bx::swap(*first, *--last);
+		}
+	}
+
+	const uint32_t mid = uint32_t(first - &_order[0]);
+
+	const uint32_t children = uint32_t(m_nodes.size() );
+	m_nodes[_node].m_first     = children;
+	m_nodes[_node].m_numBlocks = 0;
+	m_nodes.emplace_back();
+	m_nodes.emplace_back();
+
+	buildNode(children,     _depth + 1, _begin, mid,  _order, _bounds);
+	buildNode(children + 1, _depth + 1, mid,    _end, _order, _bounds);
+}
+
+bool PathTracer::intersect(const Ray& _ray, Hit& _outHit) const
+{
+	if (m_nodes.empty() )
+	{
+		return false;
+	}
+
+	const bx::simd128_t originX = bx::simd_splat(_ray.m_origin.x);
+	const bx::simd128_t originY = bx::simd_splat(_ray.m_origin.y);
+	const bx::simd128_t originZ = bx::simd_splat(_ray.m_origin.z);
+	const bx::simd128_t dirX    = bx::simd_splat(_ray.m_dir.x);
+	const bx::simd128_t dirY    = bx::simd_splat(_ray.m_dir.y);
+	const bx::simd128_t dirZ    = bx::simd_splat(_ray.m_dir.z);
+	const bx::simd128_t zero    = bx::simd_zero();
+	const bx::simd128_t one     = bx::simd_splat(1.0f);
+	const bx::simd128_t epsilon = bx::simd_splat(1e-12f);
+	const bx::simd128_t inf     = bx::simd_splat(bx::kFloatInfinity);
+
+	_outHit.m_t = _ray.m_tMax;
+	_outHit.m_triangle = UINT32_MAX;
+
+	uint32_t stack[kMaxDepth];
+	uint32_t stackSize = 0;
+	uint32_t node = 0;
+
+	if (bx::kFloatInfinity == intersectBox(m_nodes[0].m_min, m_nodes[0].m_max, _ray.m_origin, _ray.m_invDir, _ray.m_tMax) )
+	{
+		return false;
+	}
+
+	for (;;)
+	{
+		const Node& current = m_nodes[node];
+
+		if (0 != current.m_numBlocks)
+		{
+			const bx::simd128_t tMax = bx::simd_splat(_outHit.m_t);
+
+			for (uint32_t ii = 0; ii < current.m_numBlocks; ++ii)
+			{
+				const TriangleBlock& block = m_blocks[current.m_first + ii];
+
+				const bx::simd128_t e1x = bx::simd_ld(block.m_edge1[0]);
+				const bx::simd128_t e1y = bx::simd_ld(block.m_edge1[1]);
+				const bx::simd128_t e1z = bx::simd_ld(block.m_edge1[2]);
+				const bx::simd128_t e2x = bx::simd_ld(block.m_edge2[0]);
+				const bx::simd128_t e2y = bx::simd_ld(block.m_edge2[1]);
+				const bx::simd128_t e2z = bx::simd_ld(block.m_edge2[2]);
+
+				// Möller-Trumbore, four triangles at once.
+				const bx::simd128_t px = bx::simd_sub(bx::simd_mul(dirY, e2z), bx::simd_mul(dirZ, e2y) );
+				const bx::simd128_t py = bx::simd_sub(bx::simd_mul(dirZ, e2x), bx::simd_mul(dirX, e2z) );
+				const bx::simd128_t pz = bx::simd_sub(bx::simd_mul(dirX, e2y), bx::simd_mul(dirY, e2x) );
+				const bx::simd128_t det = bx::simd_add(bx::simd_add(bx::simd_mul(e1x, px), bx::simd_mul(e1y, py) ), bx::simd_mul(e1z, pz) );
+				const bx::simd128_t invDet = bx::simd_div(one, det);
+
+				const bx::simd128_t tx = bx::simd_sub(originX, bx::simd_ld(block.m_v0[0]) );
+				const bx::simd128_t ty = bx::simd_sub(originY, bx::simd_ld(block.m_v0[1]) );
+				const bx::simd128_t tz = bx::simd_sub(originZ, bx::simd_ld(block.m_v0[2]) );
+				const bx::simd128_t uu = bx::simd_mul(bx::simd_add(bx::simd_add(bx::simd_mul(tx, px), bx::simd_mul(ty, py) ), bx::simd_mul(tz, pz) ), invDet);
+
+				const bx::simd128_t qx = bx::simd_sub(bx::simd_mul(ty, e1z), bx::simd_mul(tz, e1y) );
+				const bx::simd128_t qy = bx::simd_sub(bx::simd_mul(tz, e1x), bx::simd_mul(tx, e1z) );
+				const bx::simd128_t qz = bx::simd_sub(bx::simd_mul(tx, e1y), bx::simd_mul(ty, e1x) );
+				const bx::simd128_t vv = bx::simd_mul(bx::simd_add(bx::simd_add(bx::simd_mul(dirX, qx), bx::simd_mul(dirY, qy) ), bx::simd_mul(dirZ, qz) ), invDet);
+				const bx::simd128_t tt = bx::simd_mul(bx::simd_add(bx::simd_add(bx::simd_mul(e2x, qx), bx::simd_mul(e2y, qy) ), bx::simd_mul(e2z, qz) ), invDet);
+
+				const bx::simd128_t valid = bx::simd_and(
+					  bx::simd_and(
+						  bx::simd_and(bx::simd_cmpgt(bx::simd_abs(det), epsilon), bx::simd_cmpge(uu, zero) )
+						, bx::simd_and(bx::simd_cmpge(vv, zero), bx::simd_cmple(bx::simd_add(uu, vv), one) )
+						)
+					, bx::simd_and(bx::simd_cmpgt(tt, zero), bx::simd_cmplt(tt, tMax) )
+					);
+
+				BX_ALIGN_DECL_16(float t[4]);
+				BX_ALIGN_DECL_16(float u[4]);
+				BX_ALIGN_DECL_16(float v[4]);
+				bx::simd_st(t, bx::simd_selb(valid, tt, inf) );
+				bx::simd_st(u, uu);
+				bx::simd_st(v, vv);
+
+				for (uint32_t lane = 0; lane < 4; ++lane)
+				{
+					if (t[lane] < _outHit.m_t)
+					{
+						_outHit.m_t = t[lane];
+						_outHit.m_u = u[lane];
+						_outHit.m_v = v[lane];
+						_outHit.m_triangle = block.m_triangle[lane];
+					}
+				}
+			}
+		}
+		else
+		{
+			// Nearer child first, the farther one waits on the stack.
+			const Node& left  = m_nodes[current.m_first];
+			const Node& right = m_nodes[current.m_first + 1];
+			const float tLeft  = intersectBox(left.m_min,  left.m_max,  _ray.m_origin, _ray.m_invDir, _outHit.m_t);
+			const float tRight = intersectBox(right.m_min, right.m_max, _ray.m_origin, _ray.m_invDir, _outHit.m_t);
+
+			if (bx::kFloatInfinity != tLeft
+			&&  bx::kFloatInfinity != tRight)
+			{
+				BX_ASSERT(stackSize < kMaxDepth, "BVH deeper than %u levels.", kMaxDepth);
+				const bool leftFirst = tLeft <= tRight;
+				stack[stackSize++] = current.m_first + (leftFirst ? 1 : 0);
+				node = current.m_first + (leftFirst ? 0 : 1);
+				continue;
+			}
+
+			if (bx::kFloatInfinity != tLeft)
+			{
+				node = current.m_first;
+				continue;
+			}
+
+			if (bx::kFloatInfinity != tRight)
+			{
+				node = current.m_first + 1;
+				continue;
+			}
+		}
+
+		if (0 == stackSize)
+		{
+			break;
+		}
+
+		node = stack[--stackSize];
+	}
+
+	return UINT32_MAX != _outHit.m_triangle;
+}
+
+bool PathTracer::occluded(const Ray& _ray) const
+{
+	// Nearest hit traversal culls enough for a handful of shadow rays per path.
+	Hit hit;
+	return intersect(_ray, hit);
+}
+
+bx::Vec3 PathTracer::sampleEnvironment(const bx::Vec3& _dir) const
+{
+	if (NULL == m_env)
+	{
+		return { 0.0f, 0.0f, 0.0f };
+	}
+
+	// Mapping of iblEquirectToCubemap().
+	const float uu = 0.5f + bx::atan2(_dir.z, _dir.x) / bx::kPi2;
+	const float vv = bx::acos(bx::clamp(_dir.y, -1.0f, 1.0f) ) / bx::kPi;
+	const uint32_t xx = bx::min(uint32_t(uu * float(m_envWidth) ),  m_envWidth  - 1);
+	const uint32_t yy = bx::min(uint32_t(vv * float(m_envHeight) ), m_envHeight - 1);
+	return bx::load<bx::Vec3>(&m_env[(yy*m_envWidth + xx)*4]);
+}
+
+bx::Vec3 PathTracer::trace(const Ray& _ray, const PathTracerDesc& _desc, uint32_t _seed, uint64_t& _numRays) const
+{
+	Random random(_seed);
+
+	bx::Vec3 radiance   = { 0.0f, 0.0f, 0.0f };
+	bx::Vec3 throughput = { 1.0f, 1.0f, 1.0f };
+	Ray ray = _ray;
+
+	for (uint32_t bounce = 0; bounce < _desc.m_maxBounces; ++bounce)
+	{
+		Hit hit;
+		++_numRays;
+		if (!intersect(ray, hit) )
+		{
+			radiance = bx::add(radiance, bx::mul(throughput, bx::mul(sampleEnvironment(ray.m_dir), _desc.m_envIntensity) ) );
+			break;
+		}
+
+		const Triangle& tri = m_triangles[hit.m_triangle];
+		const Brdf brdf(m_materials[tri.m_material]);
+
+		const bx::Vec3 p0 = bx::load<bx::Vec3>(tri.m_pos[0]);
+		const bx::Vec3 p1 = bx::load<bx::Vec3>(tri.m_pos[1]);
+		const bx::Vec3 p2 = bx::load<bx::Vec3>(tri.m_pos[2]);
+		const bx::Vec3 pos = bx::mad(ray.m_dir, hit.m_t, ray.m_origin);
+		const bx::Vec3 v   = bx::neg(ray.m_dir);
+
+		// Both normals face the viewer, meshes aren't necessarily closed.
+		bx::Vec3 ng = bx::normalize(bx::cross(bx::sub(p1, p0), bx::sub(p2, p0) ) );
+		if (0.0f > bx::dot(ng, v) )
+		{
+			ng = bx::neg(ng);
+		}
+
+		const float w = 1.0f - hit.m_u - hit.m_v;
+		bx::Vec3 n = bx::normalize(bx::add(bx::add(
+			  bx::mul(bx::load<bx::Vec3>(tri.m_normal[0]), w)
+			, bx::mul(bx::load<bx::Vec3>(tri.m_normal[1]), hit.m_u) )
+			, bx::mul(bx::load<bx::Vec3>(tri.m_normal[2]), hit.m_v)
+			) );
+		if (0.0f > bx::dot(n, ng) )
+		{
+			n = bx::neg(n);
+		}
+
+		const bx::Vec3 origin = bx::mad(ng, kRayEpsilon * bx::max(1.0f, bx::length(pos) ), pos);
+
+		// Point lights can only be reached by shadow rays.
+		for (const PathTracerPointLight& light : m_lights)
+		{
+			const bx::Vec3 toLight = bx::sub(bx::load<bx::Vec3>(light.m_pos), origin);
+			const float distSq = bx::dot(toLight, toLight);
+			const float dist   = bx::sqrt(distSq);
+			const bx::Vec3 l   = bx::mul(toLight, 1.0f / dist);
+			const float NdotL  = bx::dot(n, l);
+			if (0.0f >= NdotL
+			||  0.0f >= bx::dot(ng, l)
+			||  distSq >= light.m_radiusMax*light.m_radiusMax)
+			{
+				continue;
+			}
+
+			Ray shadow;
+			shadow.m_origin = origin;
+			shadow.m_dir    = l;
+			shadow.m_invDir = bx::rcp(l);
+			shadow.m_tMax   = dist;
+			++_numRays;
+			if (occluded(shadow) )
+			{
+				continue;
+			}
+
+			const BxdfVec3<float> color = light_point_attenuated(
+				  BxdfVec3<float>{ light.m_color[0], light.m_color[1], light.m_color[2] }
+				, distSq
+				, light.m_radiusMin
+				, light.m_radiusMax
+				);
+
+			const bx::Vec3 f = brdf.eval(n, v, l);
+			radiance = bx::add(radiance, bx::mul(bx::mul(throughput, bx::mul(f, fromBxdf(color) ) ), NdotL) );
+		}
+
+		const float u0 = random.nextFloat();
+		const float u1 = random.nextFloat();
+		const float u2 = random.nextFloat();
+		const bx::Vec3 l = bx::normalize(brdf.sample(n, v, u0, u1, u2) );
+
+		const float pdf   = brdf.pdf(n, v, l);
+		const float NdotL = bx::dot(n, l);
+		if (0.0f >= pdf
+		||  0.0f >= NdotL
+		||  0.0f >= bx::dot(ng, l) )
+		{
+			break;
+		}
+
+		throughput = bx::mul(throughput, bx::mul(brdf.eval(n, v, l), NdotL / pdf) );
+
+		// Russian roulette once paths had a few bounces to pick up light.
+		if (3 <= bounce)
+		{
+			const float survive = bx::clamp(bx::max(throughput.x, throughput.y, throughput.z), 0.05f, 1.0f);
+			if (random.nextFloat() >= survive)
+			{
+				break;
+			}
+
+			throughput = bx::mul(throughput, 1.0f / survive);
+		}
+
+		ray.m_origin = origin;
+		ray.m_dir    = l;
+		ray.m_invDir = bx::rcp(l);
+		ray.m_tMax   = bx::kFloatInfinity;
+	}
+
+	return radiance;
+}
+
+void PathTracer::render(float* _outRgb, const float* _view, const PathTracerDesc& _desc, JobSystem* _jobs)
+{
+	const int64_t start = bx::getHPCounter();
+
+	float invView[16];
+	bx::mtxInverse(invView, _view);
+	const bx::Vec3 eye = { invView[12], invView[13], invView[14] };
+
+	const float tanHalfFov = bx::tan(bx::toRad(_desc.m_fovY) * 0.5f);
+	const float aspect     = float(_desc.m_width) / float(_desc.m_height);
+
+	const uint32_t tilesX = (_desc.m_width  + kTileSize - 1) / kTileSize;
+	const uint32_t tilesY = (_desc.m_height + kTileSize - 1) / kTileSize;
+
+	std::atomic<uint64_t> numRays(0);
+
+	jobSystemParallelFor(_jobs, tilesX*tilesY, [&](uint32_t _begin, uint32_t _end)
+	{
+		uint64_t tileRays = 0;
+
+		for (uint32_t tile = _begin; tile < _end; ++tile)
+		{
+			const uint32_t x0 = (tile % tilesX) * kTileSize;
+			const uint32_t y0 = (tile / tilesX) * kTileSize;
+			const uint32_t x1 = bx::min<uint32_t>(x0 + kTileSize, _desc.m_width);
+			const uint32_t y1 = bx::min<uint32_t>(y0 + kTileSize, _desc.m_height);
+
+			for (uint32_t yy = y0; yy < y1; ++yy)
+			{
+				for (uint32_t xx = x0; xx < x1; ++xx)
+				{
+					const uint32_t pixel = yy*_desc.m_width + xx;
+					bx::Vec3 sum = { 0.0f, 0.0f, 0.0f };
+
+					for (uint32_t ss = 0; ss < _desc.m_numSamples; ++ss)
+					{
+						const uint32_t seed = hashSeed(pixel ^ _desc.m_seed, ss);
+						Random jitter(seed ^ 0x5bd1e995u);
+
+						const float ndcX = ( (float(xx) + jitter.nextFloat() ) / float(_desc.m_width) * 2.0f - 1.0f) * tanHalfFov * aspect;
+						const float ndcY = (1.0f - (float(yy) + jitter.nextFloat() ) / float(_desc.m_height) * 2.0f) * tanHalfFov;
+
+						Ray ray;
+						ray.m_origin = eye;
+						ray.m_dir    = bx::normalize(bx::mulXyz0({ ndcX, ndcY, 1.0f }, invView) );
+						ray.m_invDir = bx::rcp(ray.m_dir);
+						ray.m_tMax   = bx::kFloatInfinity;
+
+						sum = bx::add(sum, trace(ray, _desc, seed, tileRays) );
+					}
+
+					bx::store(&_outRgb[pixel*3], bx::mul(sum, 1.0f / float(bx::max<uint32_t>(_desc.m_numSamples, 1) ) ) );
+				}
+			}
+		}
+
+		numRays += tileRays;
+	});
+
+	m_stats.m_numRays      = numRays;
+	m_stats.m_renderTimeMs = double(bx::getHPCounter() - start) * 1000.0 / double(bx::getHPFrequency() );
+}
+
+bool pathTracerWriteHdr(bx::WriterI* _writer, const float* _rgb, uint32_t _width, uint32_t _height, bx::Error* _err)
+{
+	char header[128];
+	const int32_t len = bx::snprintf(header, sizeof(header)
+		, "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y %u +X %u\n"
+		, _height
+		, _width
+		);
+	bx::write(_writer, header, len, _err);
+
+	// Flat scanlines, readers take them as well as run length encoded ones.
+	std::vector<uint8_t> row(_width*4);
+	for (uint32_t yy = 0; yy < _height && _err->isOk(); ++yy)
+	{
+		for (uint32_t xx = 0; xx < _width; ++xx)
+		{
+			const float* rgb = &_rgb[(yy*_width + xx)*3];
+			const float maxValue = bx::max(rgb[0], rgb[1], rgb[2]);
+			uint8_t* rgbe = &row[xx*4];
+
+			if (1e-32f > maxValue)
+			{
+				rgbe[0] = rgbe[1] = rgbe[2] = rgbe[3] = 0;
+				continue;
+			}
+
+			int32_t exponent;
+			const float mantissa = bx::frexp(maxValue, &exponent);
+			const float scale    = mantissa * 256.0f / maxValue;
+			rgbe[0] = uint8_t(bx::max(rgb[0], 0.0f) * scale);
+			rgbe[1] = uint8_t(bx::max(rgb[1], 0.0f) * scale);
+			rgbe[2] = uint8_t(bx::max(rgb[2], 0.0f) * scale);
+			rgbe[3] = uint8_t(exponent + 128);
+		}
+
+		bx::write(_writer, row.data(), int32_t(row.size() ), _err);
+	}
+
+	return _err->isOk();
+}
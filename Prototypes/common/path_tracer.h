@@ -0,0 +1,169 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_PATH_TRACER_H_HEADER_GUARD
+#define PROTOTYPE_PATH_TRACER_H_HEADER_GUARD
+
+#include <bx/bounds.h>
+#include <bx/math.h>
+#include <bx/readerwriter.h>
+
+#include <vector>
+
+class JobSystem;
+
+// Same layout and meaning as the LightsBasic material uniforms.
+struct PathTracerMaterial
+{
+	float m_albedo[3];
+	float m_roughness;
+	float m_f0[3];
+	float m_metallic;
+};
+
+// Falloff of light_point_attenuated() in Lights.sh.
+struct PathTracerPointLight
+{
+	float m_pos[3];
+	float m_color[3];
+	float m_radiusMin;
+	float m_radiusMax;
+};
+
+struct PathTracerDesc
+{
+	PathTracerDesc();
+
+	uint16_t m_width;
+	uint16_t m_height;
+
+	uint32_t m_numSamples;
+
+	// Surface interactions per path, the first one is the camera hit.
+	uint32_t m_maxBounces;
+
+	// Vertical field of view in degrees, bx perspective camera.
+	float m_fovY;
+
+	// Radiance of missed rays is the environment times this, see setEnvironment().
+	float m_envIntensity;
+
+	uint32_t m_seed;
+};
+
+struct PathTracerStats
+{
+	uint32_t m_numTriangles;
+	uint32_t m_numNodes;
+	double m_buildTimeMs;
+	double m_renderTimeMs;
+
+	// Camera, bounce and shadow rays traced by the last render().
+	uint64_t m_numRays;
+};
+
+// Reference renderer for the LightsBasic shading: triangle meshes with one material
+// each, point lights and an environment, traced through a BVH on the job system.
+// Surfaces use the BRDF terms of BXDFs.sh through their CPU twins in bxdfs.h, summed
+// as the rendering equation has them, diffuse plus specular times N.L, so images show
+// what an energy conserving shader converges to:
+//
+//   PathTracer tracer;
+//   tracer.addMesh(positions, normals, numVertices, indices, numIndices, mtx, material);
+//   tracer.addLight(light);
+//   tracer.build();
+//   tracer.render(rgb, view, desc, &jobs);
+//
+// Pixels are traced in tiles, each pixel's samples are seeded by the pixel index, so
+// the image doesn't depend on the thread count.
+class PathTracer
+{
+public:
+	PathTracer();
+
+	// _positions and _normals are three floats per vertex in object space, _mtx the
+	// object to world transform. Normals are transformed by its upper 3x3, keep it
+	// free of non-uniform scale.
+	void addMesh(const float* _positions
+		, const float* _normals
+		, uint32_t _numVertices
+		, const uint16_t* _indices
+		, uint32_t _numIndices
+		, const float* _mtx
+		, const PathTracerMaterial& _material
+		);
+
+	void addLight(const PathTracerPointLight& _light);
+
+	// Latitude/longitude RGBA float image, the layout of iblCreateSky(). _rgba must
+	// outlive the tracer. Without an environment missed rays return black.
+	void setEnvironment(const float* _rgba, uint32_t _width, uint32_t _height);
+
+	// Builds the BVH over every mesh added so far.
+	void build();
+
+	// Traces the scene from a bx view matrix into _outRgb, three floats per pixel, rows
+	// top down.
+	void render(float* _outRgb, const float* _view, const PathTracerDesc& _desc, JobSystem* _jobs = NULL);
+
+	const PathTracerStats& getStats() const { return m_stats; }
+
+private:
+	struct Ray;
+	struct Hit;
+
+	// Four triangles per SIMD test, structure of arrays. Lanes without a triangle are
+	// degenerate and never hit.
+	struct TriangleBlock
+	{
+		BX_ALIGN_DECL_16(float m_v0[3][4]);
+		BX_ALIGN_DECL_16(float m_edge1[3][4]);
+		BX_ALIGN_DECL_16(float m_edge2[3][4]);
+		uint32_t m_triangle[4];
+	};
+
+	// Leaves have m_numBlocks != 0 and their blocks start at m_first, inner nodes have
+	// their children at m_first and m_first + 1.
+	struct Node
+	{
+		float m_min[3];
+		uint32_t m_first;
+		float m_max[3];
+		uint32_t m_numBlocks;
+	};
+
+	struct Triangle
+	{
+		float m_pos[3][3];
+		float m_normal[3][3];
+		uint32_t m_material;
+	};
+
+	void buildNode(uint32_t _node, uint32_t _depth, uint32_t _begin, uint32_t _end, std::vector<uint32_t>& _order, const std::vector<bx::Aabb>& _bounds);
+
+	bool intersect(const Ray& _ray, Hit& _outHit) const;
+	bool occluded(const Ray& _ray) const;
+
+	bx::Vec3 trace(const Ray& _ray, const PathTracerDesc& _desc, uint32_t _seed, uint64_t& _numRays) const;
+	bx::Vec3 sampleEnvironment(const bx::Vec3& _dir) const;
+
+	std::vector<Triangle> m_triangles;
+	std::vector<PathTracerMaterial> m_materials;
+	std::vector<PathTracerPointLight> m_lights;
+
+	std::vector<Node> m_nodes;
+	std::vector<TriangleBlock> m_blocks;
+
+	const float* m_env;
+	uint32_t m_envWidth;
+	uint32_t m_envHeight;
+
+	PathTracerStats m_stats;
+};
+
+// Radiance RGBE (.hdr) image of three floats per pixel, rows top down.
+bool pathTracerWriteHdr(bx::WriterI* _writer, const float* _rgb, uint32_t _width, uint32_t _height, bx::Error* _err);
+
+#endif // PROTOTYPE_PATH_TRACER_H_HEADER_GUARD
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "program_permutations.h"
+#include "shader_archive_load.h"
+
+#include <bx/string.h>
+
+namespace
+{
+	// Length of a feature's name, without its `:REQUIRED` suffix.
+	int32_t featureNameLength(const char* _feature)
+	{
+		int32_t len = 0;
+		while ('\0' != _feature[len]
+		&&     ':'  != _feature[len])
+		{
+			++len;
+		}
+
+		return len;
+	}
+
+	// Bit of the feature that feature _index of _shader requires, 0 for none.
+	uint32_t featureRequires(const ShaderPermutations& _shader, uint8_t _index)
+	{
+		const char* feature = _shader.m_features[_index];
+		const int32_t nameLength = featureNameLength(feature);
+		if (':' != feature[nameLength])
+		{
+			return 0;
+		}
+
+		const char* required = &feature[nameLength + 1];
+		const int32_t requiredLength = bx::strLen(required);
+		for (uint8_t ii = 0; ii < _shader.m_numFeatures; ++ii)
+		{
+			const char* other = _shader.m_features[ii];
+			if (requiredLength == featureNameLength(other)
+			&&  0 == bx::memCmp(other, required, requiredLength) )
+			{
+				return 1u << ii;
+			}
+		}
+
+		BX_ASSERT(false, "%s: feature %s requires an unknown feature.", _shader.m_name, feature);
+		return 0;
+	}
+
+} // namespace
+
+ProgramPermutations::ProgramPermutations()
+	: m_vs{ NULL, NULL, 0 }
+	, m_fs{ NULL, NULL, 0 }
+	, m_mask(0)
+{
+}
+
+bool ProgramPermutations::load(const ShaderPermutations& _vs, const ShaderPermutations& _fs, const ShaderArchive* _archive)
+{
+	destroy();
+
+	m_vs = _vs;
+	m_fs = _fs;
+
+	const uint32_t numVs = 1u << _vs.m_numFeatures;
+	const uint32_t numFs = 1u << _fs.m_numFeatures;
+
+	char name[256];
+	m_shaders.reserve(numVs + numFs);
+	// Variants that weren't compiled stay invalid, see shaderPermutationMask().
+	for (uint32_t ii = 0; ii < numVs; ++ii)
+	{
+		shaderPermutationName(name, sizeof(name), _vs, ii);
+		m_shaders.push_back(ii == shaderPermutationMask(_vs, ii)
+			? shaderArchiveLoadShader(_archive, name)
+			: bgfx::ShaderHandle(BGFX_INVALID_HANDLE)
+			);
+	}
+
+	for (uint32_t ii = 0; ii < numFs; ++ii)
+	{
+		shaderPermutationName(name, sizeof(name), _fs, ii);
+		m_shaders.push_back(ii == shaderPermutationMask(_fs, ii)
+			? shaderArchiveLoadShader(_archive, name)
+			: bgfx::ShaderHandle(BGFX_INVALID_HANDLE)
+			);
+	}
+
+	// Shaders are shared between programs and destroyed with the table. Masks mapping to
+	// the same variants get the same program back with its reference count raised, so
+	// destroy() still releases every entry once.
+	bool valid = true;
+	m_programs.resize(numVs * numFs);
+	for (uint32_t ii = 0, num = uint32_t(m_programs.size() ); ii < num; ++ii)
+	{
+		const uint32_t vs = shaderPermutationMask(_vs, ii & (numVs - 1) );
+		const uint32_t fs = shaderPermutationMask(_fs, ii >> _vs.m_numFeatures);
+		m_programs[ii] = bgfx::createProgram(m_shaders[vs], m_shaders[numVs + fs], false);
+		valid &= bgfx::isValid(m_programs[ii]);
+	}
+
+	m_mask = uint32_t(m_programs.size() ) - 1;
+	return valid;
+}
+
+bool ProgramPermutations::reload()
+{
+	ProgramPermutations next;
+	if (!next.load(m_vs, m_fs) )
+	{
+		next.destroy();
+		return false;
+	}
+
+	destroy();
+	m_shaders.swap(next.m_shaders);
+	m_programs.swap(next.m_programs);
+	m_mask = next.m_mask;
+	return true;
+}
+
+void ProgramPermutations::destroy()
+{
+	for (bgfx::ProgramHandle program : m_programs)
+	{
+		if (bgfx::isValid(program) )
+		{
+			bgfx::destroy(program);
+		}
+	}
+
+	for (bgfx::ShaderHandle shader : m_shaders)
+	{
+		if (bgfx::isValid(shader) )
+		{
+			bgfx::destroy(shader);
+		}
+	}
+
+	m_programs.clear();
+	m_shaders.clear();
+	m_mask = 0;
+}
+
+void shaderPermutationName(char* _out, int32_t _max, const ShaderPermutations& _shader, uint32_t _mask)
+{
+	int32_t len = bx::snprintf(_out, _max, "%s", _shader.m_name);
+	for (uint8_t ii = 0; ii < _shader.m_numFeatures; ++ii)
+	{
+		if (0 != (_mask & (1u << ii) ) && len < _max)
+		{
+			const char* feature = _shader.m_features[ii];
+			len += bx::snprintf(&_out[len], _max - len, "+%.*s", featureNameLength(feature), feature);
+		}
+	}
+}
+
+uint32_t shaderPermutationMask(const ShaderPermutations& _shader, uint32_t _mask)
+{
+	// Requirements may chain, clear features until none is left without its own.
+	for (uint32_t prev = ~_mask; prev != _mask;)
+	{
+		prev = _mask;
+		for (uint8_t ii = 0; ii < _shader.m_numFeatures; ++ii)
+		{
+			const uint32_t required = featureRequires(_shader, ii);
+			if (0 != (_mask & (1u << ii) )
+			&&  required != (_mask & required) )
+			{
+				_mask &= ~(1u << ii);
+			}
+		}
+	}
+
+	return _mask;
+}
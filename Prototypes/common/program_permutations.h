@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_PROGRAM_PERMUTATIONS_H_HEADER_GUARD
+#define PROTOTYPE_PROGRAM_PERMUTATIONS_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+
+#include <vector>
+
+struct ShaderArchive;
+
+// A shader and the features of its `// permutations:` line, in the same order and as
+// written there, `:REQUIRED` suffixes included.
+struct ShaderPermutations
+{
+	const char* m_name;
+	const char* const* m_features;
+	uint8_t m_numFeatures;
+};
+
+// Programs for every combination of a vertex and a fragment shader's variants, compiled
+// by add_bgfx_shader(). Bit ii of a mask selects vertex feature ii, the fragment
+// features take the bits above them:
+//
+//   static const char* s_vsFeatures[] = { "QUANTIZED_VERTEX" };
+//   static const char* s_fsFeatures[] = { "SHADOWS", "IBL" };
+//   m_programs.load({ "vs_lightsbasic", s_vsFeatures, 1 }, { "fs_lightsbasic", s_fsFeatures, 2 });
+//   m_drawList.add(mesh, m_programs.get(Quantized | Shadows), mtx);
+//
+// Every variant is loaded up front, so get() is a table lookup and the hot shaders
+// don't branch on feature uniforms. Masks with a feature but not the one it requires
+// get the program of the variant without it, add_bgfx_shader() doesn't compile those.
+class ProgramPermutations
+{
+public:
+	ProgramPermutations();
+
+	// False if a variant is missing, programs using it are invalid. Variants come from
+	// _archive where it has them, see shader_archive_load.h.
+	bool load(const ShaderPermutations& _vs, const ShaderPermutations& _fs, const ShaderArchive* _archive = NULL);
+	void destroy();
+
+	// Loads the variants again from their loose files and replaces the table once all
+	// of them loaded, for shader hot reload. False keeps the current programs.
+	bool reload();
+
+	// Bits above the features are ignored.
+	bgfx::ProgramHandle get(uint32_t _mask) const
+	{
+		BX_ASSERT(!m_programs.empty(), "ProgramPermutations::get() before load().");
+		return m_programs[_mask & m_mask];
+	}
+
+	uint32_t getNumPrograms() const { return uint32_t(m_programs.size() ); }
+
+private:
+	std::vector<bgfx::ShaderHandle> m_shaders;
+	std::vector<bgfx::ProgramHandle> m_programs;
+	ShaderPermutations m_vs;
+	ShaderPermutations m_fs;
+	uint32_t m_mask;
+};
+
+// Name of the variant of _shader with the features in _mask, as add_bgfx_shader() names
+// the binary: the shader name followed by +FEATURE for every selected feature, in order.
+void shaderPermutationName(char* _out, int32_t _max, const ShaderPermutations& _shader, uint32_t _mask);
+
+// _mask without the features whose required feature isn't in it, the variant
+// add_bgfx_shader() compiled for that combination.
+uint32_t shaderPermutationMask(const ShaderPermutations& _shader, uint32_t _mask);
+
+#endif // PROTOTYPE_PROGRAM_PERMUTATIONS_H_HEADER_GUARD
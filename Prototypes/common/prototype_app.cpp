@@ -0,0 +1,258 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "prototype_app.h"
+#include "bgfx_utils.h"
+#include "imgui/imgui.h"
+
+#include <bx/commandline.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+
+PrototypeApp::PrototypeApp(const char* _name, const char* _description, const char* _url)
+	: entry::AppI(_name, _description, _url)
+	, m_width(0)
+	, m_height(0)
+	, m_debug(BGFX_DEBUG_NONE)
+	, m_reset(BGFX_RESET_VSYNC)
+	, m_shaderArchive(NULL)
+	, m_settingsWidth(0.25f)
+	, m_settingsHeight(0.75f)
+	, m_timeOffset(0)
+	, m_lastTime(0)
+{
+}
+
+void PrototypeApp::init(int32_t _argc, const char* const* _argv, uint32_t _width, uint32_t _height)
+{
+	Args args(_argc, _argv);
+	m_benchmark.init(getName(), _argc, _argv);
+
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	uint32_t numJobThreads = 0;
+	if (const char* jobs = cmdLine.findOption("jobs") )
+	{
+		bx::fromString(&numJobThreads, jobs);
+	}
+
+	m_width  = _width;
+	m_height = _height;
+	m_debug  = BGFX_DEBUG_NONE;
+	m_reset  = m_benchmark.isEnabled() ? BGFX_RESET_NONE : BGFX_RESET_VSYNC;
+
+	bgfx::Init init;
+	init.type     = args.m_type;
+	init.vendorId = args.m_pciId;
+	init.platformData.nwh  = entry::getNativeWindowHandle(entry::kDefaultWindowHandle);
+	init.platformData.ndt  = entry::getNativeDisplayHandle();
+	init.platformData.type = entry::getNativeWindowHandleType();
+	init.resolution.width  = m_width;
+	init.resolution.height = m_height;
+	init.resolution.reset  = m_reset;
+	bgfx::init(init);
+
+	// Enable debug Text
+	bgfx::setDebug(m_debug);
+
+	imguiCreate();
+
+	m_frameUniforms.init();
+
+	m_drawList.setCulling(!cmdLine.hasArg("no-cull") );
+
+	m_jobs.init(numJobThreads);
+	m_meshes.init(&m_jobs
+		, !cmdLine.hasArg("mesh-copy")
+		, cmdLine.hasArg("mesh-optimize")
+		, cmdLine.hasArg("mesh-quantize")
+		);
+
+	// Benchmark runs measure the shaders they started with.
+	if (cmdLine.hasArg("shader-reload")
+	&&  !m_benchmark.isEnabled() )
+	{
+		m_shaderReload.init(_argv[0]);
+	}
+
+	// Reloads rebuild the loose files, the archive would still hold the shaders of the
+	// last full build.
+	if (!cmdLine.hasArg("no-shader-archive")
+	&&  !m_shaderReload.isEnabled() )
+	{
+		const int64_t archiveStart = bx::getHPCounter();
+		m_shaderArchive = shaderArchiveOpenRenderer();
+		if (NULL != m_shaderArchive)
+		{
+			printf("[shaders] %s.pack: %u shader(s) mapped in %.3f ms\n"
+				, shaderArchiveGetRendererName(bgfx::getRendererType() )
+				, shaderArchiveGetNumShaders(m_shaderArchive)
+				, double(bx::getHPCounter() - archiveStart) * 1000.0 / double(bx::getHPFrequency() )
+				);
+		}
+		else
+		{
+			printf("[shaders] No shader archive for this renderer, loading loose files.\n");
+		}
+	}
+
+	m_shaderReload.setArchive(m_shaderArchive);
+
+	const int64_t initStart = bx::getHPCounter();
+	onInit(_argc, _argv);
+	printf("[init] %s: %.3f ms, %u mesh(es) requested, %u job thread(s)\n"
+		, getName()
+		, double(bx::getHPCounter() - initStart) * 1000.0 / double(bx::getHPFrequency() )
+		, m_meshes.getNumRequested()
+		, m_jobs.getNumThreads()
+		);
+
+	// Measured frames shouldn't depend on how fast the workers are.
+	if (m_benchmark.isEnabled() )
+	{
+		m_meshes.flush();
+	}
+
+	m_timeOffset = bx::getHPCounter();
+	m_lastTime   = m_timeOffset;
+}
+
+int PrototypeApp::shutdown()
+{
+	onShutdown();
+
+	m_shaderReload.shutdown();
+
+	// Shaders bgfx hasn't released yet keep the mapping alive.
+	shaderArchiveClose(m_shaderArchive);
+	m_shaderArchive = NULL;
+
+	m_meshes.shutdown();
+	m_jobs.shutdown();
+
+	m_graph.reset();
+	m_frameUniforms.destroy();
+
+	imguiDestroy();
+
+	// Shutdown bgfx
+	bgfx::shutdown();
+
+	return 0;
+}
+
+bool PrototypeApp::update()
+{
+	if (entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState) )
+	{
+		return false;
+	}
+
+	m_benchmark.beginFrame();
+
+	// Update frame timer
+	const int64_t now  = bx::getHPCounter();
+	const double  freq = double(bx::getHPFrequency() );
+	float time      = float( (now - m_timeOffset) / freq);
+	float deltaTime = float( (now - m_lastTime) / freq);
+	m_lastTime = now;
+
+	if (m_benchmark.isEnabled() )
+	{
+		time      = m_benchmark.getTime();
+		deltaTime = m_benchmark.getDeltaTime();
+		onBenchmark(m_benchmark.getProgress() );
+	}
+
+	// Draw UI
+	imguiBeginFrame(m_mouseState.m_mx
+		, m_mouseState.m_my
+		, (m_mouseState.m_buttons[entry::MouseButton::Left  ] ? IMGUI_MBUT_LEFT   : 0)
+		| (m_mouseState.m_buttons[entry::MouseButton::Right ] ? IMGUI_MBUT_RIGHT  : 0)
+		| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
+		, m_mouseState.m_mz
+		, uint16_t(m_width)
+		, uint16_t(m_height)
+		);
+
+	showExampleDialog(this);
+
+	ImGui::SetNextWindowPos(
+		  ImVec2(m_width - m_width * m_settingsWidth - 10.0f, 10.0f)
+		, ImGuiCond_FirstUseEver
+		);
+	ImGui::SetNextWindowSize(
+		  ImVec2(m_width * m_settingsWidth, m_height * m_settingsHeight)
+		, ImGuiCond_FirstUseEver
+		);
+	ImGui::Begin("Settings", NULL, 0);
+	onGui();
+
+	const FrameCounters& counters = m_benchmark.getLastCounters();
+	ImGui::Separator();
+	bool culling = m_drawList.isCulling();
+	if (ImGui::Checkbox("Frustum culling", &culling) )
+	{
+		m_drawList.setCulling(culling);
+	}
+	ImGui::Text("Draws: %u, culled: %u", counters.m_numDraws, counters.m_numCulled);
+	ImGui::Text("Uniform uploads: %u (%u bytes), skipped: %u"
+		, counters.m_numUniformUploads
+		, counters.m_uniformBytes
+		, counters.m_numUniformSkips
+		);
+	const MeshLoadStats& meshStats = m_meshes.getStats();
+	ImGui::Text("Meshes %u/%u (%s): main thread %.3f ms, copied %.2f MB"
+		, m_meshes.getNumReady()
+		, m_meshes.getNumRequested()
+		, meshStats.m_mapped ? "streamed" : "copied"
+		, meshStats.m_loadTimeMs
+		, meshStats.m_copiedBytes / (1024.0 * 1024.0)
+		);
+
+	if (m_shaderReload.isEnabled() )
+	{
+		const ShaderReloadStats& reloadStats = m_shaderReload.getStats();
+		if (ImGui::Button("Rebuild shaders") )
+		{
+			m_shaderReload.rebuild();
+		}
+
+		ImGui::SameLine();
+		if (m_shaderReload.isBuilding() )
+		{
+			ImGui::Text("Building...");
+		}
+		else
+		{
+			ImGui::Text("%u builds, %u failed, last %.0f ms"
+				, reloadStats.m_numBuilds
+				, reloadStats.m_numFailed
+				, reloadStats.m_buildTimeMs
+				);
+		}
+	}
+	ImGui::End();
+
+	imguiEndFrame();
+
+	m_meshes.update();
+	m_shaderReload.update();
+
+	onUpdate(time, deltaTime);
+
+	m_frameUniforms.set<FrameUniforms::Time>(time);
+	m_frameUniforms.set<FrameUniforms::DeltaTime>(deltaTime);
+	m_frameUniforms.submit();
+
+	m_graph.execute(uint16_t(m_width), uint16_t(m_height) );
+
+	// Submit frame
+	bgfx::frame();
+
+	return m_benchmark.endFrame();
+}
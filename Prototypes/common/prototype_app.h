@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_APP_H_HEADER_GUARD
+#define PROTOTYPE_APP_H_HEADER_GUARD
+
+#include "common.h"
+#include "benchmark.h"
+#include "draw_list.h"
+#include "frame_uniforms.h"
+#include "mesh_streamer.h"
+#include "render_graph.h"
+#include "shader_archive_load.h"
+#include "shader_reload.h"
+#include "uniform_block.h"
+
+// Shared application shell for the prototypes. Owns bgfx init/shutdown, the imgui
+// frame, the frame timer, benchmark mode and the render graph. Prototypes add their
+// passes to m_graph in onInit() and only implement the scene specific parts.
+class PrototypeApp : public entry::AppI
+{
+public:
+	PrototypeApp(const char* _name, const char* _description, const char* _url);
+
+	void init(int32_t _argc, const char* const* _argv, uint32_t _width, uint32_t _height) override final;
+	int shutdown() override final;
+	bool update() override final;
+
+protected:
+	// Called once bgfx and imgui are up.
+	virtual void onInit(int32_t _argc, const char* const* _argv) = 0;
+
+	// Called before bgfx and imgui go down.
+	virtual void onShutdown() = 0;
+
+	// Settings window contents. Called between imguiBeginFrame/imguiEndFrame.
+	virtual void onGui() {}
+
+	// Scene update before the render graph executes. In benchmark mode _time and
+	// _deltaTime are scripted.
+	virtual void onUpdate(float _time, float _deltaTime) = 0;
+
+	// Drives UI parameters in benchmark mode. _progress goes from 0 to 1 over the run.
+	virtual void onBenchmark(float _progress) { BX_UNUSED(_progress); }
+
+	entry::MouseState m_mouseState;
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	RenderGraph m_graph;
+	Benchmark   m_benchmark;
+
+	// Worker pool, `--jobs <n>` overrides the thread count.
+	JobSystem m_jobs;
+
+	// Meshes stream in asynchronously. `--mesh-copy` loads synchronously through
+	// bgfx_utils' meshLoad() instead, to compare startup time and memory.
+	// `--mesh-optimize` reorders indices and vertices at load time, `--mesh-quantize`
+	// converts them to the compact vertex format from mesh_quantize.h.
+	MeshStreamer m_meshes;
+
+	// Frustum culled submission for mesh draws. `--no-cull` submits every group.
+	DrawList m_drawList;
+
+	// Programs loaded through it are rebuilt and swapped when their shader sources
+	// change, with `--shader-reload`.
+	ShaderReload m_shaderReload;
+
+	// Every shader of the renderer's backend in one mapping, shaders/<renderer>.pack.
+	// NULL with `--no-shader-archive`, with `--shader-reload` or without an archive,
+	// shaders then load from their loose files.
+	ShaderArchive* m_shaderArchive;
+
+	// u_frame, uploaded once per frame before the render graph executes.
+	UniformBlock<FrameUniforms, bgfx::UniformFreq::Frame> m_frameUniforms;
+
+	// Settings window size relative to the backbuffer.
+	float m_settingsWidth;
+	float m_settingsHeight;
+
+private:
+	int64_t m_timeOffset;
+	int64_t m_lastTime;
+};
+
+#endif // PROTOTYPE_APP_H_HEADER_GUARD
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "render_graph.h"
+
+#include <algorithm>
+
+RenderPassDesc::RenderPassDesc(const char* _name)
+	: m_name(_name)
+	, m_clearFlags(BGFX_CLEAR_NONE)
+	, m_clearRgba(0x000000ff)
+	, m_clearDepth(1.0f)
+	, m_clearStencil(0)
+	, m_frameBuffer(BGFX_INVALID_HANDLE)
+	, m_width(0)
+	, m_height(0)
+	, m_sideEffect(false)
+{
+}
+
+RenderGraph::RenderGraph()
+	: m_firstView(0)
+	, m_numViewsUsed(0)
+	, m_dirty(true)
+{
+	m_backbuffer = createResource("backbuffer");
+}
+
+void RenderGraph::setFirstView(bgfx::ViewId _view)
+{
+	// The next compile() only knows the new range.
+	resetViews();
+	m_firstView = _view;
+	m_dirty = true;
+}
+
+RenderResourceHandle RenderGraph::createResource(const char* _name)
+{
+	const RenderResourceHandle handle = { uint16_t(m_resources.size() ) };
+	m_resources.push_back({ _name });
+	m_dirty = true;
+	return handle;
+}
+
+RenderPassHandle RenderGraph::addPass(const RenderPassDesc& _desc, ExecuteFn _fn)
+{
+	const RenderPassHandle handle = { uint16_t(m_passes.size() ) };
+
+	Pass pass;
+	pass.m_desc = _desc;
+	pass.m_fn   = std::move(_fn);
+	pass.m_view = UINT16_MAX;
+	m_passes.push_back(std::move(pass) );
+
+	m_dirty = true;
+	return handle;
+}
+
+void RenderGraph::read(RenderPassHandle _pass, RenderResourceHandle _resource)
+{
+	BX_ASSERT(_pass.idx < m_passes.size() && _resource.idx < m_resources.size(), "Invalid render graph handle.");
+	m_passes[_pass.idx].m_reads.push_back(_resource.idx);
+	m_dirty = true;
+}
+
+void RenderGraph::write(RenderPassHandle _pass, RenderResourceHandle _resource)
+{
+	BX_ASSERT(_pass.idx < m_passes.size() && _resource.idx < m_resources.size(), "Invalid render graph handle.");
+	m_passes[_pass.idx].m_writes.push_back(_resource.idx);
+	m_dirty = true;
+}
+
+void RenderGraph::compile()
+{
+	const uint16_t numPasses = uint16_t(m_passes.size() );
+
+	// Cull: walk passes back to front. A pass is live if it has side effects or writes a
+	// resource needed by a live pass. The backbuffer is always needed.
+	std::vector<bool> needed(m_resources.size(), false);
+	std::vector<bool> live(numPasses, false);
+	needed[m_backbuffer.idx] = true;
+
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (uint16_t ii = numPasses; ii-- > 0;)
+		{
+			Pass& pass = m_passes[ii];
+			if (live[ii])
+			{
+				continue;
+			}
+
+			bool isLive = pass.m_desc.m_sideEffect;
+			for (uint16_t resource : pass.m_writes)
+			{
+				isLive |= needed[resource];
+			}
+
+			if (isLive)
+			{
+				live[ii] = true;
+				changed  = true;
+				for (uint16_t resource : pass.m_reads)
+				{
+					needed[resource] = true;
+				}
+			}
+		}
+	}
+
+	// Order: writers of a resource run before its readers. Ties keep insertion order.
+	std::vector<uint16_t> numDeps(numPasses, 0);
+	std::vector<std::vector<uint16_t> > dependents(numPasses);
+	for (uint16_t reader = 0; reader < numPasses; ++reader)
+	{
+		if (!live[reader])
+		{
+			continue;
+		}
+
+		for (uint16_t resource : m_passes[reader].m_reads)
+		{
+			for (uint16_t writer = 0; writer < numPasses; ++writer)
+			{
+				const std::vector<uint16_t>& writes = m_passes[writer].m_writes;
+				if (writer != reader
+				&&  live[writer]
+				&&  writes.end() != std::find(writes.begin(), writes.end(), resource) )
+				{
+					dependents[writer].push_back(reader);
+					++numDeps[reader];
+				}
+			}
+		}
+	}
+
+	m_order.clear();
+	std::vector<bool> emitted(numPasses, false);
+	while (true)
+	{
+		uint16_t next = UINT16_MAX;
+		for (uint16_t ii = 0; ii < numPasses; ++ii)
+		{
+			if (live[ii]
+			&&  !emitted[ii]
+			&&  0 == numDeps[ii])
+			{
+				next = ii;
+				break;
+			}
+		}
+
+		if (UINT16_MAX == next)
+		{
+			break;
+		}
+
+		emitted[next] = true;
+		m_order.push_back(next);
+		for (uint16_t dependent : dependents[next])
+		{
+			--numDeps[dependent];
+		}
+	}
+
+	// Cycles can't be ordered, append the rest in insertion order.
+	for (uint16_t ii = 0; ii < numPasses; ++ii)
+	{
+		if (live[ii]
+		&&  !emitted[ii])
+		{
+			BX_TRACE("Render graph: pass '%s' is part of a dependency cycle.", m_passes[ii].m_desc.m_name);
+			m_order.push_back(ii);
+		}
+	}
+
+	// Views are executed in ID order, so assigning them in sorted order is all the
+	// submission ordering bgfx needs.
+	resetViews();
+
+	for (Pass& pass : m_passes)
+	{
+		pass.m_view = UINT16_MAX;
+	}
+
+	bgfx::ViewId view = m_firstView;
+	for (uint16_t idx : m_order)
+	{
+		Pass& pass = m_passes[idx];
+		pass.m_view = view++;
+
+		const RenderPassDesc& desc = pass.m_desc;
+		bgfx::setViewName(pass.m_view, desc.m_name);
+		bgfx::setViewClear(pass.m_view, desc.m_clearFlags, desc.m_clearRgba, desc.m_clearDepth, desc.m_clearStencil);
+		bgfx::setViewFrameBuffer(pass.m_view, desc.m_frameBuffer);
+	}
+
+	m_numViewsUsed = uint16_t(m_order.size() );
+	m_dirty = false;
+}
+
+void RenderGraph::execute(uint16_t _width, uint16_t _height)
+{
+	if (m_dirty)
+	{
+		compile();
+	}
+
+	for (uint16_t idx : m_order)
+	{
+		Pass& pass = m_passes[idx];
+		const RenderPassDesc& desc = pass.m_desc;
+
+		bgfx::setViewRect(pass.m_view
+			, 0
+			, 0
+			, 0 != desc.m_width  ? desc.m_width  : _width
+			, 0 != desc.m_height ? desc.m_height : _height
+			);
+
+		// Make sure cleared views are processed even if the pass submits nothing.
+		if (BGFX_CLEAR_NONE != desc.m_clearFlags)
+		{
+			bgfx::touch(pass.m_view);
+		}
+
+		pass.m_fn(pass.m_view);
+	}
+}
+
+bgfx::ViewId RenderGraph::getView(RenderPassHandle _pass) const
+{
+	return _pass.idx < m_passes.size() ? m_passes[_pass.idx].m_view : bgfx::ViewId(UINT16_MAX);
+}
+
+bool RenderGraph::isActive(RenderPassHandle _pass) const
+{
+	return UINT16_MAX != getView(_pass);
+}
+
+void RenderGraph::reset()
+{
+	resetViews();
+
+	m_passes.clear();
+	m_resources.clear();
+	m_order.clear();
+	m_backbuffer = createResource("backbuffer");
+}
+
+void RenderGraph::resetViews()
+{
+	for (uint16_t ii = 0; ii < m_numViewsUsed; ++ii)
+	{
+		bgfx::resetView(bgfx::ViewId(m_firstView + ii) );
+	}
+
+	m_numViewsUsed = 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_RENDER_GRAPH_H_HEADER_GUARD
+#define PROTOTYPE_RENDER_GRAPH_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+#include <functional>
+#include <vector>
+
+#define RENDER_GRAPH_HANDLE(_name) \
+	struct _name { uint16_t idx; }; \
+	inline bool isValid(_name _handle) { return UINT16_MAX != _handle.idx; }
+
+RENDER_GRAPH_HANDLE(RenderPassHandle)
+RENDER_GRAPH_HANDLE(RenderResourceHandle)
+
+#undef RENDER_GRAPH_HANDLE
+
+struct RenderPassDesc
+{
+	RenderPassDesc(const char* _name = "");
+
+	const char* m_name;
+
+	// View clear state, applied when the pass is assigned a view.
+	uint16_t m_clearFlags;
+	uint32_t m_clearRgba;
+	float    m_clearDepth;
+	uint8_t  m_clearStencil;
+
+	// Target of the view. Invalid handle renders to the backbuffer.
+	bgfx::FrameBufferHandle m_frameBuffer;
+
+	// View rect size. Zero means the backbuffer size passed to RenderGraph::execute.
+	uint16_t m_width;
+	uint16_t m_height;
+
+	// Passes with side effects outside the graph (readback, debug output) are never culled.
+	bool m_sideEffect;
+};
+
+// Small render-pass graph shared by the prototypes.
+//
+// Passes declare which logical resources they read and write. compile() keeps only
+// the passes that contribute to the backbuffer (or have side effects), orders them
+// so writers run before readers and hands out consecutive bgfx view IDs in that
+// order, so bgfx submission order follows the graph. Culled passes never get a view
+// and their callbacks never run.
+class RenderGraph
+{
+public:
+	typedef std::function<void(bgfx::ViewId _view)> ExecuteFn;
+
+	RenderGraph();
+
+	// First view ID handed out by compile(). Views below it are left to the caller.
+	void setFirstView(bgfx::ViewId _view);
+
+	RenderResourceHandle createResource(const char* _name);
+	RenderResourceHandle getBackbuffer() const { return m_backbuffer; }
+
+	RenderPassHandle addPass(const RenderPassDesc& _desc, ExecuteFn _fn);
+	void read(RenderPassHandle _pass, RenderResourceHandle _resource);
+	void write(RenderPassHandle _pass, RenderResourceHandle _resource);
+
+	// Culls, orders and assigns views. Called by execute() when the graph changed.
+	void compile();
+
+	// Sets up the views of all live passes and runs their callbacks in order.
+	void execute(uint16_t _width, uint16_t _height);
+
+	// Valid after compile(). Returns UINT16_MAX for culled passes.
+	bgfx::ViewId getView(RenderPassHandle _pass) const;
+	bool isActive(RenderPassHandle _pass) const;
+	uint16_t getNumActivePasses() const { return uint16_t(m_order.size() ); }
+
+	// Drops all passes and resources. Views used by the previous graph are reset.
+	void reset();
+
+private:
+	struct Pass
+	{
+		RenderPassDesc m_desc;
+		ExecuteFn m_fn;
+		std::vector<uint16_t> m_reads;
+		std::vector<uint16_t> m_writes;
+		bgfx::ViewId m_view;
+	};
+
+	struct Resource
+	{
+		const char* m_name;
+	};
+
+	// Resets the views the last compile() configured.
+	void resetViews();
+
+	std::vector<Pass>     m_passes;
+	std::vector<Resource> m_resources;
+	std::vector<uint16_t> m_order;
+	RenderResourceHandle  m_backbuffer;
+	bgfx::ViewId m_firstView;
+	uint16_t     m_numViewsUsed;
+	bool         m_dirty;
+};
+
+#endif // PROTOTYPE_RENDER_GRAPH_H_HEADER_GUARD
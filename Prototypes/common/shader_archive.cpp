@@ -0,0 +1,240 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "shader_archive.h"
+
+#include <bx/hash.h>
+#include <bx/math.h>
+
+#include <vector>
+
+namespace
+{
+	constexpr uint32_t kMagic     = BX_MAKEFOURCC('S', 'G', 'S', 1);
+	constexpr uint32_t kEmpty     = UINT32_MAX;
+	constexpr uint32_t kDataAlign = 16;
+
+	BX_ERROR_RESULT(kErrorDuplicateName, BX_MAKEFOURCC('S', 'G', 'S', 'D') );
+
+	struct ShaderArchiveHeader
+	{
+		uint32_t m_magic;
+		uint32_t m_numShaders;
+		uint32_t m_numSlots;
+		uint32_t m_reserved;
+	};
+
+	struct ShaderArchiveSlot
+	{
+		uint32_t m_hash;
+		uint32_t m_nameOffset;
+		uint32_t m_dataOffset;
+		uint32_t m_dataSize;
+	};
+
+	uint32_t hashName(const bx::StringView& _name)
+	{
+		bx::HashMurmur2A hash;
+		hash.begin();
+		hash.add(_name.getPtr(), _name.getLength() );
+		return hash.end();
+	}
+
+} // namespace
+
+struct ShaderArchive
+{
+	MappedFile* m_file;
+	const ShaderArchiveSlot* m_slots;
+	const char* m_base;
+	uint32_t m_numShaders;
+	uint32_t m_slotMask;
+};
+
+ShaderArchive* shaderArchiveOpen(const char* _filePath)
+{
+	MappedFile* file = mappedFileOpen(_filePath);
+	if (NULL == file)
+	{
+		return NULL;
+	}
+
+	const uint8_t* data = mappedFileGetData(file);
+	const uint32_t size = mappedFileGetSize(file);
+
+	ShaderArchiveHeader header;
+	bool valid = size >= sizeof(header);
+	if (valid)
+	{
+		bx::memCopy(&header, data, sizeof(header) );
+
+		// At least one empty slot, probes stop there.
+		valid = kMagic == header.m_magic
+			&& bx::isPowerOf2(header.m_numSlots)
+			&& header.m_numShaders < header.m_numSlots
+			&& uint64_t(header.m_numSlots) * sizeof(ShaderArchiveSlot) <= size - sizeof(header)
+			;
+	}
+
+	const ShaderArchiveSlot* slots = reinterpret_cast<const ShaderArchiveSlot*>(data + sizeof(ShaderArchiveHeader) );
+
+	uint32_t numUsed = 0;
+	for (uint32_t ii = 0; valid && ii < header.m_numSlots; ++ii)
+	{
+		const ShaderArchiveSlot& slot = slots[ii];
+		if (kEmpty == slot.m_nameOffset)
+		{
+			continue;
+		}
+
+		++numUsed;
+		valid = slot.m_nameOffset < size
+			&& int32_t(size - slot.m_nameOffset) > bx::strLen(reinterpret_cast<const char*>(data + slot.m_nameOffset), int32_t(size - slot.m_nameOffset) )
+			&& slot.m_dataOffset <= size
+			&& slot.m_dataSize   <= size - slot.m_dataOffset
+			;
+	}
+
+	if (!valid
+	||  numUsed != header.m_numShaders)
+	{
+		mappedFileRelease(file);
+		return NULL;
+	}
+
+	ShaderArchive* archive = new ShaderArchive;
+	archive->m_file       = file;
+	archive->m_slots      = slots;
+	archive->m_base       = reinterpret_cast<const char*>(data);
+	archive->m_numShaders = header.m_numShaders;
+	archive->m_slotMask   = header.m_numSlots - 1;
+	return archive;
+}
+
+void shaderArchiveClose(ShaderArchive* _archive)
+{
+	if (NULL == _archive)
+	{
+		return;
+	}
+
+	// Shaders created from the mapping hold their own references.
+	mappedFileRelease(_archive->m_file);
+	delete _archive;
+}
+
+uint32_t shaderArchiveGetNumShaders(const ShaderArchive* _archive)
+{
+	return _archive->m_numShaders;
+}
+
+MappedFile* shaderArchiveGetFile(const ShaderArchive* _archive)
+{
+	return _archive->m_file;
+}
+
+const uint8_t* shaderArchiveFind(const ShaderArchive* _archive, const bx::StringView& _name, uint32_t* _outSize)
+{
+	const uint32_t hash = hashName(_name);
+
+	for (uint32_t idx = hash & _archive->m_slotMask;; idx = (idx + 1) & _archive->m_slotMask)
+	{
+		const ShaderArchiveSlot& slot = _archive->m_slots[idx];
+		if (kEmpty == slot.m_nameOffset)
+		{
+			return NULL;
+		}
+
+		if (hash == slot.m_hash
+		&&  0 == bx::strCmp(&_archive->m_base[slot.m_nameOffset], _name) )
+		{
+			*_outSize = slot.m_dataSize;
+			return reinterpret_cast<const uint8_t*>(&_archive->m_base[slot.m_dataOffset]);
+		}
+	}
+}
+
+bool shaderArchiveWrite(bx::WriterI* _writer, const ShaderArchiveEntry* _entries, uint32_t _numEntries, bx::Error* _err)
+{
+	// Half full at most, misses stop after a probe or two.
+	const uint32_t numSlots = bx::uint32_nextpow2(bx::max<uint32_t>(_numEntries * 2, 2) );
+	const uint32_t mask     = numSlots - 1;
+
+	ShaderArchiveSlot empty;
+	empty.m_hash       = 0;
+	empty.m_nameOffset = kEmpty;
+	empty.m_dataOffset = 0;
+	empty.m_dataSize   = 0;
+	std::vector<ShaderArchiveSlot> slots(numSlots, empty);
+
+	uint32_t offset = uint32_t(sizeof(ShaderArchiveHeader) + numSlots * sizeof(ShaderArchiveSlot) );
+	for (uint32_t ii = 0; ii < _numEntries; ++ii)
+	{
+		const ShaderArchiveEntry& entry = _entries[ii];
+		const uint32_t hash = hashName(entry.m_name);
+
+		uint32_t idx = hash & mask;
+		for (; kEmpty != slots[idx].m_nameOffset; idx = (idx + 1) & mask)
+		{
+			if (hash == slots[idx].m_hash
+			&&  0 == bx::strCmp(entry.m_name, _entries[slots[idx].m_dataOffset].m_name) )
+			{
+				BX_ERROR_SET(_err, kErrorDuplicateName, "Shader archive: duplicate shader name.");
+				return false;
+			}
+		}
+
+		// The entry index stands in for the data offset until the names are placed.
+		slots[idx].m_hash       = hash;
+		slots[idx].m_nameOffset = offset;
+		slots[idx].m_dataOffset = ii;
+		offset += entry.m_name.getLength() + 1;
+	}
+
+	std::vector<uint32_t> dataOffsets(_numEntries);
+	for (uint32_t ii = 0; ii < _numEntries; ++ii)
+	{
+		offset = bx::alignUp(offset, kDataAlign);
+		dataOffsets[ii] = offset;
+		offset += _entries[ii].m_size;
+	}
+
+	for (ShaderArchiveSlot& slot : slots)
+	{
+		if (kEmpty != slot.m_nameOffset)
+		{
+			slot.m_dataSize   = _entries[slot.m_dataOffset].m_size;
+			slot.m_dataOffset = dataOffsets[slot.m_dataOffset];
+		}
+	}
+
+	ShaderArchiveHeader header;
+	header.m_magic      = kMagic;
+	header.m_numShaders = _numEntries;
+	header.m_numSlots   = numSlots;
+	header.m_reserved   = 0;
+
+	bx::write(_writer, header, _err);
+	bx::write(_writer, slots.data(), int32_t(numSlots * sizeof(ShaderArchiveSlot) ), _err);
+
+	// Names in entry order, the offsets above were handed out in the same order.
+	offset = uint32_t(sizeof(ShaderArchiveHeader) + numSlots * sizeof(ShaderArchiveSlot) );
+	for (uint32_t ii = 0; ii < _numEntries; ++ii)
+	{
+		const bx::StringView& name = _entries[ii].m_name;
+		bx::write(_writer, name.getPtr(), name.getLength(), _err);
+		bx::writeRep(_writer, 0, 1, _err);
+		offset += name.getLength() + 1;
+	}
+
+	for (uint32_t ii = 0; ii < _numEntries; ++ii)
+	{
+		bx::writeRep(_writer, 0, int32_t(dataOffsets[ii] - offset), _err);
+		bx::write(_writer, _entries[ii].m_data, int32_t(_entries[ii].m_size), _err);
+		offset = dataOffsets[ii] + _entries[ii].m_size;
+	}
+
+	return _err->isOk();
+}
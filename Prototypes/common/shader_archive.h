@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_SHADER_ARCHIVE_H_HEADER_GUARD
+#define PROTOTYPE_SHADER_ARCHIVE_H_HEADER_GUARD
+
+#include <bx/readerwriter.h>
+#include <bx/string.h>
+
+#include "mapped_file.h"
+
+// Every compiled shader of one backend in a single file, runtime/shaders/<backend>.pack,
+// written by tools/shaderpack at build time. Opening it is one mapping, looking a shader
+// up is a hash and a probe into an open addressed table, the shader binary is handed to
+// bgfx straight from the mapping. Layout, little endian:
+//
+//   header   magic 'SGS' and version, number of shaders, number of slots (power of two)
+//   slots    name hash, name offset, data offset, data size; name offset ~0 when empty
+//   names    0 terminated
+//   data     shaderc binaries, 16 byte aligned
+//
+// Names are the ones loadShader() takes, the binary's file name without extension. Only
+// depends on bx so host tools can use it, creating shaders lives in shader_archive_load.h.
+struct ShaderArchive;
+
+struct ShaderArchiveEntry
+{
+	bx::StringView m_name;
+	const void* m_data;
+	uint32_t m_size;
+};
+
+// Returns NULL if the file can't be mapped or isn't an archive. Every slot is checked
+// against the file size here, lookups don't check again.
+ShaderArchive* shaderArchiveOpen(const char* _filePath);
+void shaderArchiveClose(ShaderArchive* _archive);
+
+uint32_t shaderArchiveGetNumShaders(const ShaderArchive* _archive);
+
+// The mapping the binaries point into, to hold a reference while bgfx uses one.
+MappedFile* shaderArchiveGetFile(const ShaderArchive* _archive);
+
+// Returns the binary of shader _name, NULL if the archive doesn't have it.
+const uint8_t* shaderArchiveFind(const ShaderArchive* _archive, const bx::StringView& _name, uint32_t* _outSize);
+
+// Names must be unique, the entries are written in the order given.
+bool shaderArchiveWrite(bx::WriterI* _writer, const ShaderArchiveEntry* _entries, uint32_t _numEntries, bx::Error* _err);
+
+#endif // PROTOTYPE_SHADER_ARCHIVE_H_HEADER_GUARD
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "shader_archive_load.h"
+#include "bgfx_utils.h"
+
+#include <bx/string.h>
+
+const char* shaderArchiveGetRendererName(bgfx::RendererType::Enum _type)
+{
+	switch (_type)
+	{
+	case bgfx::RendererType::Noop:
+	case bgfx::RendererType::Direct3D11:
+	case bgfx::RendererType::Direct3D12: return "dx11";
+	case bgfx::RendererType::Agc:
+	case bgfx::RendererType::Gnm:        return "pssl";
+	case bgfx::RendererType::Metal:      return "metal";
+	case bgfx::RendererType::Nvn:        return "nvn";
+	case bgfx::RendererType::OpenGL:     return "glsl";
+	case bgfx::RendererType::OpenGLES:   return "essl";
+	case bgfx::RendererType::Vulkan:     return "spirv";
+	default:                             return NULL;
+	}
+}
+
+ShaderArchive* shaderArchiveOpenRenderer()
+{
+	const char* name = shaderArchiveGetRendererName(bgfx::getRendererType() );
+	if (NULL == name)
+	{
+		return NULL;
+	}
+
+	char filePath[256];
+	bx::snprintf(filePath, sizeof(filePath), "shaders/%s.pack", name);
+	return shaderArchiveOpen(filePath);
+}
+
+bgfx::ShaderHandle shaderArchiveLoadShader(const ShaderArchive* _archive, const char* _name)
+{
+	uint32_t size = 0;
+	const uint8_t* data = NULL != _archive ? shaderArchiveFind(_archive, _name, &size) : NULL;
+	if (NULL == data)
+	{
+		return loadShader(_name);
+	}
+
+	MappedFile* file = shaderArchiveGetFile(_archive);
+	mappedFileAddRef(file);
+
+	const bgfx::ShaderHandle handle = bgfx::createShader(bgfx::makeRef(data, size, mappedFileReleaseFn, file) );
+	bgfx::setName(handle, _name);
+	return handle;
+}
+
+bgfx::ProgramHandle shaderArchiveLoadProgram(const ShaderArchive* _archive, const char* _vs, const char* _fs)
+{
+	const bgfx::ShaderHandle vsh = shaderArchiveLoadShader(_archive, _vs);
+	bgfx::ShaderHandle fsh = BGFX_INVALID_HANDLE;
+	if (NULL != _fs)
+	{
+		fsh = shaderArchiveLoadShader(_archive, _fs);
+	}
+
+	return bgfx::createProgram(vsh, fsh, true);
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_SHADER_ARCHIVE_LOAD_H_HEADER_GUARD
+#define PROTOTYPE_SHADER_ARCHIVE_LOAD_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+
+#include "shader_archive.h"
+
+// Directory and archive name of a renderer's shaders, the same ones bgfx_utils'
+// loadShader() uses. NULL for renderers without compiled shaders.
+const char* shaderArchiveGetRendererName(bgfx::RendererType::Enum _type);
+
+// Opens shaders/<renderer>.pack for the current renderer, NULL if there is none.
+ShaderArchive* shaderArchiveOpenRenderer();
+
+// Creates shader _name straight from the mapping, bgfx holds a reference to it until
+// the shader is uploaded. Shaders missing from the archive, or all of them with a NULL
+// _archive, load from their loose .bin files through loadShader().
+bgfx::ShaderHandle shaderArchiveLoadShader(const ShaderArchive* _archive, const char* _name);
+
+// loadProgram() through the archive, _fs may be NULL for compute.
+bgfx::ProgramHandle shaderArchiveLoadProgram(const ShaderArchive* _archive, const char* _vs, const char* _fs);
+
+#endif // PROTOTYPE_SHADER_ARCHIVE_LOAD_H_HEADER_GUARD
@@ -0,0 +1,338 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "shader_reload.h"
+#include "bgfx_utils.h"
+#include "program_permutations.h"
+#include "shader_archive_load.h"
+
+#include <bx/filepath.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if BX_PLATFORM_LINUX
+#	include <dirent.h>
+#	include <poll.h>
+#	include <sys/inotify.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif // BX_PLATFORM_LINUX
+
+namespace
+{
+	// Editors save in several steps, the build starts once the sources were quiet
+	// for this long.
+	constexpr int32_t kSettleMs = 50;
+
+	// Wake up interval while idle, bounds how long shutdown() waits.
+	constexpr int32_t kIdleMs = 100;
+
+	bool isShaderSource(const char* _name)
+	{
+		const bx::FilePath filePath(_name);
+		const bx::StringView ext = filePath.getExt();
+		return 0 == bx::strCmp(ext, ".sc")
+			|| 0 == bx::strCmp(ext, ".sh")
+			;
+	}
+
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+} // namespace
+
+ShaderReload::ShaderReload()
+	: m_archive(NULL)
+	, m_quit(false)
+	, m_requested(false)
+	, m_building(false)
+	, m_numFinished(0)
+	, m_numHandled(0)
+	, m_succeeded(false)
+	, m_buildTimeMs(0.0)
+	, m_changeTime(0)
+	, m_watchFd(-1)
+{
+}
+
+ShaderReload::~ShaderReload()
+{
+	shutdown();
+}
+
+bool ShaderReload::init(const char* _executable)
+{
+#if defined(SGTESTBED_BINARY_DIR) && defined(SGTESTBED_CMAKE_COMMAND)
+	const bx::FilePath filePath(_executable);
+	const bx::StringView prefix = "prototype-";
+	const bx::StringView name   = filePath.getBaseName();
+	if (name.getLength() <= prefix.getLength()
+	||  0 != bx::strCmp(name, prefix, prefix.getLength() ) )
+	{
+		printf("[shaders] Reload needs a prototype-<name> executable, not '%s'.\n", _executable);
+		return false;
+	}
+
+	std::string target = "shaders-";
+	target.append(name.getPtr() + prefix.getLength(), name.getLength() - prefix.getLength() );
+
+	m_command = "\"" SGTESTBED_CMAKE_COMMAND "\" --build \"" SGTESTBED_BINARY_DIR "\" --target " + target;
+	if (0 != bx::strLen(SGTESTBED_BUILD_CONFIG) )
+	{
+		m_command += " --config " SGTESTBED_BUILD_CONFIG;
+	}
+
+#	if BX_PLATFORM_WINDOWS
+	// cmd /c strips the outermost quotes.
+	m_command = "\"" + m_command + "\"";
+#	endif // BX_PLATFORM_WINDOWS
+
+#	if BX_PLATFORM_LINUX
+	m_watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (0 <= m_watchFd)
+	{
+		addWatches(SGTESTBED_SOURCE_DIR "/Prototypes");
+		addWatches(SGTESTBED_SOURCE_DIR "/Includes/Shaders");
+	}
+#	endif // BX_PLATFORM_LINUX
+
+	printf("[shaders] Reloading with %s%s.\n"
+		, target.c_str()
+		, 0 <= m_watchFd ? ", watching sources" : ", rebuild from the settings window"
+		);
+
+	m_quit = false;
+	m_thread = std::thread([this]() { threadMain(); });
+	return true;
+#else
+	BX_UNUSED(_executable);
+	printf("[shaders] Reload is only available in builds from the source tree.\n");
+	return false;
+#endif // defined(SGTESTBED_BINARY_DIR) && defined(SGTESTBED_CMAKE_COMMAND)
+}
+
+void ShaderReload::shutdown()
+{
+	if (m_thread.joinable() )
+	{
+		m_quit = true;
+		m_thread.join();
+	}
+
+#if BX_PLATFORM_LINUX
+	if (0 <= m_watchFd)
+	{
+		close(m_watchFd);
+	}
+#endif // BX_PLATFORM_LINUX
+
+	m_watchFd = -1;
+	m_programs.clear();
+	m_permutations.clear();
+}
+
+void ShaderReload::loadProgram(bgfx::ProgramHandle* _program, const char* _vs, const char* _fs)
+{
+	*_program = shaderArchiveLoadProgram(m_archive, _vs, _fs);
+	m_programs.push_back({ _program, _vs, _fs });
+}
+
+void ShaderReload::addPermutations(ProgramPermutations* _programs)
+{
+	m_permutations.push_back(_programs);
+}
+
+void ShaderReload::rebuild()
+{
+	m_requested = true;
+}
+
+void ShaderReload::update()
+{
+	bool succeeded;
+	double buildTimeMs;
+	int64_t changeTime;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_numFinished == m_numHandled)
+		{
+			return;
+		}
+
+		m_numHandled = m_numFinished;
+		succeeded    = m_succeeded;
+		buildTimeMs  = m_buildTimeMs;
+		changeTime   = m_changeTime;
+	}
+
+	++m_stats.m_numBuilds;
+	m_stats.m_buildTimeMs = buildTimeMs;
+
+	if (!succeeded)
+	{
+		++m_stats.m_numFailed;
+		printf("[shaders] Build failed after %.0f ms, keeping the current programs.\n", buildTimeMs);
+		return;
+	}
+
+	// Up to date shaders load again too. That's a few small files per program, the
+	// compile was the slow part and the build system only ran the affected ones.
+	uint32_t numSwapped = 0;
+	for (Program& program : m_programs)
+	{
+		const bgfx::ProgramHandle handle = ::loadProgram(program.m_vs, program.m_fs);
+		if (!bgfx::isValid(handle) )
+		{
+			continue;
+		}
+
+		// bgfx destroys it once the frames in flight are done with it.
+		if (bgfx::isValid(*program.m_handle) )
+		{
+			bgfx::destroy(*program.m_handle);
+		}
+
+		*program.m_handle = handle;
+		++numSwapped;
+	}
+
+	for (ProgramPermutations* programs : m_permutations)
+	{
+		if (programs->reload() )
+		{
+			numSwapped += programs->getNumPrograms();
+		}
+	}
+
+	m_stats.m_numSwapped = numSwapped;
+	m_stats.m_latencyMs  = toMs(bx::getHPCounter() - changeTime);
+
+	printf("[shaders] Rebuilt in %.0f ms, %u program(s) swapped %.0f ms after the change.\n"
+		, buildTimeMs
+		, numSwapped
+		, m_stats.m_latencyMs
+		);
+}
+
+void ShaderReload::threadMain()
+{
+	bool pending = false;
+	int64_t firstChange = 0;
+	int64_t lastChange  = 0;
+
+	while (!m_quit)
+	{
+		const bool changed = waitForChange(pending ? kSettleMs : kIdleMs);
+		const int64_t now  = bx::getHPCounter();
+
+		if (changed || m_requested.exchange(false) )
+		{
+			firstChange = pending ? firstChange : now;
+			lastChange  = now;
+			pending     = true;
+			continue;
+		}
+
+		if (!pending
+		||  toMs(now - lastChange) < double(kSettleMs) )
+		{
+			continue;
+		}
+
+		pending    = false;
+		m_building = true;
+
+		// Sources changing during the build are picked up by the next one.
+		const int32_t result = std::system(m_command.c_str() );
+		const double buildTimeMs = toMs(bx::getHPCounter() - now);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_succeeded   = 0 == result;
+			m_buildTimeMs = buildTimeMs;
+			m_changeTime  = firstChange;
+			++m_numFinished;
+		}
+
+		m_building = false;
+	}
+}
+
+bool ShaderReload::waitForChange(int32_t _timeoutMs)
+{
+#if BX_PLATFORM_LINUX
+	if (0 <= m_watchFd)
+	{
+		pollfd fd = { m_watchFd, POLLIN, 0 };
+		if (0 >= poll(&fd, 1, _timeoutMs) )
+		{
+			return false;
+		}
+
+		bool changed = false;
+		alignas(inotify_event) char buffer[4096];
+		for (ssize_t size = read(m_watchFd, buffer, sizeof(buffer) ); 0 < size; size = read(m_watchFd, buffer, sizeof(buffer) ) )
+		{
+			for (const char* ptr = buffer; ptr < buffer + size;)
+			{
+				const inotify_event* event = (const inotify_event*)ptr;
+				changed = changed || (0 != event->len && isShaderSource(event->name) );
+				ptr += sizeof(inotify_event) + event->len;
+			}
+		}
+
+		return changed;
+	}
+#endif // BX_PLATFORM_LINUX
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(_timeoutMs) );
+	return false;
+}
+
+void ShaderReload::addWatches(const std::string& _dir)
+{
+#if BX_PLATFORM_LINUX
+	// inotify doesn't recurse, every directory gets its own watch. Compiled shaders go
+	// to runtime/, its changes would start another build.
+	if (0 > inotify_add_watch(m_watchFd, _dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE) )
+	{
+		return;
+	}
+
+	DIR* dir = opendir(_dir.c_str() );
+	if (NULL == dir)
+	{
+		return;
+	}
+
+	while (const dirent* entry = readdir(dir) )
+	{
+		if ('.' == entry->d_name[0]
+		||  0 == bx::strCmp(entry->d_name, "runtime") )
+		{
+			continue;
+		}
+
+		const std::string path = _dir + "/" + entry->d_name;
+
+		struct stat st;
+		if (0 == stat(path.c_str(), &st)
+		&&  S_ISDIR(st.st_mode) )
+		{
+			addWatches(path);
+		}
+	}
+
+	closedir(dir);
+#else
+	BX_UNUSED(_dir);
+#endif // BX_PLATFORM_LINUX
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_SHADER_RELOAD_H_HEADER_GUARD
+#define PROTOTYPE_SHADER_RELOAD_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ProgramPermutations;
+struct ShaderArchive;
+
+struct ShaderReloadStats
+{
+	ShaderReloadStats()
+		: m_numBuilds(0)
+		, m_numFailed(0)
+		, m_numSwapped(0)
+		, m_buildTimeMs(0.0)
+		, m_latencyMs(0.0)
+	{
+	}
+
+	uint32_t m_numBuilds;
+	uint32_t m_numFailed;
+
+	// Programs replaced after the last successful build.
+	uint32_t m_numSwapped;
+
+	// Last build, and the time from the first source change it picked up to the
+	// programs being swapped.
+	double m_buildTimeMs;
+	double m_latencyMs;
+};
+
+// Shader hot reload. A background thread watches the shader sources (.sc and .sh under
+// Prototypes/ and Includes/Shaders, inotify on Linux) and runs the prototype's
+// shaders-<name> build target when one changes. The build system recompiles only the
+// shaders whose depfiles name the file, through the shader cache. Once the build
+// succeeds, update() loads the programs again and swaps their handles in place between
+// frames; meshes, textures and settings stay as they are. A failed build keeps the
+// current programs, shaderc's errors go to the console.
+//
+// Registered programs are loaded whether reloading is enabled or not:
+//
+//   m_shaderReload.loadProgram(&m_program, "vs_goochhighlighted", "fs_goochhighlighted");
+//
+// Handles must stay where they are until shutdown(). Draws keep the program they were
+// added with, so callers look the handle up again every frame.
+class ShaderReload
+{
+public:
+	ShaderReload();
+	~ShaderReload();
+
+	// Starts watching and rebuilding with the target building _executable's shaders,
+	// prototype-<name> -> shaders-<name>. False without a build tree to rebuild in.
+	bool init(const char* _executable);
+	void shutdown();
+
+	bool isEnabled() const { return m_thread.joinable(); }
+	bool isBuilding() const { return m_building.load(std::memory_order_relaxed); }
+
+	// Initial loads come from _archive where it has the shaders, reloads always read the
+	// loose files the build just wrote.
+	void setArchive(const ShaderArchive* _archive) { m_archive = _archive; }
+
+	// Loads a program into *_program and keeps it up to date. Names must outlive the
+	// reload, string literals in practice.
+	void loadProgram(bgfx::ProgramHandle* _program, const char* _vs, const char* _fs);
+
+	// Keeps every variant of an already loaded table up to date.
+	void addPermutations(ProgramPermutations* _programs);
+
+	// Rebuilds as if a source changed, for platforms without a watcher.
+	void rebuild();
+
+	// Swaps programs after a successful build. Call on the main thread, between frames.
+	void update();
+
+	const ShaderReloadStats& getStats() const { return m_stats; }
+
+private:
+	struct Program
+	{
+		bgfx::ProgramHandle* m_handle;
+		const char* m_vs;
+		const char* m_fs;
+	};
+
+	void threadMain();
+
+	// Blocks up to _timeoutMs, true if a shader source changed meanwhile.
+	bool waitForChange(int32_t _timeoutMs);
+	void addWatches(const std::string& _dir);
+
+	std::vector<Program> m_programs;
+	std::vector<ProgramPermutations*> m_permutations;
+	const ShaderArchive* m_archive;
+	ShaderReloadStats m_stats;
+
+	std::string m_command;
+	std::thread m_thread;
+	std::atomic<bool> m_quit;
+	std::atomic<bool> m_requested;
+	std::atomic<bool> m_building;
+
+	// Written by the thread, read by update().
+	std::mutex m_mutex;
+	uint32_t m_numFinished;
+	uint32_t m_numHandled;
+	bool m_succeeded;
+	double m_buildTimeMs;
+	int64_t m_changeTime;
+
+	int m_watchFd;
+};
+
+#endif // PROTOTYPE_SHADER_RELOAD_H_HEADER_GUARD
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "shadow_allocator.h"
+
+#include <bx/bx.h>
+#include <bx/math.h>
+
+ShadowAtlasAllocator::ShadowAtlasAllocator()
+	: m_size(0)
+	, m_minSize(0)
+	, m_usedArea(0)
+{
+}
+
+void ShadowAtlasAllocator::init(uint16_t _size, uint16_t _minSize)
+{
+	m_size    = _size;
+	m_minSize = bx::min(_minSize, _size);
+
+	m_free.resize(bx::uint32_cnttz(m_size) - bx::uint32_cnttz(m_minSize) + 1);
+	reset();
+}
+
+void ShadowAtlasAllocator::reset()
+{
+	for (std::vector<Node>& level : m_free)
+	{
+		level.clear();
+	}
+
+	m_free[0].push_back({ 0, 0 });
+	m_usedArea = 0;
+}
+
+bool ShadowAtlasAllocator::alloc(ShadowTileRect& _outRect, uint16_t _size)
+{
+	const uint8_t level = getLevel(_size);
+
+	// Closest level with a free node at or above the requested one.
+	int32_t from = level;
+	while (0 <= from
+	&&     m_free[from].empty() )
+	{
+		--from;
+	}
+
+	if (0 > from)
+	{
+		return false;
+	}
+
+	Node node = m_free[from].back();
+	m_free[from].pop_back();
+
+	// Split down to the requested level, keeping the top left child. Siblings are
+	// pushed in reverse so the next allocation takes the top right one.
+	for (int32_t ii = from; ii < level; ++ii)
+	{
+		const uint16_t half = uint16_t(m_size >> (ii + 1) );
+		std::vector<Node>& children = m_free[ii + 1];
+		children.push_back({ uint16_t(node.m_x + half), uint16_t(node.m_y + half) });
+		children.push_back({ node.m_x,                  uint16_t(node.m_y + half) });
+		children.push_back({ uint16_t(node.m_x + half), node.m_y                  });
+	}
+
+	_outRect.m_x    = node.m_x;
+	_outRect.m_y    = node.m_y;
+	_outRect.m_size = uint16_t(m_size >> level);
+
+	m_usedArea += uint32_t(_outRect.m_size)*_outRect.m_size;
+
+	return true;
+}
+
+void ShadowAtlasAllocator::free(const ShadowTileRect& _rect)
+{
+	m_usedArea -= uint32_t(_rect.m_size)*_rect.m_size;
+
+	Node node = { _rect.m_x, _rect.m_y };
+	for (uint8_t level = getLevel(_rect.m_size); 0 < level; --level)
+	{
+		// The parent is free again once the other three quarters are.
+		const uint16_t parentSize = uint16_t(m_size >> (level - 1) );
+		const uint16_t parentX = uint16_t(node.m_x & ~(parentSize - 1) );
+		const uint16_t parentY = uint16_t(node.m_y & ~(parentSize - 1) );
+
+		std::vector<Node>& nodes = m_free[level];
+
+		uint32_t numSiblings = 0;
+		for (const Node& other : nodes)
+		{
+			numSiblings += (other.m_x & ~(parentSize - 1) ) == parentX
+				&&         (other.m_y & ~(parentSize - 1) ) == parentY
+				;
+		}
+
+		if (3 != numSiblings)
+		{
+			nodes.push_back(node);
+			return;
+		}
+
+		for (uint32_t ii = 0; ii < nodes.size();)
+		{
+			if ( (nodes[ii].m_x & ~(parentSize - 1) ) == parentX
+			&&   (nodes[ii].m_y & ~(parentSize - 1) ) == parentY)
+			{
+				nodes[ii] = nodes.back();
+				nodes.pop_back();
+			}
+			else
+			{
+				++ii;
+			}
+		}
+
+		node = { parentX, parentY };
+	}
+
+	m_free[0].push_back(node);
+}
+
+uint8_t ShadowAtlasAllocator::getLevel(uint16_t _size) const
+{
+	const uint16_t size = uint16_t(bx::clamp<uint32_t>(bx::uint32_nextpow2(_size), m_minSize, m_size) );
+	return uint8_t(bx::uint32_cnttz(m_size) - bx::uint32_cnttz(size) );
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_SHADOW_ALLOCATOR_H_HEADER_GUARD
+#define PROTOTYPE_SHADOW_ALLOCATOR_H_HEADER_GUARD
+
+#include <stdint.h>
+#include <vector>
+
+struct ShadowTileRect
+{
+	uint16_t m_x;
+	uint16_t m_y;
+	uint16_t m_size;
+};
+
+// Quadtree allocator for square power of two tiles in a square atlas. Each level keeps
+// a list of free nodes; allocating splits the smallest larger node into four, freeing
+// merges a node with its three siblings once they are all free again. No bgfx involved,
+// see ShadowAtlas for the texture side.
+class ShadowAtlasAllocator
+{
+public:
+	ShadowAtlasAllocator();
+
+	// _size and _minSize are powers of two, _minSize is the smallest tile handed out.
+	void init(uint16_t _size, uint16_t _minSize);
+
+	// Frees every tile.
+	void reset();
+
+	// _size is rounded up to a power of two and clamped to [min size, atlas size].
+	// Returns false if no free node is large enough.
+	bool alloc(ShadowTileRect& _outRect, uint16_t _size);
+	void free(const ShadowTileRect& _rect);
+
+	uint16_t getSize() const { return m_size; }
+	uint16_t getMinSize() const { return m_minSize; }
+
+	// Texels covered by allocated tiles.
+	uint32_t getUsedArea() const { return m_usedArea; }
+
+private:
+	struct Node
+	{
+		uint16_t m_x;
+		uint16_t m_y;
+	};
+
+	uint8_t getLevel(uint16_t _size) const;
+
+	// Free nodes per level, level 0 is the whole atlas.
+	std::vector<std::vector<Node> > m_free;
+
+	uint16_t m_size;
+	uint16_t m_minSize;
+	uint32_t m_usedArea;
+};
+
+#endif // PROTOTYPE_SHADOW_ALLOCATOR_H_HEADER_GUARD
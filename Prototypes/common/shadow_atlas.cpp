@@ -0,0 +1,404 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "shadow_atlas.h"
+
+#include <algorithm>
+
+namespace
+{
+	struct CubeFace
+	{
+		bx::Vec3 m_forward;
+		bx::Vec3 m_up;
+	};
+
+	// Shadows.sh projects with right = cross(up, forward), keep in sync.
+	const CubeFace s_cubeFaces[6] =
+	{
+		{ {  1.0f,  0.0f,  0.0f }, { 0.0f, 1.0f,  0.0f } },
+		{ { -1.0f,  0.0f,  0.0f }, { 0.0f, 1.0f,  0.0f } },
+		{ {  0.0f,  1.0f,  0.0f }, { 0.0f, 0.0f, -1.0f } },
+		{ {  0.0f, -1.0f,  0.0f }, { 0.0f, 0.0f,  1.0f } },
+		{ {  0.0f,  0.0f,  1.0f }, { 0.0f, 1.0f,  0.0f } },
+		{ {  0.0f,  0.0f, -1.0f }, { 0.0f, 1.0f,  0.0f } },
+	};
+
+} // namespace
+
+ShadowAtlasDesc::ShadowAtlasDesc()
+	: m_size(2048)
+	, m_minTileSize(64)
+	, m_maxTileSize(512)
+	, m_maxViews(24)
+{
+}
+
+ShadowLightDesc::ShadowLightDesc()
+	: m_id(0)
+	, m_hash(0)
+	, m_tileSize(0)
+	, m_numTiles(1)
+	, m_static(true)
+{
+}
+
+ShadowAtlas::ShadowAtlas()
+	: m_texture(BGFX_INVALID_HANDLE)
+	, m_frameBuffer(BGFX_INVALID_HANDLE)
+	, m_firstView(0)
+	, m_caching(true)
+{
+	bx::memSet(&m_stats, 0, sizeof(m_stats) );
+}
+
+bool ShadowAtlas::init(bgfx::ViewId _firstView, const ShadowAtlasDesc& _desc)
+{
+	m_desc      = _desc;
+	m_firstView = _firstView;
+	m_allocator.init(_desc.m_size, _desc.m_minTileSize);
+
+	const uint64_t flags = 0
+		| BGFX_TEXTURE_RT
+		| BGFX_SAMPLER_COMPARE_LEQUAL
+		| BGFX_SAMPLER_UVW_CLAMP
+		;
+
+	if (0 == (bgfx::getCaps()->supported & BGFX_CAPS_TEXTURE_COMPARE_LEQUAL)
+	||  !bgfx::isTextureValid(0, false, 1, bgfx::TextureFormat::D16, flags) )
+	{
+		return false;
+	}
+
+	m_texture     = bgfx::createTexture2D(_desc.m_size, _desc.m_size, false, 1, bgfx::TextureFormat::D16, flags);
+	m_frameBuffer = bgfx::createFrameBuffer(1, &m_texture, false);
+
+	for (uint16_t ii = 0; ii < _desc.m_maxViews; ++ii)
+	{
+		bgfx::setViewName(bgfx::ViewId(_firstView + ii), "Shadow tile");
+	}
+
+	return true;
+}
+
+void ShadowAtlas::shutdown()
+{
+	if (bgfx::isValid(m_frameBuffer) )
+	{
+		bgfx::destroy(m_frameBuffer);
+		bgfx::destroy(m_texture);
+	}
+
+	m_entries.clear();
+	m_lights.clear();
+}
+
+void ShadowAtlas::begin()
+{
+	for (Entry& entry : m_entries)
+	{
+		entry.m_used = false;
+	}
+
+	m_lights.clear();
+}
+
+uint16_t ShadowAtlas::add(const ShadowLightDesc& _desc)
+{
+	BX_ASSERT(kMaxTiles >= _desc.m_numTiles, "Lights have at most %d tiles.", kMaxTiles);
+
+	uint32_t idx = UINT32_MAX;
+	uint32_t freeIdx = UINT32_MAX;
+	for (uint32_t ii = 0, num = uint32_t(m_entries.size() ); ii < num; ++ii)
+	{
+		const Entry& entry = m_entries[ii];
+		if (0 == entry.m_desc.m_numTiles)
+		{
+			freeIdx = bx::min(freeIdx, ii);
+		}
+		else if (_desc.m_id == entry.m_desc.m_id)
+		{
+			idx = ii;
+			break;
+		}
+	}
+
+	if (UINT32_MAX == idx)
+	{
+		if (UINT32_MAX == freeIdx)
+		{
+			freeIdx = uint32_t(m_entries.size() );
+			m_entries.emplace_back();
+		}
+
+		idx = freeIdx;
+
+		Entry& entry = m_entries[idx];
+		entry.m_desc         = _desc;
+		entry.m_numTiles     = 0;
+		entry.m_validMask    = 0;
+		entry.m_renderedMask = 0;
+		entry.m_used         = false;
+		entry.m_dropped      = false;
+	}
+
+	Entry& entry = m_entries[idx];
+	BX_ASSERT(!entry.m_used, "Shadow light %u added twice.", _desc.m_id);
+
+	// Tiles are reallocated at the new size.
+	if (entry.m_desc.m_tileSize != _desc.m_tileSize
+	||  entry.m_desc.m_numTiles != _desc.m_numTiles)
+	{
+		freeTiles(entry);
+		entry.m_dropped = false;
+	}
+
+	const bool valid = m_caching
+		&& _desc.m_static
+		&& entry.m_desc.m_static
+		&& _desc.m_hash == entry.m_desc.m_hash
+		;
+
+	if (!valid)
+	{
+		entry.m_validMask = 0;
+	}
+
+	entry.m_desc = _desc;
+	entry.m_used = true;
+
+	m_lights.push_back(uint16_t(idx) );
+
+	return uint16_t(m_lights.size() - 1);
+}
+
+void ShadowAtlas::end()
+{
+	m_stats.m_repacked = false;
+
+	// Lights that weren't added this frame give their tiles back.
+	for (Entry& entry : m_entries)
+	{
+		if (!entry.m_used)
+		{
+			freeTiles(entry);
+			entry.m_desc.m_numTiles = 0;
+		}
+	}
+
+	// New and resized lights, largest first so small tiles fill the gaps.
+	std::vector<uint16_t> pending;
+	for (uint16_t idx : m_lights)
+	{
+		if (0 == m_entries[idx].m_numTiles)
+		{
+			pending.push_back(idx);
+		}
+	}
+
+	const auto largestFirst = [this](uint16_t _a, uint16_t _b)
+	{
+		return m_entries[_a].m_desc.m_tileSize > m_entries[_b].m_desc.m_tileSize;
+	};
+	std::stable_sort(pending.begin(), pending.end(), largestFirst);
+
+	// Lights dropped by an earlier repack only get tiles when some free up, repacking for
+	// them every frame would throw away every cached tile.
+	bool fits = true;
+	for (uint16_t idx : pending)
+	{
+		Entry& entry = m_entries[idx];
+		if (!allocTiles(entry, entry.m_desc.m_tileSize) )
+		{
+			fits = fits && entry.m_dropped;
+		}
+	}
+
+	if (!fits)
+	{
+		// Start over with every light, shrinking the ones that don't fit.
+		m_stats.m_repacked = true;
+		m_allocator.reset();
+
+		pending = m_lights;
+		for (uint16_t idx : pending)
+		{
+			Entry& entry = m_entries[idx];
+			entry.m_numTiles     = 0;
+			entry.m_validMask    = 0;
+			entry.m_renderedMask = 0;
+		}
+
+		std::stable_sort(pending.begin(), pending.end(), largestFirst);
+
+		for (uint16_t idx : pending)
+		{
+			Entry& entry = m_entries[idx];
+
+			uint16_t size = entry.m_desc.m_tileSize;
+			while (!allocTiles(entry, size)
+			&&     size > m_desc.m_minTileSize)
+			{
+				size /= 2;
+			}
+
+			entry.m_dropped = 0 == entry.m_numTiles;
+		}
+	}
+
+	m_stats.m_numLights  = uint32_t(m_lights.size() );
+	m_stats.m_numTiles   = 0;
+	m_stats.m_numDropped = 0;
+	m_stats.m_numShrunk  = 0;
+	m_stats.m_usedArea   = m_allocator.getUsedArea();
+
+	for (uint16_t idx : m_lights)
+	{
+		const Entry& entry = m_entries[idx];
+		m_stats.m_numTiles   += entry.m_numTiles;
+		m_stats.m_numDropped += 0 == entry.m_numTiles;
+		m_stats.m_numShrunk  += 0 != entry.m_numTiles
+			&& entry.m_tiles[0].m_size < bx::max(entry.m_desc.m_tileSize, m_desc.m_minTileSize)
+			;
+	}
+}
+
+void ShadowAtlas::submit(const SubmitFn& _fn)
+{
+	m_stats.m_numRendered = 0;
+	m_stats.m_numCached   = 0;
+	m_stats.m_numDeferred = 0;
+
+	for (uint16_t ii = 0, num = uint16_t(m_lights.size() ); ii < num; ++ii)
+	{
+		Entry& entry = m_entries[m_lights[ii] ];
+
+		for (uint8_t tile = 0; tile < entry.m_numTiles; ++tile)
+		{
+			const uint8_t bit = uint8_t(1 << tile);
+			if (0 != (entry.m_validMask & bit) )
+			{
+				++m_stats.m_numCached;
+				continue;
+			}
+
+			if (m_stats.m_numRendered == m_desc.m_maxViews)
+			{
+				++m_stats.m_numDeferred;
+				continue;
+			}
+
+			const bgfx::ViewId view = bgfx::ViewId(m_firstView + m_stats.m_numRendered);
+			const ShadowTileRect& rect = entry.m_tiles[tile];
+
+			bgfx::setViewFrameBuffer(view, m_frameBuffer);
+			bgfx::setViewRect(view, rect.m_x, rect.m_y, rect.m_size, rect.m_size);
+			bgfx::setViewClear(view, BGFX_CLEAR_DEPTH, 0, 1.0f, 0);
+			bgfx::touch(view);
+
+			_fn(view, ii, tile);
+
+			// Dynamic and changed lights are invalidated again by add().
+			entry.m_validMask    |= bit;
+			entry.m_renderedMask |= bit;
+			++m_stats.m_numRendered;
+		}
+	}
+}
+
+bool ShadowAtlas::hasTiles(uint16_t _light) const
+{
+	const Entry& entry = m_entries[m_lights[_light] ];
+	return 0 != entry.m_numTiles
+		&& entry.m_renderedMask == (1 << entry.m_numTiles) - 1
+		;
+}
+
+const ShadowTileRect& ShadowAtlas::getTile(uint16_t _light, uint8_t _tile) const
+{
+	return m_entries[m_lights[_light] ].m_tiles[_tile];
+}
+
+void ShadowAtlas::getTileUv(float _outScaleOffset[4], uint16_t _light, uint8_t _tile) const
+{
+	const ShadowTileRect& rect = getTile(_light, _tile);
+
+	const float invSize = 1.0f / float(m_desc.m_size);
+	const float half    = 0.5f * float(rect.m_size) * invSize;
+	const float centerX = (float(rect.m_x) + 0.5f*float(rect.m_size) ) * invSize;
+	const float centerY = (float(rect.m_y) + 0.5f*float(rect.m_size) ) * invSize;
+
+	// View rects are top left, OpenGL flips them and the texture rows.
+	const bool originBottomLeft = bgfx::getCaps()->originBottomLeft;
+	_outScaleOffset[0] = half;
+	_outScaleOffset[1] = originBottomLeft ? half : -half;
+	_outScaleOffset[2] = centerX;
+	_outScaleOffset[3] = originBottomLeft ? 1.0f - centerY : centerY;
+}
+
+void ShadowAtlas::freeTiles(Entry& _entry)
+{
+	for (uint8_t ii = 0; ii < _entry.m_numTiles; ++ii)
+	{
+		m_allocator.free(_entry.m_tiles[ii]);
+	}
+
+	_entry.m_numTiles     = 0;
+	_entry.m_validMask    = 0;
+	_entry.m_renderedMask = 0;
+}
+
+bool ShadowAtlas::allocTiles(Entry& _entry, uint16_t _size)
+{
+	for (uint8_t ii = 0; ii < _entry.m_desc.m_numTiles; ++ii)
+	{
+		if (!m_allocator.alloc(_entry.m_tiles[ii], _size) )
+		{
+			_entry.m_numTiles = ii;
+			freeTiles(_entry);
+			return false;
+		}
+	}
+
+	_entry.m_numTiles = _entry.m_desc.m_numTiles;
+	return true;
+}
+
+uint16_t shadowAtlasTileSize(const bx::Sphere& _bounds, const float* _view, const float* _proj, const ShadowAtlasDesc& _desc)
+{
+	const bx::Vec3 center   = bx::mul(_bounds.center, _view);
+	const float    distance = bx::length(center);
+	const float    radius   = _bounds.radius;
+
+	// Projected diameter over the screen height, _proj[5] is the vertical scale.
+	float coverage = 1.0f;
+	if (distance > radius)
+	{
+		coverage = bx::min(1.0f, radius * _proj[5] / bx::sqrt(distance*distance - radius*radius) );
+	}
+
+	const uint32_t size = bx::uint32_nextpow2(uint32_t(coverage * float(_desc.m_maxTileSize) ) );
+	return uint16_t(bx::clamp<uint32_t>(size, _desc.m_minTileSize, _desc.m_maxTileSize) );
+}
+
+void shadowPointFaceMtx(float* _outView, float* _outProj, const bx::Vec3& _pos, uint8_t _face, float _near, float _far, bool _homogeneousDepth)
+{
+	const CubeFace& face = s_cubeFaces[_face];
+	bx::mtxLookAt(_outView, _pos, bx::add(_pos, face.m_forward), face.m_up);
+	bx::mtxProj(_outProj, 90.0f, 1.0f, _near, _far, _homogeneousDepth);
+}
+
+void shadowPointDepthParams(float _outParams[2], float _near, float _far, bool _homogeneousDepth)
+{
+	float proj[16];
+	bx::mtxProj(proj, 90.0f, 1.0f, _near, _far, _homogeneousDepth);
+
+	// Clip w is view z, so ndc z = proj[10] + proj[14]/z. OpenGL style [-1, 1] depth is
+	// stored as [0, 1].
+	const float scale = _homogeneousDepth ? 0.5f : 1.0f;
+	const float bias  = _homogeneousDepth ? 0.5f : 0.0f;
+	_outParams[0] = proj[10]*scale + bias;
+	_outParams[1] = proj[14]*scale;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_SHADOW_ATLAS_H_HEADER_GUARD
+#define PROTOTYPE_SHADOW_ATLAS_H_HEADER_GUARD
+
+#include "shadow_allocator.h"
+
+#include <bgfx/bgfx.h>
+#include <bx/bounds.h>
+#include <bx/math.h>
+
+#include <functional>
+#include <vector>
+
+struct ShadowAtlasDesc
+{
+	ShadowAtlasDesc();
+
+	// Atlas and tile sizes, powers of two.
+	uint16_t m_size;
+	uint16_t m_minTileSize;
+	uint16_t m_maxTileSize;
+
+	// Tiles rendered per frame, one bgfx view each. Tiles over the budget are rendered
+	// in a later frame.
+	uint16_t m_maxViews;
+};
+
+struct ShadowLightDesc
+{
+	ShadowLightDesc();
+
+	// Identifies the light's tiles from frame to frame.
+	uint32_t m_id;
+
+	// Everything the shadow depends on: light transform, range and the casters. Tiles
+	// of static lights are reused while it stays the same.
+	uint32_t m_hash;
+
+	// Requested tile size, see shadowAtlasTileSize(). Every tile of a light has the
+	// same size.
+	uint16_t m_tileSize;
+
+	// 6 for point lights, see shadowPointFaceMtx(), 1 for spot and directional lights.
+	uint8_t m_numTiles;
+
+	// Dynamic lights are rendered every frame.
+	bool m_static;
+};
+
+struct ShadowAtlasStats
+{
+	uint32_t m_numLights;
+	uint32_t m_numTiles;
+	uint32_t m_numRendered;
+	uint32_t m_numCached;
+
+	// Tiles over the view budget, rendered later.
+	uint32_t m_numDeferred;
+
+	// Lights that got no tiles, or smaller ones than requested, because the atlas is full.
+	// Shrunk lights keep their tiles until their requested size changes.
+	uint32_t m_numDropped;
+	uint32_t m_numShrunk;
+
+	// Texels covered by tiles, and whether end() had to free and allocate every tile.
+	uint32_t m_usedArea;
+	bool     m_repacked;
+};
+
+// Depth atlas shared by every shadow casting light. Lights are added each frame with
+// a tile size matching their screen coverage; end() keeps the tiles of lights whose size
+// didn't change and allocates the rest from a ShadowAtlasAllocator, largest first.
+// Tiles of static lights whose hash didn't change keep their depth from earlier
+// frames, everything else is rendered by submit(), one bgfx view per tile.
+//
+//   m_shadows.begin();
+//   const uint16_t light = m_shadows.add(desc);
+//   m_shadows.end();
+//   m_shadows.submit([&](bgfx::ViewId _view, uint16_t _light, uint8_t _tile) { ... });
+//
+// Tile views are taken from [first view, first view + m_maxViews), keep the render
+// graph above them with RenderGraph::setFirstView().
+class ShadowAtlas
+{
+public:
+	typedef std::function<void(bgfx::ViewId _view, uint16_t _light, uint8_t _tile)> SubmitFn;
+
+	ShadowAtlas();
+
+	// Returns false, leaving the atlas unusable, if the renderer can't sample depth
+	// textures with comparison.
+	bool init(bgfx::ViewId _firstView, const ShadowAtlasDesc& _desc = ShadowAtlasDesc() );
+	void shutdown();
+
+	// With caching disabled every tile is rendered every frame, for comparing against.
+	void setCaching(bool _enabled) { m_caching = _enabled; }
+	bool isCaching() const { return m_caching; }
+
+	void begin();
+
+	// Returns the index of the light for the getters until the next begin().
+	uint16_t add(const ShadowLightDesc& _desc);
+
+	// Allocates tiles. When the atlas is too fragmented for the new tiles every tile is
+	// reallocated, largest first, and lights that still don't fit are shrunk or dropped.
+	void end();
+
+	// Sets up a view per tile to render: atlas frame buffer, tile rect and depth clear.
+	// _fn sets the view transform and submits the casters.
+	void submit(const SubmitFn& _fn);
+
+	// False until every tile of _light was rendered once.
+	bool hasTiles(uint16_t _light) const;
+
+	const ShadowTileRect& getTile(uint16_t _light, uint8_t _tile) const;
+
+	// Atlas uv = ndc.xy*(x, y) + (z, w) in tile _tile of _light, for the renderer's
+	// texture origin.
+	void getTileUv(float _outScaleOffset[4], uint16_t _light, uint8_t _tile) const;
+
+	bgfx::TextureHandle getTexture() const { return m_texture; }
+	const ShadowAtlasDesc& getDesc() const { return m_desc; }
+	const ShadowAtlasStats& getStats() const { return m_stats; }
+
+private:
+	static constexpr uint8_t kMaxTiles = 6;
+
+	// Persistent per light id.
+	struct Entry
+	{
+		ShadowLightDesc m_desc;
+		ShadowTileRect  m_tiles[kMaxTiles];
+		uint8_t  m_numTiles;
+		uint8_t  m_validMask;
+		uint8_t  m_renderedMask;
+		bool     m_used;
+
+		// Got no tiles in the last repack.
+		bool     m_dropped;
+	};
+
+	void freeTiles(Entry& _entry);
+	bool allocTiles(Entry& _entry, uint16_t _size);
+
+	ShadowAtlasDesc m_desc;
+	ShadowAtlasAllocator m_allocator;
+
+	std::vector<Entry> m_entries;
+
+	// Entry of every light added since begin().
+	std::vector<uint16_t> m_lights;
+
+	bgfx::TextureHandle m_texture;
+	bgfx::FrameBufferHandle m_frameBuffer;
+	bgfx::ViewId m_firstView;
+
+	ShadowAtlasStats m_stats;
+	bool m_caching;
+};
+
+// Tile size for a light whose shadow covers _bounds: the largest tile when the camera
+// is inside, otherwise scaled by the bounds' projected height on screen. _proj is a bx
+// perspective projection.
+uint16_t shadowAtlasTileSize(const bx::Sphere& _bounds, const float* _view, const float* _proj, const ShadowAtlasDesc& _desc);
+
+// View and projection of cube shadow face _face (+x, -x, +y, -y, +z, -z) of a point
+// light at _pos. Shadows.sh selects faces and projects the same way, keep both in sync.
+void shadowPointFaceMtx(float* _outView, float* _outProj, const bx::Vec3& _pos, uint8_t _face, float _near, float _far, bool _homogeneousDepth);
+
+// Depth texel of view space z in a cube shadow face is x + y/z.
+void shadowPointDepthParams(float _outParams[2], float _near, float _far, bool _homogeneousDepth);
+
+#endif // PROTOTYPE_SHADOW_ATLAS_H_HEADER_GUARD
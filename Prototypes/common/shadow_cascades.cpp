@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include "shadow_cascades.h"
+
+ShadowCascadeDesc::ShadowCascadeDesc()
+	: m_numCascades(4)
+	, m_distance(40.0f)
+	, m_splitLambda(0.75f)
+	, m_resolution(1024)
+	, m_casterDistance(20.0f)
+{
+}
+
+void shadowCascadeSplits(float* _outSplits, uint8_t _num, float _near, float _far, float _lambda)
+{
+	for (uint8_t ii = 0; ii <= _num; ++ii)
+	{
+		const float t      = float(ii) / float(_num);
+		const float linear = bx::lerp(_near, _far, t);
+		const float log    = _near * bx::pow(_far / _near, t);
+		_outSplits[ii] = bx::lerp(linear, log, _lambda);
+	}
+}
+
+void shadowCascadesFit(ShadowCascade* _outCascades
+	, const ShadowCascadeDesc& _desc
+	, const float* _cameraView
+	, float _fovY
+	, float _aspect
+	, float _near
+	, const bx::Vec3& _lightDir
+	, bool _homogeneousDepth
+	)
+{
+	const uint8_t numCascades = uint8_t(bx::clamp<uint32_t>(_desc.m_numCascades, 1, kShadowMaxCascades) );
+
+	float splits[kShadowMaxCascades + 1];
+	shadowCascadeSplits(splits, numCascades, _near, bx::max(_desc.m_distance, _near), _desc.m_splitLambda);
+
+	float cameraWorld[16];
+	bx::mtxInverse(cameraWorld, _cameraView);
+
+	// Light view at the origin, only the orthographic projections move.
+	const bx::Vec3 up = bx::abs(_lightDir.y) > 0.99f
+		? bx::Vec3{ 0.0f, 0.0f, 1.0f }
+		: bx::Vec3{ 0.0f, 1.0f, 0.0f }
+		;
+
+	float view[16];
+	bx::mtxLookAt(view, { 0.0f, 0.0f, 0.0f }, _lightDir, up);
+
+	// Squared distance of a frustum corner from the view axis per unit of view depth.
+	const float tanHalfFov = bx::tan(bx::toRad(_fovY) * 0.5f);
+	const float corner     = tanHalfFov*tanHalfFov * (1.0f + _aspect*_aspect);
+
+	for (uint8_t ii = 0; ii < numCascades; ++ii)
+	{
+		const float near = splits[ii];
+		const float far  = splits[ii + 1];
+
+		// Smallest sphere around the slice centered on the view axis. Depends only on the
+		// slice, so it keeps its size when the camera turns.
+		const float centerZ = bx::min(far, 0.5f * (near + far) * (1.0f + corner) );
+		const float radius  = bx::sqrt(bx::max(
+			  (far - centerZ)*(far - centerZ) + far*far*corner
+			, (centerZ - near)*(centerZ - near) + near*near*corner
+			) );
+
+		const bx::Vec3 center = bx::mul(bx::mul({ 0.0f, 0.0f, centerZ }, cameraWorld), view);
+
+		// Snap to whole texels. Snapping moves the center by up to a texel, the extent
+		// is a texel larger than the sphere and spans the resolution.
+		const float texel  = 2.0f * radius / float(_desc.m_resolution - 2);
+		const float extent = radius + texel;
+		const float x = bx::floor(center.x / texel) * texel;
+		const float y = bx::floor(center.y / texel) * texel;
+
+		ShadowCascade& cascade = _outCascades[ii];
+		bx::memCopy(cascade.m_view, view, sizeof(view) );
+		bx::mtxOrtho(cascade.m_proj
+			, x - extent, x + extent
+			, y - extent, y + extent
+			, center.z - radius - _desc.m_casterDistance, center.z + radius
+			, 0.0f
+			, _homogeneousDepth
+			);
+		cascade.m_near = near;
+		cascade.m_far  = far;
+	}
+}
+
+void shadowCascadeUv(float _outUv[4], float _outDepth[2], const ShadowCascade& _cascade, const float _tileUv[4], bool _homogeneousDepth)
+{
+	// Orthographic, ndc = light view * scale + offset on every axis.
+	const float* proj = _cascade.m_proj;
+	_outUv[0] = proj[ 0]*_tileUv[0];
+	_outUv[1] = proj[ 5]*_tileUv[1];
+	_outUv[2] = proj[12]*_tileUv[0] + _tileUv[2];
+	_outUv[3] = proj[13]*_tileUv[1] + _tileUv[3];
+
+	// OpenGL style [-1, 1] depth is stored as [0, 1].
+	const float scale = _homogeneousDepth ? 0.5f : 1.0f;
+	const float bias  = _homogeneousDepth ? 0.5f : 0.0f;
+	_outDepth[0] = proj[10]*scale;
+	_outDepth[1] = proj[14]*scale + bias;
+}
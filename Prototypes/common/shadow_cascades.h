@@ -0,0 +1,65 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_SHADOW_CASCADES_H_HEADER_GUARD
+#define PROTOTYPE_SHADOW_CASCADES_H_HEADER_GUARD
+
+#include <bx/math.h>
+
+constexpr uint8_t kShadowMaxCascades = 4;
+
+struct ShadowCascadeDesc
+{
+	ShadowCascadeDesc();
+
+	// 1 to kShadowMaxCascades.
+	uint8_t m_numCascades;
+
+	// View depth covered by the cascades, nothing further away is shadowed.
+	float m_distance;
+
+	// Blend between uniform (0) and logarithmic (1) split distances.
+	float m_splitLambda;
+
+	// Cascade size in shadow map texels, the unit the cascades snap to.
+	uint16_t m_resolution;
+
+	// How far towards the light casters outside a cascade's bounds still cast into it.
+	float m_casterDistance;
+};
+
+struct ShadowCascade
+{
+	// Light view and orthographic projection, the view is the same for every cascade.
+	float m_view[16];
+	float m_proj[16];
+
+	// View depth range of the camera frustum slice covered.
+	float m_near;
+	float m_far;
+};
+
+// _num + 1 view depths from _near to _far, cascade ii covers [ii, ii + 1].
+void shadowCascadeSplits(float* _outSplits, uint8_t _num, float _near, float _far, float _lambda);
+
+// Fits _desc.m_numCascades cascades of a directional light shining along _lightDir to
+// the frustum of a bx perspective camera. Each cascade bounds its frustum slice with a
+// sphere, which doesn't change size as the camera turns, and moves in whole texels in
+// light space as the camera moves, so shadow edges don't shimmer.
+void shadowCascadesFit(ShadowCascade* _outCascades
+	, const ShadowCascadeDesc& _desc
+	, const float* _cameraView
+	, float _fovY
+	, float _aspect
+	, float _near
+	, const bx::Vec3& _lightDir
+	, bool _homogeneousDepth
+	);
+
+// Folds the cascade projection and the atlas tile from ShadowAtlas::getTileUv() into
+// atlas uv = light view xy * (x, y) + (z, w), and depth texel = light view z * x + y.
+void shadowCascadeUv(float _outUv[4], float _outDepth[2], const ShadowCascade& _cascade, const float _tileUv[4], bool _homogeneousDepth);
+
+#endif // PROTOTYPE_SHADOW_CASCADES_H_HEADER_GUARD
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_UNIFORM_BLOCK_H_HEADER_GUARD
+#define PROTOTYPE_UNIFORM_BLOCK_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+#include <bx/math.h>
+#include "benchmark.h"
+#include "uniform_layout.h"
+
+// Constant buffer backed by a uniform layout description (see uniform_layout.h).
+// Field offsets are compile-time constants, set<Field>() compiles to plain stores.
+//
+// Uploads are dirty tracked per vec4. set<Field>() only marks the vec4s whose value
+// actually changed, and submit() skips the upload when nothing changed since the last
+// one. bgfx can only upload a uniform array from element 0, so a dirty block uploads
+// the prefix up to its last dirty vec4.
+//
+// Skipping relies on bgfx keeping the last value set on a uniform handle. That holds as
+// long as one block owns the handle. Call invalidate() after anything that loses
+// uniform state (bgfx reset, handle shared by several draws with different values).
+//
+// FreqT picks the bgfx update frequency. Per-frame blocks (time, camera) go through
+// bgfx::setFrameUniform once per frame; per-material blocks are set before their draw.
+template<typename DescT, bgfx::UniformFreq::Enum FreqT = bgfx::UniformFreq::Draw>
+struct UniformBlock
+{
+	static constexpr auto& s_layout = kUniformLayout<DescT>;
+
+	enum { NumVec4 = s_layout.m_numVec4 };
+
+	static_assert(NumVec4 <= 32, "Dirty mask holds 32 vec4s.");
+
+	static_assert(sizeof(DescT::s_fields) / sizeof(DescT::s_fields[0]) == DescT::Count
+		, "Uniform block field table doesn't match its field enum."
+		);
+	static_assert(uint32_t(NumVec4) == uint32_t(DescT::NumVec4)
+		, "Uniform block packs to a different number of vec4s than declared. Update NumVec4 and regenerate uniforms.sh."
+		);
+
+	void init()
+	{
+		bx::memSet(m_params, 0, sizeof(m_params) );
+		u_params = bgfx::createUniform(DescT::s_name, FreqT, bgfx::UniformType::Vec4, NumVec4);
+		invalidate();
+	}
+
+	void invalidate()
+	{
+		m_dirty = UINT32_MAX >> (32 - NumVec4);
+	}
+
+	void submit()
+	{
+		if (0 == m_dirty)
+		{
+			benchmarkCountUniformSkip();
+			return;
+		}
+
+		const uint16_t num = uint16_t(32 - bx::uint32_cntlz(m_dirty) );
+
+		if (bgfx::UniformFreq::Frame == FreqT)
+		{
+			bgfx::setFrameUniform(u_params, m_params, num);
+		}
+		else
+		{
+			bgfx::setUniform(u_params, m_params, num);
+		}
+
+		benchmarkCountUniform(num);
+		m_dirty = 0;
+	}
+
+	void destroy()
+	{
+		bgfx::destroy(u_params);
+	}
+
+	template<uint32_t FieldT>
+	void set(const float* _value)
+	{
+		static_assert(FieldT < DescT::Count, "Invalid uniform field.");
+		constexpr uint8_t num = DescT::s_fields[FieldT].m_num;
+
+		for (uint8_t ii = 0; ii < num; ++ii)
+		{
+			setLane(s_layout.m_index[FieldT][ii], _value[ii]);
+		}
+	}
+
+	template<uint32_t FieldT>
+	void set(float _value)
+	{
+		static_assert(1 == DescT::s_fields[FieldT].m_num, "Uniform field isn't a float.");
+		setLane(s_layout.m_index[FieldT][0], _value);
+	}
+
+	template<uint32_t FieldT>
+	void set(const bx::Vec3& _value)
+	{
+		static_assert(3 == DescT::s_fields[FieldT].m_num, "Uniform field isn't a vec3.");
+		setLane(s_layout.m_index[FieldT][0], _value.x);
+		setLane(s_layout.m_index[FieldT][1], _value.y);
+		setLane(s_layout.m_index[FieldT][2], _value.z);
+	}
+
+	bool isDirty() const { return 0 != m_dirty; }
+
+	float m_params[NumVec4 * 4];
+	bgfx::UniformHandle u_params;
+
+private:
+	void setLane(uint16_t _index, float _value)
+	{
+		if (m_params[_index] != _value)
+		{
+			m_params[_index] = _value;
+			m_dirty |= 1u << (_index / 4);
+		}
+	}
+
+	uint32_t m_dirty;
+};
+
+#endif // PROTOTYPE_UNIFORM_BLOCK_H_HEADER_GUARD
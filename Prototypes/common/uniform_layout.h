@@ -0,0 +1,213 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef PROTOTYPE_UNIFORM_LAYOUT_H_HEADER_GUARD
+#define PROTOTYPE_UNIFORM_LAYOUT_H_HEADER_GUARD
+
+#include <stdint.h>
+#include <string>
+
+// Compile-time packing of uniform blocks into a `uniform vec4 u_name[N]` array.
+//
+// A block is described once in C++ (see 01-GoochHighlighted/uniforms.h):
+//
+//   struct MyUniforms
+//   {
+//       enum Enum { Time, Color, Count };
+//       enum { NumVec4 = 1 };                      // Expected size, static_asserted.
+//       static constexpr const char* s_name = "u_params";
+//       static constexpr UniformField s_fields[Count] =
+//       {
+//           { "u_time",  1, false },
+//           { "u_color", 3, false },
+//       };
+//   };
+//
+// The packing is computed by the compiler, UniformBlock<MyUniforms> writes fields
+// straight into their lanes and uniformgen emits the matching shader header with one
+// #define per field, so C++ and shader offsets can't drift apart.
+//
+// Packing rules, vec4 granular like std140 but tighter:
+// - Contiguous fields are placed widest first, first fit, never crossing a vec4.
+// - Scattered fields (m_scatter) go contiguous if they fit, otherwise their
+//   components are spread over the remaining free lanes, e.g. a vec3 in three .w
+//   slots. The shader side reassembles them with a constructor.
+
+struct UniformField
+{
+	const char* m_name;
+	uint8_t     m_num;
+	bool        m_scatter;
+};
+
+template<uint32_t NumFieldsT>
+struct UniformLayout
+{
+	// Float index into the packed array for every component of every field.
+	uint16_t m_index[NumFieldsT][4];
+	uint16_t m_numVec4;
+};
+
+template<uint32_t NumFieldsT>
+constexpr UniformLayout<NumFieldsT> uniformLayoutPack(const UniformField (&_fields)[NumFieldsT])
+{
+	constexpr uint32_t kMaxVec4 = NumFieldsT;
+
+	UniformLayout<NumFieldsT> layout = {};
+	bool used[kMaxVec4 * 4] = {};
+	uint16_t numVec4 = 0;
+
+	auto findContiguous = [&](uint8_t _num, uint16_t& _outIndex) -> bool
+	{
+		for (uint16_t vec4 = 0; vec4 < numVec4; ++vec4)
+		{
+			for (uint16_t offset = 0; offset + _num <= 4; ++offset)
+			{
+				bool free = true;
+				for (uint16_t cc = 0; cc < _num; ++cc)
+				{
+					free = free && !used[vec4*4 + offset + cc];
+				}
+
+				if (free)
+				{
+					_outIndex = uint16_t(vec4*4 + offset);
+					return true;
+				}
+			}
+		}
+
+		return false;
+	};
+
+	auto placeContiguous = [&](uint32_t _field)
+	{
+		const uint8_t num = _fields[_field].m_num;
+		uint16_t index = 0;
+		if (!findContiguous(num, index) )
+		{
+			index = uint16_t(numVec4*4);
+			++numVec4;
+		}
+
+		for (uint16_t cc = 0; cc < num; ++cc)
+		{
+			used[index + cc] = true;
+			layout.m_index[_field][cc] = uint16_t(index + cc);
+		}
+	};
+
+	for (uint8_t num = 4; num > 0; --num)
+	{
+		for (uint32_t ii = 0; ii < NumFieldsT; ++ii)
+		{
+			if (!_fields[ii].m_scatter
+			&&  _fields[ii].m_num == num)
+			{
+				placeContiguous(ii);
+			}
+		}
+	}
+
+	for (uint32_t ii = 0; ii < NumFieldsT; ++ii)
+	{
+		if (!_fields[ii].m_scatter)
+		{
+			continue;
+		}
+
+		const uint8_t num = _fields[ii].m_num;
+		uint16_t index = 0;
+		if (findContiguous(num, index) )
+		{
+			placeContiguous(ii);
+			continue;
+		}
+
+		for (uint16_t cc = 0; cc < num;)
+		{
+			uint16_t lane = 0;
+			while (lane < numVec4*4 && used[lane])
+			{
+				++lane;
+			}
+
+			if (lane == numVec4*4)
+			{
+				++numVec4;
+			}
+
+			used[lane] = true;
+			layout.m_index[ii][cc++] = lane;
+		}
+	}
+
+	layout.m_numVec4 = numVec4;
+	return layout;
+}
+
+template<typename DescT>
+inline constexpr auto kUniformLayout = uniformLayoutPack(DescT::s_fields);
+
+// Appends the shader side declaration of a block: the vec4 array uniform and one
+// #define per field.
+template<typename DescT>
+void uniformLayoutWriteShader(std::string& _out)
+{
+	constexpr auto& layout = kUniformLayout<DescT>;
+	constexpr uint32_t numFields = sizeof(DescT::s_fields) / sizeof(DescT::s_fields[0]);
+	const char* swizzle = "xyzw";
+
+	_out += "uniform vec4 ";
+	_out += DescT::s_name;
+	_out += "[" + std::to_string(layout.m_numVec4) + "];\n\n";
+
+	for (uint32_t ii = 0; ii < numFields; ++ii)
+	{
+		const UniformField& field = DescT::s_fields[ii];
+		const uint16_t* index = layout.m_index[ii];
+
+		bool contiguous = true;
+		for (uint8_t cc = 1; cc < field.m_num; ++cc)
+		{
+			contiguous = contiguous
+				&& index[cc] == index[0] + cc
+				&& index[cc] / 4 == index[0] / 4
+				;
+		}
+
+		const size_t length = std::char_traits<char>::length(field.m_name);
+		_out += "#define ";
+		_out += field.m_name;
+		_out += std::string(length < 20 ? 20 - length : 1, ' ');
+
+		auto lane = [&](uint16_t _index)
+		{
+			return std::string(DescT::s_name) + "[" + std::to_string(_index / 4) + "]." + swizzle[_index % 4];
+		};
+
+		if (contiguous)
+		{
+			_out += lane(index[0]);
+			for (uint8_t cc = 1; cc < field.m_num; ++cc)
+			{
+				_out += swizzle[index[cc] % 4];
+			}
+		}
+		else
+		{
+			_out += "vec" + std::to_string(field.m_num) + "(";
+			for (uint8_t cc = 0; cc < field.m_num; ++cc)
+			{
+				_out += (0 == cc ? "" : ", ") + lane(index[cc]);
+			}
+			_out += ")";
+		}
+
+		_out += "\n";
+	}
+}
+
+#endif // PROTOTYPE_UNIFORM_LAYOUT_H_HEADER_GUARD
@@ -1,6 +1,8 @@
 include(CMakeParseArguments)
 include(${CMAKE_CURRENT_LIST_DIR}/cmake/bgfxToolUtils.cmake)
 include(${CMAKE_CURRENT_LIST_DIR}/cmake/utils/ConfigureDebugging.cmake)
+include(${CMAKE_CURRENT_LIST_DIR}/cmake/shaderCache.cmake)
+set(SHADER_CACHE_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/cmake/shaderCache.cmake)
 
 function(_bgfx_shaderc_parse ARG_OUT)
 		cmake_parse_arguments(
@@ -162,8 +164,92 @@ function(_bgfx_shaderc_parse ARG_OUT)
 		set(${ARG_OUT} ${CLI} PARENT_SCOPE)
 	endfunction()
 
+# Compiles FILE for every backend. A `// permutations: A B C` line in the shader compiles
+# it once per combination of the features instead, each variant with its features
+# defined and named after them in order, e.g. fs_lightsbasic+A+C. A feature written
+# `C:A` only changes the shader together with A, combinations with C but not A aren't
+# compiled. Variants are separate commands, so they build in parallel. The binaries of
+# every variant are returned in OUTPUTS_VAR. See common/program_permutations.h for
+# loading them.
 function(add_bgfx_shader FILE FOLDER)
-    get_filename_component(FILENAME "${FILE}" NAME_WE)
+	cmake_parse_arguments(ARG "" "OUTPUTS_VAR" "DEPENDS" ${ARGN})
+	get_filename_component(FILENAME "${FILE}" NAME_WE)
+
+	file(STRINGS ${FILE} PERMUTATIONS REGEX "^//[ \t]*permutations:" LIMIT_COUNT 1)
+	string(REGEX REPLACE "^//[ \t]*permutations:" "" FEATURES "${PERMUTATIONS}")
+	string(STRIP "${FEATURES}" FEATURES)
+	string(REGEX REPLACE "[ \t]+" ";" FEATURES "${FEATURES}")
+	list(LENGTH FEATURES NUM_FEATURES)
+	if(NUM_FEATURES GREATER 8)
+		message(SEND_ERROR "${FILE} has ${NUM_FEATURES} permutation features, at most 8 are supported.")
+		return()
+	endif()
+
+	# Feature names, and the bit of the feature each one requires, 0 for none.
+	set(FEATURE_NAMES "")
+	foreach(FEATURE ${FEATURES})
+		string(REGEX REPLACE ":.*$" "" FEATURE_NAME "${FEATURE}")
+		list(APPEND FEATURE_NAMES ${FEATURE_NAME})
+	endforeach()
+
+	set(FEATURE_REQUIRES "")
+	foreach(FEATURE ${FEATURES})
+		set(REQUIRES 0)
+		if(FEATURE MATCHES ":(.+)$")
+			list(FIND FEATURE_NAMES ${CMAKE_MATCH_1} REQUIRED_BIT)
+			if(REQUIRED_BIT EQUAL -1)
+				message(SEND_ERROR "${FILE}: permutation feature ${FEATURE} requires an unknown feature.")
+				return()
+			endif()
+			math(EXPR REQUIRES "1 << ${REQUIRED_BIT}")
+		endif()
+		list(APPEND FEATURE_REQUIRES ${REQUIRES})
+	endforeach()
+
+	set(SHADER_OUTPUTS "")
+	math(EXPR LAST_MASK "(1 << ${NUM_FEATURES}) - 1")
+	foreach(MASK RANGE ${LAST_MASK})
+		set(NAME ${FILENAME})
+		set(DEFINES "")
+		set(DEAD FALSE)
+		set(BIT 0)
+		foreach(FEATURE ${FEATURE_NAMES})
+			math(EXPR SELECTED "(${MASK} >> ${BIT}) & 1")
+			if(SELECTED)
+				list(GET FEATURE_REQUIRES ${BIT} REQUIRES)
+				math(EXPR PRESENT "${MASK} & ${REQUIRES}")
+				if(NOT PRESENT EQUAL REQUIRES)
+					set(DEAD TRUE)
+				endif()
+				set(NAME "${NAME}+${FEATURE}")
+				list(APPEND DEFINES ${FEATURE})
+			endif()
+			math(EXPR BIT "${BIT} + 1")
+		endforeach()
+
+		# Same binary as the variant without the feature, ProgramPermutations uses that.
+		if(DEAD)
+			continue()
+		endif()
+
+		# A source file is the main dependency of one command only, the one of the
+		# base shader.
+		set(OUTPUTS "")
+		if(MASK EQUAL 0)
+			_add_bgfx_shader_variant(${FILE} ${FOLDER} ${NAME} MAIN DEPENDS ${ARG_DEPENDS} OUTPUTS_VAR OUTPUTS)
+		else()
+			_add_bgfx_shader_variant(${FILE} ${FOLDER} ${NAME} DEFINES ${DEFINES} DEPENDS ${ARG_DEPENDS} OUTPUTS_VAR OUTPUTS)
+		endif()
+		list(APPEND SHADER_OUTPUTS ${OUTPUTS})
+	endforeach()
+
+	if(ARG_OUTPUTS_VAR)
+		set(${ARG_OUTPUTS_VAR} ${SHADER_OUTPUTS} PARENT_SCOPE)
+	endif()
+endfunction()
+
+function(_add_bgfx_shader_variant FILE FOLDER FILENAME)
+	cmake_parse_arguments(ARG "MAIN" "OUTPUTS_VAR" "DEFINES;DEPENDS" ${ARGN})
 	string(SUBSTRING "${FILENAME}" 0 2 TYPE)
 	if("${TYPE}" STREQUAL "fs")
 		set(TYPE "FRAGMENT")
@@ -176,7 +262,10 @@ function(add_bgfx_shader FILE FOLDER)
 	endif()
 
 	if(NOT "${TYPE}" STREQUAL "")
-		set(COMMON FILE ${FILE} ${TYPE} INCLUDES ${BGFX_DIR}/Prototypes)
+		set(COMMON FILE ${FILE} ${TYPE} INCLUDES ${BGFX_DIR}/Prototypes ${SGRENDER_DIR}/Includes/Shaders)
+		if(ARG_DEFINES)
+			list(APPEND COMMON DEFINES ${ARG_DEFINES})
+		endif()
 		set(OUTPUTS "")
 		set(OUTPUTS_PRETTY "")
 
@@ -234,21 +323,179 @@ function(add_bgfx_shader FILE FOLDER)
 			set(COMMANDS "")
 		endif()
 
+		# With SGTESTBED_SHADER_BATCH the command lines go to the prototype's manifest
+		# instead, add_prototype() compiles them all with one shaderbatch run.
+		if(SGTESTBED_SHADER_BATCH)
+			foreach(OUT ${OUTPUTS})
+				get_filename_component(OUT_DIR ${${OUT}_OUTPUT} DIRECTORY)
+				file(MAKE_DIRECTORY ${OUT_DIR})
+
+				set(LINE "shader")
+				foreach(ARG ${${OUT}})
+					string(APPEND LINE "\t${ARG}")
+				endforeach()
+				set_property(GLOBAL APPEND_STRING PROPERTY SHADER_BATCH_${FOLDER} "${LINE}\n")
+				list(APPEND OUTPUT_FILES ${${OUT}_OUTPUT})
+			endforeach()
+
+			if(ARG_OUTPUTS_VAR)
+				set(${ARG_OUTPUTS_VAR} ${OUTPUT_FILES} PARENT_SCOPE)
+			endif()
+			return()
+		endif()
+
+		# Every backend compiles through shaderCache.cmake with its command line in an
+		# arguments file, rewritten only when it changes. The first one writes the depfile.
+		set(ARGS_DIR ${CMAKE_BINARY_DIR}/shaders/${FOLDER})
+		set(ARGS_FILES "")
+		set(DEPFILE ${ARGS_DIR}/${FILENAME}.d)
+		set(SHADER_DEPFILE ${DEPFILE})
 		foreach(OUT ${OUTPUTS})
 			list(APPEND OUTPUT_FILES ${${OUT}_OUTPUT})
-			list(APPEND COMMANDS COMMAND "bgfx::shaderc" ${${OUT}})
 			get_filename_component(OUT_DIR ${${OUT}_OUTPUT} DIRECTORY)
 			file(MAKE_DIRECTORY ${OUT_DIR})
+
+			string(TOLOWER ${OUT} BACKEND)
+			set(ARGS_FILE ${ARGS_DIR}/${FILENAME}.${BACKEND}.cmake)
+			set(ARGS_CONTENT "set(SHADERC [==[$<TARGET_FILE:bgfx::shaderc>]==])\nset(SHADER_ARGS")
+			foreach(ARG ${${OUT}})
+				# --defines is one argument, keep its separators.
+				string(REPLACE ";" "\\;" ARG "${ARG}")
+				string(APPEND ARGS_CONTENT " [==[${ARG}]==]")
+			endforeach()
+			string(APPEND ARGS_CONTENT ")\nset(SHADER_CACHE_DIR [==[${SGTESTBED_SHADER_CACHE_DIR}]==])\n")
+			string(APPEND ARGS_CONTENT "set(SHADER_DEPFILE [==[${SHADER_DEPFILE}]==])\n")
+			file(GENERATE OUTPUT ${ARGS_FILE} CONTENT "${ARGS_CONTENT}")
+			set(SHADER_DEPFILE "")
+
+			list(APPEND ARGS_FILES ${ARGS_FILE})
+			list(APPEND COMMANDS COMMAND ${CMAKE_COMMAND} -DSHADER_ARGS_FILE=${ARGS_FILE} -P ${SHADER_CACHE_SCRIPT})
 		endforeach()
 
+		# Includes are tracked through the depfile where the generator supports one,
+		# otherwise by the includes found at configure time.
+		if(CMAKE_GENERATOR MATCHES "Ninja|Makefiles" OR CMAKE_VERSION VERSION_GREATER_EQUAL 3.21)
+			set(DEPFILE_ARGS DEPFILE ${DEPFILE})
+		else()
+			shader_cache_scan_includes(INCLUDES ${FILE} ${BGFX_DIR}/Prototypes ${SGRENDER_DIR}/Includes/Shaders)
+			get_filename_component(FILE_DIR ${FILE} DIRECTORY)
+			set(DEPFILE_ARGS DEPENDS ${INCLUDES})
+			if(EXISTS ${FILE_DIR}/varying.def.sc)
+				list(APPEND DEPFILE_ARGS ${FILE_DIR}/varying.def.sc)
+			endif()
+		endif()
+
 		file(RELATIVE_PATH PRINT_NAME ${SGRENDER_DIR}/Prototypes ${FILE})
+		if(ARG_DEFINES)
+			string(REPLACE ";" ", " PRINT_DEFINES "${ARG_DEFINES}")
+			set(PRINT_NAME "${PRINT_NAME} (${PRINT_DEFINES})")
+		endif()
+		if(ARG_MAIN)
+			set(SOURCE_ARGS MAIN_DEPENDENCY ${FILE})
+		else()
+			set(SOURCE_ARGS DEPENDS ${FILE})
+		endif()
+
 		add_custom_command(
-			MAIN_DEPENDENCY ${FILE} OUTPUT ${OUTPUT_FILES} ${COMMANDS}
+			${SOURCE_ARGS} OUTPUT ${OUTPUT_FILES} ${COMMANDS}
+			DEPENDS ${ARG_DEPENDS} ${ARGS_FILES} ${SHADER_CACHE_SCRIPT} bgfx::shaderc
+			${DEPFILE_ARGS}
 			COMMENT "Compiling shader ${PRINT_NAME} for ${OUTPUTS_PRETTY}"
 		)
+
+		if(ARG_OUTPUTS_VAR)
+			set(${ARG_OUTPUTS_VAR} ${OUTPUT_FILES} PARENT_SCOPE)
+		endif()
 	endif()
 endfunction()
 
+# Generates a prototype's uniforms.sh from the uniform block descriptions in its
+# uniforms.h (see common/uniform_layout.h), so shader offsets always match C++.
+function(add_uniform_layout_header NAME HEADER OUTPUT)
+	add_executable(uniformgen-${NAME} ${SGRENDER_DIR}/Prototypes/tools/uniformgen/uniformgen.cpp)
+	target_include_directories(uniformgen-${NAME} PRIVATE ${SGRENDER_DIR}/Prototypes/common)
+	target_compile_definitions(uniformgen-${NAME} PRIVATE "UNIFORMGEN_HEADER=\"${HEADER}\"")
+	set_target_properties(uniformgen-${NAME} PROPERTIES FOLDER "SGTestBed/Tools")
+
+	add_custom_command(
+		OUTPUT ${OUTPUT}
+		COMMAND uniformgen-${NAME} ${OUTPUT}
+		DEPENDS uniformgen-${NAME} ${HEADER} ${SGRENDER_DIR}/Prototypes/common/uniform_layout.h
+		COMMENT "Generating ${NAME}/uniforms.sh"
+	)
+endfunction()
+
+# Host tool under Prototypes/tools/<NAME>/<NAME>.cpp. Tools share sources from common/
+# but link bx, bgfx-vertexlayout and meshoptimizer directly instead of bgfx and
+# example-common, so they run without a renderer or the entry main().
+function(add_prototype_tool NAME)
+	cmake_parse_arguments(ARG "" "" "SOURCES" ${ARGN})
+
+	add_executable(${NAME} ${SGRENDER_DIR}/Prototypes/tools/${NAME}/${NAME}.cpp ${ARG_SOURCES})
+	target_include_directories(
+		${NAME}
+		PRIVATE ${SGRENDER_DIR}/Prototypes/common
+		        ${SGRENDER_DIR}/3rdParty/bgfx.cmake/bgfx/3rdparty
+	)
+	target_link_libraries(${NAME} PRIVATE bx bgfx-vertexlayout meshoptimizer)
+	set_target_properties(${NAME} PROPERTIES FOLDER "SGTestBed/Tools")
+endfunction()
+
+# Packs the binaries of every prototype added so far into one shader archive per backend,
+# runtime/shaders/<backend>.pack, see common/shader_archive.h. An archive is repacked
+# whenever one of its binaries changes and every prototype depends on the archives.
+function(add_shader_archives)
+	get_property(SHADER_BINARIES GLOBAL PROPERTY SGTESTBED_SHADER_BINARIES)
+	get_property(SHADER_STAMPS GLOBAL PROPERTY SGTESTBED_SHADER_STAMPS)
+	get_property(PROTOTYPES GLOBAL PROPERTY SGTESTBED_SHADER_PROTOTYPES)
+	if(NOT SHADER_BINARIES)
+		return()
+	endif()
+	list(REMOVE_DUPLICATES SHADER_BINARIES)
+
+	set(BACKENDS "")
+	foreach(BINARY ${SHADER_BINARIES})
+		get_filename_component(BACKEND_DIR ${BINARY} DIRECTORY)
+		get_filename_component(BACKEND ${BACKEND_DIR} NAME)
+		list(APPEND BACKENDS ${BACKEND})
+		list(APPEND BINARIES_${BACKEND} ${BINARY})
+	endforeach()
+	list(REMOVE_DUPLICATES BACKENDS)
+
+	# Binaries are built by the shaders-<name> targets, the archives only read them.
+	# With SGTESTBED_SHADER_BATCH their stamps stand in for them.
+	if(SGTESTBED_SHADER_BATCH)
+		set(ARCHIVE_DEPENDS ${SHADER_STAMPS})
+	endif()
+
+	set(ARCHIVES "")
+	foreach(BACKEND ${BACKENDS})
+		set(LIST_FILE ${CMAKE_BINARY_DIR}/shaders/${BACKEND}.list)
+		set(ARCHIVE ${SGRENDER_DIR}/Prototypes/runtime/shaders/${BACKEND}.pack)
+		string(REPLACE ";" "\n" LIST_CONTENT "${BINARIES_${BACKEND}}")
+		file(GENERATE OUTPUT ${LIST_FILE} CONTENT "${LIST_CONTENT}\n")
+
+		if(NOT SGTESTBED_SHADER_BATCH)
+			set(ARCHIVE_DEPENDS ${BINARIES_${BACKEND}})
+		endif()
+
+		add_custom_command(
+			OUTPUT ${ARCHIVE}
+			COMMAND shaderpack -o ${ARCHIVE} --list ${LIST_FILE}
+			DEPENDS shaderpack ${LIST_FILE} ${ARCHIVE_DEPENDS}
+			COMMENT "Packing ${BACKEND} shaders"
+		)
+		list(APPEND ARCHIVES ${ARCHIVE})
+	endforeach()
+
+	add_custom_target(shader-archives DEPENDS ${ARCHIVES})
+	set_target_properties(shader-archives PROPERTIES FOLDER "SGTestBed/Shaders")
+	foreach(PROTOTYPE ${PROTOTYPES})
+		add_dependencies(shader-archives shaders-${PROTOTYPE})
+		add_dependencies(prototype-${PROTOTYPE} shader-archives)
+	endforeach()
+endfunction()
+
 function(add_prototype ARG_NAME)
     # Parse arguments
     cmake_parse_arguments(ARG "COMMON" "" "DIRECTORIES;SOURCES" ${ARGN})
@@ -271,15 +518,16 @@ function(add_prototype ARG_NAME)
 		file(GLOB GLOB_SHADERHEADERS ${DIR}/*.sh)
 		list(APPEND SHADERHEADERS ${GLOB_SHADERHEADERS})
     endforeach()
+	list(REMOVE_DUPLICATES SOURCES)
 	
 	if(ARG_COMMON)
-		add_executable(prototype-${ARG_NAME} WIN32 ${SOURCES})
+		add_library(prototype-${ARG_NAME} STATIC ${SOURCES})
 
     else()
         if(NOT ANDROID)
             add_executable(prototype-${ARG_NAME} WIN32 ${SOURCES})
         endif()
-        #target_link_libraries(prototype-${ARG_NAME} PUBLIC prototype-common)
+        target_link_libraries(prototype-${ARG_NAME} PUBLIC prototype-common)
         configure_debugging(prototype-${ARG_NAME} WORKING_DIR ${SGRENDER_DIR}/Prototypes/runtime)
         if(MSVC)
             set_target_properties(prototype-${ARG_NAME} PROPERTIES LINK_FLAGS "/ENTRY:\"mainCRTStartup\"")
@@ -309,6 +557,7 @@ function(add_prototype ARG_NAME)
                 ${BGDIR}/bx/include/compat/msvc
                 ${BGDIR}/bimg/include 
 				${SGRENDER_DIR}/Includes/Shaders
+				${SGRENDER_DIR}/Prototypes/common
     )
 
     #link_directories(${SGRENDER_DIR}/.build/3rdParty/bgfx.cmake/cmake/bgfx)
@@ -317,15 +566,79 @@ function(add_prototype ARG_NAME)
         PRIVATE bgfx bx bimg example-common
                ${DIRECTX_HEADERS}
     )
+
+	if(ARG_COMMON)
+		# Job system workers and meshoptimizer decoding for the mesh loader.
+		find_package(Threads REQUIRED)
+		target_link_libraries(prototype-${ARG_NAME} PUBLIC Threads::Threads PRIVATE meshoptimizer)
+
+		# Where `--shader-reload` finds the sources to watch and the build tree to rebuild.
+		target_compile_definitions(
+			prototype-${ARG_NAME}
+			PRIVATE "SGTESTBED_SOURCE_DIR=\"${SGRENDER_DIR}\""
+			        "SGTESTBED_BINARY_DIR=\"${CMAKE_BINARY_DIR}\""
+			        "SGTESTBED_CMAKE_COMMAND=\"${CMAKE_COMMAND}\""
+			        "SGTESTBED_BUILD_CONFIG=\"$<CONFIG>\""
+		)
+	endif()
     # Configure shaders
     if(NOT ARG_COMMON
         AND NOT IOS
         AND NOT EMSCRIPTEN
         AND NOT ANDROID
     )
+        set(SHADER_DEPENDS "")
+        set(UNIFORMS_HEADER ${SGRENDER_DIR}/Prototypes/${ARG_NAME}/uniforms.h)
+        if(EXISTS ${UNIFORMS_HEADER})
+            set(UNIFORMS_SHADER ${SGRENDER_DIR}/Prototypes/${ARG_NAME}/uniforms.sh)
+            add_uniform_layout_header(${ARG_NAME} ${UNIFORMS_HEADER} ${UNIFORMS_SHADER})
+            list(APPEND SHADER_DEPENDS ${UNIFORMS_SHADER})
+        endif()
+
+        set(SHADER_OUTPUTS "")
         foreach(SHADER ${SHADERS})
-            add_bgfx_shader(${SHADER} ${ARG_NAME})
+            add_bgfx_shader(${SHADER} ${ARG_NAME} DEPENDS ${SHADER_DEPENDS} OUTPUTS_VAR OUTPUTS)
+            list(APPEND SHADER_OUTPUTS ${OUTPUTS})
         endforeach()
+        set_property(GLOBAL APPEND PROPERTY SGTESTBED_SHADER_BINARIES ${SHADER_OUTPUTS})
+
+        if(SGTESTBED_SHADER_BATCH)
+            # One shaderbatch run compiles the manifest on all cores and only rebuilds
+            # what changed. Its depfile lists every input of every binary.
+            set(BATCH_DIR ${CMAKE_BINARY_DIR}/shaders/${ARG_NAME})
+            get_property(MANIFEST_CONTENT GLOBAL PROPERTY SHADER_BATCH_${ARG_NAME})
+            file(GENERATE
+                OUTPUT ${BATCH_DIR}/manifest.txt
+                CONTENT "shaderc\t$<TARGET_FILE:bgfx::shaderc>\ncache\t${SGTESTBED_SHADER_CACHE_DIR}\n${MANIFEST_CONTENT}"
+            )
+
+            if(CMAKE_GENERATOR MATCHES "Ninja|Makefiles" OR CMAKE_VERSION VERSION_GREATER_EQUAL 3.21)
+                set(DEPFILE_ARGS DEPFILE ${BATCH_DIR}/shaders.d)
+            else()
+                set(DEPFILE_ARGS DEPENDS ${SHADERHEADERS})
+            endif()
+
+            add_custom_command(
+                OUTPUT ${BATCH_DIR}/shaders.stamp
+                BYPRODUCTS ${SHADER_OUTPUTS}
+                COMMAND shaderbatch
+                        --manifest ${BATCH_DIR}/manifest.txt
+                        --depfile ${BATCH_DIR}/shaders.d
+                        --stamp ${BATCH_DIR}/shaders.stamp
+                DEPENDS shaderbatch bgfx::shaderc ${BATCH_DIR}/manifest.txt ${SHADERS} ${SHADER_DEPENDS}
+                ${DEPFILE_ARGS}
+                COMMENT "Compiling shaders of ${ARG_NAME}"
+            )
+            set(SHADER_OUTPUTS ${BATCH_DIR}/shaders.stamp)
+        endif()
+
+        # Every variant of the prototype's shaders and nothing else, so a running
+        # prototype can rebuild them on its own, see common/shader_reload.h.
+        add_custom_target(shaders-${ARG_NAME} DEPENDS ${SHADER_OUTPUTS})
+        set_target_properties(shaders-${ARG_NAME} PROPERTIES FOLDER "SGTestBed/Shaders")
+        add_dependencies(prototype-${ARG_NAME} shaders-${ARG_NAME})
+        set_property(GLOBAL APPEND PROPERTY SGTESTBED_SHADER_PROTOTYPES ${ARG_NAME})
+        set_property(GLOBAL APPEND PROPERTY SGTESTBED_SHADER_STAMPS ${SHADER_OUTPUTS})
 		
         source_group("Shader Files" FILES ${SHADERS} ${SHADERHEADERS})
     endif()
@@ -350,12 +663,75 @@ if(SGTESTBED_BUILD_PROTOTYPES)
     set(SGTESTBED_PROTOTYPES 
         01-GoochHighlighted
 		02-Lights-Basic
+		03-Instancing
+		04-ClusteredLights
     )
 
     foreach(PROTOTYPE ${SGTESTBED_PROTOTYPES})
         add_prototype(${PROTOTYPE})
     endforeach()
 
+    # 03-Instancing draws with 01-GoochHighlighted's shaders.
+    add_dependencies(prototype-03-Instancing prototype-01-GoochHighlighted)
+    add_dependencies(shaders-03-Instancing shaders-01-GoochHighlighted)
+
+    add_prototype_tool(
+        meshtool
+        SOURCES ${SGRENDER_DIR}/Prototypes/common/mapped_file.cpp
+                ${SGRENDER_DIR}/Prototypes/common/mesh_file.cpp
+                ${SGRENDER_DIR}/Prototypes/common/mesh_optimize.cpp
+                ${SGRENDER_DIR}/Prototypes/common/mesh_quantize.cpp
+    )
+
+    add_prototype_tool(
+        lightbench
+        SOURCES ${SGRENDER_DIR}/Prototypes/common/job_system.cpp
+                ${SGRENDER_DIR}/Prototypes/common/light_binning.cpp
+    )
+    target_link_libraries(lightbench PRIVATE Threads::Threads)
+
+    add_prototype_tool(
+        dfgtool
+        SOURCES ${SGRENDER_DIR}/Prototypes/common/dfg_lut.cpp
+                ${SGRENDER_DIR}/Prototypes/common/job_system.cpp
+                ${SGRENDER_DIR}/Prototypes/common/mapped_file.cpp
+    )
+    target_link_libraries(dfgtool PRIVATE Threads::Threads)
+
+    add_prototype_tool(
+        iblbench
+        SOURCES ${SGRENDER_DIR}/Prototypes/common/ibl.cpp
+                ${SGRENDER_DIR}/Prototypes/common/job_system.cpp
+                ${SGRENDER_DIR}/Prototypes/common/mapped_file.cpp
+    )
+    target_link_libraries(iblbench PRIVATE Threads::Threads)
+
+    add_prototype_tool(
+        shaderbatch
+        SOURCES ${SGRENDER_DIR}/Prototypes/common/job_system.cpp
+                ${SGRENDER_DIR}/Prototypes/common/mapped_file.cpp
+    )
+    target_link_libraries(shaderbatch PRIVATE Threads::Threads)
+
+    add_prototype_tool(
+        shaderpack
+        SOURCES ${SGRENDER_DIR}/Prototypes/common/mapped_file.cpp
+                ${SGRENDER_DIR}/Prototypes/common/shader_archive.cpp
+    )
+
+    add_prototype_tool(
+        pathtracer
+        SOURCES ${SGRENDER_DIR}/Prototypes/common/ibl.cpp
+                ${SGRENDER_DIR}/Prototypes/common/job_system.cpp
+                ${SGRENDER_DIR}/Prototypes/common/mapped_file.cpp
+                ${SGRENDER_DIR}/Prototypes/common/mesh_file.cpp
+                ${SGRENDER_DIR}/Prototypes/common/mesh_quantize.cpp
+                ${SGRENDER_DIR}/Prototypes/common/path_tracer.cpp
+    )
+    target_link_libraries(pathtracer PRIVATE Threads::Threads)
+
+    add_shader_archives()
+
     if(SGTESTBED_INSTALL_EXAMPLES)
         install(DIRECTORY ${SGRENDER_DIR}/Prototypes/runtime/ DESTINATION Prototypes)
         foreach(PROTOTYPE ${SGTESTBED_PROTOTYPES})
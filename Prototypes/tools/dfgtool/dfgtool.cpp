@@ -0,0 +1,263 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+// Offline DFG LUT generator. Integrates the table from common/dfg_lut.h and writes the
+// cache file the prototypes load, e.g. to ship a prebuilt runtime/cache/dfg_lut.bin or
+// to try other sizes and sample counts. --verify checks that the bxdfs.h terms give bit
+// identical results for float, SimdFloat4 and SimdFloat8 lanes in this build.
+
+#include <bx/commandline.h>
+#include <bx/file.h>
+#include <bx/rng.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "bxdfs.h"
+#include "dfg_lut.h"
+#include "job_system.h"
+
+namespace
+{
+	void help(const char* _error = NULL)
+	{
+		if (NULL != _error)
+		{
+			fprintf(stderr, "Error:\n%s\n\n", _error);
+		}
+
+		fprintf(stderr
+			, "Usage: dfgtool -o <out> [options]\n"
+			  "       dfgtool --verify\n"
+			  "\n"
+			  "Options:\n"
+			  "  -o <file>         Output cache file.\n"
+			  "  --size <n>        Texels along NdotV and roughness (default 128).\n"
+			  "  --samples <n>     Importance samples per texel, rounded up to a multiple of 8 (default 512).\n"
+			  "  --threads <n>     Threads to integrate with (default one per hardware thread).\n"
+			  "  --verify          Compare the BXDF terms across lane types instead, fails on any difference.\n"
+			);
+	}
+
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+	constexpr uint32_t kVerifySamples = 64*1024;
+
+	struct VerifyInput
+	{
+		enum Enum
+		{
+			NdotV,
+			NdotL,
+			LdotH,
+			NdotH,
+			Roughness,
+			F0,
+
+			Count
+		};
+	};
+
+	struct VerifyTerm
+	{
+		enum Enum
+		{
+			FSchlick,
+			DGgx,
+			GSmith,
+			FrDisney,
+
+			Count
+		};
+	};
+
+	const char* s_verifyTermName[] =
+	{
+		"F_Schlick",
+		"D_GGX",
+		"G_SmithGGXCorrelated",
+		"Fr_DisneyDiffuse",
+	};
+	static_assert(BX_COUNTOF(s_verifyTermName) == VerifyTerm::Count);
+
+	// Evaluates every term on all samples, _numLanes at a time. Inputs and outputs are one
+	// block of kVerifySamples floats per VerifyInput and VerifyTerm.
+	template<typename T>
+	void verifyTerms(float* _out, const float* _in, uint32_t _numLanes)
+	{
+		for (uint32_t ii = 0; ii < kVerifySamples; ii += _numLanes)
+		{
+			const T NdotV     = bxdfLoad<T>(&_in[VerifyInput::NdotV    *kVerifySamples + ii]);
+			const T NdotL     = bxdfLoad<T>(&_in[VerifyInput::NdotL    *kVerifySamples + ii]);
+			const T LdotH     = bxdfLoad<T>(&_in[VerifyInput::LdotH    *kVerifySamples + ii]);
+			const T NdotH     = bxdfLoad<T>(&_in[VerifyInput::NdotH    *kVerifySamples + ii]);
+			const T roughness = bxdfLoad<T>(&_in[VerifyInput::Roughness*kVerifySamples + ii]);
+			const T f0        = bxdfLoad<T>(&_in[VerifyInput::F0       *kVerifySamples + ii]);
+			const T alpha     = roughness*roughness;
+
+			bxdfStore(&_out[VerifyTerm::FSchlick*kVerifySamples + ii], F_Schlick(f0, T(1.0f), LdotH) );
+			bxdfStore(&_out[VerifyTerm::DGgx    *kVerifySamples + ii], D_GGX(NdotH, alpha) );
+			bxdfStore(&_out[VerifyTerm::GSmith  *kVerifySamples + ii], G_SmithGGXCorrelated(NdotL, NdotV, alpha) );
+			bxdfStore(&_out[VerifyTerm::FrDisney*kVerifySamples + ii], Fr_DisneyDiffuse(NdotV, NdotL, LdotH, roughness) );
+		}
+	}
+
+	int verify()
+	{
+		// Inputs in (0, 1], the ranges the shaders and the DFG integration feed the terms.
+		std::vector<float> in(VerifyInput::Count*kVerifySamples);
+		bx::RngMwc rng;
+		for (float& value : in)
+		{
+			value = 1.0f - bx::frnd(&rng);
+		}
+
+		std::vector<float> scalar(VerifyTerm::Count*kVerifySamples);
+		std::vector<float> simd4(VerifyTerm::Count*kVerifySamples);
+		std::vector<float> simd8(VerifyTerm::Count*kVerifySamples);
+		verifyTerms<float>(scalar.data(), in.data(), 1);
+		verifyTerms<SimdFloat4>(simd4.data(), in.data(), 4);
+		verifyTerms<SimdFloat8>(simd8.data(), in.data(), 8);
+
+		bool match = true;
+		for (uint32_t term = 0; term < VerifyTerm::Count; ++term)
+		{
+			uint32_t numDiffs = 0;
+			uint32_t first    = 0;
+			for (uint32_t ii = term*kVerifySamples, end = ii + kVerifySamples; ii < end; ++ii)
+			{
+				if (0 != bx::memCmp(&scalar[ii], &simd4[ii], sizeof(float) )
+				||  0 != bx::memCmp(&scalar[ii], &simd8[ii], sizeof(float) ) )
+				{
+					first = 0 == numDiffs ? ii : first;
+					++numDiffs;
+				}
+			}
+
+			printf("[dfgtool] %-20s %u samples, %u differ%s\n"
+				, s_verifyTermName[term]
+				, kVerifySamples
+				, numDiffs
+				, 0 == numDiffs ? "" : " MISMATCH"
+				);
+
+			if (0 != numDiffs)
+			{
+				printf("[dfgtool] %-20s first at %u: %.9g float, %.9g SimdFloat4, %.9g SimdFloat8\n"
+					, ""
+					, first - term*kVerifySamples
+					, scalar[first]
+					, simd4[first]
+					, simd8[first]
+					);
+				match = false;
+			}
+		}
+
+		return match ? bx::kExitSuccess : bx::kExitFailure;
+	}
+
+} // namespace
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg("verify") )
+	{
+		return verify();
+	}
+
+	const char* outFilePath = cmdLine.findOption('o');
+	if (NULL == outFilePath)
+	{
+		help("Output file must be specified.");
+		return bx::kExitFailure;
+	}
+
+	DfgLutDesc desc;
+	if (const char* size = cmdLine.findOption("size") )
+	{
+		uint32_t value = 0;
+		bx::fromString(&value, size);
+		if (0 == value
+		||  UINT16_MAX < value)
+		{
+			help("Size must be between 1 and 65535.");
+			return bx::kExitFailure;
+		}
+
+		desc.m_size = uint16_t(value);
+	}
+
+	if (const char* samples = cmdLine.findOption("samples") )
+	{
+		bx::fromString(&desc.m_numSamples, samples);
+	}
+
+	uint32_t numThreads = bx::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+	if (const char* threads = cmdLine.findOption("threads") )
+	{
+		bx::fromString(&numThreads, threads);
+		numThreads = bx::max<uint32_t>(numThreads, 1);
+	}
+
+	std::vector<float> lut(uint32_t(desc.m_size)*desc.m_size*4);
+
+	const int64_t start = bx::getHPCounter();
+	if (1 < numThreads)
+	{
+		// The calling thread works too.
+		JobSystem jobs;
+		jobs.init(numThreads - 1);
+		dfgLutCompute(lut.data(), desc, &jobs);
+		jobs.shutdown();
+	}
+	else
+	{
+		dfgLutCompute(lut.data(), desc);
+	}
+	const double timeMs = toMs(bx::getHPCounter() - start);
+
+	bx::Error err;
+	bx::FileWriter writer;
+	if (!bx::open(&writer, outFilePath, false, &err) )
+	{
+		fprintf(stderr, "Unable to open output file '%s'.\n", outFilePath);
+		return bx::kExitFailure;
+	}
+
+	const bool written = dfgLutWrite(&writer, desc, lut.data(), &err);
+	bx::close(&writer);
+
+	if (!written)
+	{
+		fprintf(stderr, "Failed to write '%s'.\n", outFilePath);
+		return bx::kExitFailure;
+	}
+
+	printf("[dfgtool] %s: %ux%u, %u samples, %u threads, %.3f ms\n"
+		, outFilePath
+		, desc.m_size
+		, desc.m_size
+		, desc.m_numSamples
+		, numThreads
+		, timeMs
+		);
+
+	return bx::kExitSuccess;
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+// Environment prefiltering benchmark. Prefilters the procedural sky from common/ibl.h
+// at several specular resolutions and sample counts, single threaded and on N threads,
+// and prints the time per prefilter and the speedup. Then times the spherical harmonics
+// irradiance projection of 128^2 to 512^2 sources the same way.
+
+#include <bx/commandline.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "ibl.h"
+#include "job_system.h"
+
+namespace
+{
+	void help(const char* _error = NULL)
+	{
+		if (NULL != _error)
+		{
+			fprintf(stderr, "Error:\n%s\n\n", _error);
+		}
+
+		fprintf(stderr
+			, "Usage: iblbench [options]\n"
+			  "\n"
+			  "Options:\n"
+			  "  --size <n>        Only prefilter to n^2 specular faces (default 64, 128 and 256).\n"
+			  "  --samples <n>     Only use n specular samples (default 16, 64 and 256).\n"
+			  "  --source <n>      Source cubemap face size (default 256).\n"
+			  "  --threads <n>     Threads to compare against one (default one per hardware thread).\n"
+			  "  --iterations <n>  Timed prefilters per configuration (default 3).\n"
+			);
+	}
+
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+	double benchPrefilter(const IblCubemap& _source, const IblPrefilterDesc& _desc, JobSystem* _jobs, uint32_t _iterations, IblCubemap& _outSpecular, IblCubemap& _outIrradiance)
+	{
+		double total = 0.0;
+		for (uint32_t ii = 0; ii < _iterations; ++ii)
+		{
+			const int64_t start = bx::getHPCounter();
+			iblPrefilter(_outSpecular, _outIrradiance, _source, _desc, _jobs);
+			total += toMs(bx::getHPCounter() - start);
+		}
+
+		return total / double(_iterations);
+	}
+
+	double benchProjectSh(const IblCubemap& _source, JobSystem* _jobs, uint32_t _iterations, IblSh& _outSh)
+	{
+		double total = 0.0;
+		for (uint32_t ii = 0; ii < _iterations; ++ii)
+		{
+			const int64_t start = bx::getHPCounter();
+			iblProjectSh(_outSh, _source, _jobs);
+			total += toMs(bx::getHPCounter() - start);
+		}
+
+		return total / double(_iterations);
+	}
+
+	bool parsePowerOfTwo(uint16_t& _outValue, const char* _option)
+	{
+		uint32_t value = 0;
+		bx::fromString(&value, _option);
+		_outValue = uint16_t(value);
+
+		return 0 != value
+			&& UINT16_MAX >= value
+			&& 0 == (value & (value - 1) )
+			;
+	}
+
+} // namespace
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitSuccess;
+	}
+
+	std::vector<uint16_t> sizes = { 64, 128, 256 };
+	if (const char* size = cmdLine.findOption("size") )
+	{
+		uint16_t value;
+		if (!parsePowerOfTwo(value, size) )
+		{
+			help("Size must be a power of two.");
+			return bx::kExitFailure;
+		}
+
+		sizes = { value };
+	}
+
+	std::vector<uint32_t> sampleCounts = { 16, 64, 256 };
+	if (const char* samples = cmdLine.findOption("samples") )
+	{
+		uint32_t value = 0;
+		bx::fromString(&value, samples);
+		sampleCounts = { bx::max<uint32_t>(value, 1) };
+	}
+
+	uint16_t sourceSize = 256;
+	if (const char* source = cmdLine.findOption("source") )
+	{
+		if (!parsePowerOfTwo(sourceSize, source) )
+		{
+			help("Source size must be a power of two.");
+			return bx::kExitFailure;
+		}
+	}
+
+	uint32_t numThreads = bx::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+	if (const char* threads = cmdLine.findOption("threads") )
+	{
+		bx::fromString(&numThreads, threads);
+		numThreads = bx::max<uint32_t>(numThreads, 1);
+	}
+
+	uint32_t iterations = 3;
+	if (const char* iterationsOption = cmdLine.findOption("iterations") )
+	{
+		bx::fromString(&iterations, iterationsOption);
+		iterations = bx::max<uint32_t>(iterations, 1);
+	}
+
+	// The calling thread works too.
+	JobSystem jobs;
+	jobs.init(numThreads - 1);
+
+	std::vector<float> sky;
+	iblCreateSky(sky, sourceSize*4, sourceSize*2);
+
+	IblCubemap source;
+	iblEquirectToCubemap(source, sky.data(), sourceSize*4, sourceSize*2, sourceSize, &jobs);
+
+	for (const uint16_t size : sizes)
+	{
+		for (const uint32_t numSamples : sampleCounts)
+		{
+			IblPrefilterDesc desc;
+			desc.m_specularSize = size;
+			desc.m_numSamples   = numSamples;
+
+			IblCubemap specular;
+			IblCubemap irradiance;
+			const double serialMs = benchPrefilter(source, desc, NULL, iterations, specular, irradiance);
+
+			IblCubemap threadedSpecular;
+			IblCubemap threadedIrradiance;
+			const double threadedMs = 1 < numThreads
+				? benchPrefilter(source, desc, &jobs, iterations, threadedSpecular, threadedIrradiance)
+				: serialMs
+				;
+
+			const bool match = 1 == numThreads
+				|| (specular.m_texels   == threadedSpecular.m_texels
+				&&  irradiance.m_texels == threadedIrradiance.m_texels)
+				;
+
+			printf("[iblbench] %4u^2, %3u samples: 1 thread %9.3f ms, %2u threads %9.3f ms, %5.2fx%s\n"
+				, size
+				, numSamples
+				, serialMs
+				, numThreads
+				, threadedMs
+				, serialMs / threadedMs
+				, match ? "" : " MISMATCH"
+				);
+
+			if (!match)
+			{
+				jobs.shutdown();
+				return bx::kExitFailure;
+			}
+		}
+	}
+
+	for (const uint16_t size : { 128, 256, 512 })
+	{
+		std::vector<float> shSky;
+		iblCreateSky(shSky, size*4, size*2);
+
+		IblCubemap shSource;
+		iblEquirectToCubemap(shSource, shSky.data(), size*4, size*2, size, &jobs);
+
+		IblSh sh;
+		const double serialMs = benchProjectSh(shSource, NULL, iterations, sh);
+
+		IblSh threadedSh;
+		const double threadedMs = 1 < numThreads
+			? benchProjectSh(shSource, &jobs, iterations, threadedSh)
+			: serialMs
+			;
+
+		const bool match = 1 == numThreads
+			|| 0 == bx::memCmp(sh.m_coeffs, threadedSh.m_coeffs, sizeof(sh.m_coeffs) )
+			;
+
+		printf("[iblbench] sh %4u^2 source: 1 thread %9.3f ms, %2u threads %9.3f ms, %5.2fx%s\n"
+			, size
+			, serialMs
+			, numThreads
+			, threadedMs
+			, serialMs / threadedMs
+			, match ? "" : " MISMATCH"
+			);
+
+		if (!match)
+		{
+			jobs.shutdown();
+			return bx::kExitFailure;
+		}
+	}
+
+	jobs.shutdown();
+
+	return bx::kExitSuccess;
+}
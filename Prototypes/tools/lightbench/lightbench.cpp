@@ -0,0 +1,204 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+// CPU light binning benchmark. Bins random LightsBasic point lights into the clustered
+// lights froxel grid from common/light_binning.h with 1 to N threads and prints the
+// time per bin and the speedup over the single threaded run, for 1k, 10k and 100k
+// lights by default.
+
+#include <bx/commandline.h>
+#include <bx/rng.h>
+#include <bx/string.h>
+
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "job_system.h"
+#include "light_binning.h"
+
+namespace
+{
+	void help(const char* _error = NULL)
+	{
+		if (NULL != _error)
+		{
+			fprintf(stderr, "Error:\n%s\n\n", _error);
+		}
+
+		fprintf(stderr
+			, "Usage: lightbench [options]\n"
+			  "\n"
+			  "Options:\n"
+			  "  --lights <n>     Only bin n lights (default 1000, 10000 and 100000).\n"
+			  "  --threads <n>    Most threads to scale to (default one per hardware thread).\n"
+			  "  --iterations <n> Timed bins per configuration (default 50).\n"
+			  "  --radius <r>     Largest light influenceRadiusMax (default 4).\n"
+			);
+	}
+
+	// Lights scattered through a box around the view frustum, so some miss it entirely.
+	void createLights(std::vector<PointLight>& _outLights, uint32_t _num, float _radius)
+	{
+		bx::RngMwc rng;
+
+		_outLights.resize(_num);
+		for (PointLight& light : _outLights)
+		{
+			light.m_pos =
+			{
+				bx::lerp(-60.0f,  60.0f, bx::frnd(&rng) ),
+				bx::lerp(-35.0f,  35.0f, bx::frnd(&rng) ),
+				bx::lerp(  0.0f, 100.0f, bx::frnd(&rng) ),
+			};
+			light.m_radiusMax = bx::lerp(0.25f*_radius, _radius, bx::frnd(&rng) );
+			light.m_color     = { 1.0f, 1.0f, 1.0f };
+			light.m_radiusMin = 0.25f;
+		}
+	}
+
+	double benchBin(LightBinner& _binner, const std::vector<PointLight>& _lights, const float* _view, const float* _proj, JobSystem* _jobs, uint32_t _iterations)
+	{
+		const uint32_t numLights = uint32_t(_lights.size() );
+
+		// Warm up the scratch buffers and the workers.
+		for (uint32_t ii = 0; ii < 3; ++ii)
+		{
+			_binner.bin(_lights.data(), numLights, _view, _proj, _jobs);
+		}
+
+		double total = 0.0;
+		for (uint32_t ii = 0; ii < _iterations; ++ii)
+		{
+			_binner.bin(_lights.data(), numLights, _view, _proj, _jobs);
+			total += _binner.getStats().m_binTimeMs;
+		}
+
+		return total / double(_iterations);
+	}
+
+} // namespace
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitSuccess;
+	}
+
+	std::vector<uint32_t> lightCounts = { 1000, 10000, 100000 };
+	if (const char* lights = cmdLine.findOption("lights") )
+	{
+		uint32_t numLights = 0;
+		bx::fromString(&numLights, lights);
+		if (0 == numLights)
+		{
+			help("Light count must be at least 1.");
+			return bx::kExitFailure;
+		}
+
+		lightCounts = { numLights };
+	}
+
+	uint32_t maxThreads = bx::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+	if (const char* threads = cmdLine.findOption("threads") )
+	{
+		bx::fromString(&maxThreads, threads);
+		maxThreads = bx::max<uint32_t>(maxThreads, 1);
+	}
+
+	uint32_t iterations = 50;
+	if (const char* iterationsOption = cmdLine.findOption("iterations") )
+	{
+		bx::fromString(&iterations, iterationsOption);
+		iterations = bx::max<uint32_t>(iterations, 1);
+	}
+
+	float radius = 4.0f;
+	if (const char* radiusOption = cmdLine.findOption("radius") )
+	{
+		bx::fromString(&radius, radiusOption);
+	}
+
+	// Powers of two up to the thread limit, and the limit itself.
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t num = 1; num < maxThreads; num *= 2)
+	{
+		threadCounts.push_back(num);
+	}
+	threadCounts.push_back(maxThreads);
+
+	float view[16];
+	bx::mtxIdentity(view);
+
+	for (const uint32_t numLights : lightCounts)
+	{
+		LightClustersDesc desc;
+		desc.m_maxLights  = numLights;
+		desc.m_maxIndices = UINT32_MAX;
+
+		float proj[16];
+		bx::mtxProj(proj, 60.0f, 16.0f/9.0f, desc.m_near, desc.m_far, false);
+
+		std::vector<PointLight> lights;
+		createLights(lights, numLights, radius);
+
+		LightBinner binner;
+		binner.init(desc);
+
+		// Single threaded reference, every threaded run must produce the same tables.
+		const double serialMs = benchBin(binner, lights, view, proj, NULL, iterations);
+		const LightClustersStats stats = binner.getStats();
+		const std::vector<float> indices(binner.getIndices(), binner.getIndices() + stats.m_numIndices);
+		const std::vector<float> clusters(binner.getClusters(), binner.getClusters() + stats.m_numClusters*2);
+
+		printf("[lightbench] %u lights: %u indices, %u/%u clusters occupied, max %u per cluster, %u overflowed\n"
+			, numLights
+			, stats.m_numIndices
+			, stats.m_numOccupied
+			, stats.m_numClusters
+			, stats.m_maxPerCluster
+			, stats.m_numOverflowed
+			);
+
+		for (const uint32_t numThreads : threadCounts)
+		{
+			double timeMs = serialMs;
+			bool match = true;
+
+			if (1 < numThreads)
+			{
+				// The calling thread works too.
+				JobSystem jobs;
+				jobs.init(numThreads - 1);
+				timeMs = benchBin(binner, lights, view, proj, &jobs, iterations);
+				jobs.shutdown();
+
+				match = binner.getStats().m_numIndices == stats.m_numIndices
+					&& 0 == bx::memCmp(binner.getIndices(), indices.data(), indices.size()*sizeof(float) )
+					&& 0 == bx::memCmp(binner.getClusters(), clusters.data(), clusters.size()*sizeof(float) )
+					;
+			}
+
+			printf("[lightbench] %6u lights, %2u threads: %8.4f ms, %5.2fx%s\n"
+				, numLights
+				, numThreads
+				, timeMs
+				, serialMs / timeMs
+				, match ? "" : " MISMATCH"
+				);
+
+			if (!match)
+			{
+				return bx::kExitFailure;
+			}
+		}
+	}
+
+	return bx::kExitSuccess;
+}
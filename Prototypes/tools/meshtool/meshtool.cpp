@@ -0,0 +1,124 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+// Offline mesh processing for geometryc .bin files. Reads a .bin, runs the mesh
+// optimization passes from common/mesh_optimize.h, optionally converts it to the compact
+// vertex format from common/mesh_quantize.h, prints their metrics and writes the result
+// back in the same chunk format.
+
+#include <bx/commandline.h>
+#include <bx/file.h>
+#include <bx/string.h>
+
+#include <stdio.h>
+
+#include "mesh_file.h"
+#include "mesh_optimize.h"
+#include "mesh_quantize.h"
+
+namespace
+{
+	void help(const char* _error = NULL)
+	{
+		if (NULL != _error)
+		{
+			fprintf(stderr, "Error:\n%s\n\n", _error);
+		}
+
+		fprintf(stderr
+			, "Usage: meshtool -f <in.bin> -o <out.bin> [options]\n"
+			  "\n"
+			  "Options:\n"
+			  "  -f <file path>                Input .bin file.\n"
+			  "  -o <file path>                Output .bin file, may be the input file.\n"
+			  "  --tipsify                     FIFO cache vertex cache optimizer (Tipsify).\n"
+			  "  --cache-size <n>              Simulated post-transform cache size (default 16).\n"
+			  "  --overdraw-threshold <ratio>  ACMR the overdraw pass may give up (default 1.05).\n"
+			  "  --quantize                    16-bit positions, octahedral normals, half UVs.\n"
+			);
+	}
+
+} // namespace
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	const char* inFilePath  = cmdLine.findOption('f');
+	const char* outFilePath = cmdLine.findOption('o');
+	if (NULL == inFilePath
+	||  NULL == outFilePath)
+	{
+		help("Input and output file must be specified.");
+		return bx::kExitFailure;
+	}
+
+	MeshOptimizeDesc desc;
+	desc.m_fifo = cmdLine.hasArg("tipsify");
+
+	if (const char* cacheSize = cmdLine.findOption("cache-size") )
+	{
+		bx::fromString(&desc.m_cacheSize, cacheSize);
+	}
+
+	if (const char* threshold = cmdLine.findOption("overdraw-threshold") )
+	{
+		bx::fromString(&desc.m_overdrawThreshold, threshold);
+	}
+
+	MeshFileData* data = meshFileOpen(inFilePath);
+	if (NULL == data)
+	{
+		fprintf(stderr, "Failed to read '%s'.\n", inFilePath);
+		return bx::kExitFailure;
+	}
+
+	MeshOptimizeStats stats;
+	meshFileOptimize(*data, desc, &stats);
+	meshOptimizeStatsPrint(inFilePath, stats);
+
+	if (cmdLine.hasArg("quantize") )
+	{
+		MeshQuantizeStats quantizeStats;
+		meshFileQuantize(*data, &quantizeStats);
+		meshQuantizeStatsPrint(inFilePath, quantizeStats);
+	}
+
+	// Serialize before closing, the output may overwrite the mapped input.
+	bx::DefaultAllocator allocator;
+	bx::MemoryBlock memBlock(&allocator);
+	bx::MemoryWriter memWriter(&memBlock);
+
+	bx::Error err;
+	meshFileWrite(&memWriter, data->m_mesh, &err);
+	const int64_t size = bx::seek(&memWriter, 0, bx::Whence::Current);
+	meshFileClose(data);
+
+	if (!err.isOk() )
+	{
+		fprintf(stderr, "Failed to serialize '%s'.\n", inFilePath);
+		return bx::kExitFailure;
+	}
+
+	bx::FileWriter writer;
+	if (!bx::open(&writer, outFilePath, false, &err) )
+	{
+		fprintf(stderr, "Unable to open output file '%s'.\n", outFilePath);
+		return bx::kExitFailure;
+	}
+
+	bx::write(&writer, memBlock.more(), int32_t(size), &err);
+	bx::close(&writer);
+
+	if (!err.isOk() )
+	{
+		fprintf(stderr, "Failed to write '%s'.\n", outFilePath);
+		return bx::kExitFailure;
+	}
+
+	printf("Wrote '%s' (%u bytes).\n", outFilePath, uint32_t(size) );
+
+	return bx::kExitSuccess;
+}
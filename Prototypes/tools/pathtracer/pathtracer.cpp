@@ -0,0 +1,333 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+// Reference renderer for 02-Lights-Basic. Path traces the LightsBasic scene, ground cube,
+// bunny, gold material, point light and procedural sky as the prototype starts up, with
+// common/path_tracer.h and writes a Radiance .hdr to compare the real-time image with.
+// --furnace renders a white metal bunny alone under a white sky instead, where an energy
+// conserving BRDF never comes out brighter than the sky; the exit code fails if it does.
+
+#include <bx/commandline.h>
+#include <bx/file.h>
+#include <bx/string.h>
+
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "ibl.h"
+#include "job_system.h"
+#include "mesh_file.h"
+#include "mesh_quantize.h"
+#include "path_tracer.h"
+
+namespace
+{
+	void help(const char* _error = NULL)
+	{
+		if (NULL != _error)
+		{
+			fprintf(stderr, "Error:\n%s\n\n", _error);
+		}
+
+		fprintf(stderr
+			, "Usage: pathtracer -o <out.hdr> [options]\n"
+			  "\n"
+			  "Options:\n"
+			  "  -o <file path>       Output Radiance .hdr file.\n"
+			  "  --meshes <dir>       Directory with cube.bin and bunny.bin (default meshes).\n"
+			  "  --width <n>          Image width (default 640).\n"
+			  "  --height <n>         Image height (default 360).\n"
+			  "  --samples <n>        Samples per pixel (default 64).\n"
+			  "  --bounces <n>        Surface interactions per path (default 8).\n"
+			  "  --threads <n>        Threads to trace on (default one per hardware thread).\n"
+			  "  --roughness <r>      Material roughness (default 0.2).\n"
+			  "  --metallic <m>       Material metallic (default 1).\n"
+			  "  --furnace            White metal bunny alone under a white sky, no point light.\n"
+			);
+	}
+
+	// Adds every group of a .bin file, false if it can't be read.
+	bool addMeshFile(PathTracer& _tracer, const char* _filePath, const float* _mtx, const PathTracerMaterial& _material)
+	{
+		MeshFileData* data = meshFileOpen(_filePath);
+		if (NULL == data)
+		{
+			fprintf(stderr, "Failed to read '%s'.\n", _filePath);
+			return false;
+		}
+
+		std::vector<float> positions;
+		std::vector<float> normals;
+		std::vector<uint16_t> indices;
+
+		for (uint32_t ii = 0, num = uint32_t(data->m_mesh.m_groups.size() ); ii < num; ++ii)
+		{
+			const MeshFileGroup& group = data->m_mesh.m_groups[ii];
+			meshFileDecodeVertices(positions, normals, data->m_mesh, ii);
+
+			// Payloads aren't necessarily aligned.
+			indices.resize(group.m_numIndices);
+			bx::memCopy(indices.data(), group.m_indices, group.m_numIndices*sizeof(uint16_t) );
+
+			_tracer.addMesh(positions.data()
+				, normals.data()
+				, group.m_numVertices
+				, indices.data()
+				, group.m_numIndices
+				, _mtx
+				, _material
+				);
+		}
+
+		meshFileClose(data);
+		return true;
+	}
+
+	// View matrix of camera.h at _eye, looking along its yaw and pitch.
+	void cameraViewMtx(float* _outView, const bx::Vec3& _eye, float _horizontalAngle, float _verticalAngle)
+	{
+		const bx::Vec3 direction =
+		{
+			bx::cos(_verticalAngle) * bx::sin(_horizontalAngle),
+			bx::sin(_verticalAngle),
+			bx::cos(_verticalAngle) * bx::cos(_horizontalAngle),
+		};
+
+		const bx::Vec3 right =
+		{
+			bx::sin(_horizontalAngle - bx::kPiHalf),
+			0.0f,
+			bx::cos(_horizontalAngle - bx::kPiHalf),
+		};
+
+		bx::mtxLookAt(_outView, _eye, bx::add(_eye, direction), bx::cross(right, direction) );
+	}
+
+} // namespace
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitSuccess;
+	}
+
+	const char* outFilePath = cmdLine.findOption('o');
+	if (NULL == outFilePath)
+	{
+		help("Output file must be specified.");
+		return bx::kExitFailure;
+	}
+
+	const char* meshDir = cmdLine.findOption("meshes", "meshes");
+	const bool furnace  = cmdLine.hasArg("furnace");
+
+	PathTracerDesc desc;
+	uint32_t value = 0;
+	if (const char* width = cmdLine.findOption("width") )
+	{
+		bx::fromString(&value, width);
+		desc.m_width = uint16_t(bx::clamp<uint32_t>(value, 1, UINT16_MAX) );
+	}
+
+	if (const char* height = cmdLine.findOption("height") )
+	{
+		bx::fromString(&value, height);
+		desc.m_height = uint16_t(bx::clamp<uint32_t>(value, 1, UINT16_MAX) );
+	}
+
+	if (const char* samples = cmdLine.findOption("samples") )
+	{
+		bx::fromString(&desc.m_numSamples, samples);
+		desc.m_numSamples = bx::max<uint32_t>(desc.m_numSamples, 1);
+	}
+
+	if (const char* bounces = cmdLine.findOption("bounces") )
+	{
+		bx::fromString(&desc.m_maxBounces, bounces);
+		desc.m_maxBounces = bx::max<uint32_t>(desc.m_maxBounces, 1);
+	}
+
+	uint32_t numThreads = bx::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+	if (const char* threads = cmdLine.findOption("threads") )
+	{
+		bx::fromString(&numThreads, threads);
+		numThreads = bx::max<uint32_t>(numThreads, 1);
+	}
+
+	// LightsBasic's default gold.
+	PathTracerMaterial material;
+	material.m_albedo[0] = 1.0f;  material.m_albedo[1] = 0.782f; material.m_albedo[2] = 0.344f;
+	material.m_roughness = 0.2f;
+	material.m_f0[0]     = 1.02f; material.m_f0[1]     = 0.782f; material.m_f0[2]     = 0.344f;
+	material.m_metallic  = 1.0f;
+
+	if (const char* roughness = cmdLine.findOption("roughness") )
+	{
+		bx::fromString(&material.m_roughness, roughness);
+		material.m_roughness = bx::clamp(material.m_roughness, 0.0f, 1.0f);
+	}
+
+	if (const char* metallic = cmdLine.findOption("metallic") )
+	{
+		bx::fromString(&material.m_metallic, metallic);
+		material.m_metallic = bx::clamp(material.m_metallic, 0.0f, 1.0f);
+	}
+
+	if (furnace)
+	{
+		// White, so whatever goes missing is lost by the BRDF and not absorbed. Always
+		// metal: the LightsBasic model adds the diffuse lobe to the specular one without a
+		// (1 - F) split, so a white dielectric reflects up to twice what it receives.
+		material.m_albedo[0] = material.m_albedo[1] = material.m_albedo[2] = 1.0f;
+		material.m_f0[0]     = material.m_f0[1]     = material.m_f0[2]     = 1.0f;
+
+		if (material.m_metallic < 1.0f)
+		{
+			printf("[pathtracer] --furnace renders metal only, ignoring --metallic.\n");
+		}
+		material.m_metallic = 1.0f;
+	}
+
+	PathTracer tracer;
+
+	// Ground and bunny transforms of LightsBasic::onInit() and updateBunny().
+	char filePath[512];
+	if (!furnace)
+	{
+		float scale[16];
+		float translate[16];
+		float ground[16];
+		bx::mtxScale(scale, 10.0f);
+		bx::mtxTranslate(translate, 0.0f, -10.0f, 0.0f);
+		bx::mtxMul(ground, scale, translate);
+
+		bx::snprintf(filePath, sizeof(filePath), "%s/cube.bin", meshDir);
+		if (!addMeshFile(tracer, filePath, ground, material) )
+		{
+			return bx::kExitFailure;
+		}
+	}
+
+	float bunny[16];
+	bx::mtxScale(bunny, 2.0f);
+
+	bx::snprintf(filePath, sizeof(filePath), "%s/bunny.bin", meshDir);
+	if (!addMeshFile(tracer, filePath, bunny, material) )
+	{
+		return bx::kExitFailure;
+	}
+
+	// Default light of LightsBasic::updateLight().
+	if (!furnace)
+	{
+		const bx::Vec3 pos = bx::mul(bx::normalize(bx::fromLatLong(0.0f, -bx::toRad(30.0f) ) ), 20.0f);
+
+		PathTracerPointLight light;
+		bx::store(light.m_pos, pos);
+		light.m_color[0]  = light.m_color[1] = light.m_color[2] = 1.0f;
+		light.m_radiusMin = 1.0f;
+		light.m_radiusMax = 50.0f;
+		tracer.addLight(light);
+	}
+
+	std::vector<float> sky;
+	if (furnace)
+	{
+		sky.assign(4*2, 1.0f);
+		tracer.setEnvironment(sky.data(), 2, 1);
+	}
+	else
+	{
+		iblCreateSky(sky, 1024, 512);
+		tracer.setEnvironment(sky.data(), 1024, 512);
+	}
+
+	tracer.build();
+
+	// The calling thread works too.
+	JobSystem jobs;
+	jobs.init(numThreads - 1);
+
+	float view[16];
+	cameraViewMtx(view, { 0.0f, 3.0f, -6.0f }, 0.01f, -0.3f);
+
+	std::vector<float> image(uint32_t(desc.m_width)*desc.m_height*3);
+	tracer.render(image.data(), view, desc, &jobs);
+	jobs.shutdown();
+
+	const PathTracerStats& stats = tracer.getStats();
+	printf("[pathtracer] %ux%u, %u spp, %u bounces, %u triangles, %u nodes: build %.1f ms, trace %.1f ms on %u threads, %.2f Mrays/s\n"
+		, desc.m_width
+		, desc.m_height
+		, desc.m_numSamples
+		, desc.m_maxBounces
+		, stats.m_numTriangles
+		, stats.m_numNodes
+		, stats.m_buildTimeMs
+		, stats.m_renderTimeMs
+		, numThreads
+		, double(stats.m_numRays) / (stats.m_renderTimeMs * 1000.0)
+		);
+
+	bool energyConserved = true;
+	if (furnace)
+	{
+		// Under a white sky nothing may reflect more than it receives. Single pixels are
+		// noisy, the mean over the bunny isn't; rough surfaces lose what single scattering
+		// microfacets don't bounce twice, so they come out darker than 1.
+		double sum = 0.0;
+		float maxValue = 0.0f;
+		uint32_t numCovered = 0;
+		for (uint32_t ii = 0, num = uint32_t(image.size() ); ii < num; ii += 3)
+		{
+			const float lum = (image[ii] + image[ii+1] + image[ii+2]) / 3.0f;
+			if (lum < 0.9999f || lum > 1.0001f)
+			{
+				// Background pixels see the sky directly and are exactly 1.
+				sum += lum;
+				maxValue = bx::max(maxValue, lum);
+				++numCovered;
+			}
+		}
+
+		const double mean = numCovered > 0 ? sum / numCovered : 0.0;
+		printf("[pathtracer] furnace: %u bunny pixels, mean %.4f, max %.4f\n"
+			, numCovered
+			, mean
+			, maxValue
+			);
+
+		// Some slack for the noise left in the mean at low sample counts.
+		energyConserved = mean <= 1.01;
+		if (!energyConserved)
+		{
+			fprintf(stderr, "Furnace: the bunny reflects more than the sky, %.4f.\n", mean);
+		}
+	}
+
+	bx::Error err;
+	bx::FileWriter writer;
+	if (!bx::open(&writer, outFilePath, false, &err) )
+	{
+		fprintf(stderr, "Unable to open output file '%s'.\n", outFilePath);
+		return bx::kExitFailure;
+	}
+
+	pathTracerWriteHdr(&writer, image.data(), desc.m_width, desc.m_height, &err);
+	bx::close(&writer);
+
+	if (!err.isOk() )
+	{
+		fprintf(stderr, "Failed to write '%s'.\n", outFilePath);
+		return bx::kExitFailure;
+	}
+
+	return energyConserved ? bx::kExitSuccess : bx::kExitFailure;
+}
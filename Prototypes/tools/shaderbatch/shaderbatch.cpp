@@ -0,0 +1,691 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+// Batch shader compiler. Compiles every shader, variant and backend listed in a
+// manifest with shaderc on a thread pool, instead of one build command per binary.
+// Sources and includes are read, scanned and hashed once for the whole batch, binaries
+// newer than their inputs are skipped and the rest go through the shader cache. Writes
+// one depfile for the build system and prints the time each shader took.
+//
+// Manifest lines are tab separated; add_prototype() writes one per prototype with
+// SGTESTBED_SHADER_BATCH on:
+//
+//   shaderc <path to shaderc>
+//   cache   <shader cache directory, may be empty>
+//   shader  <shaderc arguments, one per field>
+
+#include <bx/commandline.h>
+#include <bx/hash.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "job_system.h"
+#include "mapped_file.h"
+
+#if BX_PLATFORM_WINDOWS
+#	define popen  _popen
+#	define pclose _pclose
+#endif // BX_PLATFORM_WINDOWS
+
+namespace
+{
+	namespace fs = std::filesystem;
+
+	void help(const char* _error = NULL)
+	{
+		if (NULL != _error)
+		{
+			fprintf(stderr, "Error:\n%s\n\n", _error);
+		}
+
+		fprintf(stderr
+			, "Usage: shaderbatch --manifest <file> [options]\n"
+			  "\n"
+			  "Options:\n"
+			  "  --manifest <file>   Shaders to compile, see the top of shaderbatch.cpp.\n"
+			  "  --depfile <file>    Depfile listing every source and include, for --stamp.\n"
+			  "  --stamp <file>      Touched once every shader is up to date.\n"
+			  "  --threads <n>       Concurrent shaderc processes (default one per hardware thread).\n"
+			  "  --force             Compile binaries that are up to date too.\n"
+			  "  --verbose           List every shader's time, not only the slowest.\n"
+			);
+	}
+
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+	// Two seeds, so a cache key has 64 bits.
+	struct Hash64
+	{
+		void begin()
+		{
+			m_lo.begin(0);
+			m_hi.begin(0x9e3779b9);
+		}
+
+		void add(const void* _data, uint32_t _size)
+		{
+			m_lo.add(_data, _size);
+			m_hi.add(_data, _size);
+		}
+
+		void add(const std::string& _str)
+		{
+			// Lengths keep "ab", "c" apart from "a", "bc".
+			const uint32_t size = uint32_t(_str.size() );
+			add(&size, sizeof(size) );
+			add(_str.data(), size);
+		}
+
+		uint64_t end()
+		{
+			return uint64_t(m_hi.end() ) << 32 | m_lo.end();
+		}
+
+		bx::HashMurmur2A m_lo;
+		bx::HashMurmur2A m_hi;
+	};
+
+	struct SourceFile
+	{
+		std::string m_path;
+		std::vector<std::string> m_includes;
+		fs::file_time_type m_modified;
+		uint64_t m_hash;
+		uint32_t m_size;
+	};
+
+	// Every file a batch reads, each read, scanned for #include and hashed once no
+	// matter how many shaders include it.
+	class SourceFiles
+	{
+	public:
+		// Index of the file, UINT32_MAX if it doesn't exist. ../common/common.sh from two
+		// directories is the same file.
+		uint32_t get(const std::string& _path)
+		{
+			const std::string path = fs::path(_path).lexically_normal().generic_string();
+
+			std::unordered_map<std::string, uint32_t>::const_iterator it = m_lookup.find(path);
+			if (it != m_lookup.end() )
+			{
+				return it->second;
+			}
+
+			std::error_code ec;
+			uint32_t index = UINT32_MAX;
+			if (fs::is_regular_file(path, ec) )
+			{
+				index = uint32_t(m_files.size() );
+				m_files.push_back(load(path) );
+			}
+
+			m_lookup[path] = index;
+			return index;
+		}
+
+		const SourceFile& operator[](uint32_t _index) const { return m_files[_index]; }
+		uint32_t getNumFiles() const { return uint32_t(m_files.size() ); }
+
+		// _file and everything it includes, recursively, searched next to the including
+		// file and then in _includeDirs. Every #include counts, taken or not.
+		void collect(std::vector<uint32_t>& _out, uint32_t _file, const std::vector<std::string>& _includeDirs)
+		{
+			_out.clear();
+			_out.push_back(_file);
+			for (uint32_t ii = 0; ii < _out.size(); ++ii)
+			{
+				// Copied, get() may grow m_files.
+				const std::string dir       = fs::path(m_files[_out[ii] ].m_path).parent_path().generic_string();
+				const std::vector<std::string> includes = m_files[_out[ii] ].m_includes;
+
+				for (const std::string& name : includes)
+				{
+					uint32_t include = get(dir + "/" + name);
+					for (uint32_t jj = 0; UINT32_MAX == include && jj < _includeDirs.size(); ++jj)
+					{
+						include = get(_includeDirs[jj] + "/" + name);
+					}
+
+					if (UINT32_MAX != include
+					&&  _out.end() == std::find(_out.begin(), _out.end(), include) )
+					{
+						_out.push_back(include);
+					}
+				}
+			}
+		}
+
+	private:
+		static SourceFile load(const std::string& _path)
+		{
+			std::error_code ec;
+			SourceFile file;
+			file.m_path     = _path;
+			file.m_modified = fs::last_write_time(_path, ec);
+			file.m_size     = 0;
+
+			Hash64 hash;
+			hash.begin();
+
+			// Empty files don't map.
+			if (MappedFile* mapped = mappedFileOpen(_path.c_str() ) )
+			{
+				const char* data = (const char*)mappedFileGetData(mapped);
+				file.m_size = mappedFileGetSize(mapped);
+				hash.add(data, file.m_size);
+
+				for (const char* line = data, *end = data + file.m_size; line < end;)
+				{
+					const char* eol = (const char*)memchr(line, '\n', end - line);
+					eol = NULL != eol ? eol : end;
+
+					const char* ptr = line;
+					while (ptr < eol && (' ' == *ptr || '\t' == *ptr) ) { ++ptr; }
+					if (ptr < eol && '#' == *ptr)
+					{
+						++ptr;
+						while (ptr < eol && (' ' == *ptr || '\t' == *ptr) ) { ++ptr; }
+						if (eol - ptr > 7 && 0 == bx::strCmp(bx::StringView(ptr, 7), "include") )
+						{
+							ptr += 7;
+							while (ptr < eol && (' ' == *ptr || '\t' == *ptr) ) { ++ptr; }
+							if (ptr < eol && ('"' == *ptr || '<' == *ptr) )
+							{
+								const char close = '"' == *ptr ? '"' : '>';
+								const char* name = ++ptr;
+								while (ptr < eol && close != *ptr) { ++ptr; }
+								if (ptr < eol)
+								{
+									file.m_includes.emplace_back(name, ptr - name);
+								}
+							}
+						}
+					}
+
+					line = eol + 1;
+				}
+
+				mappedFileRelease(mapped);
+			}
+
+			file.m_hash = hash.end();
+			return file;
+		}
+
+		std::vector<SourceFile> m_files;
+		std::unordered_map<std::string, uint32_t> m_lookup;
+	};
+
+	struct ShaderResult
+	{
+		enum Enum
+		{
+			UpToDate,
+			Cached,
+			Compiled,
+			Failed,
+
+			Count
+		};
+	};
+
+	struct ShaderJob
+	{
+		std::vector<std::string> m_args;
+		std::string m_input;
+		std::string m_output;
+		std::vector<std::string> m_includeDirs;
+		std::string m_varyingDef;
+
+		std::vector<uint32_t> m_depends;
+		uint32_t m_cost;
+		uint64_t m_key;
+
+		ShaderResult::Enum m_result;
+		double m_timeMs;
+	};
+
+	// Quoted for the shell popen() runs.
+	void appendQuoted(std::string& _out, const std::string& _arg)
+	{
+#if BX_PLATFORM_WINDOWS
+		_out += '"';
+		_out += _arg;
+		_out += '"';
+#else
+		_out += '\'';
+		for (char ch : _arg)
+		{
+			_out += ch;
+			if ('\'' == ch)
+			{
+				_out += "\\''";
+			}
+		}
+		_out += '\'';
+#endif // BX_PLATFORM_WINDOWS
+	}
+
+	// Exit code of the command, its output in _outLog.
+	int32_t run(const std::string& _command, std::string& _outLog)
+	{
+		FILE* pipe = popen(_command.c_str(), "r");
+		if (NULL == pipe)
+		{
+			_outLog = "Unable to run: " + _command + "\n";
+			return -1;
+		}
+
+		char buffer[4096];
+		for (size_t size = fread(buffer, 1, sizeof(buffer), pipe); 0 < size; size = fread(buffer, 1, sizeof(buffer), pipe) )
+		{
+			_outLog.append(buffer, size);
+		}
+
+		return pclose(pipe);
+	}
+
+	// Keys hash the sources as written, shaderCache.cmake hashes shaderc's preprocessed
+	// output so the two never match. The batch keeps to its own directory of the shared
+	// store rather than filling it with entries the per-shader commands can't find, and
+	// doesn't pay a preprocess per shader to compute theirs.
+	std::string cachePath(const std::string& _cacheDir, uint64_t _key)
+	{
+		char name[40];
+		bx::snprintf(name, sizeof(name), "batch/%02x/%016llx.bin", uint32_t(_key >> 56), (unsigned long long)_key);
+		return _cacheDir + "/" + name;
+	}
+
+	bool parseManifest(const char* _filePath, std::string& _outShaderc, std::string& _outCacheDir, std::vector<ShaderJob>& _outJobs)
+	{
+		MappedFile* mapped = mappedFileOpen(_filePath);
+		if (NULL == mapped)
+		{
+			return false;
+		}
+
+		const char* data = (const char*)mappedFileGetData(mapped);
+		const char* end  = data + mappedFileGetSize(mapped);
+
+		for (const char* line = data; line < end;)
+		{
+			const char* eol = (const char*)memchr(line, '\n', end - line);
+			eol = NULL != eol ? eol : end;
+
+			std::vector<std::string> fields;
+			for (const char* field = line; field < eol;)
+			{
+				const char* tab = (const char*)memchr(field, '\t', eol - field);
+				tab = NULL != tab ? tab : eol;
+				fields.emplace_back(field, tab - field);
+				field = tab + 1;
+			}
+
+			line = eol + 1;
+			if (fields.empty() )
+			{
+				continue;
+			}
+
+			if ("shaderc" == fields[0] && 2 <= fields.size() )
+			{
+				_outShaderc = fields[1];
+			}
+			else if ("cache" == fields[0] && 2 <= fields.size() )
+			{
+				_outCacheDir = fields[1];
+			}
+			else if ("shader" == fields[0])
+			{
+				ShaderJob job;
+				job.m_args.assign(fields.begin() + 1, fields.end() );
+				for (size_t ii = 0; ii + 1 < job.m_args.size(); ++ii)
+				{
+					const std::string& arg = job.m_args[ii];
+					if      ("-f" == arg)           { job.m_input      = job.m_args[ii + 1]; }
+					else if ("-o" == arg)           { job.m_output     = job.m_args[ii + 1]; }
+					else if ("-i" == arg)           { job.m_includeDirs.push_back(job.m_args[ii + 1]); }
+					else if ("--varyingdef" == arg) { job.m_varyingDef = job.m_args[ii + 1]; }
+				}
+
+				if (job.m_varyingDef.empty() )
+				{
+					// shaderc's default.
+					job.m_varyingDef = fs::path(job.m_input).parent_path().generic_string() + "/varying.def.sc";
+				}
+
+				job.m_cost   = 0;
+				job.m_key    = 0;
+				job.m_result = ShaderResult::UpToDate;
+				job.m_timeMs = 0.0;
+				_outJobs.push_back(job);
+			}
+		}
+
+		mappedFileRelease(mapped);
+		return !_outShaderc.empty();
+	}
+
+	// Make syntax, spaces escaped.
+	void appendDepfilePath(std::string& _out, const std::string& _path)
+	{
+		for (char ch : _path)
+		{
+			if (' ' == ch)
+			{
+				_out += '\\';
+			}
+			_out += ch;
+		}
+	}
+
+	const char* resultName(ShaderResult::Enum _result)
+	{
+		switch (_result)
+		{
+		case ShaderResult::UpToDate: return "up to date";
+		case ShaderResult::Cached:   return "cached";
+		case ShaderResult::Compiled: return "compiled";
+		default:                        return "FAILED";
+		}
+	}
+
+} // namespace
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitSuccess;
+	}
+
+	const char* manifestPath = cmdLine.findOption("manifest");
+	if (NULL == manifestPath)
+	{
+		help("Manifest must be specified.");
+		return bx::kExitFailure;
+	}
+
+	const char* depfilePath = cmdLine.findOption("depfile");
+	const char* stampPath   = cmdLine.findOption("stamp");
+	const bool force        = cmdLine.hasArg("force");
+	const bool verbose      = cmdLine.hasArg("verbose");
+
+	uint32_t numThreads = bx::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+	if (const char* threads = cmdLine.findOption("threads") )
+	{
+		bx::fromString(&numThreads, threads);
+		numThreads = bx::max<uint32_t>(numThreads, 1);
+	}
+
+	std::string shaderc;
+	std::string cacheDir;
+	std::vector<ShaderJob> jobs;
+	if (!parseManifest(manifestPath, shaderc, cacheDir, jobs) )
+	{
+		fprintf(stderr, "Unable to read manifest '%s'.\n", manifestPath);
+		return bx::kExitFailure;
+	}
+
+	const int64_t start = bx::getHPCounter();
+
+	// Inputs of every job, read once. A changed manifest means changed arguments, so
+	// it counts as an input of every binary.
+	std::error_code ec;
+	const fs::file_time_type manifestModified = fs::last_write_time(manifestPath, ec);
+	const fs::file_time_type shadercModified  = fs::last_write_time(shaderc, ec);
+	SourceFiles files;
+
+	uint64_t shadercHash = 0;
+	if (!cacheDir.empty() )
+	{
+		const uint32_t index = files.get(shaderc);
+		shadercHash = UINT32_MAX != index ? files[index].m_hash : 0;
+	}
+
+	for (ShaderJob& job : jobs)
+	{
+		const uint32_t input = files.get(job.m_input);
+		if (UINT32_MAX == input)
+		{
+			fprintf(stderr, "%s: No such file.\n", job.m_input.c_str() );
+			job.m_result = ShaderResult::Failed;
+			continue;
+		}
+
+		files.collect(job.m_depends, input, job.m_includeDirs);
+		const uint32_t varying = files.get(job.m_varyingDef);
+		if (UINT32_MAX != varying)
+		{
+			job.m_depends.push_back(varying);
+		}
+
+		fs::file_time_type newest = std::max(manifestModified, shadercModified);
+		for (uint32_t depend : job.m_depends)
+		{
+			newest = std::max(newest, files[depend].m_modified);
+			job.m_cost += files[depend].m_size;
+		}
+
+		const fs::file_time_type outputModified = fs::last_write_time(job.m_output, ec);
+		if (!force
+		&&  !ec
+		&&  outputModified >= newest)
+		{
+			continue;
+		}
+
+		if (!cacheDir.empty() )
+		{
+			// Arguments without the output path, the sources in include order.
+			Hash64 key;
+			key.begin();
+			key.add(&shadercHash, sizeof(shadercHash) );
+			for (const std::string& arg : job.m_args)
+			{
+				key.add(arg == job.m_output ? std::string() : arg);
+			}
+
+			for (uint32_t depend : job.m_depends)
+			{
+				key.add(&files[depend].m_hash, sizeof(uint64_t) );
+			}
+
+			job.m_key = key.end();
+		}
+
+		job.m_result = ShaderResult::Compiled;
+	}
+
+	// Largest sources first, so a long compile doesn't start last.
+	std::vector<uint32_t> order;
+	for (uint32_t ii = 0, num = uint32_t(jobs.size() ); ii < num; ++ii)
+	{
+		if (ShaderResult::Compiled == jobs[ii].m_result)
+		{
+			order.push_back(ii);
+		}
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t _a, uint32_t _b) { return jobs[_a].m_cost > jobs[_b].m_cost; });
+
+	std::mutex outputMutex;
+	const JobSystem::RangeFn compile = [&](uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			ShaderJob& job = jobs[order[ii] ];
+			const int64_t jobStart = bx::getHPCounter();
+
+			std::error_code error;
+			fs::create_directories(fs::path(job.m_output).parent_path(), error);
+
+			const std::string entry = cacheDir.empty() ? std::string() : cachePath(cacheDir, job.m_key);
+			if (!entry.empty()
+			&&  fs::copy_file(entry, job.m_output, fs::copy_options::overwrite_existing, error) )
+			{
+				job.m_result = ShaderResult::Cached;
+				job.m_timeMs = toMs(bx::getHPCounter() - jobStart);
+				continue;
+			}
+
+			std::string command;
+			appendQuoted(command, shaderc);
+			for (const std::string& arg : job.m_args)
+			{
+				command += ' ';
+				appendQuoted(command, arg);
+			}
+			command += " 2>&1";
+
+#if BX_PLATFORM_WINDOWS
+			// cmd /c strips the outermost quotes.
+			command = "\"" + command + "\"";
+#endif // BX_PLATFORM_WINDOWS
+
+			std::string log;
+			const int32_t result = run(command, log);
+			job.m_timeMs = toMs(bx::getHPCounter() - jobStart);
+
+			if (0 != result)
+			{
+				job.m_result = ShaderResult::Failed;
+				fs::remove(job.m_output, error);
+			}
+			else if (!entry.empty() )
+			{
+				// Concurrent batches may add the same entry, each renames its own copy.
+				char suffix[32];
+				bx::snprintf(suffix, sizeof(suffix), ".%llx.%u", (unsigned long long)start, ii);
+				fs::create_directories(fs::path(entry).parent_path(), error);
+				if (fs::copy_file(job.m_output, entry + suffix, fs::copy_options::overwrite_existing, error) )
+				{
+					fs::rename(entry + suffix, entry, error);
+				}
+			}
+
+			// One shader's messages at a time.
+			if (!log.empty()
+			||  0 != result)
+			{
+				std::lock_guard<std::mutex> lock(outputMutex);
+				fprintf(stderr, "%s%s", log.c_str(), 0 != result ? "" : "\n");
+				if (0 != result)
+				{
+					fprintf(stderr, "shaderc failed to compile %s.\n", job.m_input.c_str() );
+				}
+			}
+		}
+	};
+
+	if (1 < numThreads)
+	{
+		// The calling thread compiles too.
+		JobSystem pool;
+		pool.init(numThreads - 1);
+		pool.parallelFor(uint32_t(order.size() ), 1, compile);
+		pool.shutdown();
+	}
+	else
+	{
+		compile(0, uint32_t(order.size() ) );
+	}
+
+	const double wallMs = toMs(bx::getHPCounter() - start);
+
+	uint32_t numResults[ShaderResult::Count] = {};
+	double compileMs = 0.0;
+	for (const ShaderJob& job : jobs)
+	{
+		++numResults[job.m_result];
+		compileMs += job.m_timeMs;
+	}
+
+	// Slowest first. Up to date binaries took no time.
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t _a, uint32_t _b) { return jobs[_a].m_timeMs > jobs[_b].m_timeMs; });
+	const uint32_t numListed = verbose ? uint32_t(order.size() ) : bx::min<uint32_t>(uint32_t(order.size() ), 10);
+	for (uint32_t ii = 0; ii < numListed; ++ii)
+	{
+		const ShaderJob& job = jobs[order[ii] ];
+		printf("[shaderbatch] %9.1f ms  %-10s %s\n"
+			, job.m_timeMs
+			, resultName(job.m_result)
+			, job.m_output.c_str()
+			);
+	}
+
+	printf("[shaderbatch] %u binaries: %u compiled, %u cached, %u up to date, %u failed; %u source files; %.1f ms on %u threads, %.1f ms of shaderc (%.2fx)\n"
+		, uint32_t(jobs.size() )
+		, numResults[ShaderResult::Compiled]
+		, numResults[ShaderResult::Cached]
+		, numResults[ShaderResult::UpToDate]
+		, numResults[ShaderResult::Failed]
+		, files.getNumFiles()
+		, wallMs
+		, numThreads
+		, compileMs
+		, wallMs > 0.0 ? compileMs / wallMs : 0.0
+		);
+
+	// One depfile for the stamp, with every input of every binary. The batch itself
+	// only compiles what changed.
+	if (NULL != depfilePath
+	&&  NULL != stampPath)
+	{
+		std::vector<bool> listed(files.getNumFiles(), false);
+		std::string content;
+		appendDepfilePath(content, stampPath);
+		content += ":";
+		for (const ShaderJob& job : jobs)
+		{
+			for (uint32_t depend : job.m_depends)
+			{
+				if (!listed[depend])
+				{
+					listed[depend] = true;
+					content += " \\\n  ";
+					appendDepfilePath(content, files[depend].m_path);
+				}
+			}
+		}
+		content += "\n";
+
+		if (FILE* file = fopen(depfilePath, "wb") )
+		{
+			fwrite(content.data(), 1, content.size(), file);
+			fclose(file);
+		}
+	}
+
+	if (0 != numResults[ShaderResult::Failed])
+	{
+		return bx::kExitFailure;
+	}
+
+	if (NULL != stampPath)
+	{
+		if (FILE* file = fopen(stampPath, "wb") )
+		{
+			fclose(file);
+		}
+	}
+
+	return bx::kExitSuccess;
+}
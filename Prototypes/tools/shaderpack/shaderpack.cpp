@@ -0,0 +1,218 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+// Packs compiled shaders into a shader archive, see common/shader_archive.h. The list
+// holds one shaderc binary per line; add_prototype() writes one per backend and the
+// build packs runtime/shaders/<backend>/ into runtime/shaders/<backend>.pack. Shaders are
+// named after their file without the extension, as loadShader() names them.
+
+#include <bx/commandline.h>
+#include <bx/file.h>
+#include <bx/filepath.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <filesystem>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mapped_file.h"
+#include "shader_archive.h"
+
+namespace
+{
+	namespace fs = std::filesystem;
+
+	void help(const char* _error = NULL)
+	{
+		if (NULL != _error)
+		{
+			fprintf(stderr, "Error:\n%s\n\n", _error);
+		}
+
+		fprintf(stderr
+			, "Usage: shaderpack -o <archive> --list <file>\n"
+			  "\n"
+			  "Options:\n"
+			  "  -o <archive>     Output shader archive.\n"
+			  "  --list <file>    Compiled shaders to pack, one path per line.\n"
+			  "  --verbose        List every packed shader.\n"
+			);
+	}
+
+	double toMs(int64_t _ticks)
+	{
+		return double(_ticks) * 1000.0 / double(bx::getHPFrequency() );
+	}
+
+	bool readList(const char* _filePath, std::vector<std::string>& _outPaths)
+	{
+		MappedFile* mapped = mappedFileOpen(_filePath);
+		if (NULL == mapped)
+		{
+			return false;
+		}
+
+		const char* data = (const char*)mappedFileGetData(mapped);
+		const char* end  = data + mappedFileGetSize(mapped);
+
+		for (const char* line = data; line < end;)
+		{
+			const char* eol = (const char*)memchr(line, '\n', end - line);
+			eol = NULL != eol ? eol : end;
+
+			const bx::StringView path = bx::strTrim(bx::StringView(line, int32_t(eol - line) ), " \t\r");
+			if (!path.isEmpty() )
+			{
+				_outPaths.emplace_back(path.getPtr(), path.getLength() );
+			}
+
+			line = eol + 1;
+		}
+
+		mappedFileRelease(mapped);
+		return true;
+	}
+
+} // namespace
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitSuccess;
+	}
+
+	const char* outFilePath = cmdLine.findOption('o');
+	if (NULL == outFilePath)
+	{
+		help("Output file must be specified.");
+		return bx::kExitFailure;
+	}
+
+	const char* listPath = cmdLine.findOption("list");
+	if (NULL == listPath)
+	{
+		help("Shader list must be specified.");
+		return bx::kExitFailure;
+	}
+
+	const bool verbose = cmdLine.hasArg("verbose");
+
+	std::vector<std::string> paths;
+	if (!readList(listPath, paths) )
+	{
+		fprintf(stderr, "Unable to read shader list '%s'.\n", listPath);
+		return bx::kExitFailure;
+	}
+
+	const int64_t start = bx::getHPCounter();
+
+	// Binaries stay mapped until the archive is written.
+	std::vector<std::string> names;
+	std::vector<MappedFile*> files;
+	std::unordered_map<std::string, size_t> byName;
+	names.reserve(paths.size() );
+	files.reserve(paths.size() );
+
+	bool valid = true;
+	for (const std::string& path : paths)
+	{
+		const bx::FilePath filePath(path.c_str() );
+		const bx::StringView baseName = filePath.getBaseName();
+		std::string name(baseName.getPtr(), baseName.getLength() );
+
+		const auto it = byName.find(name);
+		if (it != byName.end() )
+		{
+			fprintf(stderr, "Shader '%s' is both '%s' and '%s'.\n", name.c_str(), paths[it->second].c_str(), path.c_str() );
+			valid = false;
+			break;
+		}
+
+		MappedFile* file = mappedFileOpen(path.c_str() );
+		if (NULL == file)
+		{
+			fprintf(stderr, "Unable to open shader '%s'.\n", path.c_str() );
+			valid = false;
+			break;
+		}
+
+		byName.emplace(name, names.size() );
+		names.push_back(std::move(name) );
+		files.push_back(file);
+	}
+
+	std::vector<ShaderArchiveEntry> entries(files.size() );
+	uint64_t totalSize = 0;
+	for (size_t ii = 0; ii < files.size(); ++ii)
+	{
+		entries[ii].m_name = bx::StringView(names[ii].c_str(), int32_t(names[ii].size() ) );
+		entries[ii].m_data = mappedFileGetData(files[ii]);
+		entries[ii].m_size = mappedFileGetSize(files[ii]);
+		totalSize += entries[ii].m_size;
+
+		if (verbose)
+		{
+			printf("  %8u  %s\n", entries[ii].m_size, names[ii].c_str() );
+		}
+	}
+
+	// Written next to the archive and renamed over it, a running prototype may still
+	// have the old one mapped.
+	const std::string tmpFilePath = std::string(outFilePath) + ".tmp";
+
+	bool written = false;
+	if (valid)
+	{
+		bx::Error err;
+		bx::makeAll(bx::FilePath(bx::FilePath(outFilePath).getPath() ), &err);
+
+		bx::FileWriter writer;
+		if (bx::open(&writer, tmpFilePath.c_str(), false, &err) )
+		{
+			written = shaderArchiveWrite(&writer, entries.data(), uint32_t(entries.size() ), &err);
+			bx::close(&writer);
+		}
+		else
+		{
+			fprintf(stderr, "Unable to open output file '%s'.\n", tmpFilePath.c_str() );
+		}
+	}
+
+	for (MappedFile* file : files)
+	{
+		mappedFileRelease(file);
+	}
+
+	std::error_code ec;
+	if (written)
+	{
+		fs::rename(tmpFilePath, outFilePath, ec);
+		written = !ec;
+	}
+
+	if (!written)
+	{
+		fs::remove(tmpFilePath, ec);
+		fprintf(stderr, "Failed to write '%s'.\n", outFilePath);
+		return bx::kExitFailure;
+	}
+
+	printf("[shaderpack] %s: %u shader(s), %.2f KB, %.3f ms\n"
+		, outFilePath
+		, uint32_t(entries.size() )
+		, double(totalSize) / 1024.0
+		, toMs(bx::getHPCounter() - start)
+		);
+
+	return bx::kExitSuccess;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2025 Soumitra Goswami. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+// Build time generator for a prototype's uniforms.sh. Compiled once per prototype with
+// UNIFORMGEN_HEADER pointing at its uniforms.h, which lists its blocks in
+// UNIFORM_BLOCKS(_x).
+
+#include <stdio.h>
+#include <string>
+
+#include "uniform_layout.h"
+#include UNIFORMGEN_HEADER
+
+int main(int _argc, const char* _argv[])
+{
+	if (_argc < 2)
+	{
+		fprintf(stderr, "Usage: uniformgen <uniforms.sh>\n");
+		return 1;
+	}
+
+	std::string source = "// Generated by uniformgen from uniforms.h. Do not edit.\n";
+
+#define UNIFORMGEN_WRITE_BLOCK(_desc) \
+	source += "\n"; \
+	uniformLayoutWriteShader<_desc>(source);
+
+	UNIFORM_BLOCKS(UNIFORMGEN_WRITE_BLOCK)
+
+#undef UNIFORMGEN_WRITE_BLOCK
+
+	FILE* file = fopen(_argv[1], "wb");
+	if (NULL == file)
+	{
+		fprintf(stderr, "uniformgen: Failed to open '%s' for writing.\n", _argv[1]);
+		return 1;
+	}
+
+	fwrite(source.data(), 1, source.size(), file);
+	fclose(file);
+
+	return 0;
+}